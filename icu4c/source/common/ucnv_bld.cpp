@@ -45,6 +45,7 @@
 #include "cmemory.h"
 #include "ucln_cmn.h"
 #include "ustr_cnv.h"
+#include "ustr_imp.h"
 
 
 #if 0
@@ -195,6 +196,17 @@ static struct {
 /*initializes some global variables */
 static UHashtable *SHARED_DATA_HASHTABLE = NULL;
 static icu::UMutex cnvCacheMutex;
+
+/*
+ * Pinned shared data, see ucnv_setCachePinning().
+ * Open-addressing table of pinned entries which are also in SHARED_DATA_HASHTABLE.
+ * Slots are only written while holding cnvCacheMutex, and only change from NULL to
+ * non-NULL (except in ucnv_cleanup()), so that readers need not take the mutex.
+ */
+#define UCNV_PINNED_TABLE_SIZE 64
+static std::atomic<UConverterSharedData *> gPinnedSharedData[UCNV_PINNED_TABLE_SIZE];
+/* Protected by cnvCacheMutex. */
+static UBool gCachePinning = FALSE;
 /*  Note:  the global mutex is used for      */
 /*         reference count updates.          */
 
@@ -237,11 +249,35 @@ ucnv_flushAvailableConverterCache() {
     gAvailableConvertersInitOnce.reset();
 }
 
+/* ucnv_unpinSharedData. This is only called from ucnv_cleanup().
+ *                       Makes pinned shared data reference-counted again so that
+ *                       ucnv_flushCache() can delete it.
+ */
+static void
+ucnv_unpinSharedData() {
+    for (int32_t i = 0; i < UCNV_PINNED_TABLE_SIZE; ++i) {
+        gPinnedSharedData[i].store(NULL, std::memory_order_relaxed);
+    }
+    gCachePinning = FALSE;
+    if (SHARED_DATA_HASHTABLE != NULL) {
+        int32_t pos = UHASH_FIRST;
+        const UHashElement *e;
+        while ((e = uhash_nextElement(SHARED_DATA_HASHTABLE, &pos)) != NULL) {
+            UConverterSharedData *sharedData = (UConverterSharedData *)e->value.pointer;
+            if (sharedData->isPinned) {
+                sharedData->isPinned = FALSE;
+                sharedData->referenceCounter = 0;
+            }
+        }
+    }
+}
+
 /* ucnv_cleanup - delete all storage held by the converter cache, except any  */
 /*                in use by open converters.                                  */
 /*                Not thread safe.                                            */
 /*                Not supported API.                                          */
 static UBool U_CALLCONV ucnv_cleanup(void) {
+    ucnv_unpinSharedData();
     ucnv_flushCache();
     if (SHARED_DATA_HASHTABLE != NULL && uhash_count(SHARED_DATA_HASHTABLE) == 0) {
         uhash_close(SHARED_DATA_HASHTABLE);
@@ -426,6 +462,24 @@ getAlgorithmicTypeFromName(const char *realName)
 */
 #define UCNV_CACHE_LOAD_FACTOR 2
 
+/* Adds pinned shared data to the lock-free lookup table.              */
+/*   Must be called with the cnvCacheMutex being held.                */
+/*   If the table is full, then the data remains pinned but can only  */
+/*     be found via SHARED_DATA_HASHTABLE.                            */
+static void
+ucnv_pinSharedData(UConverterSharedData *data)
+{
+    const char *name = data->staticData->name;
+    int32_t i = ustr_hashCharsN(name, (int32_t)uprv_strlen(name)) & (UCNV_PINNED_TABLE_SIZE - 1);
+    for (int32_t count = 0; count < UCNV_PINNED_TABLE_SIZE; ++count) {
+        if (gPinnedSharedData[i].load(std::memory_order_relaxed) == NULL) {
+            gPinnedSharedData[i].store(data, std::memory_order_release);
+            return;
+        }
+        i = (i + 1) & (UCNV_PINNED_TABLE_SIZE - 1);
+    }
+}
+
 /* Puts the shared data in the static hashtable SHARED_DATA_HASHTABLE */
 /*   Will always be called with the cnvCacheMutex alrady being held   */
 /*     by the calling function.                                       */
@@ -464,6 +518,12 @@ ucnv_shareConverterData(UConverterSharedData * data)
     /* Mark it shared */
     data->sharedDataCached = TRUE;
 
+    if (gCachePinning) {
+        /* Pin it before it becomes visible to other threads. */
+        data->isPinned = TRUE;
+        ucnv_pinSharedData(data);
+    }
+
     uhash_put(SHARED_DATA_HASHTABLE,
             (void*) data->staticData->name, /* Okay to cast away const as long as
             keyDeleter == NULL */
@@ -473,7 +533,26 @@ ucnv_shareConverterData(UConverterSharedData * data)
 
 }
 
-/*  Look up a converter name in the shared data cache.                    */
+/*  Look up a converter name in the pinned shared data table.                */
+/*    Does not require cnvCacheMutex.                                         */
+static UConverterSharedData *
+ucnv_getPinnedSharedData(const char *name)
+{
+    int32_t i = ustr_hashCharsN(name, (int32_t)uprv_strlen(name)) & (UCNV_PINNED_TABLE_SIZE - 1);
+    for (int32_t count = 0; count < UCNV_PINNED_TABLE_SIZE; ++count) {
+        UConverterSharedData *data = gPinnedSharedData[i].load(std::memory_order_acquire);
+        if (data == NULL) {
+            break;
+        }
+        if (uprv_strcmp(data->staticData->name, name) == 0) {
+            return data;
+        }
+        i = (i + 1) & (UCNV_PINNED_TABLE_SIZE - 1);
+    }
+    return NULL;
+}
+
+
 /*    cnvCacheMutex must be held by the caller to protect the hash table. */
 /* gets the shared data from the SHARED_DATA_HASHTABLE (might return NULL if it isn't there)
  * @param name The name of the shared data
@@ -571,7 +650,9 @@ ucnv_load(UConverterLoadArgs *pArgs, UErrorCode *err) {
     {
         /* The data for this converter was already in the cache.            */
         /* Update the reference counter on the shared data: one more client */
-        mySharedConverterData->referenceCounter++;
+        if (!mySharedConverterData->isPinned) {
+            mySharedConverterData->referenceCounter++;
+        }
     }
 
     return mySharedConverterData;
@@ -584,7 +665,7 @@ ucnv_load(UConverterLoadArgs *pArgs, UErrorCode *err) {
  */
 U_CAPI void
 ucnv_unload(UConverterSharedData *sharedData) {
-    if(sharedData != NULL) {
+    if(sharedData != NULL && !sharedData->isPinned) {
         if (sharedData->referenceCounter > 0) {
             sharedData->referenceCounter--;
         }
@@ -598,7 +679,7 @@ ucnv_unload(UConverterSharedData *sharedData) {
 U_CFUNC void
 ucnv_unloadSharedDataIfReady(UConverterSharedData *sharedData)
 {
-    if(sharedData != NULL && sharedData->isReferenceCounted) {
+    if(sharedData != NULL && sharedData->isReferenceCounted && !sharedData->isPinned) {
         umtx_lock(&cnvCacheMutex);
         ucnv_unload(sharedData);
         umtx_unlock(&cnvCacheMutex);
@@ -608,7 +689,7 @@ ucnv_unloadSharedDataIfReady(UConverterSharedData *sharedData)
 U_CFUNC void
 ucnv_incrementRefCount(UConverterSharedData *sharedData)
 {
-    if(sharedData != NULL && sharedData->isReferenceCounted) {
+    if(sharedData != NULL && sharedData->isReferenceCounted && !sharedData->isPinned) {
         umtx_lock(&cnvCacheMutex);
         sharedData->referenceCounter++;
         umtx_unlock(&cnvCacheMutex);
@@ -812,9 +893,13 @@ ucnv_loadSharedData(const char *converterName,
         pArgs->nestedLoads=1;
         pArgs->pkg=NULL;
 
-        umtx_lock(&cnvCacheMutex);
-        mySharedConverterData = ucnv_load(pArgs, err);
-        umtx_unlock(&cnvCacheMutex);
+        /* Pinned data is never unloaded, and can be found without the mutex. */
+        mySharedConverterData = ucnv_getPinnedSharedData(pArgs->name);
+        if (mySharedConverterData == NULL) {
+            umtx_lock(&cnvCacheMutex);
+            mySharedConverterData = ucnv_load(pArgs, err);
+            umtx_unlock(&cnvCacheMutex);
+        }
         if (U_FAILURE (*err) || (mySharedConverterData == NULL))
         {
             return NULL;
@@ -1076,7 +1161,7 @@ ucnv_flushCache ()
         {
             mySharedData = (UConverterSharedData *) e->value.pointer;
             /*deletes only if reference counter == 0 */
-            if (mySharedData->referenceCounter == 0)
+            if (!mySharedData->isPinned && mySharedData->referenceCounter == 0)
             {
                 tableDeletedNum++;
 
@@ -1098,6 +1183,15 @@ ucnv_flushCache ()
     return tableDeletedNum;
 }
 
+U_CAPI void U_EXPORT2
+ucnv_setCachePinning(UBool pin)
+{
+    /* Only affects converter data that is loaded from now on. */
+    umtx_lock(&cnvCacheMutex);
+    gCachePinning = pin;
+    umtx_unlock(&cnvCacheMutex);
+}
+
 /* available converters list --------------------------------------------------- */
 
 static void U_CALLCONV initAvailableConvertersList(UErrorCode &errCode) {
@@ -104,6 +104,12 @@ struct UConverterSharedData {
     UBool                sharedDataCached;   /* TRUE:  shared data is in cache, don't destroy on ucnv_close() if 0 ref.  FALSE: shared data isn't in the cache, do attempt to clean it up if the ref is 0 */
     /** If FALSE, then referenceCounter is not used. Must not change after initialization. */
     UBool isReferenceCounted;
+    /**
+     * If TRUE, then this cached data is kept until u_cleanup(), referenceCounter is not used,
+     * and the data can be found without locking. Set before the data is shared; never changes
+     * afterwards (except in ucnv_cleanup()).
+     */
+    UBool isPinned;
 
     const UConverterImpl *impl;     /* vtable-style struct of mostly function pointers */
 
@@ -128,7 +134,7 @@ struct UConverterSharedData {
 #define UCNV_IMMUTABLE_SHARED_DATA_INITIALIZER(pStaticData, pImpl) \
     { \
         sizeof(UConverterSharedData), ~((uint32_t)0), \
-        NULL, pStaticData, FALSE, FALSE, pImpl, \
+        NULL, pStaticData, FALSE, FALSE, FALSE, pImpl, \
         0, UCNV_MBCS_TABLE_INITIALIZER \
     }
 
@@ -431,6 +431,11 @@ ucnv_DBCSFromUTF8(UConverterFromUnicodeArgs *pFromUArgs,
                   UConverterToUnicodeArgs *pToUArgs,
                   UErrorCode *pErrorCode);
 
+static void U_CALLCONV
+ucnv_MBCSToUTF8(UConverterFromUnicodeArgs *pFromUArgs,
+                UConverterToUnicodeArgs *pToUArgs,
+                UErrorCode *pErrorCode);
+
 static const UConverterImpl _SBCSUTF8Impl={
     UCNV_MBCS,
 
@@ -453,7 +458,7 @@ static const UConverterImpl _SBCSUTF8Impl={
     NULL,
     ucnv_MBCSGetUnicodeSet,
 
-    NULL,
+    ucnv_MBCSToUTF8,
     ucnv_SBCSFromUTF8
 };
 
@@ -479,7 +484,7 @@ static const UConverterImpl _DBCSUTF8Impl={
     NULL,
     ucnv_MBCSGetUnicodeSet,
 
-    NULL,
+    ucnv_MBCSToUTF8,
     ucnv_DBCSFromUTF8
 };
 
@@ -504,7 +509,7 @@ static const UConverterImpl _MBCSImpl={
     ucnv_MBCSWriteSub,
     NULL,
     ucnv_MBCSGetUnicodeSet,
-    NULL,
+    ucnv_MBCSToUTF8,
     NULL
 };
 
@@ -514,7 +519,7 @@ static const UConverterImpl _MBCSImpl={
 
 const UConverterSharedData _MBCSData={
     sizeof(UConverterSharedData), 1,
-    NULL, NULL, FALSE, TRUE, &_MBCSImpl,
+    NULL, NULL, FALSE, TRUE, FALSE, &_MBCSImpl,
     0, UCNV_MBCS_TABLE_INITIALIZER
 };
 
@@ -5010,6 +5015,142 @@ ucnv_MBCSSingleFromUChar32(UConverterSharedData *sharedData,
 }
 #endif
 
+/* MBCS-to-UTF-8 conversion function --------------------------------------- */
+
+/*
+ * Direct conversion from MBCS to UTF-8 for ucnv_convertEx(), without pivoting.
+ *
+ * Only complete characters with roundtrip mappings and state-change-only bytes
+ * are converted here.
+ * Fallbacks, unassigned and illegal sequences (including extension mappings),
+ * a character that continues beyond the source buffer,
+ * and a character that does not fit into the rest of the target buffer
+ * stop the conversion before that character, with U_USING_DEFAULT_WARNING
+ * so that ucnv_convertEx() handles it by pivoting.
+ * Since this function never stops inside a character,
+ * it does not need cnv->toUBytes or cnv->toUnicodeStatus.
+ */
+static void U_CALLCONV
+ucnv_MBCSToUTF8(UConverterFromUnicodeArgs *pFromUArgs,
+                UConverterToUnicodeArgs *pToUArgs,
+                UErrorCode *pErrorCode) {
+    UConverter *cnv;
+    const uint8_t *source, *sourceLimit, *charStart;
+    uint8_t *target;
+    int32_t targetCapacity;
+
+    const int32_t (*stateTable)[256];
+    const uint16_t *unicodeCodeUnits;
+
+    uint32_t offset;
+    uint8_t state, nextState, action;
+    int32_t entry, length;
+    UChar32 c;
+
+    cnv=pToUArgs->converter;
+    if(cnv->toULength>0 || pFromUArgs->converter->fromUChar32!=0) {
+        /* continue a partial character by pivoting */
+        *pErrorCode=U_USING_DEFAULT_WARNING;
+        return;
+    }
+
+    if((cnv->options&UCNV_OPTION_SWAP_LFNL)!=0) {
+        stateTable=(const int32_t (*)[256])cnv->sharedData->mbcs.swapLFNLStateTable;
+    } else {
+        stateTable=cnv->sharedData->mbcs.stateTable;
+    }
+    unicodeCodeUnits=cnv->sharedData->mbcs.unicodeCodeUnits;
+
+    /* set up the local pointers */
+    source=(const uint8_t *)pToUArgs->source;
+    sourceLimit=(const uint8_t *)pToUArgs->sourceLimit;
+    target=(uint8_t *)pFromUArgs->target;
+    targetCapacity=(int32_t)(pFromUArgs->targetLimit-pFromUArgs->target);
+
+    /* see ucnv_MBCSToUnicodeWithOffsets() */
+    if((state=(uint8_t)(cnv->mode))==0) {
+        state=cnv->sharedData->mbcs.dbcsOnlyState;
+    }
+
+    while(source<sourceLimit) {
+        if(targetCapacity==0) {
+            /* target is full */
+            *pErrorCode=U_BUFFER_OVERFLOW_ERROR;
+            break;
+        }
+
+        /* read one complete character */
+        charStart=source;
+        nextState=state;
+        offset=0;
+        entry=stateTable[nextState][*source++];
+        while(MBCS_ENTRY_IS_TRANSITION(entry) && source<sourceLimit) {
+            nextState=(uint8_t)MBCS_ENTRY_TRANSITION_STATE(entry);
+            offset+=MBCS_ENTRY_TRANSITION_OFFSET(entry);
+            entry=stateTable[nextState][*source++];
+        }
+        if(MBCS_ENTRY_IS_TRANSITION(entry)) {
+            /* the character continues beyond the source buffer */
+            source=charStart;
+            *pErrorCode=U_USING_DEFAULT_WARNING;
+            break;
+        }
+
+        /* map it to a roundtrip code point, or else leave it to pivoting */
+        action=(uint8_t)(MBCS_ENTRY_FINAL_ACTION(entry));
+        if(action==MBCS_STATE_VALID_DIRECT_16) {
+            c=MBCS_ENTRY_FINAL_VALUE_16(entry);
+        } else if(action==MBCS_STATE_VALID_16) {
+            c=unicodeCodeUnits[offset+MBCS_ENTRY_FINAL_VALUE_16(entry)];
+            if(c>=0xfffe) {
+                c=U_SENTINEL;
+            }
+        } else if(action==MBCS_STATE_VALID_16_PAIR) {
+            offset+=MBCS_ENTRY_FINAL_VALUE_16(entry);
+            c=unicodeCodeUnits[offset++];
+            if(c<0xd800) {
+                /* BMP code point below 0xd800 */
+            } else if(c<=0xdbff) {
+                /* roundtrip surrogate pair */
+                c=U16_GET_SUPPLEMENTARY(c, unicodeCodeUnits[offset]);
+            } else if(c==0xe000) {
+                /* roundtrip BMP code point above 0xd800 */
+                c=unicodeCodeUnits[offset];
+            } else {
+                c=U_SENTINEL;
+            }
+        } else if(action==MBCS_STATE_VALID_DIRECT_20) {
+            c=MBCS_ENTRY_FINAL_VALUE(entry)+0x10000;
+        } else if(action==MBCS_STATE_CHANGE_ONLY && cnv->sharedData->mbcs.dbcsOnlyState==0) {
+            state=(uint8_t)MBCS_ENTRY_FINAL_STATE(entry);
+            continue;
+        } else {
+            c=U_SENTINEL;
+        }
+
+        if(c<0 || (length=U8_LENGTH(c))>targetCapacity) {
+            /* unmappable, or not enough room for the whole character */
+            source=charStart;
+            *pErrorCode=U_USING_DEFAULT_WARNING;
+            break;
+        }
+        if(length==1) {
+            *target++=(uint8_t)c;
+        } else {
+            int32_t i=0;
+            U8_APPEND_UNSAFE(target, i, c);
+            target+=length;
+        }
+        targetCapacity-=length;
+        state=(uint8_t)MBCS_ENTRY_FINAL_STATE(entry); /* typically 0 */
+    }
+
+    /* write back the updated pointers and the state */
+    cnv->mode=state;
+    pToUArgs->source=(const char *)source;
+    pFromUArgs->target=(char *)target;
+}
+
 /* MBCS-from-UTF-8 conversion functions ------------------------------------- */
 
 /* offsets for n-byte UTF-8 sequences that were calculated with ((lead<<6)+trail)<<6+trail... */
@@ -0,0 +1,196 @@
+// © 2020 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+/*
+*******************************************************************************
+*   file name:  ucnvpool.cpp
+*   encoding:   UTF-8
+*   tab size:   8 (not used)
+*   indentation:4
+*
+*   Implementation of the converter pool.
+*
+*   Idle converters are kept in one bucket per canonical converter name.
+*   Since different aliases open the same converter, the pool also maps each
+*   requested name to its bucket. Both maps only grow when a name is seen for
+*   the first time; in steady state, acquire and release only push and pop
+*   a bucket's array under the pool's own mutex.
+*/
+
+#include "unicode/ucnvpool.h"
+
+#if !UCONFIG_NO_CONVERSION
+
+#include <mutex>
+
+#include "unicode/ucnv.h"
+#include "ucnv_bld.h"
+#include "ucnv_imp.h"
+#include "uhash.h"
+#include "cmemory.h"
+#include "cstring.h"
+
+U_NAMESPACE_USE
+
+namespace {
+
+struct PoolBucket : public UMemory {
+    UConverter **converters;   // idle converters
+    int32_t count;
+};
+
+U_CDECL_BEGIN
+static void U_CALLCONV
+deletePoolBucket(void *obj) {
+    PoolBucket *bucket = (PoolBucket *)obj;
+    for (int32_t i = 0; i < bucket->count; ++i) {
+        ucnv_close(bucket->converters[i]);
+    }
+    uprv_free(bucket->converters);
+    delete bucket;
+}
+U_CDECL_END
+
+}  // namespace
+
+struct UConverterPool : public UMemory {
+    std::mutex mutex;
+    UHashtable *byRequestedName;   // char * (owned) -> PoolBucket * (not owned)
+    UHashtable *byCanonicalName;   // char * (owned) -> PoolBucket * (owned)
+    int32_t maxIdle;
+};
+
+U_CAPI UConverterPool* U_EXPORT2
+ucnvpool_open(int32_t maxIdlePerName, UErrorCode *status) {
+    if (U_FAILURE(*status)) {
+        return NULL;
+    }
+    if (maxIdlePerName <= 0) {
+        *status = U_ILLEGAL_ARGUMENT_ERROR;
+        return NULL;
+    }
+    UConverterPool *pool = new UConverterPool();
+    if (pool == NULL) {
+        *status = U_MEMORY_ALLOCATION_ERROR;
+        return NULL;
+    }
+    pool->maxIdle = maxIdlePerName;
+    pool->byRequestedName = uhash_open(uhash_hashChars, uhash_compareChars, NULL, status);
+    pool->byCanonicalName = uhash_open(uhash_hashChars, uhash_compareChars, NULL, status);
+    if (U_FAILURE(*status)) {
+        ucnvpool_close(pool);
+        return NULL;
+    }
+    uhash_setKeyDeleter(pool->byRequestedName, uprv_free);
+    uhash_setKeyDeleter(pool->byCanonicalName, uprv_free);
+    uhash_setValueDeleter(pool->byCanonicalName, deletePoolBucket);
+    return pool;
+}
+
+U_CAPI void U_EXPORT2
+ucnvpool_close(UConverterPool *pool) {
+    if (pool == NULL) {
+        return;
+    }
+    uhash_close(pool->byRequestedName);
+    uhash_close(pool->byCanonicalName);
+    delete pool;
+}
+
+/*
+ * Makes the converter's name, and the name it was requested with, known to the pool.
+ * Must be called with the pool's mutex being held.
+ */
+static void
+ucnvpool_register(UConverterPool *pool, const char *requestedName, const UConverter *cnv,
+                  UErrorCode *status) {
+    const char *canonicalName = ucnv_getName(cnv, status);
+    if (U_FAILURE(*status)) {
+        return;
+    }
+    PoolBucket *bucket = (PoolBucket *)uhash_get(pool->byCanonicalName, canonicalName);
+    if (bucket == NULL) {
+        bucket = new PoolBucket();
+        char *key = uprv_strdup(canonicalName);
+        if (bucket == NULL || key == NULL) {
+            delete bucket;
+            uprv_free(key);
+            *status = U_MEMORY_ALLOCATION_ERROR;
+            return;
+        }
+        bucket->converters = (UConverter **)uprv_malloc(pool->maxIdle * sizeof(UConverter *));
+        bucket->count = 0;
+        if (bucket->converters == NULL) {
+            delete bucket;
+            uprv_free(key);
+            *status = U_MEMORY_ALLOCATION_ERROR;
+            return;
+        }
+        uhash_put(pool->byCanonicalName, key, bucket, status);
+        if (U_FAILURE(*status)) {
+            return;
+        }
+    }
+    if (uhash_get(pool->byRequestedName, requestedName) == NULL) {
+        char *key = uprv_strdup(requestedName);
+        if (key == NULL) {
+            *status = U_MEMORY_ALLOCATION_ERROR;
+            return;
+        }
+        uhash_put(pool->byRequestedName, key, bucket, status);
+    }
+}
+
+U_CAPI UConverter* U_EXPORT2
+ucnvpool_acquire(UConverterPool *pool, const char *converterName, UErrorCode *status) {
+    if (U_FAILURE(*status)) {
+        return NULL;
+    }
+    if (pool == NULL || converterName == NULL) {
+        *status = U_ILLEGAL_ARGUMENT_ERROR;
+        return NULL;
+    }
+    UBool isKnownName;
+    {
+        std::lock_guard<std::mutex> lock(pool->mutex);
+        PoolBucket *bucket = (PoolBucket *)uhash_get(pool->byRequestedName, converterName);
+        if (bucket != NULL && bucket->count > 0) {
+            return bucket->converters[--bucket->count];
+        }
+        isKnownName = bucket != NULL;
+    }
+
+    UConverter *cnv = ucnv_open(converterName, status);
+    if (U_SUCCESS(*status) && !isKnownName) {
+        // A failure to register only means that this converter will not be pooled.
+        UErrorCode localStatus = U_ZERO_ERROR;
+        std::lock_guard<std::mutex> lock(pool->mutex);
+        ucnvpool_register(pool, converterName, cnv, &localStatus);
+    }
+    return cnv;
+}
+
+U_CAPI void U_EXPORT2
+ucnvpool_release(UConverterPool *pool, UConverter *cnv) {
+    if (pool == NULL || cnv == NULL) {
+        return;
+    }
+    ucnv_reset(cnv);
+    cnv->fromCharErrorBehaviour = UCNV_TO_U_DEFAULT_CALLBACK;
+    cnv->fromUCharErrorBehaviour = UCNV_FROM_U_DEFAULT_CALLBACK;
+    cnv->toUContext = NULL;
+    cnv->fromUContext = NULL;
+
+    UErrorCode localStatus = U_ZERO_ERROR;
+    const char *name = ucnv_getName(cnv, &localStatus);
+    if (U_SUCCESS(localStatus)) {
+        std::lock_guard<std::mutex> lock(pool->mutex);
+        PoolBucket *bucket = (PoolBucket *)uhash_get(pool->byCanonicalName, name);
+        if (bucket != NULL && bucket->count < pool->maxIdle) {
+            bucket->converters[bucket->count++] = cnv;
+            return;
+        }
+    }
+    ucnv_close(cnv);
+}
+
+#endif  /* !UCONFIG_NO_CONVERSION */
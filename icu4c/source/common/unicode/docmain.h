@@ -99,7 +99,7 @@
  *   </tr>
  *   <tr>
  *     <td>Codepage Conversion</td>
- *     <td>ucnv.h, ucnvsel.h</td>
+ *     <td>ucnv.h, ucnvpool.h, ucnvsel.h</td>
  *     <td>C API</td>
  *   </tr>
  *   <tr>
@@ -218,6 +218,11 @@
  *     <td>C API</td>
  *   </tr>
  *   <tr>
+ *     <td>Locale Data Warmup</td>
+ *     <td>uwarmup.h</td>
+ *     <td>C API</td>
+ *   </tr>
+ *   <tr>
  *     <td>Paragraph Layout / Complex Text Layout</td>
  *     <td>playout.h</td>
  *     <td>icu::ParagraphLayout</td>
@@ -1684,6 +1684,27 @@ ucnv_fromAlgorithmic(UConverter *cnv,
 U_STABLE int32_t U_EXPORT2
 ucnv_flushCache(void);
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * Turns pinning of cached converter data on or off.
+ *
+ * While pinning is on, data-based converters that are loaded into the cache
+ * stay loaded until u_cleanup(): they are not reference-counted,
+ * ucnv_flushCache() does not delete them,
+ * and ucnv_open() finds them without taking the cache lock.
+ * This suits multi-threaded services that open and close converters
+ * for a small, stable set of charsets.
+ *
+ * Turning pinning off does not unpin converter data that is already pinned.
+ *
+ * @param pin TRUE to pin converter data that is loaded from now on
+ * @see ucnv_flushCache
+ * @draft ICU 68
+ */
+U_DRAFT void U_EXPORT2
+ucnv_setCachePinning(UBool pin);
+#endif  /* U_HIDE_DRAFT_API */
+
 /**
  * Returns the number of available converters, as per the alias file.
  *
@@ -0,0 +1,132 @@
+// © 2020 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+/*
+*******************************************************************************
+*   file name:  ucnvpool.h
+*   encoding:   UTF-8
+*   tab size:   8 (not used)
+*   indentation:4
+*
+*   Purpose: A thread-safe pool of reusable converters.
+*/
+
+#ifndef __ICU_UCNV_POOL_H__
+#define __ICU_UCNV_POOL_H__
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_CONVERSION
+
+#include "unicode/ucnv.h"
+#include "unicode/localpointer.h"
+
+/**
+ * \file
+ *
+ * A converter pool keeps idle converters for reuse.
+ *
+ * Opening a converter allocates the UConverter and looks up its shared data
+ * in the global converter cache. Services that convert short texts
+ * on many threads can instead acquire a converter from a pool and release it
+ * when done. Once a pool has warmed up, acquiring and releasing a converter
+ * neither allocates memory nor takes the global converter cache lock.
+ *
+ * A pool is thread-safe. A converter acquired from a pool is owned by
+ * the caller until it is released, and must not be shared between threads.
+ */
+
+#ifndef U_HIDE_DRAFT_API
+
+/**
+ * @{
+ * The converter pool data structure
+ * @draft ICU 68
+ */
+struct UConverterPool;
+typedef struct UConverterPool UConverterPool;
+/** @} */
+
+/**
+ * Opens an empty converter pool.
+ *
+ * @param maxIdlePerName the maximum number of idle converters that the pool keeps
+ *                       for each converter; must be positive.
+ *                       Converters released beyond this number are closed.
+ * @param status an in/out ICU UErrorCode
+ * @return the new pool
+ *
+ * @draft ICU 68
+ */
+U_DRAFT UConverterPool* U_EXPORT2
+ucnvpool_open(int32_t maxIdlePerName, UErrorCode *status);
+
+/**
+ * Closes a pool and all of its idle converters.
+ * Converters that are currently acquired from the pool must be closed
+ * with ucnv_close() rather than released to the closed pool.
+ *
+ * @param pool the pool to close
+ *
+ * @draft ICU 68
+ */
+U_DRAFT void U_EXPORT2
+ucnvpool_close(UConverterPool *pool);
+
+/**
+ * Gets a converter for the given name from the pool,
+ * or opens a new one with ucnv_open() if the pool has no idle converter for that name.
+ * The converter is in its reset state with default callbacks.
+ *
+ * @param pool the pool
+ * @param converterName name of the converter, as for ucnv_open()
+ * @param status an in/out ICU UErrorCode
+ * @return the converter, or NULL if an error occurred
+ *
+ * @see ucnvpool_release
+ * @draft ICU 68
+ */
+U_DRAFT UConverter* U_EXPORT2
+ucnvpool_acquire(UConverterPool *pool, const char *converterName, UErrorCode *status);
+
+/**
+ * Returns a converter to the pool.
+ * The converter is reset and its callbacks are restored to their defaults.
+ * Other settings, such as substitution characters and fallback usage, are not
+ * restored; callers that change them should close the converter instead.
+ * If the pool already holds the maximum number of idle converters
+ * for the converter's name, then the converter is closed.
+ *
+ * @param pool the pool
+ * @param cnv a converter obtained from ucnvpool_acquire() on the same pool;
+ *            may be NULL
+ *
+ * @see ucnvpool_acquire
+ * @draft ICU 68
+ */
+U_DRAFT void U_EXPORT2
+ucnvpool_release(UConverterPool *pool, UConverter *cnv);
+
+#if U_SHOW_CPLUSPLUS_API
+
+U_NAMESPACE_BEGIN
+
+/**
+ * \class LocalUConverterPoolPointer
+ * "Smart pointer" class, closes a UConverterPool via ucnvpool_close().
+ * For most methods see the LocalPointerBase base class.
+ *
+ * @see LocalPointerBase
+ * @see LocalPointer
+ * @draft ICU 68
+ */
+U_DEFINE_LOCAL_OPEN_POINTER(LocalUConverterPoolPointer, UConverterPool, ucnvpool_close);
+
+U_NAMESPACE_END
+
+#endif
+
+#endif  /* U_HIDE_DRAFT_API */
+
+#endif  /* !UCONFIG_NO_CONVERSION */
+
+#endif  /* __ICU_UCNV_POOL_H__ */
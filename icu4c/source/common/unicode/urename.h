@@ -695,6 +695,7 @@
 #define ucnv_resetFromUnicode U_ICU_ENTRY_POINT_RENAME(ucnv_resetFromUnicode)
 #define ucnv_resetToUnicode U_ICU_ENTRY_POINT_RENAME(ucnv_resetToUnicode)
 #define ucnv_safeClone U_ICU_ENTRY_POINT_RENAME(ucnv_safeClone)
+#define ucnv_setCachePinning U_ICU_ENTRY_POINT_RENAME(ucnv_setCachePinning)
 #define ucnv_setDefaultName U_ICU_ENTRY_POINT_RENAME(ucnv_setDefaultName)
 #define ucnv_setFallback U_ICU_ENTRY_POINT_RENAME(ucnv_setFallback)
 #define ucnv_setFromUCallBack U_ICU_ENTRY_POINT_RENAME(ucnv_setFromUCallBack)
@@ -712,6 +713,10 @@
 #define ucnv_unload U_ICU_ENTRY_POINT_RENAME(ucnv_unload)
 #define ucnv_unloadSharedDataIfReady U_ICU_ENTRY_POINT_RENAME(ucnv_unloadSharedDataIfReady)
 #define ucnv_usesFallback U_ICU_ENTRY_POINT_RENAME(ucnv_usesFallback)
+#define ucnvpool_acquire U_ICU_ENTRY_POINT_RENAME(ucnvpool_acquire)
+#define ucnvpool_close U_ICU_ENTRY_POINT_RENAME(ucnvpool_close)
+#define ucnvpool_open U_ICU_ENTRY_POINT_RENAME(ucnvpool_open)
+#define ucnvpool_release U_ICU_ENTRY_POINT_RENAME(ucnvpool_release)
 #define ucnvsel_close U_ICU_ENTRY_POINT_RENAME(ucnvsel_close)
 #define ucnvsel_open U_ICU_ENTRY_POINT_RENAME(ucnvsel_open)
 #define ucnvsel_openFromSerialized U_ICU_ENTRY_POINT_RENAME(ucnvsel_openFromSerialized)
@@ -802,6 +807,7 @@
 #define ucsdet_close U_ICU_ENTRY_POINT_RENAME(ucsdet_close)
 #define ucsdet_detect U_ICU_ENTRY_POINT_RENAME(ucsdet_detect)
 #define ucsdet_detectAll U_ICU_ENTRY_POINT_RENAME(ucsdet_detectAll)
+#define ucsdet_enableFastDetection U_ICU_ENTRY_POINT_RENAME(ucsdet_enableFastDetection)
 #define ucsdet_enableInputFilter U_ICU_ENTRY_POINT_RENAME(ucsdet_enableInputFilter)
 #define ucsdet_getAllDetectableCharsets U_ICU_ENTRY_POINT_RENAME(ucsdet_getAllDetectableCharsets)
 #define ucsdet_getConfidence U_ICU_ENTRY_POINT_RENAME(ucsdet_getConfidence)
@@ -809,6 +815,7 @@
 #define ucsdet_getLanguage U_ICU_ENTRY_POINT_RENAME(ucsdet_getLanguage)
 #define ucsdet_getName U_ICU_ENTRY_POINT_RENAME(ucsdet_getName)
 #define ucsdet_getUChars U_ICU_ENTRY_POINT_RENAME(ucsdet_getUChars)
+#define ucsdet_isFastDetectionEnabled U_ICU_ENTRY_POINT_RENAME(ucsdet_isFastDetectionEnabled)
 #define ucsdet_isInputFilterEnabled U_ICU_ENTRY_POINT_RENAME(ucsdet_isInputFilterEnabled)
 #define ucsdet_open U_ICU_ENTRY_POINT_RENAME(ucsdet_open)
 #define ucsdet_setDeclaredEncoding U_ICU_ENTRY_POINT_RENAME(ucsdet_setDeclaredEncoding)
@@ -1462,11 +1469,13 @@
 #define uregex_appendTailUText U_ICU_ENTRY_POINT_RENAME(uregex_appendTailUText)
 #define uregex_clone U_ICU_ENTRY_POINT_RENAME(uregex_clone)
 #define uregex_close U_ICU_ENTRY_POINT_RENAME(uregex_close)
+#define uregex_closeSet U_ICU_ENTRY_POINT_RENAME(uregex_closeSet)
 #define uregex_end U_ICU_ENTRY_POINT_RENAME(uregex_end)
 #define uregex_end64 U_ICU_ENTRY_POINT_RENAME(uregex_end64)
 #define uregex_find U_ICU_ENTRY_POINT_RENAME(uregex_find)
 #define uregex_find64 U_ICU_ENTRY_POINT_RENAME(uregex_find64)
 #define uregex_findNext U_ICU_ENTRY_POINT_RENAME(uregex_findNext)
+#define uregex_findSet U_ICU_ENTRY_POINT_RENAME(uregex_findSet)
 #define uregex_flags U_ICU_ENTRY_POINT_RENAME(uregex_flags)
 #define uregex_getFindProgressCallback U_ICU_ENTRY_POINT_RENAME(uregex_getFindProgressCallback)
 #define uregex_getMatchCallback U_ICU_ENTRY_POINT_RENAME(uregex_getMatchCallback)
@@ -1488,6 +1497,7 @@
 #define uregex_matches64 U_ICU_ENTRY_POINT_RENAME(uregex_matches64)
 #define uregex_open U_ICU_ENTRY_POINT_RENAME(uregex_open)
 #define uregex_openC U_ICU_ENTRY_POINT_RENAME(uregex_openC)
+#define uregex_openSet U_ICU_ENTRY_POINT_RENAME(uregex_openSet)
 #define uregex_openUText U_ICU_ENTRY_POINT_RENAME(uregex_openUText)
 #define uregex_pattern U_ICU_ENTRY_POINT_RENAME(uregex_pattern)
 #define uregex_patternUText U_ICU_ENTRY_POINT_RENAME(uregex_patternUText)
@@ -1511,6 +1521,7 @@
 #define uregex_setStackLimit U_ICU_ENTRY_POINT_RENAME(uregex_setStackLimit)
 #define uregex_setText U_ICU_ENTRY_POINT_RENAME(uregex_setText)
 #define uregex_setTimeLimit U_ICU_ENTRY_POINT_RENAME(uregex_setTimeLimit)
+#define uregex_setUTF8Text U_ICU_ENTRY_POINT_RENAME(uregex_setUTF8Text)
 #define uregex_setUText U_ICU_ENTRY_POINT_RENAME(uregex_setUText)
 #define uregex_split U_ICU_ENTRY_POINT_RENAME(uregex_split)
 #define uregex_splitUText U_ICU_ENTRY_POINT_RENAME(uregex_splitUText)
@@ -1853,6 +1864,8 @@
 #define utrie_swapAnyVersion U_ICU_ENTRY_POINT_RENAME(utrie_swapAnyVersion)
 #define utrie_unserialize U_ICU_ENTRY_POINT_RENAME(utrie_unserialize)
 #define utrie_unserializeDummy U_ICU_ENTRY_POINT_RENAME(utrie_unserializeDummy)
+#define uwarmup_getCacheEntries U_ICU_ENTRY_POINT_RENAME(uwarmup_getCacheEntries)
+#define uwarmup_loadLocales U_ICU_ENTRY_POINT_RENAME(uwarmup_loadLocales)
 #define vzone_clone U_ICU_ENTRY_POINT_RENAME(vzone_clone)
 #define vzone_close U_ICU_ENTRY_POINT_RENAME(vzone_close)
 #define vzone_countTransitionRules U_ICU_ENTRY_POINT_RENAME(vzone_countTransitionRules)
@@ -155,6 +155,23 @@ int32_t UnifiedCache::keyCount() const {
     return uhash_count(fHashtable);
 }
 
+void UnifiedCache::visitEntries(
+        void (*visit)(void *context, const CacheKeyBase &key,
+                      const SharedObject *value, UErrorCode creationStatus),
+        void *context) const {
+    std::lock_guard<std::mutex> lock(*gCacheMutex);
+    int32_t pos = UHASH_FIRST;
+    const UHashElement *element;
+    while ((element = uhash_nextElement(fHashtable, &pos)) != nullptr) {
+        const CacheKeyBase *key = (const CacheKeyBase *) element->key.pointer;
+        const SharedObject *value = (const SharedObject *) element->value.pointer;
+        if (_inProgress(value, key->fCreationStatus)) {
+            continue;
+        }
+        visit(context, *key, value == fNoValue ? nullptr : value, key->fCreationStatus);
+    }
+}
+
 void UnifiedCache::flush() const {
     std::lock_guard<std::mutex> lock(*gCacheMutex);
 
@@ -292,6 +292,17 @@ class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
     */
    void flush() const;
 
+   /**
+    * Calls visit() for each entry in this cache, with the entry's value,
+    * or with NULL and the creation status if the value could not be created.
+    * Entries whose values are still being created are skipped.
+    * The cache mutex is held during the calls, so visit() must not use the cache.
+    */
+   void visitEntries(
+           void (*visit)(void *context, const CacheKeyBase &key,
+                         const SharedObject *value, UErrorCode creationStatus),
+           void *context) const;
+
    /**
     * Configures at what point evcition of unused entries will begin.
     * Eviction is triggered whenever the number of evictable keys exeeds
@@ -32,16 +32,23 @@
 #define NEW_ARRAY(type,count) (type *) uprv_malloc((count) * sizeof(type))
 #define DELETE_ARRAY(array) uprv_free((void *) (array))
 
+// Fast detection only examines this many bytes at the start of the input.
+#define FAST_DETECTION_SAMPLE_SIZE 8192
+
+// A match with this confidence ends fast detection.
+#define FAST_DETECTION_CERTAIN_CONFIDENCE 100
+
 U_NAMESPACE_BEGIN
 
 struct CSRecognizerInfo : public UMemory {
-    CSRecognizerInfo(CharsetRecognizer *recognizer, UBool isDefaultEnabled)
-        : recognizer(recognizer), isDefaultEnabled(isDefaultEnabled) {}
+    CSRecognizerInfo(CharsetRecognizer *recognizer, UBool isDefaultEnabled, UBool isNGram = FALSE)
+        : recognizer(recognizer), isDefaultEnabled(isDefaultEnabled), isNGram(isNGram) {}
 
     ~CSRecognizerInfo() {delete recognizer;}
 
     CharsetRecognizer *recognizer;
     UBool isDefaultEnabled;
+    UBool isNGram;      // Single-byte charset recognizer that scores n-grams; run last in fast detection.
 };
 
 U_NAMESPACE_END
@@ -92,17 +99,17 @@ static void U_CALLCONV initRecognizers(UErrorCode &status) {
         new CSRecognizerInfo(new CharsetRecog_UTF_32_BE(), TRUE),
         new CSRecognizerInfo(new CharsetRecog_UTF_32_LE(), TRUE),
 
-        new CSRecognizerInfo(new CharsetRecog_8859_1(), TRUE),
-        new CSRecognizerInfo(new CharsetRecog_8859_2(), TRUE),
-        new CSRecognizerInfo(new CharsetRecog_8859_5_ru(), TRUE),
-        new CSRecognizerInfo(new CharsetRecog_8859_6_ar(), TRUE),
-        new CSRecognizerInfo(new CharsetRecog_8859_7_el(), TRUE),
-        new CSRecognizerInfo(new CharsetRecog_8859_8_I_he(), TRUE),
-        new CSRecognizerInfo(new CharsetRecog_8859_8_he(), TRUE),
-        new CSRecognizerInfo(new CharsetRecog_windows_1251(), TRUE),
-        new CSRecognizerInfo(new CharsetRecog_windows_1256(), TRUE),
-        new CSRecognizerInfo(new CharsetRecog_KOI8_R(), TRUE),
-        new CSRecognizerInfo(new CharsetRecog_8859_9_tr(), TRUE),
+        new CSRecognizerInfo(new CharsetRecog_8859_1(), TRUE, TRUE),
+        new CSRecognizerInfo(new CharsetRecog_8859_2(), TRUE, TRUE),
+        new CSRecognizerInfo(new CharsetRecog_8859_5_ru(), TRUE, TRUE),
+        new CSRecognizerInfo(new CharsetRecog_8859_6_ar(), TRUE, TRUE),
+        new CSRecognizerInfo(new CharsetRecog_8859_7_el(), TRUE, TRUE),
+        new CSRecognizerInfo(new CharsetRecog_8859_8_I_he(), TRUE, TRUE),
+        new CSRecognizerInfo(new CharsetRecog_8859_8_he(), TRUE, TRUE),
+        new CSRecognizerInfo(new CharsetRecog_windows_1251(), TRUE, TRUE),
+        new CSRecognizerInfo(new CharsetRecog_windows_1256(), TRUE, TRUE),
+        new CSRecognizerInfo(new CharsetRecog_KOI8_R(), TRUE, TRUE),
+        new CSRecognizerInfo(new CharsetRecog_8859_9_tr(), TRUE, TRUE),
         new CSRecognizerInfo(new CharsetRecog_sjis(), TRUE),
         new CSRecognizerInfo(new CharsetRecog_gb_18030(), TRUE),
         new CSRecognizerInfo(new CharsetRecog_euc_jp(), TRUE),
@@ -114,10 +121,10 @@ static void U_CALLCONV initRecognizers(UErrorCode &status) {
         new CSRecognizerInfo(new CharsetRecog_2022KR(), TRUE),
         new CSRecognizerInfo(new CharsetRecog_2022CN(), TRUE),
 
-        new CSRecognizerInfo(new CharsetRecog_IBM424_he_rtl(), FALSE),
-        new CSRecognizerInfo(new CharsetRecog_IBM424_he_ltr(), FALSE),
-        new CSRecognizerInfo(new CharsetRecog_IBM420_ar_rtl(), FALSE),
-        new CSRecognizerInfo(new CharsetRecog_IBM420_ar_ltr(), FALSE)
+        new CSRecognizerInfo(new CharsetRecog_IBM424_he_rtl(), FALSE, TRUE),
+        new CSRecognizerInfo(new CharsetRecog_IBM424_he_ltr(), FALSE, TRUE),
+        new CSRecognizerInfo(new CharsetRecog_IBM420_ar_rtl(), FALSE, TRUE),
+        new CSRecognizerInfo(new CharsetRecog_IBM420_ar_ltr(), FALSE, TRUE)
 #endif
     };
     int32_t rCount = UPRV_LENGTHOF(tempArray);
@@ -150,7 +157,7 @@ void CharsetDetector::setRecognizers(UErrorCode &status)
 CharsetDetector::CharsetDetector(UErrorCode &status)
   : textIn(new InputText(status)), resultArray(NULL),
     resultCount(0), fStripTags(FALSE), fFreshTextSet(FALSE),
-    fEnabledRecognizers(NULL)
+    fFastDetection(FALSE), fEnabledRecognizers(NULL)
 {
     if (U_FAILURE(status)) {
         return;
@@ -213,6 +220,19 @@ UBool CharsetDetector::getStripTagsFlag() const
     return fStripTags;
 }
 
+UBool CharsetDetector::setFastDetectionFlag(UBool flag)
+{
+    UBool temp = fFastDetection;
+    fFastDetection = flag;
+    fFreshTextSet = TRUE;
+    return temp;
+}
+
+UBool CharsetDetector::getFastDetectionFlag() const
+{
+    return fFastDetection;
+}
+
 void CharsetDetector::setDeclaredEncoding(const char *encoding, int32_t len) const
 {
     textIn->setDeclaredEncoding(encoding,len);
@@ -247,19 +267,10 @@ const CharsetMatch * const *CharsetDetector::detectAll(int32_t &maxMatchesFound,
 
         return NULL;
     } else if (fFreshTextSet) {
-        CharsetRecognizer *csr;
-        int32_t            i;
-
-        textIn->MungeInput(fStripTags);
-
-        // Iterate over all possible charsets, remember all that
-        // give a match quality > 0.
-        resultCount = 0;
-        for (i = 0; i < fCSRecognizers_size; i += 1) {
-            csr = fCSRecognizers[i]->recognizer;
-            if (csr->match(textIn, resultArray[resultCount])) {
-                resultCount++;
-            }
+        if (fFastDetection) {
+            runRecognizersInStages();
+        } else {
+            runAllRecognizers();
         }
 
         if (resultCount > 1) {
@@ -273,6 +284,79 @@ const CharsetMatch * const *CharsetDetector::detectAll(int32_t &maxMatchesFound,
     return resultArray;
 }
 
+void CharsetDetector::runAllRecognizers()
+{
+    textIn->MungeInput(fStripTags);
+
+    // Iterate over all possible charsets, remember all that
+    // give a match quality > 0.
+    resultCount = 0;
+    for (int32_t i = 0; i < fCSRecognizers_size; i += 1) {
+        CharsetRecognizer *csr = fCSRecognizers[i]->recognizer;
+        if (csr->match(textIn, resultArray[resultCount])) {
+            resultCount++;
+        }
+    }
+}
+
+void CharsetDetector::runRecognizersInStages()
+{
+    // Only look at a prefix of the input. The matches refer back to textIn,
+    // so the full length is restored before returning for the sake of getUChars().
+    int32_t rawLength = textIn->fRawLength;
+    if (textIn->fRawLength > FAST_DETECTION_SAMPLE_SIZE) {
+        textIn->fRawLength = FAST_DETECTION_SAMPLE_SIZE;
+    }
+    textIn->MungeInput(fStripTags);
+
+    // Stage 1: The Unicode recognizers check for BOMs and UTF-8 validity,
+    // then come the multi-byte and ISO-2022 recognizers, in their registration order.
+    // Stop at the first match that is certain.
+    resultCount = 0;
+    int32_t i;
+    for (i = 0; i < fCSRecognizers_size; i += 1) {
+        if (fCSRecognizers[i]->isNGram) {
+            continue;
+        }
+        CharsetMatch *match = resultArray[resultCount];
+        if (fCSRecognizers[i]->recognizer->match(textIn, match)) {
+            if (match->getConfidence() >= FAST_DETECTION_CERTAIN_CONFIDENCE) {
+                // Report only this match.
+                resultArray[resultCount] = resultArray[0];
+                resultArray[0] = match;
+                resultCount = 1;
+                textIn->fRawLength = rawLength;
+                return;
+            }
+            resultCount++;
+        }
+    }
+
+    // Stage 2: The single-byte charsets differ only in their upper halves.
+    // 7-bit input decodes the same in all of them, so their n-gram
+    // statistics would contribute only a language guess.
+    UBool has8BitBytes = FALSE;
+    for (i = 0x80; i <= 0xFF; i += 1) {
+        if (textIn->fByteStats[i] != 0) {
+            has8BitBytes = TRUE;
+            break;
+        }
+    }
+
+    // Stage 3: Run the expensive n-gram recognizers.
+    if (has8BitBytes) {
+        for (i = 0; i < fCSRecognizers_size; i += 1) {
+            if (!fCSRecognizers[i]->isNGram) {
+                continue;
+            }
+            if (fCSRecognizers[i]->recognizer->match(textIn, resultArray[resultCount])) {
+                resultCount++;
+            }
+        }
+    }
+    textIn->fRawLength = rawLength;
+}
+
 void CharsetDetector::setDetectableCharset(const char *encoding, UBool enabled, UErrorCode &status)
 {
     if (U_FAILURE(status)) {
@@ -30,8 +30,12 @@ class CharsetDetector : public UMemory
     int32_t resultCount;
     UBool fStripTags;   // If true, setText() will strip tags from input text.
     UBool fFreshTextSet;
+    UBool fFastDetection; // If true, detectAll() runs the recognizers in stages and stops early.
     static void setRecognizers(UErrorCode &status);
 
+    void runAllRecognizers();
+    void runRecognizersInStages();
+
     UBool *fEnabledRecognizers;  // If not null, active set of charset recognizers had
                                 // been changed from the default. The array index is
                                 // corresponding to fCSRecognizers. See setDetectableCharset().
@@ -53,6 +57,10 @@ class CharsetDetector : public UMemory
 
     UBool getStripTagsFlag() const;
 
+    UBool setFastDetectionFlag(UBool flag);
+
+    UBool getFastDetectionFlag() const;
+
 //    const char *getCharsetName(int32_t index, UErrorCode& status) const;
 
     static int32_t getDetectableCount();
@@ -14,12 +14,19 @@
 #if !UCONFIG_NO_CONVERSION
 #include "csrsbcs.h"
 #include "csmatch.h"
+#include "umutex.h"
 
 #define N_GRAM_SIZE 3
 #define N_GRAM_MASK 0xFFFFFF
 
 U_NAMESPACE_BEGIN
 
+static int32_t ngramConfidence(int32_t hitCount, int32_t ngramCount);
+static UBool getScoredConfidence(InputText *det, const int32_t *ngrams, int32_t &confidence);
+#if !UCONFIG_ONLY_HTML_CONVERSION
+static int32_t lamAlefOf(int32_t b);
+#endif
+
 NGramParser::NGramParser(const int32_t *theNgramList, const uint8_t *theCharMap)
  : ngram(0), byteIndex(0)
 {
@@ -127,6 +134,11 @@ int32_t NGramParser::parse(InputText *det)
     // TODO: Is this OK? The buffer could have ended in the middle of a word...
     addByte(0x20);
 
+    return ngramConfidence(hitCount, ngramCount);
+}
+
+static int32_t ngramConfidence(int32_t hitCount, int32_t ngramCount)
+{
     double rawPercent = (double) hitCount / (double) ngramCount;
 
     //            if (rawPercent <= 2.0) {
@@ -171,6 +183,11 @@ NGramParser_IBM420::NGramParser_IBM420(const int32_t *theNgramList, const uint8_
 NGramParser_IBM420::~NGramParser_IBM420() {}
 
 int32_t NGramParser_IBM420::isLamAlef(int32_t b)
+{
+    return lamAlefOf(b);
+}
+
+static int32_t lamAlefOf(int32_t b)
 {
 	if(b == 0xB2 || b == 0xB3){
          	return 0x47;        		
@@ -253,9 +270,14 @@ CharsetRecog_sbcs::~CharsetRecog_sbcs()
 
 int32_t CharsetRecog_sbcs::match_sbcs(InputText *det, const int32_t ngrams[],  const uint8_t byteMap[]) const
 {
-    NGramParser parser(ngrams, byteMap);
     int32_t result;
 
+    if (getScoredConfidence(det, ngrams, result)) {
+        return result;
+    }
+
+    NGramParser parser(ngrams, byteMap);
+
     result = parser.parse(det);
 
     return result;
@@ -884,6 +906,290 @@ static const int32_t ngrams_8859_9_tr[] = {
     0x6E206B, 0x6E6461, 0x6E6465, 0x6E6520, 0x6E6920, 0x6E696E, 0x6EFD20, 0x72696E, 0x72FD6E, 0x766520, 0x796120, 0x796F72, 0xFD6E20, 0xFD6E64, 0xFD6EFD, 0xFDF0FD,
 };
 
+/*
+ * Single-pass n-gram scoring.
+ *
+ * Scoring each n-gram table with its own NGramParser means one pass over the input,
+ * with a binary search per byte, for every table. Instead, the first single-byte
+ * recognizer that is asked to match some input scores all of the tables at once,
+ * and stores their confidences in the InputText for the other recognizers.
+ *
+ * The n-grams that a parser sees depend only on its byte map, so the tables are
+ * grouped by byte map, and the input is mapped and turned into n-grams once per group.
+ * gByteMaps interleaves the groups' byte maps so that mapping one input byte for all
+ * of the groups touches a single small row. All tables are merged into one hash table
+ * of n-grams, with a bit set for each table that contains an n-gram.
+ * The hit and n-gram counts, and thus the confidences, are the same as NGramParser's.
+ */
+
+enum {
+    NGRAM_GROUP_8859_1,
+    NGRAM_GROUP_8859_2,
+    NGRAM_GROUP_8859_5,
+    NGRAM_GROUP_8859_6,
+    NGRAM_GROUP_8859_7,
+    NGRAM_GROUP_8859_8,
+    NGRAM_GROUP_8859_9,
+    NGRAM_GROUP_WINDOWS_1251,
+    NGRAM_GROUP_WINDOWS_1256,
+    NGRAM_GROUP_KOI8_R,
+#if !UCONFIG_ONLY_HTML_CONVERSION
+    NGRAM_GROUP_IBM424,
+    NGRAM_GROUP_IBM420,     // Must be last: its bytes are unshaped as in NGramParser_IBM420.
+#endif
+    NGRAM_GROUP_COUNT
+};
+
+static const uint8_t * const ngramGroupCharMaps[NGRAM_GROUP_COUNT] = {
+    charMap_8859_1,
+    charMap_8859_2,
+    charMap_8859_5,
+    charMap_8859_6,
+    charMap_8859_7,
+    charMap_8859_8,
+    charMap_8859_9,
+    charMap_windows_1251,
+    charMap_windows_1256,
+    charMap_KOI8_R,
+#if !UCONFIG_ONLY_HTML_CONVERSION
+    charMap_IBM424_he,
+    charMap_IBM420_ar,
+#endif
+};
+
+struct NGramTableInfo {
+    const int32_t *ngrams;
+    int32_t group;
+};
+
+// Tables of the same group must be adjacent.
+static const NGramTableInfo ngramTables[] = {
+    { ngrams_8859_1[0].ngrams, NGRAM_GROUP_8859_1 },
+    { ngrams_8859_1[1].ngrams, NGRAM_GROUP_8859_1 },
+    { ngrams_8859_1[2].ngrams, NGRAM_GROUP_8859_1 },
+    { ngrams_8859_1[3].ngrams, NGRAM_GROUP_8859_1 },
+    { ngrams_8859_1[4].ngrams, NGRAM_GROUP_8859_1 },
+    { ngrams_8859_1[5].ngrams, NGRAM_GROUP_8859_1 },
+    { ngrams_8859_1[6].ngrams, NGRAM_GROUP_8859_1 },
+    { ngrams_8859_1[7].ngrams, NGRAM_GROUP_8859_1 },
+    { ngrams_8859_1[8].ngrams, NGRAM_GROUP_8859_1 },
+    { ngrams_8859_1[9].ngrams, NGRAM_GROUP_8859_1 },
+    { ngrams_8859_2[0].ngrams, NGRAM_GROUP_8859_2 },
+    { ngrams_8859_2[1].ngrams, NGRAM_GROUP_8859_2 },
+    { ngrams_8859_2[2].ngrams, NGRAM_GROUP_8859_2 },
+    { ngrams_8859_2[3].ngrams, NGRAM_GROUP_8859_2 },
+    { ngrams_8859_5_ru, NGRAM_GROUP_8859_5 },
+    { ngrams_8859_6_ar, NGRAM_GROUP_8859_6 },
+    { ngrams_8859_7_el, NGRAM_GROUP_8859_7 },
+    { ngrams_8859_8_I_he, NGRAM_GROUP_8859_8 },
+    { ngrams_8859_8_he, NGRAM_GROUP_8859_8 },
+    { ngrams_8859_9_tr, NGRAM_GROUP_8859_9 },
+    { ngrams_windows_1251, NGRAM_GROUP_WINDOWS_1251 },
+    { ngrams_windows_1256, NGRAM_GROUP_WINDOWS_1256 },
+    { ngrams_KOI8_R, NGRAM_GROUP_KOI8_R },
+#if !UCONFIG_ONLY_HTML_CONVERSION
+    { ngrams_IBM424_he_rtl, NGRAM_GROUP_IBM424 },
+    { ngrams_IBM424_he_ltr, NGRAM_GROUP_IBM424 },
+    { ngrams_IBM420_ar_rtl, NGRAM_GROUP_IBM420 },
+    { ngrams_IBM420_ar_ltr, NGRAM_GROUP_IBM420 },
+#endif
+};
+
+#define NGRAM_TABLE_COUNT UPRV_LENGTHOF(ngramTables)
+#define NGRAM_TABLE_LENGTH 64
+
+// The table bits must fit into NGramHashEntry::tables.
+static_assert(NGRAM_TABLE_COUNT <= 32, "too many n-gram tables");
+
+// Large enough that the n-grams of all tables fill less than half of it.
+#define NGRAM_HASH_SHIFT 12
+#define NGRAM_HASH_SIZE (1 << NGRAM_HASH_SHIFT)
+
+struct NGramHashEntry {
+    int32_t ngram;      // -1 if the entry is empty
+    uint32_t tables;    // bit i is set if ngramTables[i] contains the n-gram
+};
+
+static NGramHashEntry gNGramHash[NGRAM_HASH_SIZE];
+
+// gByteMaps[b][g] is the byte map of group g applied to input byte b.
+// For IBM420, gLamAlefMaps[b] is the second byte, if any, that a lam-alef ligature expands to.
+static uint8_t gByteMaps[256][NGRAM_GROUP_COUNT];
+#if !UCONFIG_ONLY_HTML_CONVERSION
+static uint8_t gLamAlefMaps[256];
+#endif
+
+static int32_t gGroupStart[NGRAM_GROUP_COUNT + 1];   // first table index of each group
+
+static icu::UInitOnce gNGramsInitOnce = U_INITONCE_INITIALIZER;
+
+static inline int32_t ngramHash(int32_t ngram)
+{
+    return (int32_t)(((uint32_t)ngram * 0x9E3779B1u) >> (32 - NGRAM_HASH_SHIFT));
+}
+
+// The tables are built from constant data and do not allocate memory, so they need no cleanup.
+static void U_CALLCONV initNGrams()
+{
+    int32_t i, t, g;
+
+    for (i = 0; i < NGRAM_HASH_SIZE; i += 1) {
+        gNGramHash[i].ngram = -1;
+        gNGramHash[i].tables = 0;
+    }
+    for (t = 0; t < (int32_t)NGRAM_TABLE_COUNT; t += 1) {
+        for (i = 0; i < NGRAM_TABLE_LENGTH; i += 1) {
+            int32_t ngram = ngramTables[t].ngrams[i];
+            int32_t h = ngramHash(ngram);
+            while (gNGramHash[h].ngram >= 0 && gNGramHash[h].ngram != ngram) {
+                h = (h + 1) & (NGRAM_HASH_SIZE - 1);
+            }
+            gNGramHash[h].ngram = ngram;
+            gNGramHash[h].tables |= (uint32_t)1 << t;
+        }
+    }
+
+    for (g = 0, t = 0; g <= NGRAM_GROUP_COUNT; g += 1) {
+        while (t < (int32_t)NGRAM_TABLE_COUNT && ngramTables[t].group < g) {
+            t += 1;
+        }
+        gGroupStart[g] = t;
+    }
+
+    for (i = 0; i < 256; i += 1) {
+        for (g = 0; g < NGRAM_GROUP_COUNT; g += 1) {
+            gByteMaps[i][g] = ngramGroupCharMaps[g][i];
+        }
+#if !UCONFIG_ONLY_HTML_CONVERSION
+        int32_t alef = lamAlefOf(i);
+        gByteMaps[i][NGRAM_GROUP_IBM420] =
+            charMap_IBM420_ar[alef != 0 ? 0xB1 : unshapeMap_IBM420[i]];
+        gLamAlefMaps[i] = alef != 0 ? charMap_IBM420_ar[alef] : 0;
+#endif
+    }
+}
+
+/*
+ * The n-gram parsing state of one group, equivalent to an NGramParser's.
+ */
+struct NGramGroupState {
+    int32_t ngram;
+    int32_t ngramCount;
+    UBool ignoreSpace;
+};
+
+static inline void addNGramByte(NGramGroupState &state, int32_t group, int32_t b, int32_t hitCounts[])
+{
+    state.ngram = ((state.ngram << 8) + b) & N_GRAM_MASK;
+    state.ngramCount += 1;
+
+    int32_t h = ngramHash(state.ngram);
+    while (gNGramHash[h].ngram >= 0) {
+        if (gNGramHash[h].ngram == state.ngram) {
+            uint32_t tables = gNGramHash[h].tables;
+            for (int32_t t = gGroupStart[group]; t < gGroupStart[group + 1]; t += 1) {
+                if (tables & ((uint32_t)1 << t)) {
+                    hitCounts[t] += 1;
+                }
+            }
+            break;
+        }
+        h = (h + 1) & (NGRAM_HASH_SIZE - 1);
+    }
+}
+
+static inline void addMappedByte(NGramGroupState &state, int32_t group, uint8_t mb, int32_t hitCounts[])
+{
+    // TODO: 0x20 might not be a space in all character sets...
+    if (mb != 0) {
+        if (!(mb == 0x20 && state.ignoreSpace)) {
+            addNGramByte(state, group, mb, hitCounts);
+        }
+        state.ignoreSpace = (mb == 0x20);
+    }
+}
+
+static void scoreAllNGrams(InputText *det, int32_t confidences[])
+{
+    NGramGroupState states[NGRAM_GROUP_COUNT];
+    int32_t hitCounts[NGRAM_TABLE_COUNT];
+    int32_t i, g;
+
+    uprv_memset(states, 0, sizeof(states));
+    uprv_memset(hitCounts, 0, sizeof(hitCounts));
+
+#if !UCONFIG_ONLY_HTML_CONVERSION
+    // NGramParser_IBM420 stops at the first NUL byte.
+    UBool ibm420Stopped = FALSE;
+    const int32_t byteMapGroupCount = NGRAM_GROUP_IBM420;
+#else
+    const int32_t byteMapGroupCount = NGRAM_GROUP_COUNT;
+#endif
+
+    for (i = 0; i < det->fInputLen; i += 1) {
+        uint8_t b = det->fInputBytes[i];
+        const uint8_t *mapped = gByteMaps[b];
+
+        for (g = 0; g < byteMapGroupCount; g += 1) {
+            addMappedByte(states[g], g, mapped[g], hitCounts);
+        }
+
+#if !UCONFIG_ONLY_HTML_CONVERSION
+        if (b == 0) {
+            ibm420Stopped = TRUE;
+        }
+        if (!ibm420Stopped) {
+            addMappedByte(states[NGRAM_GROUP_IBM420], NGRAM_GROUP_IBM420, mapped[NGRAM_GROUP_IBM420], hitCounts);
+            if (gLamAlefMaps[b] != 0) {
+                addMappedByte(states[NGRAM_GROUP_IBM420], NGRAM_GROUP_IBM420, gLamAlefMaps[b], hitCounts);
+            }
+        }
+#endif
+    }
+
+    // As in NGramParser::parse(), end the last word.
+    for (g = 0; g < NGRAM_GROUP_COUNT; g += 1) {
+        addNGramByte(states[g], g, 0x20, hitCounts);
+        for (int32_t t = gGroupStart[g]; t < gGroupStart[g + 1]; t += 1) {
+            confidences[t] = ngramConfidence(hitCounts[t], states[g].ngramCount);
+        }
+    }
+}
+
+/*
+ * Gets the confidence for the given n-gram table, scoring all tables
+ * if that has not been done yet for the current input.
+ * Returns FALSE if the caller needs to parse the input itself.
+ */
+static UBool getScoredConfidence(InputText *det, const int32_t *ngrams, int32_t &confidence)
+{
+    int32_t t;
+
+    for (t = 0; t < (int32_t)NGRAM_TABLE_COUNT; t += 1) {
+        if (ngramTables[t].ngrams == ngrams) {
+            break;
+        }
+    }
+    if (t == (int32_t)NGRAM_TABLE_COUNT) {
+        return FALSE;
+    }
+
+    if (!det->fNGramsScored) {
+        if (det->fNGramConfidences == NULL) {
+            det->fNGramConfidences = (int32_t *) uprv_malloc(NGRAM_TABLE_COUNT * sizeof(int32_t));
+            if (det->fNGramConfidences == NULL) {
+                return FALSE;
+            }
+        }
+        umtx_initOnce(gNGramsInitOnce, &initNGrams);
+        scoreAllNGrams(det, det->fNGramConfidences);
+        det->fNGramsScored = TRUE;
+    }
+
+    confidence = det->fNGramConfidences[t];
+    return TRUE;
+}
+
 CharsetRecog_8859_1::~CharsetRecog_8859_1()
 {
     // nothing to do
@@ -1223,9 +1529,14 @@ const char *CharsetRecog_IBM420_ar::getLanguage() const
     
 int32_t CharsetRecog_IBM420_ar::match_sbcs(InputText *det, const int32_t ngrams[],  const uint8_t byteMap[]) const
 {
-    NGramParser_IBM420 parser(ngrams, byteMap);
     int32_t result;
-    
+
+    if (getScoredConfidence(det, ngrams, result)) {
+        return result;
+    }
+
+    NGramParser_IBM420 parser(ngrams, byteMap);
+
     result = parser.parse(det);
         
     return result;
@@ -253,7 +253,8 @@ DateFormatSymbols::createForLocale(
     if (U_FAILURE(status)) {
         return NULL;
     }
-    DateFormatSymbols *result = new DateFormatSymbols(shared->get());
+    // Alias the cached symbol arrays instead of copying them.
+    DateFormatSymbols *result = new DateFormatSymbols(*shared);
     shared->removeRef();
     if (result == NULL) {
         status = U_MEMORY_ALLOCATION_ERROR;
@@ -291,11 +292,18 @@ DateFormatSymbols::DateFormatSymbols(const char *type, UErrorCode& status)
 }
 
 DateFormatSymbols::DateFormatSymbols(const DateFormatSymbols& other)
-    : UObject(other)
+    : UObject(other), fSharedArrays(NULL)
 {
     copyData(other);
 }
 
+DateFormatSymbols::DateFormatSymbols(const SharedDateFormatSymbols &shared)
+    : UObject(), fSharedArrays(&shared)
+{
+    fSharedArrays->addRef();
+    copyData(shared.get());
+}
+
 void
 DateFormatSymbols::assignArray(UnicodeString*& dstArray,
                                int32_t& dstCount,
@@ -360,70 +368,105 @@ DateFormatSymbols::createZoneStrings(const UnicodeString *const * otherStrings)
     }
 }
 
-/**
- * Copy all of the other's data to this.
- */
 void
-DateFormatSymbols::copyData(const DateFormatSymbols& other) {
-    UErrorCode status = U_ZERO_ERROR;
-    U_LOCALE_BASED(locBased, *this);
-    locBased.setLocaleIDs(
-        other.getLocale(ULOC_VALID_LOCALE, status),
-        other.getLocale(ULOC_ACTUAL_LOCALE, status));
-    assignArray(fEras, fErasCount, other.fEras, other.fErasCount);
-    assignArray(fEraNames, fEraNamesCount, other.fEraNames, other.fEraNamesCount);
-    assignArray(fNarrowEras, fNarrowErasCount, other.fNarrowEras, other.fNarrowErasCount);
-    assignArray(fMonths, fMonthsCount, other.fMonths, other.fMonthsCount);
-    assignArray(fShortMonths, fShortMonthsCount, other.fShortMonths, other.fShortMonthsCount);
-    assignArray(fNarrowMonths, fNarrowMonthsCount, other.fNarrowMonths, other.fNarrowMonthsCount);
-    assignArray(fStandaloneMonths, fStandaloneMonthsCount, other.fStandaloneMonths, other.fStandaloneMonthsCount);
-    assignArray(fStandaloneShortMonths, fStandaloneShortMonthsCount, other.fStandaloneShortMonths, other.fStandaloneShortMonthsCount);
-    assignArray(fStandaloneNarrowMonths, fStandaloneNarrowMonthsCount, other.fStandaloneNarrowMonths, other.fStandaloneNarrowMonthsCount);
-    assignArray(fWeekdays, fWeekdaysCount, other.fWeekdays, other.fWeekdaysCount);
-    assignArray(fShortWeekdays, fShortWeekdaysCount, other.fShortWeekdays, other.fShortWeekdaysCount);
-    assignArray(fShorterWeekdays, fShorterWeekdaysCount, other.fShorterWeekdays, other.fShorterWeekdaysCount);
-    assignArray(fNarrowWeekdays, fNarrowWeekdaysCount, other.fNarrowWeekdays, other.fNarrowWeekdaysCount);
-    assignArray(fStandaloneWeekdays, fStandaloneWeekdaysCount, other.fStandaloneWeekdays, other.fStandaloneWeekdaysCount);
-    assignArray(fStandaloneShortWeekdays, fStandaloneShortWeekdaysCount, other.fStandaloneShortWeekdays, other.fStandaloneShortWeekdaysCount);
-    assignArray(fStandaloneShorterWeekdays, fStandaloneShorterWeekdaysCount, other.fStandaloneShorterWeekdays, other.fStandaloneShorterWeekdaysCount);
-    assignArray(fStandaloneNarrowWeekdays, fStandaloneNarrowWeekdaysCount, other.fStandaloneNarrowWeekdays, other.fStandaloneNarrowWeekdaysCount);
-    assignArray(fAmPms, fAmPmsCount, other.fAmPms, other.fAmPmsCount);
-    assignArray(fNarrowAmPms, fNarrowAmPmsCount, other.fNarrowAmPms, other.fNarrowAmPmsCount );
+DateFormatSymbols::copyArray(UnicodeString*& dstArray,
+                             int32_t& dstCount,
+                             const UnicodeString* srcArray,
+                             int32_t srcCount)
+{
+    if (fSharedArrays != NULL) {
+        // The shared symbols own the array and never modify it.
+        dstArray = const_cast<UnicodeString *>(srcArray);
+        dstCount = srcCount;
+    } else {
+        assignArray(dstArray, dstCount, srcArray, srcCount);
+    }
+}
+
+void
+DateFormatSymbols::copyArrays(const DateFormatSymbols& other) {
+    copyArray(fEras, fErasCount, other.fEras, other.fErasCount);
+    copyArray(fEraNames, fEraNamesCount, other.fEraNames, other.fEraNamesCount);
+    copyArray(fNarrowEras, fNarrowErasCount, other.fNarrowEras, other.fNarrowErasCount);
+    copyArray(fMonths, fMonthsCount, other.fMonths, other.fMonthsCount);
+    copyArray(fShortMonths, fShortMonthsCount, other.fShortMonths, other.fShortMonthsCount);
+    copyArray(fNarrowMonths, fNarrowMonthsCount, other.fNarrowMonths, other.fNarrowMonthsCount);
+    copyArray(fStandaloneMonths, fStandaloneMonthsCount, other.fStandaloneMonths, other.fStandaloneMonthsCount);
+    copyArray(fStandaloneShortMonths, fStandaloneShortMonthsCount, other.fStandaloneShortMonths, other.fStandaloneShortMonthsCount);
+    copyArray(fStandaloneNarrowMonths, fStandaloneNarrowMonthsCount, other.fStandaloneNarrowMonths, other.fStandaloneNarrowMonthsCount);
+    copyArray(fWeekdays, fWeekdaysCount, other.fWeekdays, other.fWeekdaysCount);
+    copyArray(fShortWeekdays, fShortWeekdaysCount, other.fShortWeekdays, other.fShortWeekdaysCount);
+    copyArray(fShorterWeekdays, fShorterWeekdaysCount, other.fShorterWeekdays, other.fShorterWeekdaysCount);
+    copyArray(fNarrowWeekdays, fNarrowWeekdaysCount, other.fNarrowWeekdays, other.fNarrowWeekdaysCount);
+    copyArray(fStandaloneWeekdays, fStandaloneWeekdaysCount, other.fStandaloneWeekdays, other.fStandaloneWeekdaysCount);
+    copyArray(fStandaloneShortWeekdays, fStandaloneShortWeekdaysCount, other.fStandaloneShortWeekdays, other.fStandaloneShortWeekdaysCount);
+    copyArray(fStandaloneShorterWeekdays, fStandaloneShorterWeekdaysCount, other.fStandaloneShorterWeekdays, other.fStandaloneShorterWeekdaysCount);
+    copyArray(fStandaloneNarrowWeekdays, fStandaloneNarrowWeekdaysCount, other.fStandaloneNarrowWeekdays, other.fStandaloneNarrowWeekdaysCount);
+    copyArray(fAmPms, fAmPmsCount, other.fAmPms, other.fAmPmsCount);
+    copyArray(fNarrowAmPms, fNarrowAmPmsCount, other.fNarrowAmPms, other.fNarrowAmPmsCount );
     fTimeSeparator.fastCopyFrom(other.fTimeSeparator);  // fastCopyFrom() - see assignArray comments
-    assignArray(fQuarters, fQuartersCount, other.fQuarters, other.fQuartersCount);
-    assignArray(fShortQuarters, fShortQuartersCount, other.fShortQuarters, other.fShortQuartersCount);
-    assignArray(fStandaloneQuarters, fStandaloneQuartersCount, other.fStandaloneQuarters, other.fStandaloneQuartersCount);
-    assignArray(fStandaloneShortQuarters, fStandaloneShortQuartersCount, other.fStandaloneShortQuarters, other.fStandaloneShortQuartersCount);
-    assignArray(fWideDayPeriods, fWideDayPeriodsCount,
+    copyArray(fQuarters, fQuartersCount, other.fQuarters, other.fQuartersCount);
+    copyArray(fShortQuarters, fShortQuartersCount, other.fShortQuarters, other.fShortQuartersCount);
+    copyArray(fStandaloneQuarters, fStandaloneQuartersCount, other.fStandaloneQuarters, other.fStandaloneQuartersCount);
+    copyArray(fStandaloneShortQuarters, fStandaloneShortQuartersCount, other.fStandaloneShortQuarters, other.fStandaloneShortQuartersCount);
+    copyArray(fWideDayPeriods, fWideDayPeriodsCount,
                 other.fWideDayPeriods, other.fWideDayPeriodsCount);
-    assignArray(fNarrowDayPeriods, fNarrowDayPeriodsCount,
+    copyArray(fNarrowDayPeriods, fNarrowDayPeriodsCount,
                 other.fNarrowDayPeriods, other.fNarrowDayPeriodsCount);
-    assignArray(fAbbreviatedDayPeriods, fAbbreviatedDayPeriodsCount,
+    copyArray(fAbbreviatedDayPeriods, fAbbreviatedDayPeriodsCount,
                 other.fAbbreviatedDayPeriods, other.fAbbreviatedDayPeriodsCount);
-    assignArray(fStandaloneWideDayPeriods, fStandaloneWideDayPeriodsCount,
+    copyArray(fStandaloneWideDayPeriods, fStandaloneWideDayPeriodsCount,
                 other.fStandaloneWideDayPeriods, other.fStandaloneWideDayPeriodsCount);
-    assignArray(fStandaloneNarrowDayPeriods, fStandaloneNarrowDayPeriodsCount,
+    copyArray(fStandaloneNarrowDayPeriods, fStandaloneNarrowDayPeriodsCount,
                 other.fStandaloneNarrowDayPeriods, other.fStandaloneNarrowDayPeriodsCount);
-    assignArray(fStandaloneAbbreviatedDayPeriods, fStandaloneAbbreviatedDayPeriodsCount,
+    copyArray(fStandaloneAbbreviatedDayPeriods, fStandaloneAbbreviatedDayPeriodsCount,
                 other.fStandaloneAbbreviatedDayPeriods, other.fStandaloneAbbreviatedDayPeriodsCount);
     if (other.fLeapMonthPatterns != NULL) {
-        assignArray(fLeapMonthPatterns, fLeapMonthPatternsCount, other.fLeapMonthPatterns, other.fLeapMonthPatternsCount);
+        copyArray(fLeapMonthPatterns, fLeapMonthPatternsCount, other.fLeapMonthPatterns, other.fLeapMonthPatternsCount);
     } else {
         fLeapMonthPatterns = NULL;
         fLeapMonthPatternsCount = 0;
     }
     if (other.fShortYearNames != NULL) {
-        assignArray(fShortYearNames, fShortYearNamesCount, other.fShortYearNames, other.fShortYearNamesCount);
+        copyArray(fShortYearNames, fShortYearNamesCount, other.fShortYearNames, other.fShortYearNamesCount);
     } else {
         fShortYearNames = NULL;
         fShortYearNamesCount = 0;
     }
     if (other.fShortZodiacNames != NULL) {
-        assignArray(fShortZodiacNames, fShortZodiacNamesCount, other.fShortZodiacNames, other.fShortZodiacNamesCount);
+        copyArray(fShortZodiacNames, fShortZodiacNamesCount, other.fShortZodiacNames, other.fShortZodiacNamesCount);
     } else {
         fShortZodiacNames = NULL;
         fShortZodiacNamesCount = 0;
     }
+}
+
+void
+DateFormatSymbols::unshareArrays() {
+    if (fSharedArrays != NULL) {
+        const SharedDateFormatSymbols *shared = fSharedArrays;
+        fSharedArrays = NULL;
+        copyArrays(shared->get());
+        shared->removeRef();
+    }
+}
+
+/**
+ * Copy all of the other's data to this.
+ * The arrays are shared with cached symbols, if the other shares them too.
+ */
+void
+DateFormatSymbols::copyData(const DateFormatSymbols& other) {
+    UErrorCode status = U_ZERO_ERROR;
+    U_LOCALE_BASED(locBased, *this);
+    locBased.setLocaleIDs(
+        other.getLocale(ULOC_VALID_LOCALE, status),
+        other.getLocale(ULOC_ACTUAL_LOCALE, status));
+    if (fSharedArrays == NULL && other.fSharedArrays != NULL) {
+        fSharedArrays = other.fSharedArrays;
+        fSharedArrays->addRef();
+    }
+    copyArrays(other);
 
     if (other.fZoneStrings != NULL) {
         fZoneStringsColCount = other.fZoneStringsColCount;
@@ -450,6 +493,9 @@ DateFormatSymbols::copyData(const DateFormatSymbols& other) {
  */
 DateFormatSymbols& DateFormatSymbols::operator=(const DateFormatSymbols& other)
 {
+    if (this == &other) {
+        return *this;
+    }
     dispose();
     copyData(other);
 
@@ -463,6 +509,13 @@ DateFormatSymbols::~DateFormatSymbols()
 
 void DateFormatSymbols::dispose()
 {
+    if (fSharedArrays != NULL) {
+        // The arrays belong to the shared symbols.
+        fSharedArrays->removeRef();
+        fSharedArrays = NULL;
+        disposeZoneStrings();
+        return;
+    }
     delete[] fEras;
     delete[] fEraNames;
     delete[] fNarrowEras;
@@ -873,6 +926,7 @@ void
 DateFormatSymbols::setYearNames(const UnicodeString* yearNames, int32_t count,
                                 DtContextType context, DtWidthType width)
 {
+    unshareArrays();
     if (context == FORMAT && width == ABBREVIATED) {
         if (fShortYearNames) {
             delete[] fShortYearNames;
@@ -895,6 +949,7 @@ void
 DateFormatSymbols::setZodiacNames(const UnicodeString* zodiacNames, int32_t count,
                                 DtContextType context, DtWidthType width)
 {
+    unshareArrays();
     if (context == FORMAT && width == ABBREVIATED) {
         if (fShortZodiacNames) {
             delete[] fShortZodiacNames;
@@ -910,6 +965,7 @@ DateFormatSymbols::setZodiacNames(const UnicodeString* zodiacNames, int32_t coun
 void
 DateFormatSymbols::setEras(const UnicodeString* erasArray, int32_t count)
 {
+    unshareArrays();
     // delete the old list if we own it
     if (fEras)
         delete[] fEras;
@@ -924,6 +980,7 @@ DateFormatSymbols::setEras(const UnicodeString* erasArray, int32_t count)
 void
 DateFormatSymbols::setEraNames(const UnicodeString* eraNamesArray, int32_t count)
 {
+    unshareArrays();
     // delete the old list if we own it
     if (fEraNames)
         delete[] fEraNames;
@@ -938,6 +995,7 @@ DateFormatSymbols::setEraNames(const UnicodeString* eraNamesArray, int32_t count
 void
 DateFormatSymbols::setNarrowEras(const UnicodeString* narrowErasArray, int32_t count)
 {
+    unshareArrays();
     // delete the old list if we own it
     if (fNarrowEras)
         delete[] fNarrowEras;
@@ -952,6 +1010,7 @@ DateFormatSymbols::setNarrowEras(const UnicodeString* narrowErasArray, int32_t c
 void
 DateFormatSymbols::setMonths(const UnicodeString* monthsArray, int32_t count)
 {
+    unshareArrays();
     // delete the old list if we own it
     if (fMonths)
         delete[] fMonths;
@@ -966,6 +1025,7 @@ DateFormatSymbols::setMonths(const UnicodeString* monthsArray, int32_t count)
 void
 DateFormatSymbols::setShortMonths(const UnicodeString* shortMonthsArray, int32_t count)
 {
+    unshareArrays();
     // delete the old list if we own it
     if (fShortMonths)
         delete[] fShortMonths;
@@ -980,6 +1040,7 @@ DateFormatSymbols::setShortMonths(const UnicodeString* shortMonthsArray, int32_t
 void
 DateFormatSymbols::setMonths(const UnicodeString* monthsArray, int32_t count, DtContextType context, DtWidthType width)
 {
+    unshareArrays();
     // delete the old list if we own it
     // we always own the new list, which we create here (we duplicate rather
     // than adopting the list passed in)
@@ -1046,6 +1107,7 @@ DateFormatSymbols::setMonths(const UnicodeString* monthsArray, int32_t count, Dt
 
 void DateFormatSymbols::setWeekdays(const UnicodeString* weekdaysArray, int32_t count)
 {
+    unshareArrays();
     // delete the old list if we own it
     if (fWeekdays)
         delete[] fWeekdays;
@@ -1060,6 +1122,7 @@ void DateFormatSymbols::setWeekdays(const UnicodeString* weekdaysArray, int32_t
 void
 DateFormatSymbols::setShortWeekdays(const UnicodeString* shortWeekdaysArray, int32_t count)
 {
+    unshareArrays();
     // delete the old list if we own it
     if (fShortWeekdays)
         delete[] fShortWeekdays;
@@ -1074,6 +1137,7 @@ DateFormatSymbols::setShortWeekdays(const UnicodeString* shortWeekdaysArray, int
 void
 DateFormatSymbols::setWeekdays(const UnicodeString* weekdaysArray, int32_t count, DtContextType context, DtWidthType width)
 {
+    unshareArrays();
     // delete the old list if we own it
     // we always own the new list, which we create here (we duplicate rather
     // than adopting the list passed in)
@@ -1155,6 +1219,7 @@ DateFormatSymbols::setWeekdays(const UnicodeString* weekdaysArray, int32_t count
 void
 DateFormatSymbols::setQuarters(const UnicodeString* quartersArray, int32_t count, DtContextType context, DtWidthType width)
 {
+    unshareArrays();
     // delete the old list if we own it
     // we always own the new list, which we create here (we duplicate rather
     // than adopting the list passed in)
@@ -1226,6 +1291,7 @@ DateFormatSymbols::setQuarters(const UnicodeString* quartersArray, int32_t count
 void
 DateFormatSymbols::setAmPmStrings(const UnicodeString* amPmsArray, int32_t count)
 {
+    unshareArrays();
     // delete the old list if we own it
     if (fAmPms) delete[] fAmPms;
 
@@ -1376,8 +1442,21 @@ DateFormatSymbols::getPatternUChars(void)
     return gPatternChars;
 }
 
+// Index in gPatternChars of each letter from 'A' to 'z', or -1.
+static const int8_t gPatternCharIndexes[0x7B - 0x41] = {
+    22, 36, -1, 10,  9, 11,  0,  5, -1, -1, 16, 26,  2, -1, 31, -1,
+    27, -1,  8, -1, 30, 29, 13, 32, 18, 23, -1, -1, -1, -1, -1, -1,
+    14, 35, 25,  3, 19, -1, 21, 15, -1, -1,  4, -1,  6, -1, -1, -1,
+    28, 34,  7, -1, 20, 24, 12, 33,  1, 17
+};
+
 UDateFormatField U_EXPORT2
 DateFormatSymbols::getPatternCharIndex(UChar c) {
+    // Called for every field of every formatted date: Look up letters directly.
+    if (0x41 <= c && c <= 0x7A) {
+        int32_t index = gPatternCharIndexes[c - 0x41];
+        return index >= 0 ? static_cast<UDateFormatField>(index) : UDAT_FIELD_COUNT;
+    }
     const UChar *p = u_strchr(gPatternChars, c);
     if (p == NULL) {
         return UDAT_FIELD_COUNT;
@@ -2023,6 +2102,7 @@ DateFormatSymbols::initializeData(const Locale& locale, const char *type, UError
 {
     int32_t len = 0;
     /* In case something goes wrong, initialize all of the data to NULL. */
+    fSharedArrays = NULL;
     fEras = NULL;
     fErasCount = 0;
     fEraNames = NULL;
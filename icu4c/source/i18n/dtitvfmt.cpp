@@ -143,7 +143,9 @@ DateIntervalFormat::DateIntervalFormat()
     fLocale(Locale::getRoot()),
     fDatePattern(nullptr),
     fTimePattern(nullptr),
-    fDateTimeFormat(nullptr)
+    fDateTimeFormat(nullptr),
+    fPatternFormats(),
+    fPatternUses()
 {}
 
 
@@ -156,7 +158,9 @@ DateIntervalFormat::DateIntervalFormat(const DateIntervalFormat& itvfmt)
     fLocale(itvfmt.fLocale),
     fDatePattern(nullptr),
     fTimePattern(nullptr),
-    fDateTimeFormat(nullptr) {
+    fDateTimeFormat(nullptr),
+    fPatternFormats(),
+    fPatternUses() {
     *this = itvfmt;
 }
 
@@ -164,6 +168,7 @@ DateIntervalFormat::DateIntervalFormat(const DateIntervalFormat& itvfmt)
 DateIntervalFormat&
 DateIntervalFormat::operator=(const DateIntervalFormat& itvfmt) {
     if ( this != &itvfmt ) {
+        resetPatternFormats();
         delete fDateFormat;
         delete fInfo;
         delete fFromCalendar;
@@ -209,6 +214,7 @@ DateIntervalFormat::operator=(const DateIntervalFormat& itvfmt) {
 
 
 DateIntervalFormat::~DateIntervalFormat() {
+    resetPatternFormats();
     delete fInfo;
     delete fDateFormat;
     delete fFromCalendar;
@@ -487,19 +493,14 @@ DateIntervalFormat::formatImpl(Calendar& fromCalendar,
              */
             return fDateFormat->_format(fromCalendar, appendTo, fphandler, status);
         }
-        return fallbackFormat(fromCalendar, toCalendar, fromToOnSameDay, appendTo, firstIndex, fphandler, status);
+        return fallbackFormat(fromCalendar, toCalendar, fromToOnSameDay, -1, appendTo, firstIndex, fphandler, status);
     }
     // If the first part in interval pattern is empty,
     // the 2nd part of it saves the full-pattern used in fall-back.
     // For a 'real' interval pattern, the first part will never be empty.
     if ( intervalPattern.firstPart.isEmpty() ) {
         // fall back
-        UnicodeString originalPattern;
-        fDateFormat->toPattern(originalPattern);
-        fDateFormat->applyPattern(intervalPattern.secondPart);
-        appendTo = fallbackFormat(fromCalendar, toCalendar, fromToOnSameDay, appendTo, firstIndex, fphandler, status);
-        fDateFormat->applyPattern(originalPattern);
-        return appendTo;
+        return fallbackFormat(fromCalendar, toCalendar, fromToOnSameDay, 2 * itvPtnIndex + 1, appendTo, firstIndex, fphandler, status);
     }
     Calendar* firstCal;
     Calendar* secondCal;
@@ -514,20 +515,69 @@ DateIntervalFormat::formatImpl(Calendar& fromCalendar,
     }
     // break the interval pattern into 2 parts,
     // first part should not be empty,
-    UnicodeString originalPattern;
-    fDateFormat->toPattern(originalPattern);
-    fDateFormat->applyPattern(intervalPattern.firstPart);
-    fDateFormat->_format(*firstCal, appendTo, fphandler, status);
+    formatPattern(2 * itvPtnIndex, *firstCal, appendTo, fphandler, status);
 
     if ( !intervalPattern.secondPart.isEmpty() ) {
-        fDateFormat->applyPattern(intervalPattern.secondPart);
-        fDateFormat->_format(*secondCal, appendTo, fphandler, status);
+        formatPattern(2 * itvPtnIndex + 1, *secondCal, appendTo, fphandler, status);
     }
-    fDateFormat->applyPattern(originalPattern);
     return appendTo;
 }
 
 
+void
+DateIntervalFormat::formatPattern(int32_t patternIndex,
+                                  Calendar& cal,
+                                  UnicodeString& appendTo,
+                                  FieldPositionHandler& fphandler,
+                                  UErrorCode& status) const {
+    if ( U_FAILURE(status) ) {
+        return;
+    }
+    if ( patternIndex < 0 ) {
+        fDateFormat->_format(cal, appendTo, fphandler, status);
+        return;
+    }
+    const UnicodeString* pattern;
+    if ( patternIndex == kTimePatternIndex ) {
+        pattern = fTimePattern;
+    } else if ( patternIndex == kDatePatternIndex ) {
+        pattern = fDatePattern;
+    } else if ( (patternIndex & 1) == 0 ) {
+        pattern = &fIntervalPatterns[patternIndex / 2].firstPart;
+    } else {
+        pattern = &fIntervalPatterns[patternIndex / 2].secondPart;
+    }
+    SimpleDateFormat*& patternFormat = fPatternFormats[patternIndex];
+    if ( patternFormat == nullptr && fPatternUses[patternIndex] >= kPatternFormatMinUses ) {
+        // If cloning fails, keep applying the pattern to fDateFormat.
+        patternFormat = fDateFormat->clone();
+        if ( patternFormat != nullptr ) {
+            patternFormat->applyPattern(*pattern);
+        }
+    }
+    if ( patternFormat != nullptr ) {
+        patternFormat->_format(cal, appendTo, fphandler, status);
+        return;
+    }
+    ++fPatternUses[patternIndex];
+    UnicodeString originalPattern;
+    fDateFormat->toPattern(originalPattern);
+    fDateFormat->applyPattern(*pattern);
+    fDateFormat->_format(cal, appendTo, fphandler, status);
+    fDateFormat->applyPattern(originalPattern);
+}
+
+
+void
+DateIntervalFormat::resetPatternFormats() {
+    for ( int32_t i = 0; i < kPatternFormatCount; ++i ) {
+        delete fPatternFormats[i];
+        fPatternFormats[i] = nullptr;
+        fPatternUses[i] = 0;
+    }
+}
+
+
 
 void
 DateIntervalFormat::parseObject(const UnicodeString& /* source */,
@@ -563,6 +613,7 @@ DateIntervalFormat::setDateIntervalInfo(const DateIntervalInfo& newItvPattern,
     fTimePattern = nullptr;
     delete fDateTimeFormat;
     fDateTimeFormat = nullptr;
+    resetPatternFormats();
 
     if (fDateFormat) {
         initializePattern(status);
@@ -580,6 +631,7 @@ DateIntervalFormat::getDateFormat() const {
 void
 DateIntervalFormat::adoptTimeZone(TimeZone* zone)
 {
+    resetPatternFormats();
     if (fDateFormat != nullptr) {
         fDateFormat->adoptTimeZone(zone);
     }
@@ -598,6 +650,7 @@ DateIntervalFormat::adoptTimeZone(TimeZone* zone)
 void
 DateIntervalFormat::setTimeZone(const TimeZone& zone)
 {
+    resetPatternFormats();
     if (fDateFormat != nullptr) {
         fDateFormat->setTimeZone(zone);
     }
@@ -633,7 +686,9 @@ DateIntervalFormat::DateIntervalFormat(const Locale& locale,
     fLocale(locale),
     fDatePattern(nullptr),
     fTimePattern(nullptr),
-    fDateTimeFormat(nullptr)
+    fDateTimeFormat(nullptr),
+    fPatternFormats(),
+    fPatternUses()
 {
     LocalPointer<DateIntervalInfo> info(dtItvInfo, status);
     LocalPointer<SimpleDateFormat> dtfmt(static_cast<SimpleDateFormat *>(
@@ -1428,6 +1483,7 @@ DateIntervalFormat::splitPatternInto2Part(const UnicodeString& intervalPattern)
 void DateIntervalFormat::fallbackFormatRange(
         Calendar& fromCalendar,
         Calendar& toCalendar,
+        int32_t patternIndex,
         UnicodeString& appendTo,
         int8_t& firstIndex,
         FieldPositionHandler& fphandler,
@@ -1445,16 +1501,16 @@ void DateIntervalFormat::fallbackFormatRange(
     if (offsets[0] < offsets[1]) {
         firstIndex = 0;
         appendTo.append(patternBody.tempSubStringBetween(0, offsets[0]));
-        fDateFormat->_format(fromCalendar, appendTo, fphandler, status);
+        formatPattern(patternIndex, fromCalendar, appendTo, fphandler, status);
         appendTo.append(patternBody.tempSubStringBetween(offsets[0], offsets[1]));
-        fDateFormat->_format(toCalendar, appendTo, fphandler, status);
+        formatPattern(patternIndex, toCalendar, appendTo, fphandler, status);
         appendTo.append(patternBody.tempSubStringBetween(offsets[1]));
     } else {
         firstIndex = 1;
         appendTo.append(patternBody.tempSubStringBetween(0, offsets[1]));
-        fDateFormat->_format(toCalendar, appendTo, fphandler, status);
+        formatPattern(patternIndex, toCalendar, appendTo, fphandler, status);
         appendTo.append(patternBody.tempSubStringBetween(offsets[1], offsets[0]));
-        fDateFormat->_format(fromCalendar, appendTo, fphandler, status);
+        formatPattern(patternIndex, fromCalendar, appendTo, fphandler, status);
         appendTo.append(patternBody.tempSubStringBetween(offsets[0]));
     }
 }
@@ -1463,6 +1519,7 @@ UnicodeString&
 DateIntervalFormat::fallbackFormat(Calendar& fromCalendar,
                                    Calendar& toCalendar,
                                    UBool fromToOnSameDay, // new
+                                   int32_t patternIndex,
                                    UnicodeString& appendTo,
                                    int8_t& firstIndex,
                                    FieldPositionHandler& fphandler,
@@ -1480,34 +1537,24 @@ DateIntervalFormat::fallbackFormat(Calendar& fromCalendar,
         int32_t offsets[2];
         UnicodeString patternBody = sf.getTextWithNoArguments(offsets, 2);
 
-        UnicodeString fullPattern; // for saving the pattern in fDateFormat
-        fDateFormat->toPattern(fullPattern); // save current pattern, restore later
-
         // {0} is time range
         // {1} is single date portion
         // TODO(ICU-20406): Use SimpleFormatter Iterator interface when available.
         if (offsets[0] < offsets[1]) {
             appendTo.append(patternBody.tempSubStringBetween(0, offsets[0]));
-            fDateFormat->applyPattern(*fTimePattern);
-            fallbackFormatRange(fromCalendar, toCalendar, appendTo, firstIndex, fphandler, status);
+            fallbackFormatRange(fromCalendar, toCalendar, kTimePatternIndex, appendTo, firstIndex, fphandler, status);
             appendTo.append(patternBody.tempSubStringBetween(offsets[0], offsets[1]));
-            fDateFormat->applyPattern(*fDatePattern);
-            fDateFormat->_format(fromCalendar, appendTo, fphandler, status);
+            formatPattern(kDatePatternIndex, fromCalendar, appendTo, fphandler, status);
             appendTo.append(patternBody.tempSubStringBetween(offsets[1]));
         } else {
             appendTo.append(patternBody.tempSubStringBetween(0, offsets[1]));
-            fDateFormat->applyPattern(*fDatePattern);
-            fDateFormat->_format(fromCalendar, appendTo, fphandler, status);
+            formatPattern(kDatePatternIndex, fromCalendar, appendTo, fphandler, status);
             appendTo.append(patternBody.tempSubStringBetween(offsets[1], offsets[0]));
-            fDateFormat->applyPattern(*fTimePattern);
-            fallbackFormatRange(fromCalendar, toCalendar, appendTo, firstIndex, fphandler, status);
+            fallbackFormatRange(fromCalendar, toCalendar, kTimePatternIndex, appendTo, firstIndex, fphandler, status);
             appendTo.append(patternBody.tempSubStringBetween(offsets[0]));
         }
-
-        // restore full pattern
-        fDateFormat->applyPattern(fullPattern);
     } else {
-        fallbackFormatRange(fromCalendar, toCalendar, appendTo, firstIndex, fphandler, status);
+        fallbackFormatRange(fromCalendar, toCalendar, patternIndex, appendTo, firstIndex, fphandler, status);
     }
     return appendTo;
 }
@@ -36,6 +36,8 @@
 #include "hash.h"
 #include "gregoimp.h"
 #include "uresimp.h"
+#include "sharedobject.h"
+#include "unifiedcache.h"
 
 
 U_NAMESPACE_BEGIN
@@ -73,12 +75,51 @@ DateIntervalInfo::DateIntervalInfo(UErrorCode& status)
 
 
 
+// The interval patterns of one locale, stored in the UnifiedCache:
+// Loading them from the resource bundles takes several times longer
+// than copying them.
+class SharedDateIntervalInfo : public SharedObject {
+public:
+    SharedDateIntervalInfo(const Locale& locale, UErrorCode& status) : dtitvinf(status) {
+        dtitvinf.initializeData(locale, status);
+    }
+    virtual ~SharedDateIntervalInfo();
+    const DateIntervalInfo& get() const { return dtitvinf; }
+private:
+    DateIntervalInfo dtitvinf;
+    SharedDateIntervalInfo(const SharedDateIntervalInfo&) = delete;
+    SharedDateIntervalInfo& operator=(const SharedDateIntervalInfo&) = delete;
+};
+
+SharedDateIntervalInfo::~SharedDateIntervalInfo() {
+}
+
+template<>
+const SharedDateIntervalInfo*
+        LocaleCacheKey<SharedDateIntervalInfo>::createObject(
+                const void* /*unusedContext*/, UErrorCode& status) const {
+    LocalPointer<SharedDateIntervalInfo> shared(
+            new SharedDateIntervalInfo(fLoc, status), status);
+    if (U_FAILURE(status)) {
+        return nullptr;
+    }
+    shared->addRef();
+    return shared.orphan();
+}
+
+
 DateIntervalInfo::DateIntervalInfo(const Locale& locale, UErrorCode& status)
 :   fFallbackIntervalPattern(gDefaultFallbackPattern),
     fFirstDateInPtnIsLaterDate(false),
     fIntervalPatterns(nullptr)
 {
-    initializeData(locale, status);
+    const SharedDateIntervalInfo* shared = nullptr;
+    UnifiedCache::getByLocale(locale, shared, status);
+    if (U_FAILURE(status)) {
+        return;
+    }
+    *this = shared->get();
+    shared->removeRef();
 }
 
 
@@ -387,6 +428,7 @@ DateIntervalInfo::DateIntervalSink::~DateIntervalSink() {}
 void
 DateIntervalInfo::initializeData(const Locale& locale, UErrorCode& status)
 {
+    deleteHash(fIntervalPatterns);
     fIntervalPatterns = initHash(status);
     if (U_FAILURE(status)) {
       return;
@@ -42,6 +42,7 @@
 #include "ucln_in.h"
 #include "charstr.h"
 #include "uassert.h"
+#include "unifiedcache.h"
 
 #if U_CHARSET_FAMILY==U_EBCDIC_FAMILY
 /**
@@ -301,8 +302,81 @@ DateTimePatternGenerator::createInstance(UErrorCode& status) {
     return createInstance(Locale::getDefault(), status);
 }
 
+DTBestPatternMemo::DTBestPatternMemo(UErrorCode &status) : fPatterns(status) {
+    if (U_SUCCESS(status)) {
+        fPatterns.setValueDeleter(uprv_deleteUObject);
+    }
+}
+
+DTBestPatternMemo::~DTBestPatternMemo() {
+}
+
+UBool
+DTBestPatternMemo::get(const UnicodeString &key, UnicodeString &pattern) const {
+    std::lock_guard<std::mutex> lock(fMutex);
+    const UnicodeString *memoPattern = static_cast<const UnicodeString *>(fPatterns.get(key));
+    if (memoPattern == nullptr) {
+        return FALSE;
+    }
+    pattern = *memoPattern;
+    return TRUE;
+}
+
+void
+DTBestPatternMemo::put(const UnicodeString &key, const UnicodeString &pattern, UErrorCode &status) {
+    std::lock_guard<std::mutex> lock(fMutex);
+    if (fPatterns.count() >= MAX_PATTERNS) {
+        fPatterns.removeAll();
+    }
+    LocalPointer<UnicodeString> value(new UnicodeString(pattern), status);
+    if (U_SUCCESS(status)) {
+        fPatterns.put(key, value.orphan(), status);
+    }
+}
+
+SharedDateTimePatternGenerator::~SharedDateTimePatternGenerator() {
+    delete ptr;
+}
+
+template<> U_I18N_API
+const SharedDateTimePatternGenerator *LocaleCacheKey<SharedDateTimePatternGenerator>::createObject(
+        const void * /*unused*/, UErrorCode &status) const {
+    LocalPointer<DateTimePatternGenerator> dtpg(
+            DateTimePatternGenerator::internalMakeInstance(fLoc, status));
+    if (U_FAILURE(status)) {
+        return nullptr;
+    }
+    SharedDateTimePatternGenerator *result = new SharedDateTimePatternGenerator(dtpg.getAlias());
+    if (result == nullptr) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return nullptr;
+    }
+    dtpg.orphan();
+    result->addRef();
+    return result;
+}
+
 DateTimePatternGenerator* U_EXPORT2
 DateTimePatternGenerator::createInstance(const Locale& locale, UErrorCode& status) {
+    if (U_FAILURE(status)) {
+        return nullptr;
+    }
+    // Clone the generator that was built from the locale data once, and cached.
+    const SharedDateTimePatternGenerator *shared = nullptr;
+    UnifiedCache::getByLocale(locale, shared, status);
+    if (U_FAILURE(status)) {
+        return nullptr;
+    }
+    LocalPointer<DateTimePatternGenerator> result((*shared)->clone(), status);
+    shared->removeRef();
+    if (U_SUCCESS(status) && U_FAILURE(result->internalErrorCode)) {
+        status = result->internalErrorCode;
+    }
+    return U_SUCCESS(status) ? result.orphan() : nullptr;
+}
+
+DateTimePatternGenerator* U_EXPORT2
+DateTimePatternGenerator::internalMakeInstance(const Locale& locale, UErrorCode& status) {
     if (U_FAILURE(status)) {
         return nullptr;
     }
@@ -325,6 +399,7 @@ DateTimePatternGenerator::DateTimePatternGenerator(UErrorCode &status) :
     skipMatcher(nullptr),
     fAvailableFormatKeyHash(nullptr),
     fDefaultHourFormatChar(0),
+    fBestPatternMemo(nullptr),
     internalErrorCode(U_ZERO_ERROR)
 {
     fp = new FormatParser();
@@ -340,6 +415,7 @@ DateTimePatternGenerator::DateTimePatternGenerator(const Locale& locale, UErrorC
     skipMatcher(nullptr),
     fAvailableFormatKeyHash(nullptr),
     fDefaultHourFormatChar(0),
+    fBestPatternMemo(nullptr),
     internalErrorCode(U_ZERO_ERROR)
 {
     fp = new FormatParser();
@@ -352,6 +428,14 @@ DateTimePatternGenerator::DateTimePatternGenerator(const Locale& locale, UErrorC
     else {
         initData(locale, status);
     }
+    if (U_SUCCESS(status)) {
+        // Start the memo now, so that all clones of a cached generator share it.
+        LocalPointer<DTBestPatternMemo> memo(new DTBestPatternMemo(status), status);
+        if (U_SUCCESS(status)) {
+            fBestPatternMemo = memo.orphan();
+            fBestPatternMemo->addRef();
+        }
+    }
 }
 
 DateTimePatternGenerator::DateTimePatternGenerator(const DateTimePatternGenerator& other) :
@@ -359,6 +443,7 @@ DateTimePatternGenerator::DateTimePatternGenerator(const DateTimePatternGenerato
     skipMatcher(nullptr),
     fAvailableFormatKeyHash(nullptr),
     fDefaultHourFormatChar(0),
+    fBestPatternMemo(nullptr),
     internalErrorCode(U_ZERO_ERROR)
 {
     fp = new FormatParser();
@@ -380,6 +465,14 @@ DateTimePatternGenerator::operator=(const DateTimePatternGenerator& other) {
     internalErrorCode = other.internalErrorCode;
     pLocale = other.pLocale;
     fDefaultHourFormatChar = other.fDefaultHourFormatChar;
+    uprv_memcpy(fAllowedHourFormats, other.fAllowedHourFormats, sizeof(fAllowedHourFormats));
+    if (fBestPatternMemo != other.fBestPatternMemo) {
+        clearBestPatternMemo();
+        fBestPatternMemo = other.fBestPatternMemo;
+        if (fBestPatternMemo != nullptr) {
+            fBestPatternMemo->addRef();
+        }
+    }
     *fp = *(other.fp);
     dtMatcher->copyFrom(other.dtMatcher->skeleton);
     *distanceInfo = *(other.distanceInfo);
@@ -453,6 +546,7 @@ DateTimePatternGenerator::~DateTimePatternGenerator() {
     if (distanceInfo != nullptr) delete distanceInfo;
     if (patternMap != nullptr) delete patternMap;
     if (skipMatcher != nullptr) delete skipMatcher;
+    clearBestPatternMemo();
 }
 
 namespace {
@@ -1098,6 +1192,7 @@ DateTimePatternGenerator::initHashtable(UErrorCode& err) {
 
 void
 DateTimePatternGenerator::setAppendItemFormat(UDateTimePatternField field, const UnicodeString& value) {
+    clearBestPatternMemo();
     appendItemFormats[field] = value;
     // NUL-terminate for the C API.
     appendItemFormats[field].getTerminatedBuffer();
@@ -1120,6 +1215,7 @@ DateTimePatternGenerator::getAppendItemName(UDateTimePatternField field) const {
 
 void
 DateTimePatternGenerator::setFieldDisplayName(UDateTimePatternField field, UDateTimePGDisplayWidth width, const UnicodeString& value) {
+    clearBestPatternMemo();
     fieldDisplayNames[field][width] = value;
     // NUL-terminate for the C API.
     fieldDisplayNames[field][width].getTerminatedBuffer();
@@ -1156,6 +1252,31 @@ DateTimePatternGenerator::getBestPattern(const UnicodeString& patternForm, UDate
         status = internalErrorCode;
         return UnicodeString();
     }
+    UnicodeString memoKey((UChar)options);
+    memoKey.append(patternForm);
+    UnicodeString memoPattern;
+    if (fBestPatternMemo != nullptr && fBestPatternMemo->get(memoKey, memoPattern)) {
+        return memoPattern;
+    }
+    UnicodeString resultPattern = computeBestPattern(patternForm, options, status);
+    if (U_SUCCESS(status)) {
+        // The memo is an optimization: Ignore failures to start or add to it.
+        UErrorCode memoStatus = U_ZERO_ERROR;
+        if (fBestPatternMemo == nullptr) {
+            LocalPointer<DTBestPatternMemo> memo(new DTBestPatternMemo(memoStatus), memoStatus);
+            if (U_FAILURE(memoStatus)) {
+                return resultPattern;
+            }
+            fBestPatternMemo = memo.orphan();
+            fBestPatternMemo->addRef();
+        }
+        fBestPatternMemo->put(memoKey, resultPattern, memoStatus);
+    }
+    return resultPattern;
+}
+
+UnicodeString
+DateTimePatternGenerator::computeBestPattern(const UnicodeString& patternForm, UDateTimePatternMatchOptions options, UErrorCode& status) {
     const UnicodeString *bestPattern = nullptr;
     UnicodeString dtFormat;
     UnicodeString resultPattern;
@@ -1313,6 +1434,7 @@ DateTimePatternGenerator::replaceFieldTypes(const UnicodeString& pattern,
 
 void
 DateTimePatternGenerator::setDecimal(const UnicodeString& newDecimal) {
+    clearBestPatternMemo();
     this->decimal = newDecimal;
     // NUL-terminate for the C API.
     this->decimal.getTerminatedBuffer();
@@ -1338,6 +1460,7 @@ DateTimePatternGenerator::addCanonicalItems(UErrorCode& status) {
 
 void
 DateTimePatternGenerator::setDateTimeFormat(const UnicodeString& dtFormat) {
+    clearBestPatternMemo();
     dateTimeFormat = dtFormat;
     // NUL-terminate for the C API.
     dateTimeFormat.getTerminatedBuffer();
@@ -1437,6 +1560,7 @@ DateTimePatternGenerator::addPatternWithSkeleton(
         status = internalErrorCode;
         return UDATPG_NO_CONFLICT;
     }
+    clearBestPatternMemo();
 
     UnicodeString basePattern;
     PtnSkeleton   skeleton;
@@ -1903,6 +2027,16 @@ DateTimePatternGenerator::clone() const {
     return new DateTimePatternGenerator(*this);
 }
 
+// Called before each modification: The memo might be shared with other generators,
+// and its patterns would no longer be the best ones for this one.
+void
+DateTimePatternGenerator::clearBestPatternMemo() {
+    if (fBestPatternMemo != nullptr) {
+        fBestPatternMemo->removeRef();
+        fBestPatternMemo = nullptr;
+    }
+}
+
 PatternMap::PatternMap() {
    for (int32_t i=0; i < MAX_PATTERN_ENTRIES; ++i ) {
        boot[i] = nullptr;
@@ -14,10 +14,14 @@
 #ifndef __DTPTNGEN_IMPL_H__
 #define __DTPTNGEN_IMPL_H__
 
+#include <mutex>
+
 #include "unicode/udatpg.h"
 
 #include "unicode/strenum.h"
 #include "unicode/unistr.h"
+#include "hash.h"
+#include "sharedobject.h"
 #include "uvector.h"
 
 // TODO(claireho): Split off Builder class.
@@ -305,6 +309,38 @@ class DTRedundantEnumeration : public StringEnumeration {
     LocalPointer<UVector> fPatterns;
 };
 
+// Results of DateTimePatternGenerator::getBestPattern(), keyed by options and skeleton.
+// Shared by a generator and its clones until one of them is modified,
+// and by all of the generators created for the same locale,
+// possibly on different threads; get() and put() lock the memo.
+class DTBestPatternMemo : public SharedObject {
+public:
+    DTBestPatternMemo(UErrorCode &status);
+    virtual ~DTBestPatternMemo();
+    // Sets pattern and returns TRUE if the memo has the key.
+    UBool get(const UnicodeString &key, UnicodeString &pattern) const;
+    void put(const UnicodeString &key, const UnicodeString &pattern, UErrorCode &status);
+private:
+    // Bound on the number of patterns; the memo starts over when it is full.
+    static const int32_t MAX_PATTERNS = 256;
+    mutable std::mutex fMutex;
+    Hashtable fPatterns;
+};
+
+// A generator for one locale, stored in the UnifiedCache.
+// It is never modified: createInstance() returns clones of it.
+class SharedDateTimePatternGenerator : public SharedObject {
+public:
+    SharedDateTimePatternGenerator(DateTimePatternGenerator *dtpgToAdopt) : ptr(dtpgToAdopt) { }
+    virtual ~SharedDateTimePatternGenerator();
+    const DateTimePatternGenerator *operator->() const { return ptr; }
+    const DateTimePatternGenerator &operator*() const { return *ptr; }
+private:
+    DateTimePatternGenerator *ptr;
+    SharedDateTimePatternGenerator(const SharedDateTimePatternGenerator &);
+    SharedDateTimePatternGenerator &operator=(const SharedDateTimePatternGenerator &);
+};
+
 U_NAMESPACE_END
 
 #endif
@@ -43,8 +43,22 @@ FormattedStringBuilder::FormattedStringBuilder() {
 #endif
 }
 
+FormattedStringBuilder::FormattedStringBuilder(char16_t *chars, Field *fields, int32_t capacity) {
+    if (chars == nullptr || fields == nullptr || capacity <= DEFAULT_CAPACITY) {
+        // The inline arrays are at least as large.
+        return;
+    }
+    fUsingHeap = true;
+    fUsingArena = true;
+    fChars.heap.ptr = chars;
+    fChars.heap.capacity = capacity;
+    fFields.heap.ptr = fields;
+    fFields.heap.capacity = capacity;
+    fZero = capacity / 2;
+}
+
 FormattedStringBuilder::~FormattedStringBuilder() {
-    if (fUsingHeap) {
+    if (fUsingHeap && !fUsingArena) {
         uprv_free(fChars.heap.ptr);
         uprv_free(fFields.heap.ptr);
     }
@@ -62,9 +76,12 @@ FormattedStringBuilder &FormattedStringBuilder::operator=(const FormattedStringB
 
     // Continue with deallocation and copying
     if (fUsingHeap) {
-        uprv_free(fChars.heap.ptr);
-        uprv_free(fFields.heap.ptr);
+        if (!fUsingArena) {
+            uprv_free(fChars.heap.ptr);
+            uprv_free(fFields.heap.ptr);
+        }
         fUsingHeap = false;
+        fUsingArena = false;
     }
 
     int32_t capacity = other.getCapacity();
@@ -191,6 +208,18 @@ FormattedStringBuilder::insert(int32_t index, const UnicodeString &unistr, int32
     return count;
 }
 
+int32_t
+FormattedStringBuilder::insert(int32_t index, const char16_t *chars, const Field *fields, int32_t count,
+                               UErrorCode &status) {
+    int32_t position = prepareForInsert(index, count, status);
+    if (U_FAILURE(status)) {
+        return count;
+    }
+    uprv_memcpy2(getCharPtr() + position, chars, sizeof(char16_t) * count);
+    uprv_memcpy2(getFieldPtr() + position, fields, sizeof(Field) * count);
+    return count;
+}
+
 int32_t
 FormattedStringBuilder::splice(int32_t startThis, int32_t endThis,  const UnicodeString &unistr,
                             int32_t startOther, int32_t endOther, Field field, UErrorCode& status) {
@@ -301,11 +330,12 @@ int32_t FormattedStringBuilder::prepareForInsertHelper(int32_t index, int32_t co
                 oldFields + oldZero + index,
                 sizeof(Field) * (fLength - index));
 
-        if (fUsingHeap) {
+        if (fUsingHeap && !fUsingArena) {
             uprv_free(oldChars);
             uprv_free(oldFields);
         }
         fUsingHeap = true;
+        fUsingArena = false;
         fChars.heap.ptr = newChars;
         fChars.heap.capacity = newCapacity;
         fFields.heap.ptr = newFields;
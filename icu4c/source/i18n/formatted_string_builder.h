@@ -71,6 +71,13 @@ class U_I18N_API FormattedStringBuilder : public UMemory {
         inline bool operator!=(const Field& other) const;
     };
 
+    /**
+     * Uses the caller's arrays as the initial storage ("arena"), so that strings of up to
+     * capacity code units need no heap memory. The arrays must outlive the builder. Longer
+     * strings move to the heap as usual, and so does the copy made by the assignment operator.
+     */
+    FormattedStringBuilder(char16_t *chars, Field *fields, int32_t capacity);
+
     FormattedStringBuilder &operator=(const FormattedStringBuilder &other);
 
     int32_t length() const;
@@ -135,6 +142,10 @@ class U_I18N_API FormattedStringBuilder : public UMemory {
     int32_t insert(int32_t index, const UnicodeString &unistr, int32_t start, int32_t end, Field field,
                    UErrorCode &status);
 
+    /** Inserts code units, each with its own field. Note: insert at index 0 is very efficient. */
+    int32_t insert(int32_t index, const char16_t *chars, const Field *fields, int32_t count,
+                   UErrorCode &status);
+
     /** Deletes a substring and then inserts a string at that same position.
      * Similar to JavaScript Array.prototype.splice().
      *
@@ -184,6 +195,8 @@ class U_I18N_API FormattedStringBuilder : public UMemory {
 
   private:
     bool fUsingHeap = false;
+    // If true, then the "heap" arrays belong to the caller and are not freed.
+    bool fUsingArena = false;
     ValueOrHeapArray<char16_t> fChars;
     ValueOrHeapArray<Field> fFields;
     int32_t fZero = DEFAULT_CAPACITY / 2;
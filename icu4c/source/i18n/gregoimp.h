@@ -16,6 +16,7 @@
 #include "unicode/utypes.h"
 #if !UCONFIG_NO_FORMATTING
 
+#include "unicode/ucal.h"
 #include "unicode/ures.h"
 #include "unicode/locid.h"
 #include "putilimp.h"
@@ -264,6 +265,58 @@ class Grego {
     static const int8_t MONTH_LENGTH[24];
 };
 
+/**
+ * The proleptic Gregorian date and time of day of a local time, for code that
+ * needs the civil fields of many timestamps but not a Calendar object.
+ * The constructor computes the year, month, day of month and time of day
+ * with integer arithmetic; the day of week and day of year are derived
+ * only when asked for. Week fields depend on Calendar settings and are not
+ * provided.
+ * @internal
+ */
+class GregorianLocalTime : public UMemory {
+ public:
+    /**
+     * @param localMillis 1970-epoch milliseconds of the local time
+     *        (UTC plus the zone offset), from MIN_MILLIS to MAX_MILLIS
+     */
+    inline explicit GregorianLocalTime(double localMillis);
+
+    /** @return the year, with 0 == 1 BCE, -1 == 2 BCE, etc. */
+    int32_t getExtendedYear() const { return fYear; }
+
+    /** @return the 0-based month, with 0==Jan */
+    int32_t getMonth() const { return fMonth; }
+
+    /** @return the 1-based day of month */
+    int32_t getDayOfMonth() const { return fDayOfMonth; }
+
+    /** @return the 1-based day of year */
+    inline int32_t getDayOfYear() const;
+
+    /** @return the 1-based day of week, with 1==Sun */
+    int32_t getDayOfWeek() const {
+        // 1970-01-01 was a Thursday.
+        int32_t dow = (fDay + 4) % 7;
+        return (dow < 0 ? dow + 7 : dow) + UCAL_SUNDAY;
+    }
+
+    /** @return milliseconds since local midnight */
+    int32_t getMillisInDay() const { return fMillisInDay; }
+
+    int32_t getHourOfDay() const { return fMillisInDay / U_MILLIS_PER_HOUR; }
+    int32_t getMinute() const { return (fMillisInDay / U_MILLIS_PER_MINUTE) % 60; }
+    int32_t getSecond() const { return (fMillisInDay / U_MILLIS_PER_SECOND) % 60; }
+    int32_t getMillisecond() const { return fMillisInDay % U_MILLIS_PER_SECOND; }
+
+ private:
+    int32_t fDay;  // 1970-epoch day
+    int32_t fYear;
+    int32_t fMonth;
+    int32_t fDayOfMonth;
+    int32_t fMillisInDay;
+};
+
 inline double ClockMath::floorDivide(double numerator, double denominator) {
     return uprv_floor(numerator / denominator);
 }
@@ -289,6 +342,38 @@ inline void Grego::dayToFields(double day, int32_t& year, int32_t& month,
   dayToFields(day,year,month,dom,dow,doy_unused);
 }
 
+inline GregorianLocalTime::GregorianLocalTime(double localMillis) {
+    double day = uprv_floor(localMillis / kOneDay);
+    fDay = (int32_t)day;
+    fMillisInDay = (int32_t)(localMillis - day * kOneDay);
+    // Count days from 0000-03-01 in 400-year cycles of years that start in March,
+    // so that the leap day is the last day of a year. In the cycle,
+    // a year has 365 days plus one every 4 years, except every 100 years
+    // but including the last day of the cycle.
+    int64_t days = (int64_t)fDay + 719468;  // 1970-01-01 - 0000-03-01
+    int64_t cycle = (days >= 0 ? days : days - 146096) / 146097;
+    int32_t dayOfCycle = (int32_t)(days - cycle * 146097);  // [0, 146096]
+    int32_t yearOfCycle =
+        (dayOfCycle - dayOfCycle / 1460 + dayOfCycle / 36524 - dayOfCycle / 146096) / 365;  // [0, 399]
+    int32_t dayFromMarch = dayOfCycle - (365 * yearOfCycle + yearOfCycle / 4 - yearOfCycle / 100);
+    // Months from March have 31, 30, 31, 30, 31 days, repeating,
+    // so that (153 * m + 2) / 5 is the number of days before month m.
+    int32_t monthFromMarch = (5 * dayFromMarch + 2) / 153;  // [0, 11]
+    fDayOfMonth = dayFromMarch - (153 * monthFromMarch + 2) / 5 + 1;
+    fMonth = monthFromMarch < 10 ? monthFromMarch + 2 : monthFromMarch - 10;
+    fYear = (int32_t)(cycle * 400) + yearOfCycle + (fMonth < 2 ? 1 : 0);
+}
+
+inline int32_t GregorianLocalTime::getDayOfYear() const {
+    // Days before the month from March 1, as in the constructor.
+    int32_t monthFromMarch = fMonth >= 2 ? fMonth - 2 : fMonth + 10;
+    int32_t dayFromMarch = (153 * monthFromMarch + 2) / 5 + fDayOfMonth;
+    if (monthFromMarch >= 10) {
+        return dayFromMarch - 306;  // January and February: 306 days from March 1
+    }
+    return dayFromMarch + 59 + (Grego::isLeapYear(fYear) ? 1 : 0);
+}
+
 inline double Grego::julianDayToMillis(int32_t julian)
 {
   return (julian - kEpochStartAsJulianDay) * kOneDay;
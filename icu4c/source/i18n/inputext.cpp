@@ -31,6 +31,8 @@ InputText::InputText(UErrorCode &status)
       fByteStats(NEW_ARRAY(int16_t, 256)),       // byte frequency statistics for the input text.
                                                  //   Value is percent, not absolute.
       fDeclaredEncoding(0),
+      fNGramConfidences(0),
+      fNGramsScored(FALSE),
       fRawInput(0),
       fRawLength(0)
 {
@@ -42,6 +44,7 @@ InputText::InputText(UErrorCode &status)
 InputText::~InputText()
 {
     DELETE_ARRAY(fDeclaredEncoding);
+    DELETE_ARRAY(fNGramConfidences);
     DELETE_ARRAY(fByteStats);
     DELETE_ARRAY(fInputBytes);
 }
@@ -87,6 +90,8 @@ void InputText::MungeInput(UBool fStripTags) {
     int32_t openTags = 0;
     int32_t badTags  = 0;
 
+    fNGramsScored = FALSE;
+
     //
     //  html / xml markup stripping.
     //     quick and dirty, not 100% accurate, but hopefully good enough, statistically.
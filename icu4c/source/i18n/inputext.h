@@ -49,6 +49,12 @@ class InputText : public UMemory
     UBool     fC1Bytes;          // True if any bytes in the range 0x80 - 0x9F are in the input;false by default
     char     *fDeclaredEncoding;
 
+    // Confidences of the single-byte charset n-gram tables.
+    //   The first single-byte recognizer scores all of the tables at once;
+    //   see csrsbcs.cpp. fNGramsScored is reset when the input changes.
+    int32_t  *fNGramConfidences;
+    UBool     fNGramsScored;
+
     const uint8_t           *fRawInput;     // Original, untouched input bytes.
     //  If user gave us a byte array, this is it.
     //  If user gave us a stream, it's read to a 
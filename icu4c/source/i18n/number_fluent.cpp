@@ -7,6 +7,7 @@
 
 #include "uassert.h"
 #include "unicode/numberformatter.h"
+#include "unicode/ustring.h"
 #include "number_decimalquantity.h"
 #include "number_formatimpl.h"
 #include "umutex.h"
@@ -16,6 +17,8 @@
 #include "number_mapper.h"
 #include "util.h"
 #include "fphdlimp.h"
+#include "sharedobject.h"
+#include "ustr_imp.h"
 
 using namespace icu;
 using namespace icu::number;
@@ -630,8 +633,10 @@ FormattedNumber LocalizedNumberFormatter::formatInt(int64_t value, UErrorCode& s
         status = U_MEMORY_ALLOCATION_ERROR;
         return FormattedNumber(status);
     }
-    results->quantity.setToLong(value);
-    formatImpl(results, status);
+    formatIntImpl(value, results->quantity, results->getStringRef(), status);
+    if (U_SUCCESS(status)) {
+        results->getStringRef().writeTerminator(status);
+    }
 
     // Do not save the results object if we encountered a failure.
     if (U_SUCCESS(status)) {
@@ -649,8 +654,10 @@ FormattedNumber LocalizedNumberFormatter::formatDouble(double value, UErrorCode&
         status = U_MEMORY_ALLOCATION_ERROR;
         return FormattedNumber(status);
     }
-    results->quantity.setToDouble(value);
-    formatImpl(results, status);
+    formatDoubleImpl(value, results->quantity, results->getStringRef(), status);
+    if (U_SUCCESS(status)) {
+        results->getStringRef().writeTerminator(status);
+    }
 
     // Do not save the results object if we encountered a failure.
     if (U_SUCCESS(status)) {
@@ -701,15 +708,233 @@ LocalizedNumberFormatter::formatDecimalQuantity(const DecimalQuantity& dq, UErro
 }
 
 void LocalizedNumberFormatter::formatImpl(impl::UFormattedNumberData* results, UErrorCode& status) const {
+    formatImpl(results->quantity, results->getStringRef(), status);
+    if (U_FAILURE(status)) {
+        return;
+    }
+    results->getStringRef().writeTerminator(status);
+}
+
+void LocalizedNumberFormatter::formatImpl(DecimalQuantity& quantity, FormattedStringBuilder& string,
+                                          UErrorCode& status) const {
     if (computeCompiled(status)) {
-        fCompiled->format(results->quantity, results->getStringRef(), status);
+        fCompiled->format(quantity, string, status);
     } else {
-        NumberFormatterImpl::formatStatic(fMacros, results->quantity, results->getStringRef(), status);
+        NumberFormatterImpl::formatStatic(fMacros, quantity, string, status);
     }
-    if (U_FAILURE(status)) {
+}
+
+void LocalizedNumberFormatter::formatIntImpl(int64_t value, DecimalQuantity& quantity,
+                                             FormattedStringBuilder& string, UErrorCode& status) const {
+    // Once the formatter is compiled, integers might not need the whole pipeline.
+    if (getCallCount() < 0 && fCompiled->formatFastInt64(value, quantity, string, status)) {
         return;
     }
-    results->getStringRef().writeTerminator(status);
+    quantity.setToLong(value);
+    formatImpl(quantity, string, status);
+}
+
+void LocalizedNumberFormatter::formatDoubleImpl(double value, DecimalQuantity& quantity,
+                                                FormattedStringBuilder& string, UErrorCode& status) const {
+    if (getCallCount() < 0 && fCompiled->formatFastDouble(value, quantity, string, status)) {
+        return;
+    }
+    quantity.setToDouble(value);
+    formatImpl(quantity, string, status);
+}
+
+namespace {
+
+// A FormattedStringBuilder with a stack arena, for formatting into a caller buffer.
+// Strings that fit into the arena are built without heap memory.
+struct ArenaStringBuilder {
+    static constexpr int32_t kCapacity = 256;
+    char16_t chars[kCapacity];
+    FormattedStringBuilder::Field fields[kCapacity];
+    FormattedStringBuilder string {chars, fields, kCapacity};
+};
+
+bool isValidDest(const void* dest, int32_t capacity, UErrorCode& status) {
+    if (U_FAILURE(status)) {
+        return false;
+    }
+    if (capacity < 0 || (dest == nullptr && capacity > 0)) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return false;
+    }
+    return true;
+}
+
+int32_t copyToUTF16(const FormattedStringBuilder& string, char16_t* dest, int32_t capacity,
+                    UErrorCode& status) {
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    int32_t length = string.length();
+    if (0 < length && length <= capacity) {
+        u_memcpy(dest, string.chars(), length);
+    }
+    return u_terminateUChars(dest, capacity, length, &status);
+}
+
+int32_t copyToUTF8(const FormattedStringBuilder& string, char* dest, int32_t capacity,
+                   UErrorCode& status) {
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    int32_t length = 0;
+    u_strToUTF8(dest, capacity, &length, string.chars(), string.length(), &status);
+    return length;
+}
+
+}  // namespace
+
+int32_t LocalizedNumberFormatter::formatInt(int64_t value, char16_t* dest, int32_t capacity,
+                                            UErrorCode& status) const {
+    if (!isValidDest(dest, capacity, status)) { return 0; }
+    ArenaStringBuilder builder;
+    DecimalQuantity quantity;
+    formatIntImpl(value, quantity, builder.string, status);
+    return copyToUTF16(builder.string, dest, capacity, status);
+}
+
+int32_t LocalizedNumberFormatter::formatDouble(double value, char16_t* dest, int32_t capacity,
+                                               UErrorCode& status) const {
+    if (!isValidDest(dest, capacity, status)) { return 0; }
+    ArenaStringBuilder builder;
+    DecimalQuantity quantity;
+    formatDoubleImpl(value, quantity, builder.string, status);
+    return copyToUTF16(builder.string, dest, capacity, status);
+}
+
+int32_t LocalizedNumberFormatter::formatIntToUTF8(int64_t value, char* dest, int32_t capacity,
+                                                  UErrorCode& status) const {
+    if (!isValidDest(dest, capacity, status)) { return 0; }
+    ArenaStringBuilder builder;
+    DecimalQuantity quantity;
+    formatIntImpl(value, quantity, builder.string, status);
+    return copyToUTF8(builder.string, dest, capacity, status);
+}
+
+int32_t LocalizedNumberFormatter::formatDoubleToUTF8(double value, char* dest, int32_t capacity,
+                                                     UErrorCode& status) const {
+    if (!isValidDest(dest, capacity, status)) { return 0; }
+    ArenaStringBuilder builder;
+    DecimalQuantity quantity;
+    formatDoubleImpl(value, quantity, builder.string, status);
+    return copyToUTF8(builder.string, dest, capacity, status);
+}
+
+namespace {
+
+int32_t appendToColumn(const FormattedStringBuilder& string, char16_t* dest, int32_t start,
+                       int32_t capacity, UErrorCode&) {
+    int32_t length = string.length();
+    if (0 < length && length <= capacity - start) {
+        u_memcpy(dest + start, string.chars(), length);
+    }
+    return length;
+}
+
+int32_t appendToColumn(const FormattedStringBuilder& string, char* dest, int32_t start,
+                       int32_t capacity, UErrorCode& status) {
+    int32_t length = 0;
+    if (start < capacity) {
+        u_strToUTF8(dest + start, capacity - start, &length, string.chars(), string.length(), &status);
+    } else {
+        u_strToUTF8(nullptr, 0, &length, string.chars(), string.length(), &status);
+    }
+    return length;
+}
+
+int32_t terminateColumn(char16_t* dest, int32_t capacity, int32_t length, UErrorCode& status) {
+    return u_terminateUChars(dest, capacity, length, &status);
+}
+
+int32_t terminateColumn(char* dest, int32_t capacity, int32_t length, UErrorCode& status) {
+    return u_terminateChars(dest, capacity, length, &status);
+}
+
+// Appends the formatted strings for a column of values one after another.
+// The string builder and the DecimalQuantity are reused for all values, and with a compiled
+// formatter each value takes the fast path with the modifiers resolved per sign and plural form.
+// Keeps counting after the destination is full, so that the caller can preflight.
+template<typename Value, typename Unit, typename FormatOne>
+int32_t formatColumn(const Value* values, int32_t count, Unit* dest, int32_t capacity, int32_t* offsets,
+                     FormatOne formatOne, UErrorCode& status) {
+    if (!isValidDest(dest, capacity, status)) { return 0; }
+    if (count < 0 || (values == nullptr && count > 0)) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    ArenaStringBuilder builder;
+    DecimalQuantity quantity;
+    int32_t total = 0;
+    for (int32_t i = 0; i < count; i++) {
+        if (offsets != nullptr) {
+            offsets[i] = total;
+        }
+        builder.string.clear();
+        quantity.clear();
+        formatOne(values[i], quantity, builder.string, status);
+        if (U_FAILURE(status)) {
+            return 0;
+        }
+        // Overflow of this one value is recorded through the total below.
+        UErrorCode localStatus = U_ZERO_ERROR;
+        int32_t length = appendToColumn(builder.string, dest, total, capacity, localStatus);
+        if (U_FAILURE(localStatus) && localStatus != U_BUFFER_OVERFLOW_ERROR) {
+            status = localStatus;
+            return 0;
+        }
+        if (length > INT32_MAX - total) {
+            status = U_INDEX_OUTOFBOUNDS_ERROR;
+            return 0;
+        }
+        total += length;
+    }
+    if (offsets != nullptr) {
+        offsets[count] = total;
+    }
+    return terminateColumn(dest, capacity, total, status);
+}
+
+}  // namespace
+
+int32_t LocalizedNumberFormatter::formatInts(const int64_t* values, int32_t count, char16_t* dest,
+                                             int32_t capacity, int32_t* offsets,
+                                             UErrorCode& status) const {
+    return formatColumn(values, count, dest, capacity, offsets,
+        [this](int64_t value, DecimalQuantity& quantity, FormattedStringBuilder& string, UErrorCode& errorCode) {
+            formatIntImpl(value, quantity, string, errorCode);
+        }, status);
+}
+
+int32_t LocalizedNumberFormatter::formatDoubles(const double* values, int32_t count, char16_t* dest,
+                                                int32_t capacity, int32_t* offsets,
+                                                UErrorCode& status) const {
+    return formatColumn(values, count, dest, capacity, offsets,
+        [this](double value, DecimalQuantity& quantity, FormattedStringBuilder& string, UErrorCode& errorCode) {
+            formatDoubleImpl(value, quantity, string, errorCode);
+        }, status);
+}
+
+int32_t LocalizedNumberFormatter::formatIntsToUTF8(const int64_t* values, int32_t count, char* dest,
+                                                   int32_t capacity, int32_t* offsets,
+                                                   UErrorCode& status) const {
+    return formatColumn(values, count, dest, capacity, offsets,
+        [this](int64_t value, DecimalQuantity& quantity, FormattedStringBuilder& string, UErrorCode& errorCode) {
+            formatIntImpl(value, quantity, string, errorCode);
+        }, status);
+}
+
+int32_t LocalizedNumberFormatter::formatDoublesToUTF8(const double* values, int32_t count, char* dest,
+                                                      int32_t capacity, int32_t* offsets,
+                                                      UErrorCode& status) const {
+    return formatColumn(values, count, dest, capacity, offsets,
+        [this](double value, DecimalQuantity& quantity, FormattedStringBuilder& string, UErrorCode& errorCode) {
+            formatDoubleImpl(value, quantity, string, errorCode);
+        }, status);
 }
 
 void LocalizedNumberFormatter::getAffixImpl(bool isPrefix, bool isNegative, UnicodeString& result,
@@ -786,6 +1011,193 @@ int32_t LocalizedNumberFormatter::getCallCount() const {
 
 // Note: toFormat defined in number_asformat.cpp
 
+U_NAMESPACE_BEGIN
+namespace number {
+namespace impl {
+
+CompiledNumberFormatterData::~CompiledNumberFormatterData() = default;
+
+}  // namespace impl
+}  // namespace number
+U_NAMESPACE_END
+
+CompiledNumberFormatter LocalizedNumberFormatter::compile(UErrorCode& status) const {
+    if (U_FAILURE(status)) { return {}; }
+    if (fMacros.copyErrorTo(status)) { return {}; }
+    LocalPointer<CompiledNumberFormatterData> data(new CompiledNumberFormatterData(*this, fMacros.locale), status);
+    if (U_FAILURE(status)) { return {}; }
+    // With a threshold of 1, the first call builds the NumberFormatterImpl.
+    if (!data->formatter.computeCompiled(status) || U_FAILURE(status)) {
+        if (U_SUCCESS(status)) {
+            status = U_INTERNAL_PROGRAM_ERROR;
+        }
+        return {};
+    }
+    return CompiledNumberFormatter(data.orphan());
+}
+
+// Note: CompiledNumberFormatter::forSkeleton defined in number_skeletons.cpp
+
+CompiledNumberFormatter::CompiledNumberFormatter(const CompiledNumberFormatterData* data) : fData(data) {
+    fData->addRef();
+}
+
+CompiledNumberFormatter::CompiledNumberFormatter(const CompiledNumberFormatter& other) : fData(other.fData) {
+    if (fData != nullptr) {
+        fData->addRef();
+    }
+}
+
+CompiledNumberFormatter::CompiledNumberFormatter(CompiledNumberFormatter&& src) U_NOEXCEPT
+        : fData(src.fData) {
+    src.fData = nullptr;
+}
+
+CompiledNumberFormatter& CompiledNumberFormatter::operator=(const CompiledNumberFormatter& other) {
+    SharedObject::copyPtr(other.fData, fData);
+    return *this;
+}
+
+CompiledNumberFormatter& CompiledNumberFormatter::operator=(CompiledNumberFormatter&& src) U_NOEXCEPT {
+    if (this != &src) {
+        SharedObject::clearPtr(fData);
+        fData = src.fData;
+        src.fData = nullptr;
+    }
+    return *this;
+}
+
+CompiledNumberFormatter::~CompiledNumberFormatter() {
+    SharedObject::clearPtr(fData);
+}
+
+FormattedNumber CompiledNumberFormatter::formatInt(int64_t value, UErrorCode& status) const {
+    if (fData == nullptr) {
+        if (U_SUCCESS(status)) {
+            status = U_INVALID_STATE_ERROR;
+        }
+        return {};
+    }
+    return fData->formatter.formatInt(value, status);
+}
+
+FormattedNumber CompiledNumberFormatter::formatDouble(double value, UErrorCode& status) const {
+    if (fData == nullptr) {
+        if (U_SUCCESS(status)) {
+            status = U_INVALID_STATE_ERROR;
+        }
+        return {};
+    }
+    return fData->formatter.formatDouble(value, status);
+}
+
+FormattedNumber CompiledNumberFormatter::formatDecimal(StringPiece value, UErrorCode& status) const {
+    if (fData == nullptr) {
+        if (U_SUCCESS(status)) {
+            status = U_INVALID_STATE_ERROR;
+        }
+        return {};
+    }
+    return fData->formatter.formatDecimal(value, status);
+}
+
+int32_t CompiledNumberFormatter::formatInt(int64_t value, char16_t* dest, int32_t capacity,
+                                           UErrorCode& status) const {
+    if (fData == nullptr) {
+        if (U_SUCCESS(status)) {
+            status = U_INVALID_STATE_ERROR;
+        }
+        return 0;
+    }
+    return fData->formatter.formatInt(value, dest, capacity, status);
+}
+
+int32_t CompiledNumberFormatter::formatDouble(double value, char16_t* dest, int32_t capacity,
+                                              UErrorCode& status) const {
+    if (fData == nullptr) {
+        if (U_SUCCESS(status)) {
+            status = U_INVALID_STATE_ERROR;
+        }
+        return 0;
+    }
+    return fData->formatter.formatDouble(value, dest, capacity, status);
+}
+
+int32_t CompiledNumberFormatter::formatIntToUTF8(int64_t value, char* dest, int32_t capacity,
+                                                 UErrorCode& status) const {
+    if (fData == nullptr) {
+        if (U_SUCCESS(status)) {
+            status = U_INVALID_STATE_ERROR;
+        }
+        return 0;
+    }
+    return fData->formatter.formatIntToUTF8(value, dest, capacity, status);
+}
+
+int32_t CompiledNumberFormatter::formatDoubleToUTF8(double value, char* dest, int32_t capacity,
+                                                    UErrorCode& status) const {
+    if (fData == nullptr) {
+        if (U_SUCCESS(status)) {
+            status = U_INVALID_STATE_ERROR;
+        }
+        return 0;
+    }
+    return fData->formatter.formatDoubleToUTF8(value, dest, capacity, status);
+}
+
+int32_t CompiledNumberFormatter::formatInts(const int64_t* values, int32_t count, char16_t* dest,
+                                            int32_t capacity, int32_t* offsets, UErrorCode& status) const {
+    if (fData == nullptr) {
+        if (U_SUCCESS(status)) {
+            status = U_INVALID_STATE_ERROR;
+        }
+        return 0;
+    }
+    return fData->formatter.formatInts(values, count, dest, capacity, offsets, status);
+}
+
+int32_t CompiledNumberFormatter::formatDoubles(const double* values, int32_t count, char16_t* dest,
+                                               int32_t capacity, int32_t* offsets, UErrorCode& status) const {
+    if (fData == nullptr) {
+        if (U_SUCCESS(status)) {
+            status = U_INVALID_STATE_ERROR;
+        }
+        return 0;
+    }
+    return fData->formatter.formatDoubles(values, count, dest, capacity, offsets, status);
+}
+
+int32_t CompiledNumberFormatter::formatIntsToUTF8(const int64_t* values, int32_t count, char* dest,
+                                                  int32_t capacity, int32_t* offsets, UErrorCode& status) const {
+    if (fData == nullptr) {
+        if (U_SUCCESS(status)) {
+            status = U_INVALID_STATE_ERROR;
+        }
+        return 0;
+    }
+    return fData->formatter.formatIntsToUTF8(values, count, dest, capacity, offsets, status);
+}
+
+int32_t CompiledNumberFormatter::formatDoublesToUTF8(const double* values, int32_t count, char* dest,
+                                                     int32_t capacity, int32_t* offsets, UErrorCode& status) const {
+    if (fData == nullptr) {
+        if (U_SUCCESS(status)) {
+            status = U_INVALID_STATE_ERROR;
+        }
+        return 0;
+    }
+    return fData->formatter.formatDoublesToUTF8(values, count, dest, capacity, offsets, status);
+}
+
+// Note: CompiledNumberFormatter::toSkeleton defined in number_skeletons.cpp
+
+const Locale& CompiledNumberFormatter::getLocale() const {
+    if (fData == nullptr) {
+        return Locale::getRoot();
+    }
+    return fData->locale;
+}
+
 #if (U_PF_WINDOWS <= U_PLATFORM && U_PLATFORM <= U_PF_CYGWIN) && defined(_MSC_VER)
 // Warning 4661.
 #pragma warning(pop)
@@ -5,7 +5,10 @@
 
 #if !UCONFIG_NO_FORMATTING
 
+#include <cmath>
+
 #include "cstring.h"
+#include "putilimp.h"
 #include "unicode/ures.h"
 #include "uresimp.h"
 #include "charstr.h"
@@ -112,6 +115,220 @@ int32_t NumberFormatterImpl::getPrefixSuffixUnsafe(Signum signum, StandardPlural
 
 NumberFormatterImpl::NumberFormatterImpl(const MacroProps& macros, bool safe, UErrorCode& status) {
     fMicroPropsGenerator = macrosToMicroGenerator(macros, safe, status);
+    if (safe && U_SUCCESS(status)) {
+        setupFastFormat(macros);
+    }
+}
+
+//////////
+
+// The fast path writes the whole number into a stack buffer, then into the output in one go.
+// setupFastFormat() limits the settings so that any int64 or double on the fast path fits.
+static constexpr int32_t kFastBufferCapacity = 128;
+static constexpr int32_t kFastMaxDigits = 20;
+// 10^18 is the largest power of ten in an int64_t.
+static constexpr int32_t kFastMaxTruncatedDigits = 18;
+static constexpr int32_t kFastMaxSeparatorLength = 4;
+
+// A double with at most this many fraction digits may be formatted on the fast path.
+// More would restrict the fast path to small magnitudes; see formatFastDouble().
+static constexpr int32_t kFastMaxDoubleFrac = 6;
+
+static const double kPowersOfTen[kFastMaxDoubleFrac + 1] = {1, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6};
+
+void NumberFormatterImpl::setupFastFormat(const MacroProps& macros) {
+    fFastData.enabled = false;
+    if (macros.notation.fType != Notation::NTN_SIMPLE || macros.scale.isValid() ||
+            fMicros.padding.isValid() || fScientificHandler.isValid() || fCompactHandler.isValid() ||
+            fLongNameHandler.isValid() || fPatternModifier->needsPlurals() ||
+            fImmutablePatternModifier.isNull()) {
+        return;
+    }
+
+    // Integer width: a minimum, and a maximum that truncates, as for date fields.
+    const IntegerWidth& integerWidth = fMicros.integerWidth;
+    int32_t maxInt = integerWidth.fUnion.minMaxInt.fMaxInt;
+    if (integerWidth.fHasError ||
+            integerWidth.fUnion.minMaxInt.fMinInt < 0 ||
+            integerWidth.fUnion.minMaxInt.fMinInt > kFastMaxDigits ||
+            (maxInt != -1 && (maxInt < 1 || maxInt > kFastMaxTruncatedDigits ||
+                              integerWidth.fUnion.minMaxInt.fFormatFailIfMoreThanMaxDigits))) {
+        return;
+    }
+
+    // Precision: a range of fraction digits, or unlimited.
+    const Precision& precision = fMicros.rounder.getPrecision();
+    int32_t minFrac;
+    int32_t maxFrac;
+    if (precision.fType == Precision::RND_FRACTION) {
+        minFrac = precision.fUnion.fracSig.fMinFrac;
+        maxFrac = precision.fUnion.fracSig.fMaxFrac;
+    } else if (precision.fType == Precision::RND_NONE) {
+        minFrac = 0;
+        maxFrac = -1;
+    } else {
+        return;
+    }
+    if (minFrac < 0 || minFrac > kFastMaxDoubleFrac) {
+        return;
+    }
+
+    // Symbols: contiguous BMP digits, and short separators.
+    UChar32 zero = fMicros.symbols->getCodePointZero();
+    const UnicodeString& groupingSeparator = fMicros.symbols->getConstSymbol(
+        fMicros.useCurrency ? DecimalFormatSymbols::kMonetaryGroupingSeparatorSymbol
+                            : DecimalFormatSymbols::kGroupingSeparatorSymbol);
+    const UnicodeString& decimalSeparator = fMicros.symbols->getConstSymbol(
+        fMicros.useCurrency ? DecimalFormatSymbols::kMonetarySeparatorSymbol
+                            : DecimalFormatSymbols::kDecimalSeparatorSymbol);
+    if (zero < 0 || U16_LENGTH(zero) != 1 ||
+            groupingSeparator.length() > kFastMaxSeparatorLength ||
+            decimalSeparator.length() > kFastMaxSeparatorLength) {
+        return;
+    }
+
+    // Grouping, as in Grouper::groupAtPosition().
+    const Grouper& grouping = fMicros.grouping;
+    if (grouping.fGrouping1 > 0 && grouping.fGrouping2 <= 0) {
+        return;
+    }
+
+    fFastData.enabled = true;
+    fFastData.alwaysShowDecimal = fMicros.decimal == UNUM_DECIMAL_SEPARATOR_ALWAYS;
+    fFastData.minInt = static_cast<int8_t>(integerWidth.fUnion.minMaxInt.fMinInt);
+    fFastData.maxInt = static_cast<int8_t>(maxInt);
+    fFastData.minFrac = static_cast<int8_t>(minFrac);
+    fFastData.doubleFrac = static_cast<int8_t>(
+        (maxFrac < 0 || maxFrac > kFastMaxDoubleFrac) ? kFastMaxDoubleFrac : maxFrac);
+    fFastData.zero = static_cast<char16_t>(zero);
+    fFastData.grouping1 = grouping.fGrouping1;
+    fFastData.grouping2 = grouping.fGrouping2;
+    fFastData.minGrouping = grouping.fMinGrouping;
+    fFastData.groupingSeparator = &groupingSeparator;
+    fFastData.decimalSeparator = &decimalSeparator;
+}
+
+bool NumberFormatterImpl::formatFastInt64(int64_t value, DecimalQuantity& quantity,
+                                          FormattedStringBuilder& outString, UErrorCode& status) const {
+    if (!fFastData.enabled) {
+        return false;
+    }
+    if (fFastData.maxInt >= 0) {
+        // Keep the low digits, as IntegerWidth::apply() does.
+        if (value < 0) {
+            return false;
+        }
+        int64_t limit = 1;
+        for (int32_t i = 0; i < fFastData.maxInt; i++) {
+            limit *= 10;
+        }
+        value %= limit;
+    }
+    // The quantity is still needed by FormattedNumber, for example for plural selection.
+    quantity.setToLong(value);
+    quantity.setMinFraction(fFastData.minFrac);
+    quantity.setMinInteger(fFastData.minInt);
+    if (value < 0) {
+        writeFast(0 - static_cast<uint64_t>(value), 0, SIGNUM_NEG, outString, status);
+    } else {
+        writeFast(static_cast<uint64_t>(value), 0, value == 0 ? SIGNUM_POS_ZERO : SIGNUM_POS, outString, status);
+    }
+    return true;
+}
+
+bool NumberFormatterImpl::formatFastDouble(double value, DecimalQuantity& quantity,
+                                           FormattedStringBuilder& outString, UErrorCode& status) const {
+    if (!fFastData.enabled || fFastData.maxInt >= 0) {
+        return false;
+    }
+    // Find the integer n such that n * 10^-f is the value. Then that is also the value's shortest
+    // decimal representation, and rounding does not change it: below 2^52, a double's neighbors
+    // are less than 10^-f apart, so no other multiple of 10^-f rounds to the same double.
+    int32_t fractionCount = fFastData.doubleFrac;
+    double scaled = value * kPowersOfTen[fractionCount];
+    if (!(uprv_fabs(scaled) < 4503599627370496.0)) {  // 2^52; also excludes NaN and infinity
+        return false;
+    }
+    int64_t digits = static_cast<int64_t>(uprv_round(scaled));
+    if (static_cast<double>(digits) / kPowersOfTen[fractionCount] != value ||
+            (digits == 0 && std::signbit(value))) {
+        return false;
+    }
+    quantity.setToLong(digits);
+    quantity.adjustMagnitude(-fractionCount);
+    quantity.setMinFraction(fFastData.minFrac);
+    quantity.setMinInteger(fFastData.minInt);
+    if (digits < 0) {
+        writeFast(static_cast<uint64_t>(-digits), fractionCount, SIGNUM_NEG, outString, status);
+    } else {
+        writeFast(static_cast<uint64_t>(digits), fractionCount,
+                  digits == 0 ? SIGNUM_POS_ZERO : SIGNUM_POS, outString, status);
+    }
+    return true;
+}
+
+int32_t NumberFormatterImpl::writeFast(uint64_t value, int32_t fractionCount, Signum signum,
+                                       FormattedStringBuilder& string, UErrorCode& status) const {
+    static constexpr Field kIntegerField = {UFIELD_CATEGORY_NUMBER, UNUM_INTEGER_FIELD};
+    static constexpr Field kFractionField = {UFIELD_CATEGORY_NUMBER, UNUM_FRACTION_FIELD};
+    char16_t chars[kFastBufferCapacity];
+    Field fields[kFastBufferCapacity];
+    int32_t start = kFastBufferCapacity;
+
+    // Fraction digits, down to or padded up to the minimum, written from the end.
+    while (fractionCount > fFastData.minFrac && value % 10 == 0) {
+        value /= 10;
+        fractionCount--;
+    }
+    for (int32_t i = fractionCount; i < fFastData.minFrac; i++) {
+        chars[--start] = fFastData.zero;
+        fields[start] = kFractionField;
+    }
+    for (int32_t i = 0; i < fractionCount; i++) {
+        chars[--start] = static_cast<char16_t>(fFastData.zero + value % 10);
+        fields[start] = kFractionField;
+        value /= 10;
+    }
+    if (start < kFastBufferCapacity || fFastData.alwaysShowDecimal) {
+        const UnicodeString& separator = *fFastData.decimalSeparator;
+        for (int32_t i = separator.length(); i > 0;) {
+            chars[--start] = separator.charAt(--i);
+            fields[start] = {UFIELD_CATEGORY_NUMBER, UNUM_DECIMAL_SEPARATOR_FIELD};
+        }
+    }
+
+    // Integer digits, with grouping separators.
+    int32_t integerCount = 0;
+    for (uint64_t rest = value; rest != 0; rest /= 10) {
+        integerCount++;
+    }
+    if (integerCount < fFastData.minInt) {
+        integerCount = fFastData.minInt;
+    }
+    bool grouped = fFastData.grouping1 > 0 &&
+        integerCount - fFastData.grouping1 >= fFastData.minGrouping;
+    for (int32_t i = 0; i < integerCount; i++) {
+        if (grouped && i >= fFastData.grouping1 && (i - fFastData.grouping1) % fFastData.grouping2 == 0) {
+            const UnicodeString& separator = *fFastData.groupingSeparator;
+            for (int32_t j = separator.length(); j > 0;) {
+                chars[--start] = separator.charAt(--j);
+                fields[start] = {UFIELD_CATEGORY_NUMBER, UNUM_GROUPING_SEPARATOR_FIELD};
+            }
+        }
+        chars[--start] = static_cast<char16_t>(fFastData.zero + value % 10);
+        fields[start] = kIntegerField;
+        value /= 10;
+    }
+    if (start == kFastBufferCapacity) {
+        // Force output of the digit for value 0
+        chars[--start] = fFastData.zero;
+        fields[start] = kIntegerField;
+    }
+
+    int32_t length = string.insert(0, chars + start, fields + start, kFastBufferCapacity - start, status);
+    const Modifier* modifier = fImmutablePatternModifier->getModifier(signum, StandardPlural::OTHER);
+    length += modifier->apply(string, 0, length, status);
+    return length;
 }
 
 //////////
@@ -53,6 +53,23 @@ class NumberFormatterImpl : public UMemory {
      */
     int32_t format(DecimalQuantity& inValue, FormattedStringBuilder& outString, UErrorCode& status) const;
 
+    /**
+     * Formats an integer without a MicroPropsGenerator, writing the digits and grouping straight into
+     * the output, if this formatter's settings allow it. The quantity is set to the value as format()
+     * would leave it.
+     *
+     * @return false if the settings need the general pipeline; nothing is written in that case.
+     */
+    bool formatFastInt64(int64_t value, DecimalQuantity& quantity, FormattedStringBuilder& outString,
+                         UErrorCode& status) const;
+
+    /**
+     * Like formatFastInt64(), for a double with no more fraction digits than the precision allows,
+     * such as a price with two fraction digits. Values that need rounding also return false.
+     */
+    bool formatFastDouble(double value, DecimalQuantity& quantity, FormattedStringBuilder& outString,
+                          UErrorCode& status) const;
+
     /**
      * Like format(), but saves the result into an output MicroProps without additional processing.
      */
@@ -104,11 +121,42 @@ class NumberFormatterImpl : public UMemory {
         CurrencySymbols fCurrencySymbols;
     } fWarehouse;
 
+    // Settings for formatFastInt64() and formatFastDouble(), resolved by setupFastFormat():
+    struct FastFormatData {
+        bool enabled = false;
+        bool alwaysShowDecimal;
+        int8_t minInt;
+        // Integer digits kept by formatFastInt64(), or -1 for all.
+        int8_t maxInt;
+        int8_t minFrac;
+        // Fraction digits that a double may have on the fast path, or -1 for none.
+        int8_t doubleFrac;
+        char16_t zero;
+        int16_t grouping1;
+        int16_t grouping2;
+        int16_t minGrouping;
+        const UnicodeString* groupingSeparator;
+        const UnicodeString* decimalSeparator;
+    } fFastData;
+
 
     NumberFormatterImpl(const MacroProps &macros, bool safe, UErrorCode &status);
 
     MicroProps& preProcessUnsafe(DecimalQuantity &inValue, UErrorCode &status);
 
+    /**
+     * Enables the fast path if the MicroPropsGenerator would do no more than round to a number of fraction
+     * digits, group the integer digits, and add the pattern affixes: no scientific or compact notation,
+     * scale, padding, rounding increment, significant digits, maximum integer digits, or long names.
+     */
+    void setupFastFormat(const MacroProps& macros);
+
+    /**
+     * Writes value * 10^-fractionCount, with the pattern affixes for signum, on the fast path.
+     */
+    int32_t writeFast(uint64_t value, int32_t fractionCount, Signum signum,
+                      FormattedStringBuilder& string, UErrorCode& status) const;
+
     int32_t getPrefixSuffixUnsafe(Signum signum, StandardPlural::Form plural,
                                   FormattedStringBuilder& outString, UErrorCode& status);
 
@@ -160,6 +160,11 @@ class RoundingImpl {
     /** Required for ScientificFormatter */
     bool isSignificantDigits() const;
 
+    /** Required for the NumberFormatterImpl fast path */
+    const Precision& getPrecision() const {
+        return fPrecision;
+    }
+
     /**
      * Rounding endpoint used by Engineering and Compact notation. Chooses the most appropriate multiplier (magnitude
      * adjustment), applies the adjustment, rounds, and returns the chosen multiplier.
@@ -16,6 +16,7 @@
 #include "patternprops.h"
 #include "unicode/ucharstriebuilder.h"
 #include "number_utils.h"
+#include "number_utypes.h"
 #include "number_decimalquantity.h"
 #include "unicode/numberformatter.h"
 #include "uinvchar.h"
@@ -1723,6 +1724,20 @@ NumberFormatter::forSkeleton(const UnicodeString& skeleton, UParseError& perror,
     return skeleton::create(skeleton, &perror, status);
 }
 
+CompiledNumberFormatter CompiledNumberFormatter::forSkeleton(const UnicodeString& skeleton,
+                                                             const Locale& locale, UErrorCode& status) {
+    return NumberFormatter::forSkeleton(skeleton, status).locale(locale).compile(status);
+}
+
+UnicodeString CompiledNumberFormatter::toSkeleton(UErrorCode& status) const {
+    if (U_FAILURE(status)) { return ICU_Utility::makeBogusString(); }
+    if (fData == nullptr) {
+        status = U_INVALID_STATE_ERROR;
+        return ICU_Utility::makeBogusString();
+    }
+    return fData->formatter.toSkeleton(status);
+}
+
 #if (U_PF_WINDOWS <= U_PLATFORM && U_PLATFORM <= U_PF_CYGWIN) && defined(_MSC_VER)
 // Warning 4661.
 #pragma warning(pop)
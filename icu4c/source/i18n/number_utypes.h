@@ -12,6 +12,7 @@
 #include "number_decimalquantity.h"
 #include "formatted_string_builder.h"
 #include "formattedval_impl.h"
+#include "sharedobject.h"
 
 U_NAMESPACE_BEGIN namespace number {
 namespace impl {
@@ -42,6 +43,22 @@ class U_I18N_API UFormattedNumberData : public FormattedValueStringBuilderImpl {
 };
 
 
+/**
+ * The shared data of a CompiledNumberFormatter: a LocalizedNumberFormatter whose
+ * NumberFormatterImpl has been built, so that it always takes the fast path.
+ * Immutable after construction.
+ */
+class CompiledNumberFormatterData : public SharedObject {
+  public:
+    LocalizedNumberFormatter formatter;
+    Locale locale;
+
+    CompiledNumberFormatterData(const LocalizedNumberFormatter& other, const Locale& locale)
+            : formatter(other.threshold(1)), locale(locale) {}
+    virtual ~CompiledNumberFormatterData();
+};
+
+
 } // namespace impl
 } // namespace number
 U_NAMESPACE_END
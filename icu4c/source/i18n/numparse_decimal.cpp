@@ -455,5 +455,83 @@ UnicodeString DecimalMatcher::toString() const {
     return u"<Decimal>";
 }
 
+void DecimalMatcher::getPlainSeparators(UChar32& grouping, UChar32& decimal) const {
+    // Only grouping sizes where match() accepts exactly the prescribed groups in all modes;
+    // in lenient mode, it rejects 1-digit groups.
+    if (!groupingDisabled && groupingSeparator.length() == 1 && grouping1 >= 2 && grouping2 >= 2) {
+        grouping = groupingSeparator.charAt(0);
+    } else {
+        grouping = U_SENTINEL;
+    }
+    if (!integerOnly && decimalSeparator.length() == 1) {
+        decimal = decimalSeparator.charAt(0);
+    } else {
+        decimal = U_SENTINEL;
+    }
+    if (grouping == decimal || (u'0' <= grouping && grouping <= u'9')) {
+        grouping = U_SENTINEL;
+    }
+    if (u'0' <= decimal && decimal <= u'9') {
+        decimal = U_SENTINEL;
+    }
+}
+
+bool DecimalMatcher::matchPlain(const UnicodeString& input, int32_t start, UChar32 grouping,
+                                UChar32 decimal, ParsedNumber& result) const {
+    const char16_t* chars = input.getBuffer();
+    int32_t limit = input.length();
+    if (chars == nullptr || start < 0 || start >= limit || result.seenNumber()) {
+        return false;
+    }
+
+    // Check the form of the number first, so that the result is not touched if it does not fit.
+    // See match() and validateGroup() for the group sizes that it accepts:
+    // The first group has 1..grouping2 digits, and each further group grouping2 digits,
+    // except for the last one before the decimal separator, which has grouping1 digits.
+    int32_t count = 0;
+    int32_t decimalIndex = -1;
+    bool seenGrouping = false;
+    for (int32_t i = start; i < limit; i++) {
+        char16_t c = chars[i];
+        if (u'0' <= c && c <= u'9') {
+            count++;
+        } else if (c == grouping && decimalIndex < 0) {
+            if (seenGrouping ? count != grouping2 : (count == 0 || count > grouping2)) {
+                return false;
+            }
+            seenGrouping = true;
+            count = 0;
+        } else if (c == decimal && decimalIndex < 0) {
+            if (seenGrouping ? count != grouping1 : count == 0) {
+                return false;
+            }
+            decimalIndex = i;
+            count = 0;
+        } else {
+            return false;
+        }
+    }
+    if (count == 0 || (seenGrouping && decimalIndex < 0 && count != grouping1)) {
+        return false;
+    }
+
+    // Build the quantity the same way as match().
+    number::impl::DecimalQuantity digitsConsumed;
+    digitsConsumed.clear();
+    for (int32_t i = start; i < limit; i++) {
+        char16_t c = chars[i];
+        if (u'0' <= c && c <= u'9') {
+            digitsConsumed.appendDigit(static_cast<int8_t>(c - u'0'), 0, true);
+        }
+    }
+    if (decimalIndex >= 0) {
+        digitsConsumed.adjustMagnitude(-(limit - decimalIndex - 1));
+        result.flags |= FLAG_HAS_DECIMAL_SEPARATOR;
+    }
+    result.quantity = digitsConsumed;
+    result.charEnd = limit;
+    return true;
+}
+
 
 #endif /* #if !UCONFIG_NO_FORMATTING */
@@ -31,6 +31,25 @@ class DecimalMatcher : public NumberParseMatcher, public UMemory {
 
     UnicodeString toString() const override;
 
+    /**
+     * Gets the separators that matchPlain() can accept: single code units that match() takes
+     * as the grouping and decimal separators. Either is U_SENTINEL if there is no such separator,
+     * or if this matcher does not accept it.
+     */
+    void getPlainSeparators(UChar32& grouping, UChar32& decimal) const;
+
+    /**
+     * Fast path for a number that is all of the rest of the input: ASCII digits, optionally with
+     * grouping separators in the positions that the grouping sizes prescribe, and an optional decimal
+     * separator followed by more digits. The separators are those from getPlainSeparators(),
+     * or U_SENTINEL to not accept them.
+     *
+     * If the input has this form, then this sets the result as match() would have and returns true.
+     * Otherwise, this returns false and leaves the result unchanged.
+     */
+    bool matchPlain(const UnicodeString& input, int32_t start, UChar32 grouping, UChar32 decimal,
+                    ParsedNumber& result) const;
+
   private:
     /** If true, only accept strings whose grouping sizes match the locale */
     bool requireGroupingMatch;
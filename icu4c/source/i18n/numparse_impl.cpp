@@ -222,6 +222,43 @@ void NumberParserImpl::addMatcher(NumberParseMatcher& matcher) {
 
 void NumberParserImpl::freeze() {
     fFrozen = true;
+
+    // The fast path is only valid if the decimal matcher is the only one that could match
+    // any part of a plain decimal number.
+    fPlainDecimalMatcher = nullptr;
+    bool hasDecimalMatcher = false;
+    for (int32_t i = 0; i < fNumMatchers; i++) {
+        if (fMatchers[i] == &fLocalMatchers.decimal) {
+            hasDecimalMatcher = true;
+        }
+    }
+    if (!hasDecimalMatcher) {
+        return;
+    }
+    for (UChar32 c = u'0'; c <= u'9'; c++) {
+        if (isLeadOfOtherMatcher(c)) {
+            return;
+        }
+    }
+    fLocalMatchers.decimal.getPlainSeparators(fPlainGrouping, fPlainDecimal);
+    if (fPlainGrouping >= 0 && isLeadOfOtherMatcher(fPlainGrouping)) {
+        fPlainGrouping = U_SENTINEL;
+    }
+    if (fPlainDecimal >= 0 && isLeadOfOtherMatcher(fPlainDecimal)) {
+        fPlainDecimal = U_SENTINEL;
+    }
+    fPlainDecimalMatcher = &fLocalMatchers.decimal;
+}
+
+bool NumberParserImpl::isLeadOfOtherMatcher(UChar32 c) const {
+    UnicodeString str(c);
+    StringSegment segment(str, 0 != (fParseFlags & PARSE_FLAG_IGNORE_CASE));
+    for (int32_t i = 0; i < fNumMatchers; i++) {
+        if (fMatchers[i] != &fLocalMatchers.decimal && fMatchers[i]->smokeTest(segment)) {
+            return true;
+        }
+    }
+    return false;
 }
 
 parse_flags_t NumberParserImpl::getParseFlags() const {
@@ -239,17 +276,23 @@ void NumberParserImpl::parse(const UnicodeString& input, int32_t start, bool gre
         return;
     }
     U_ASSERT(fFrozen);
-    // TODO: Check start >= 0 and start < input.length()
-    StringSegment segment(input, 0 != (fParseFlags & PARSE_FLAG_IGNORE_CASE));
-    segment.adjustOffset(start);
-    if (greedy) {
-        parseGreedy(segment, result, status);
-    } else if (0 != (fParseFlags & PARSE_FLAG_ALLOW_INFINITE_RECURSION)) {
-        // Start at 1 so that recursionLevels never gets to 0
-        parseLongestRecursive(segment, result, 1, status);
+    if (fPlainDecimalMatcher != nullptr &&
+            fPlainDecimalMatcher->matchPlain(input, start, fPlainGrouping, fPlainDecimal, result)) {
+        // Plain decimal number: Only the decimal matcher could have matched any of it,
+        // in greedy and non-greedy mode alike, and it would have consumed all of it.
     } else {
-        // Arbitrary recursion safety limit: 100 levels.
-        parseLongestRecursive(segment, result, -100, status);
+        // TODO: Check start >= 0 and start < input.length()
+        StringSegment segment(input, 0 != (fParseFlags & PARSE_FLAG_IGNORE_CASE));
+        segment.adjustOffset(start);
+        if (greedy) {
+            parseGreedy(segment, result, status);
+        } else if (0 != (fParseFlags & PARSE_FLAG_ALLOW_INFINITE_RECURSION)) {
+            // Start at 1 so that recursionLevels never gets to 0
+            parseLongestRecursive(segment, result, 1, status);
+        } else {
+            // Arbitrary recursion safety limit: 100 levels.
+            parseLongestRecursive(segment, result, -100, status);
+        }
     }
     for (int32_t i = 0; i < fNumMatchers; i++) {
         fMatchers[i]->postProcess(result);
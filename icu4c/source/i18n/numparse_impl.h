@@ -94,8 +94,17 @@ class U_I18N_API NumberParserImpl : public MutableMatcherCollection, public UMem
         MultiplierParseHandler multiplier;
     } fLocalValidators;
 
+    // Fast path for plain decimal numbers, set up in freeze():
+    // The decimal matcher if no other matcher can match any ASCII digit, otherwise nullptr;
+    // and the separators that no other matcher can match, otherwise U_SENTINEL.
+    const DecimalMatcher* fPlainDecimalMatcher = nullptr;
+    UChar32 fPlainGrouping = U_SENTINEL;
+    UChar32 fPlainDecimal = U_SENTINEL;
+
     explicit NumberParserImpl(parse_flags_t parseFlags);
 
+    bool isLeadOfOtherMatcher(UChar32 c) const;
+
     void parseGreedy(StringSegment& segment, ParsedNumber& result, UErrorCode& status) const;
 
     void parseLongestRecursive(
@@ -20,6 +20,8 @@
 #include "unicode/ures.h"
 #include "unicode/simpletz.h"
 #include "unicode/gregocal.h"
+#include "unicode/tzrule.h"
+#include "unicode/tztrans.h"
 #include "gregoimp.h"
 #include "cmemory.h"
 #include "uassert.h"
@@ -28,6 +30,8 @@
 #include "uresimp.h"
 #include "zonemeta.h"
 #include "umutex.h"
+#include "sharedobject.h"
+#include "unifiedcache.h"
 
 #ifdef U_DEBUG_TZ
 # include <stdio.h>
@@ -81,6 +85,159 @@ U_NAMESPACE_BEGIN
 
 static const int32_t ZEROS[] = {0,0};
 
+// Maximum absolute offset in seconds (86400 seconds = 1 day)
+// getHistoricalOffset uses this constant as safety margin of
+// quick zone transition checking.
+#define MAX_OFFSET_SECONDS 86400
+
+// Number of years from finalStartYear covered by FinalZoneTransitions.
+#define FINAL_TRANSITION_YEARS 100
+
+/**
+ * The transitions of an OlsonTimeZone's finalZone for FINAL_TRANSITION_YEARS
+ * from finalStartMillis, with the offsets in effect after each one.
+ * Looking up an offset in this table replaces the calendar field computations
+ * of SimpleTimeZone::getOffset() with a binary search.
+ * Immutable, and shared through the UnifiedCache by the zones with the same canonical ID.
+ */
+class FinalZoneTransitions : public SharedObject {
+public:
+    FinalZoneTransitions(const SimpleTimeZone &zone, UDate start, int32_t startYear, UErrorCode &status);
+    virtual ~FinalZoneTransitions();
+
+    /**
+     * Returns the index of the interval containing the date, or -1 if the date is
+     * at or after the end of the table.  The date must not be before the start.
+     * Tries the hint interval first.
+     */
+    int32_t indexOf(UDate date, int32_t hint) const;
+
+    /**
+     * Returns TRUE if the date is at least margin milliseconds away from
+     * both ends of the interval.
+     */
+    UBool isInside(int32_t idx, UDate date, double margin) const {
+        double limit = idx + 1 < count ? times[idx + 1] : tableLimit;
+        return times[idx] + margin <= date && date + margin < limit;
+    }
+
+    int32_t rawOffsetAt(int32_t idx) const { return offsets[idx << 1]; }
+    int32_t dstOffsetAt(int32_t idx) const { return offsets[(idx << 1) + 1]; }
+
+private:
+    int32_t count;
+    // Start of each interval; times[0] is the start of the table.
+    LocalMemory<double> times;
+    // Pairs of raw and dst offsets in milliseconds.
+    LocalMemory<int32_t> offsets;
+    // End of the last interval.
+    double tableLimit;
+};
+
+FinalZoneTransitions::FinalZoneTransitions(const SimpleTimeZone &zone, UDate start, int32_t startYear,
+                                           UErrorCode &status)
+        : count(0), tableLimit(start) {
+    if (U_FAILURE(status)) {
+        return;
+    }
+    UBool useDaylight = zone.useDaylightTime();
+    // SimpleTimeZone has at most two transitions a year: The table holds the start
+    // and those transitions, with one spare entry that only an extra transition would fill.
+    int32_t capacity = useDaylight ? 2 * FINAL_TRANSITION_YEARS + 2 : 1;
+    if (times.allocateInsteadAndReset(capacity) == NULL ||
+            offsets.allocateInsteadAndReset(2 * capacity) == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    times[0] = start;
+    zone.getOffset(start, FALSE, offsets[0], offsets[1], status);
+    count = 1;
+    if (!useDaylight) {
+        tableLimit = DBL_MAX;
+        return;
+    }
+    double limit = Grego::fieldsToDay(startYear + FINAL_TRANSITION_YEARS, 0, 1) * U_MILLIS_PER_DAY;
+    TimeZoneTransition transition;
+    UDate base = start;
+    while (U_SUCCESS(status) && count < capacity &&
+            zone.getNextTransition(base, FALSE, transition) && transition.getTime() < limit) {
+        base = transition.getTime();
+        times[count] = base;
+        zone.getOffset(base, FALSE, offsets[count << 1], offsets[(count << 1) + 1], status);
+        ++count;
+    }
+    if (count < capacity) {
+        tableLimit = limit;
+    } else {
+        // Not expected: The table is full, so the last interval may not be complete.
+        tableLimit = times[--count];
+    }
+}
+
+FinalZoneTransitions::~FinalZoneTransitions() {}
+
+int32_t FinalZoneTransitions::indexOf(UDate date, int32_t hint) const {
+    U_ASSERT(!(date < times[0]));
+    if (!(date < tableLimit)) {
+        return -1;
+    }
+    if (0 <= hint && hint < count && times[hint] <= date &&
+            (hint + 1 == count || date < times[hint + 1])) {
+        return hint;
+    }
+    // Binary search for the last interval starting at or before the date.
+    int32_t start = 1, limit = count;
+    while (start < limit) {
+        int32_t mid = (start + limit) / 2;
+        if (times[mid] <= date) {
+            start = mid + 1;
+        } else {
+            limit = mid;
+        }
+    }
+    return start - 1;
+}
+
+/**
+ * Cache key for the FinalZoneTransitions of a zone, by its canonical ID.
+ * The creation context is the OlsonTimeZone.
+ */
+class FinalZoneTransitionsKey : public CacheKey<FinalZoneTransitions> {
+public:
+    FinalZoneTransitionsKey(const UChar *id) : fID(id) {}
+    FinalZoneTransitionsKey(const FinalZoneTransitionsKey &other)
+            : CacheKey<FinalZoneTransitions>(other), fID(other.fID) {}
+    virtual ~FinalZoneTransitionsKey();
+    virtual int32_t hashCode() const {
+        return (int32_t)(37u * (uint32_t)CacheKey<FinalZoneTransitions>::hashCode() + (uint32_t)fID.hashCode());
+    }
+    virtual UBool operator == (const CacheKeyBase &other) const {
+        if (this == &other) {
+            return TRUE;
+        }
+        if (!CacheKey<FinalZoneTransitions>::operator == (other)) {
+            return FALSE;
+        }
+        return fID == static_cast<const FinalZoneTransitionsKey &>(other).fID;
+    }
+    virtual CacheKeyBase *clone() const {
+        return new FinalZoneTransitionsKey(*this);
+    }
+    virtual const FinalZoneTransitions *createObject(const void *creationContext, UErrorCode &status) const {
+        const OlsonTimeZone *zone = static_cast<const OlsonTimeZone *>(creationContext);
+        return zone->createFinalTransitions(status);
+    }
+    virtual char *writeDescription(char *buffer, int32_t bufLen) const {
+        fID.extract(0, fID.length(), buffer, bufLen, US_INV);
+        buffer[bufLen - 1] = 0;
+        return buffer;
+    }
+private:
+    UnicodeString fID;
+};
+
+FinalZoneTransitionsKey::~FinalZoneTransitionsKey() {}
+
 UOBJECT_DEFINE_RTTI_IMPLEMENTATION(OlsonTimeZone)
 
 /**
@@ -121,7 +278,7 @@ OlsonTimeZone::OlsonTimeZone(const UResourceBundle* top,
                              const UResourceBundle* res,
                              const UnicodeString& tzid,
                              UErrorCode& ec) :
-  BasicTimeZone(tzid), finalZone(NULL)
+  BasicTimeZone(tzid), finalZone(NULL), finalTransitions(NULL), lastTransitionIdx(0), lastFinalIdx(0)
 {
     clearTransitionRules();
     U_DEBUG_TZ_MSG(("OlsonTimeZone(%s)\n", ures_getKey((UResourceBundle*)res)));
@@ -264,7 +421,7 @@ OlsonTimeZone::OlsonTimeZone(const UResourceBundle* top,
  * Copy constructor
  */
 OlsonTimeZone::OlsonTimeZone(const OlsonTimeZone& other) :
-    BasicTimeZone(other), finalZone(0) {
+    BasicTimeZone(other), finalZone(0), finalTransitions(NULL), lastTransitionIdx(0), lastFinalIdx(0) {
     *this = other;
 }
 
@@ -292,6 +449,10 @@ OlsonTimeZone& OlsonTimeZone::operator=(const OlsonTimeZone& other) {
     finalStartYear = other.finalStartYear;
     finalStartMillis = other.finalStartMillis;
 
+    // Fetched again from the cache when needed.
+    SharedObject::clearPtr(finalTransitions);
+    finalTransitionsInitOnce.reset();
+
     clearTransitionRules();
 
     return *this;
@@ -302,6 +463,7 @@ OlsonTimeZone& OlsonTimeZone::operator=(const OlsonTimeZone& other) {
  */
 OlsonTimeZone::~OlsonTimeZone() {
     deleteTransitionRules();
+    SharedObject::clearPtr(finalTransitions);
     delete finalZone;
 }
 
@@ -391,7 +553,9 @@ void OlsonTimeZone::getOffset(UDate date, UBool local, int32_t& rawoff,
         return;
     }
     if (finalZone != NULL && date >= finalStartMillis) {
-        finalZone->getOffset(date, local, rawoff, dstoff, ec);
+        if (!getFinalOffset(date, local, rawoff, dstoff)) {
+            finalZone->getOffset(date, local, rawoff, dstoff, ec);
+        }
     } else {
         getHistoricalOffset(date, local, kFormer, kLatter, rawoff, dstoff);
     }
@@ -404,7 +568,9 @@ OlsonTimeZone::getOffsetFromLocal(UDate date, int32_t nonExistingTimeOpt, int32_
         return;
     }
     if (finalZone != NULL && date >= finalStartMillis) {
-        finalZone->getOffsetFromLocal(date, nonExistingTimeOpt, duplicatedTimeOpt, rawoff, dstoff, ec);
+        if (!getFinalOffset(date, TRUE, rawoff, dstoff)) {
+            finalZone->getOffsetFromLocal(date, nonExistingTimeOpt, duplicatedTimeOpt, rawoff, dstoff, ec);
+        }
     } else {
         getHistoricalOffset(date, TRUE, nonExistingTimeOpt, duplicatedTimeOpt, rawoff, dstoff);
     }
@@ -463,10 +629,30 @@ OlsonTimeZone::transitionTimeInSeconds(int16_t transIdx) const {
         | ((int64_t)((uint32_t)transitionTimesPost32[(transIdx << 1) + 1]));
 }
 
-// Maximum absolute offset in seconds (86400 seconds = 1 day)
-// getHistoricalOffset uses this constant as safety margin of
-// quick zone transition checking.
-#define MAX_OFFSET_SECONDS 86400
+int16_t
+OlsonTimeZone::findTransition(double sec) const {
+    int16_t transCount = transitionCount();
+    int16_t hint = (int16_t)umtx_loadAcquire(lastTransitionIdx);
+    if (hint < transCount && transitionTimeInSeconds(hint) <= sec
+            && (hint + 1 == transCount || sec < transitionTimeInSeconds(hint + 1))) {
+        return hint;
+    }
+    // Binary search for the first transition after sec.
+    int16_t start = 0, limit = transCount;
+    while (start < limit) {
+        int16_t mid = (int16_t)((start + limit) / 2);
+        if (transitionTimeInSeconds(mid) <= sec) {
+            start = mid + 1;
+        } else {
+            limit = mid;
+        }
+    }
+    int16_t transIdx = start - 1;
+    if (transIdx >= 0) {
+        umtx_storeRelease(lastTransitionIdx, transIdx);
+    }
+    return transIdx;
+}
 
 void
 OlsonTimeZone::getHistoricalOffset(UDate date, UBool local,
@@ -486,10 +672,11 @@ OlsonTimeZone::getHistoricalOffset(UDate date, UBool local,
             rawoff = initialRawOffset() * U_MILLIS_PER_SECOND;
             dstoff = initialDstOffset() * U_MILLIS_PER_SECOND;
         } else {
-            // Linear search from the end is the fastest approach, since
-            // most lookups will happen at/near the end.
+            // Start with the last transition that can apply: For a UTC time that is
+            // the one at or before it.  A local time is at most MAX_OFFSET_SECONDS
+            // ahead of UTC, and the loop adjusts the few transitions within that margin.
             int16_t transIdx;
-            for (transIdx = transCount - 1; transIdx >= 0; transIdx--) {
+            for (transIdx = findTransition(local ? sec + MAX_OFFSET_SECONDS : sec); transIdx >= 0; transIdx--) {
                 int64_t transition = transitionTimeInSeconds(transIdx);
 
                 if (local && (sec >= (transition - MAX_OFFSET_SECONDS))) {
@@ -685,6 +872,65 @@ OlsonTimeZone::deleteTransitionRules(void) {
     clearTransitionRules();
 }
 
+/*
+ * Lazy finalZone transitions initializer
+ */
+
+const FinalZoneTransitions *
+OlsonTimeZone::createFinalTransitions(UErrorCode& status) const {
+    if (U_FAILURE(status)) {
+        return NULL;
+    }
+    U_ASSERT(finalZone != NULL);
+    LocalPointer<FinalZoneTransitions> result(
+        new FinalZoneTransitions(*finalZone, finalStartMillis, finalStartYear, status), status);
+    if (U_FAILURE(status)) {
+        return NULL;
+    }
+    result->addRef();
+    return result.orphan();
+}
+
+void
+OlsonTimeZone::initFinalTransitions() {
+    UErrorCode status = U_ZERO_ERROR;
+    const UnifiedCache *cache = UnifiedCache::getInstance(status);
+    if (U_SUCCESS(status) && canonicalID != NULL) {
+        cache->get(FinalZoneTransitionsKey(canonicalID), this, finalTransitions, status);
+    }
+    if (U_FAILURE(status)) {
+        // Use finalZone directly.
+        SharedObject::clearPtr(finalTransitions);
+    }
+}
+
+void
+OlsonTimeZone::checkFinalTransitions() const {
+    OlsonTimeZone *ncThis = const_cast<OlsonTimeZone *>(this);
+    umtx_initOnce(ncThis->finalTransitionsInitOnce, ncThis, &OlsonTimeZone::initFinalTransitions);
+}
+
+UBool
+OlsonTimeZone::getFinalOffset(UDate date, UBool local, int32_t& rawoff, int32_t& dstoff) const {
+    checkFinalTransitions();
+    if (finalTransitions == NULL) {
+        return FALSE;
+    }
+    int32_t idx = finalTransitions->indexOf(date, umtx_loadAcquire(lastFinalIdx));
+    if (idx < 0) {
+        return FALSE;
+    }
+    umtx_storeRelease(lastFinalIdx, idx);
+    // A local time near a transition needs finalZone to resolve
+    // skipped and repeated wall times.
+    if (local && !finalTransitions->isInside(idx, date, (double)MAX_OFFSET_SECONDS * U_MILLIS_PER_SECOND)) {
+        return FALSE;
+    }
+    rawoff = finalTransitions->rawOffsetAt(idx);
+    dstoff = finalTransitions->dstOffsetAt(idx);
+    return TRUE;
+}
+
 /*
  * Lazy transition rules initializer
  */
@@ -25,6 +25,7 @@ struct UResourceBundle;
 U_NAMESPACE_BEGIN
 
 class SimpleTimeZone;
+class FinalZoneTransitions;
 
 /**
  * A time zone based on the Olson tz database.  Olson time zones change
@@ -299,6 +300,21 @@ class U_I18N_API OlsonTimeZone: public BasicTimeZone {
 
     int16_t transitionCount() const;
 
+    /*
+     * Returns the index of the last transition at or before the given time,
+     * or -1 if there is none.  Tries the interval of the previous lookup first,
+     * and otherwise does a binary search.
+     */
+    int16_t findTransition(double sec) const;
+
+    /*
+     * Looks up the offsets for a date at or after finalStartMillis
+     * in the shared table of finalZone transitions.  Returns FALSE if the date is beyond
+     * the table, or if it is a local time too close to a transition to be decided this way;
+     * then finalZone must be used.
+     */
+    UBool getFinalOffset(UDate date, UBool local, int32_t& rawoff, int32_t& dstoff) const;
+
     int64_t transitionTimeInSeconds(int16_t transIdx) const;
     double transitionTime(int16_t transIdx) const;
 
@@ -377,6 +393,24 @@ class U_I18N_API OlsonTimeZone: public BasicTimeZone {
      */
     int32_t finalStartYear;
 
+    /**
+     * Transitions of finalZone from finalStartMillis for some decades,
+     * shared by all zones with the same canonical ID through the UnifiedCache.
+     * Fetched when a date in the finalZone range is first looked up.
+     */
+    const FinalZoneTransitions *finalTransitions;
+    UInitOnce finalTransitionsInitOnce = U_INITONCE_INITIALIZER;
+    void checkFinalTransitions() const;
+    void U_CALLCONV initFinalTransitions();
+
+    /**
+     * Index of the transition interval found by the last historical lookup,
+     * and of the finalTransitions interval found by the last final lookup.
+     * Consecutive lookups usually fall into the same interval.
+     */
+    mutable u_atomic_int32_t lastTransitionIdx;
+    mutable u_atomic_int32_t lastFinalIdx;
+
     /*
      * Canonical (CLDR) ID of this zone
      */
@@ -389,6 +423,9 @@ class U_I18N_API OlsonTimeZone: public BasicTimeZone {
 
   public:    // Internal, for access from plain C code
     void initTransitionRules(UErrorCode& status);
+
+    // Internal, for creating the shared FinalZoneTransitions on a cache miss
+    const FinalZoneTransitions *createFinalTransitions(UErrorCode& status) const;
   private:
 
     InitialTimeZoneRule *initialRule;
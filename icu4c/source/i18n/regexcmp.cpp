@@ -316,6 +316,16 @@ void    RegexCompile::compile(
     //
     matchStartType();
 
+    //
+    // Optimization pass 3: a literal string that all matches must contain
+    //
+    requiredString();
+
+    //
+    // Choose between the linear time and the backtracking match engines
+    //
+    chooseMatchEngine();
+
     //
     // Set up fast latin-1 range sets
     //
@@ -2746,13 +2756,20 @@ void   RegexCompile::matchStartType() {
         case URX_DOLLAR_MD:
         case URX_RELOC_OPRND:
         case URX_STO_INP_LOC:
-        case URX_BACKREF:         // BackRef.  Must assume that it might be a zero length match
-        case URX_BACKREF_I:
-
         case URX_STO_SP:          // Setup for atomic or possessive blocks.  Doesn't change what can match.
         case URX_LD_SP:
             break;
 
+        case URX_BACKREF:         // BackRef.  Must assume that it might be a zero length match
+        case URX_BACKREF_I:
+            // A back reference that may begin the match can begin with any character,
+            //   for example when the group was captured in a look-ahead.
+            if (currentLen == 0) {
+                fRXPat->fInitialChars->add(0, 0x10ffff);
+                numInitialStrings += 2;
+            }
+            break;
+
         case URX_CARET:
             if (atStart) {
                 fRXPat->fStartType = START_START;
@@ -3163,6 +3180,8 @@ void   RegexCompile::matchStartType() {
         U_ASSERT(fRXPat->fInitialChars->contains(c));
         fRXPat->fStartType   = START_STRING;
         fRXPat->fInitialChar = c;
+        fRXPat->fInitialStringSearch->init(fRXPat->fLiteralText,
+                                           fRXPat->fInitialStringIdx, fRXPat->fInitialStringLen);
     } else if (fRXPat->fStartType == START_LINE) {
         // Match at start of line in Multi-Line mode.
         // Nothing to do here; everything is already set.
@@ -3188,6 +3207,200 @@ void   RegexCompile::matchStartType() {
 
 
 
+//------------------------------------------------------------------------------
+//
+//   requiredString    Find the longest literal string that every match of the
+//                     pattern must contain.  find() uses it to give up quickly
+//                     on input that can not match.
+//
+//                     A string qualifies if it is matched case-sensitively,
+//                     is not inside of a look-around block, and no forward
+//                     branch in the pattern can skip over it.  Counted loops
+//                     are assumed to possibly iterate zero times, so strings
+//                     in their bodies never qualify.
+//
+//------------------------------------------------------------------------------
+void   RegexCompile::requiredString() {
+    if (U_FAILURE(*fStatus)) {
+        return;
+    }
+
+    int32_t    end = fRXPat->fCompiledPat->size() - 1;
+    int32_t    loc;
+    int32_t    op;
+    int32_t    opType;
+
+    // reach[loc] is the furthest destination of any forward branch from a
+    //   location before loc.  A string at loc can be skipped if reach[loc] > loc.
+    //   Branches from within look-around blocks are included, because failing
+    //   negative look-arounds continue past the end of their block.
+    UVector32  reach(end+2, *fStatus);
+    reach.setSize(end+2);
+    if (U_FAILURE(*fStatus)) {
+        return;
+    }
+    int32_t    furthest = 0;
+    for (loc=0; loc<=end; loc++) {
+        reach.setElementAt(furthest, loc);
+        op     = (int32_t)fRXPat->fCompiledPat->elementAti(loc);
+        opType = URX_TYPE(op);
+        int32_t  dest = 0;
+        switch (opType) {
+        case URX_STATE_SAVE:
+        case URX_JMP:
+        case URX_JMPX:
+        case URX_JMP_SAV:
+        case URX_JMP_SAV_X:
+            dest = URX_VAL(op);
+            break;
+        case URX_CTR_INIT:
+        case URX_CTR_INIT_NG:
+            // The loop end is in the first operand. A zero-count loop continues after it.
+            dest = URX_VAL((int32_t)fRXPat->fCompiledPat->elementAti(loc+1)) + 1;
+            break;
+        case URX_LBN_CONT:
+            dest = URX_VAL((int32_t)fRXPat->fCompiledPat->elementAti(loc+3));
+            break;
+        default:
+            break;
+        }
+        if (dest > furthest) {
+            furthest = dest;
+        }
+    }
+    reach.setElementAt(furthest, end+1);
+
+    int32_t    bestIdx = 0;
+    int32_t    bestLen = 0;
+    for (loc=3; loc<=end; loc++) {
+        op     = (int32_t)fRXPat->fCompiledPat->elementAti(loc);
+        opType = URX_TYPE(op);
+        switch (opType) {
+        case URX_STRING:
+            {
+                int32_t stringLen = URX_VAL((int32_t)fRXPat->fCompiledPat->elementAti(loc+1));
+                if (reach.elementAti(loc) <= loc && stringLen > bestLen) {
+                    bestIdx = URX_VAL(op);
+                    bestLen = stringLen;
+                }
+                loc++;
+            }
+            break;
+
+        case URX_LA_START:
+        case URX_LB_START:
+            {
+                // Skip the look-around block. It ends with the last URX_LA_END or
+                //   URX_LBN_END that refers to the same data location.
+                int32_t  dataLoc  = URX_VAL(op);
+                int32_t  blockEnd = loc;
+                for (int32_t i=loc+1; i<=end; i++) {
+                    int32_t  endOp = (int32_t)fRXPat->fCompiledPat->elementAti(i);
+                    if ((URX_TYPE(endOp) == URX_LA_END || URX_TYPE(endOp) == URX_LBN_END) &&
+                            URX_VAL(endOp) == dataLoc) {
+                        blockEnd = i;
+                    }
+                }
+                loc = blockEnd;
+            }
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    if (bestLen == 0 ||
+            (fRXPat->fStartType == START_STRING && bestIdx == fRXPat->fInitialStringIdx)) {
+        // No string, or the string is already searched for by the START_STRING
+        //   scan in find().
+        return;
+    }
+    fRXPat->fRequiredStringSearch->init(fRXPat->fLiteralText, bestIdx, bestLen);
+}
+
+
+
+//------------------------------------------------------------------------------
+//
+//   chooseMatchEngine   Decide whether the pattern is matched by the linear time
+//                       NFA simulation, RegexMatcher::MatchNFA(), or by backtracking.
+//
+//                       The NFA engine handles the ops whose effect depends only on
+//                       the current pattern and input positions.  Ops that look at
+//                       saved input positions or at the backtrack stack itself
+//                       (back references, look-around, atomic groups, counted loops,
+//                       loops guarding against zero length iterations), and \X,
+//                       require backtracking.
+//
+//------------------------------------------------------------------------------
+void   RegexCompile::chooseMatchEngine() {
+    if (U_FAILURE(*fStatus)) {
+        return;
+    }
+    UBool   linearTimeOK = TRUE;
+    int32_t end = fRXPat->fCompiledPat->size();
+    for (int32_t loc = 0; loc < end && linearTimeOK; loc++) {
+        int32_t op = (int32_t)fRXPat->fCompiledPat->elementAti(loc);
+        switch (URX_TYPE(op)) {
+        case URX_NOP:
+        case URX_BACKTRACK:
+        case URX_FAIL:
+        case URX_END:
+        case URX_ONECHAR:
+        case URX_ONECHAR_I:
+        case URX_STRING:
+        case URX_STRING_I:
+        case URX_STRING_LEN:
+        case URX_STATE_SAVE:
+        case URX_JMP:
+        case URX_JMP_SAV:
+        case URX_START_CAPTURE:
+        case URX_END_CAPTURE:
+        case URX_STATIC_SETREF:
+        case URX_STAT_SETREF_N:
+        case URX_SETREF:
+        case URX_DOTANY:
+        case URX_DOTANY_ALL:
+        case URX_DOTANY_UNIX:
+        case URX_BACKSLASH_B:
+        case URX_BACKSLASH_BU:
+        case URX_BACKSLASH_D:
+        case URX_BACKSLASH_G:
+        case URX_BACKSLASH_H:
+        case URX_BACKSLASH_R:
+        case URX_BACKSLASH_V:
+        case URX_BACKSLASH_Z:
+        case URX_CARET:
+        case URX_CARET_M:
+        case URX_CARET_M_UNIX:
+        case URX_DOLLAR:
+        case URX_DOLLAR_D:
+        case URX_DOLLAR_M:
+        case URX_DOLLAR_MD:
+        case URX_LOOP_SR_I:
+        case URX_LOOP_DOT_I:
+        case URX_LOOP_C:
+            break;
+
+        default:
+            linearTimeOK = FALSE;
+            break;
+        }
+    }
+
+    if (fRXPat->fFlags & UREGEX_LINEAR_TIME) {
+        if (!linearTimeOK) {
+            error(U_REGEX_UNIMPLEMENTED);
+        }
+        fRXPat->fUseNFAEngine = linearTimeOK;
+    } else {
+        fRXPat->fUseNFAEngine = linearTimeOK && (fRXPat->fFlags & UREGEX_BACKTRACKING) == 0;
+    }
+}
+
+
+
 //------------------------------------------------------------------------------
 //
 //   minMatchLength    Calculate the length of the shortest string that could
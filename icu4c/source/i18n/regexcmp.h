@@ -119,6 +119,8 @@ class U_I18N_API RegexCompile : public UMemory {
     int32_t     maxMatchLength(int32_t start,
                                int32_t end);
     void        matchStartType();
+    void        requiredString();
+    void        chooseMatchEngine();
     void        stripNOPs();
 
     void        setEval(int32_t op);
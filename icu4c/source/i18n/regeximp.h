@@ -21,6 +21,8 @@
 
 #include "cmemory.h"
 #include "ucase.h"
+#include "uvectr32.h"
+#include "uvectr64.h"
 
 U_NAMESPACE_BEGIN
 
@@ -357,6 +359,87 @@ inline void Regex8BitSet::operator = (const Regex8BitSet &s) {
 }
 
 
+//
+//  Substring search for a literal string from a pattern's fLiteralText.
+//  Horspool search, with the shift table indexed by the low byte of each code unit.
+//  Shifts are capped at 255, which only makes the search step by less than it could
+//  for strings longer than that.
+//
+struct RegexStringSearch : public UMemory {
+    inline RegexStringSearch();
+    inline void init(const UnicodeString &literalText, int32_t idx, int32_t len);
+    inline int32_t search(const UChar *literalText, const UChar *text, int32_t start, int32_t limit) const;
+    int32_t  fStringIdx;        // Index of the string in the pattern's fLiteralText.
+    int32_t  fStringLen;        // Length of the string in code units.  0 if there is no string.
+    uint8_t  fShift[256];
+};
+
+inline RegexStringSearch::RegexStringSearch() : fStringIdx(0), fStringLen(0) {
+    uprv_memset(fShift, 0, sizeof(fShift));
+}
+
+inline void RegexStringSearch::init(const UnicodeString &literalText, int32_t idx, int32_t len) {
+    fStringIdx = idx;
+    fStringLen = len;
+    int32_t maxShift = len < 255 ? len : 255;
+    uprv_memset(fShift, maxShift, sizeof(fShift));
+    for (int32_t i = 0; i < len-1; i++) {
+        int32_t shift = len - 1 - i;
+        fShift[literalText.charAt(idx+i) & 0xff] = (uint8_t)(shift < 255 ? shift : 255);
+    }
+}
+
+//
+//  Return the index of the first occurrence of the string in text[start, limit),
+//    or -1 if there is none.  literalText is the buffer of the pattern's fLiteralText.
+//
+inline int32_t RegexStringSearch::search(const UChar *literalText, const UChar *text,
+                                          int32_t start, int32_t limit) const {
+    const UChar *s = literalText + fStringIdx;
+    int32_t last = fStringLen - 1;
+    UChar lastChar = s[last];
+    for (int32_t pos = start; pos < limit - last; ) {
+        UChar c = text[pos + last];
+        if (c == lastChar && uprv_memcmp(text + pos, s, last * U_SIZEOF_UCHAR) == 0) {
+            return pos;
+        }
+        pos += fShift[c & 0xff];
+    }
+    return -1;
+}
+
+
+//
+//  Working storage for the linear time match engine, RegexMatcher::MatchNFA().
+//  Allocated by a matcher the first time it is needed, and kept for later matches.
+//
+//  Each thread in a list occupies one stack frame, laid out as an REStackFrame.
+//  Its fPatIdx holds the NFA state, a pattern index in the low 32 bits plus a
+//  sub-state above them (an offset into a literal string, or a pending LF after a CR);
+//  its fInputIdx holds the start of the match that the thread is working on.
+//
+struct RegexNFAWorkspace : public UMemory {
+    inline RegexNFAWorkspace(UErrorCode &status);
+    UVector64   fThreads1;     // Thread lists for the current and the next input position.
+    UVector64   fThreads2;
+    UVector32   fStateIndex;   // Mark index of the first sub-state of each pattern op.
+    UVector32   fMarks;        // Per NFA state, the generation that last added it to a list.
+    int32_t     fGeneration;
+    UVector64   fJobs;         // Pending alternatives and capture restores while adding a thread.
+    UVector64   fFrame;        // Frame of the thread being added.
+    UVector64   fMatchFrame;   // Frame of the best match found so far.
+    int64_t     fMatchEnd;     // Input index at the end of that match.
+    UBool       fSetMode;      // Matching a RegexSet: reaching an END records it in
+    UVector32   fMatchedEnds;  //   fMatchedEnds, and the thread continues no further.
+};
+
+inline RegexNFAWorkspace::RegexNFAWorkspace(UErrorCode &status) :
+        fThreads1(status), fThreads2(status), fStateIndex(status), fMarks(status),
+        fGeneration(0), fJobs(status), fFrame(status), fMatchFrame(status), fMatchEnd(0),
+        fSetMode(FALSE), fMatchedEnds(status) {
+}
+
+
 //  Case folded UText Iterator helper class.
 //  Wraps a UText, provides a case-folded enumeration over its contents.
 //  Used in implementing case insensitive matching constructs.
@@ -409,6 +492,34 @@ class CaseFoldingUCharIterator: public UMemory {
 
 };
 
+// Case folded UTF-8 string iterator.
+//  Wraps a UTF-8 string, provides a case-folded enumeration over its contents.
+//  Used in implementing case insensitive matching constructs.
+//  Implementation in regeximp.cpp
+
+class CaseFoldingUTF8Iterator: public UMemory {
+      public:
+        CaseFoldingUTF8Iterator(const uint8_t *chars, int64_t start, int64_t limit);
+        ~CaseFoldingUTF8Iterator();
+
+        UChar32 next();           // Next case folded character
+
+        UBool   inExpansion();    // True if last char returned from next() and the
+                                  //  next to be returned both originated from a string
+                                  //  folding of the same code point from the orignal string.
+
+        int64_t  getIndex();      // Return the current input buffer index.
+
+      private:
+        const  uint8_t    *fChars;
+        int64_t            fIndex;
+        int64_t            fLimit;
+        const  UChar      *fFoldChars;
+        int32_t            fFoldLength;
+        int32_t            fFoldIndex;
+
+};
+
 U_NAMESPACE_END
 #endif
 
@@ -0,0 +1,399 @@
+// © 2020 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+//
+//  file:  regexset.cpp
+//
+//  Implementation of class RegexSet, finding which of a number of regular
+//  expressions match an input text.
+//
+//  The patterns that compile for the linear time match engine are combined into a
+//  single program, which RegexMatcher::MatchNFASet() runs over the input.  Each
+//  pattern's program is copied into the combined one, with its jump targets,
+//  literal string offsets and set references relocated.  Sets equal to a set of
+//  an earlier pattern share its slot in the combined pattern's fSets and fSets8.
+//  Patterns are only started at characters that can begin a match, and a pattern
+//  whose required or initial literal string is absent from the input is not run.
+//
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_REGULAR_EXPRESSIONS
+
+#include "unicode/regex.h"
+#include "unicode/uniset.h"
+#include "cmemory.h"
+#include "uassert.h"
+#include "uhash.h"
+#include "uvector.h"
+#include "uvectr32.h"
+#include "uvectr64.h"
+#include "regeximp.h"
+#include "regextxt.h"
+
+U_CDECL_BEGIN
+static int32_t U_CALLCONV
+hashUnicodeSet(const UHashTok key) {
+    return ((const icu::UnicodeSet *)key.pointer)->hashCode();
+}
+
+static UBool U_CALLCONV
+compareUnicodeSets(const UHashTok key1, const UHashTok key2) {
+    return *(const icu::UnicodeSet *)key1.pointer == *(const icu::UnicodeSet *)key2.pointer;
+}
+U_CDECL_END
+
+U_NAMESPACE_BEGIN
+
+UOBJECT_DEFINE_RTTI_IMPLEMENTATION(RegexSet)
+
+RegexSet::RegexSet() :
+        fPatterns(NULL), fMatchers(NULL), fMatched(NULL), fExcluded(NULL),
+        fCombinedPattern(NULL), fCombinedMatcher(NULL), fStartLocs(NULL), fPatternOfOp(NULL),
+        fByteStartIndex(NULL), fByteStarts(NULL), fWideStarts(NULL), fAnyStarts(NULL),
+        fFirstStarts(NULL) {
+}
+
+
+RegexSet::~RegexSet() {
+    if (fPatterns != NULL) {
+        for (int32_t i = 0; i < fPatterns->size(); i++) {
+            delete (RegexPattern *)fPatterns->elementAt(i);
+            if (fMatchers != NULL) {
+                delete fMatchers[i];
+            }
+        }
+        delete fPatterns;
+    }
+    uprv_free(fMatchers);
+    uprv_free(fMatched);
+    uprv_free(fExcluded);
+    delete fCombinedMatcher;
+    delete fCombinedPattern;
+    delete fStartLocs;
+    delete fPatternOfOp;
+    delete fByteStartIndex;
+    delete fByteStarts;
+    delete fWideStarts;
+    delete fAnyStarts;
+    delete fFirstStarts;
+}
+
+
+//--------------------------------------------------------------------------
+//
+//   compile
+//
+//--------------------------------------------------------------------------
+RegexSet * U_EXPORT2
+RegexSet::compile(const UnicodeString patterns[],
+                  int32_t              count,
+                  uint32_t             flags,
+                  UParseError          &pe,
+                  UErrorCode           &status) {
+    if (U_FAILURE(status)) {
+        return NULL;
+    }
+    if (count < 0 || (patterns == NULL && count > 0)) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return NULL;
+    }
+    LocalPointer<RegexSet> set(new RegexSet, status);
+    if (U_FAILURE(status)) {
+        return NULL;
+    }
+    set->fPatterns       = new UVector(status);
+    set->fStartLocs      = new UVector32(status);
+    set->fPatternOfOp    = new UVector32(status);
+    set->fByteStartIndex = new UVector32(status);
+    set->fByteStarts     = new UVector32(status);
+    set->fWideStarts     = new UVector32(status);
+    set->fAnyStarts      = new UVector32(status);
+    set->fFirstStarts    = new UVector32(status);
+    set->fMatchers       = (RegexMatcher **)uprv_malloc((count + 1) * sizeof(RegexMatcher *));
+    set->fMatched        = (UBool *)uprv_malloc((count + 1) * sizeof(UBool));
+    set->fExcluded       = (UBool *)uprv_malloc((count + 1) * sizeof(UBool));
+    if (U_SUCCESS(status) &&
+            (set->fPatterns == NULL || set->fStartLocs == NULL || set->fPatternOfOp == NULL ||
+             set->fByteStartIndex == NULL || set->fByteStarts == NULL || set->fWideStarts == NULL ||
+             set->fAnyStarts == NULL || set->fFirstStarts == NULL ||
+             set->fMatchers == NULL || set->fMatched == NULL || set->fExcluded == NULL)) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+    }
+    if (U_FAILURE(status)) {
+        return NULL;
+    }
+
+    for (int32_t i = 0; i < count; i++) {
+        set->fMatchers[i] = NULL;
+        RegexPattern *pattern = RegexPattern::compile(patterns[i], flags, pe, status);
+        if (U_FAILURE(status)) {
+            return NULL;
+        }
+        set->fPatterns->addElement(pattern, status);
+        if (U_FAILURE(status)) {
+            delete pattern;
+            return NULL;
+        }
+        if (!pattern->fUseNFAEngine) {
+            // Patterns that need backtracking are matched on their own.
+            set->fMatchers[i] = pattern->matcher(status);
+            if (U_FAILURE(status)) {
+                return NULL;
+            }
+        }
+    }
+
+    set->combine(status);
+    if (U_FAILURE(status)) {
+        return NULL;
+    }
+    return set.orphan();
+}
+
+
+//--------------------------------------------------------------------------
+//
+//   combine       Build the combined program for the patterns that use the
+//                 linear time match engine, and the lists of the patterns that
+//                 can start a match at a given input character.
+//
+//--------------------------------------------------------------------------
+void RegexSet::combine(UErrorCode &status) {
+    fCombinedPattern = new RegexPattern;
+    if (fCombinedPattern == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    if (U_FAILURE(fCombinedPattern->fDeferredStatus)) {
+        status = fCombinedPattern->fDeferredStatus;
+        return;
+    }
+    RegexPattern *combined    = fCombinedPattern;
+    UVector64    *combinedPat = combined->fCompiledPat;
+    combined->fUseNFAEngine = TRUE;
+    // Only whether each pattern matches is wanted, not capture groups.  MatchNFASet()
+    //   does not record them, so the frames only need their header.
+    combined->fFrameSize = RESTACKFRAME_HDRCOUNT;
+
+    // Map from each UnicodeSet of the combined pattern to its index in fSets.
+    UHashtable *setIndexes = uhash_open(hashUnicodeSet, compareUnicodeSets, NULL, &status);
+    UVector32   charStarts(status);     // Patterns whose matches start with a char from fInitialChars.
+
+    for (int32_t patIndex = 0; patIndex < fPatterns->size() && U_SUCCESS(status); patIndex++) {
+        const RegexPattern *pattern = (const RegexPattern *)fPatterns->elementAt(patIndex);
+        if (!pattern->fUseNFAEngine) {
+            fStartLocs->addElement(-1, status);
+            continue;
+        }
+        int32_t        base    = combinedPat->size();
+        int32_t        litBase = combined->fLiteralText.length();
+        const int64_t *pat     = pattern->fCompiledPat->getBuffer();
+        int32_t        patSize = pattern->fCompiledPat->size();
+
+        for (int32_t pc = 0; pc < patSize && U_SUCCESS(status); pc++) {
+            int32_t op      = (int32_t)pat[pc];
+            int32_t opType  = URX_TYPE(op);
+            int32_t opValue = URX_VAL(op);
+            switch (opType) {
+            case URX_STATE_SAVE:
+            case URX_JMP:
+            case URX_JMP_SAV:
+                opValue += base;
+                break;
+
+            case URX_STRING:
+            case URX_STRING_I:
+                opValue += litBase;
+                break;
+
+            case URX_SETREF:
+            case URX_LOOP_SR_I:
+                {
+                    UnicodeSet *s = (UnicodeSet *)pattern->fSets->elementAt(opValue);
+                    opValue = uhash_geti(setIndexes, s);
+                    if (opValue == 0) {
+                        UnicodeSet *copy = s->clone();
+                        if (copy == NULL) {
+                            status = U_MEMORY_ALLOCATION_ERROR;
+                            break;
+                        }
+                        opValue = combined->fSets->size();
+                        combined->fSets->addElement(copy, status);
+                        if (U_FAILURE(status)) {
+                            delete copy;
+                            break;
+                        }
+                        uhash_puti(setIndexes, copy, opValue, &status);
+                    }
+                }
+                break;
+
+            default:
+                break;
+            }
+            if (opValue > 0x00ffffff) {
+                status = U_REGEX_PATTERN_TOO_BIG;
+            }
+            combinedPat->addElement(((int64_t)opType << 24) | opValue, status);
+            fPatternOfOp->addElement(patIndex, status);
+        }
+        combined->fLiteralText.append(pattern->fLiteralText);
+        fStartLocs->addElement(base, status);
+        if (pattern->fDataSize > combined->fDataSize) {
+            combined->fDataSize = pattern->fDataSize;
+        }
+
+        switch (pattern->fStartType) {
+        case START_CHAR:
+        case START_SET:
+        case START_STRING:
+            charStarts.addElement(patIndex, status);
+            if (!pattern->fInitialChars->containsNone(0x100, 0x10ffff)) {
+                fWideStarts->addElement(patIndex, status);
+            }
+            break;
+        case START_START:
+            fFirstStarts->addElement(patIndex, status);
+            break;
+        default:
+            fAnyStarts->addElement(patIndex, status);
+            break;
+        }
+    }
+    uhash_close(setIndexes);
+    if (U_FAILURE(status)) {
+        return;
+    }
+
+    for (UChar32 c = 0; c < 256; c++) {
+        fByteStartIndex->addElement(fByteStarts->size(), status);
+        for (int32_t i = 0; i < charStarts.size(); i++) {
+            int32_t patIndex = charStarts.elementAti(i);
+            if (((const RegexPattern *)fPatterns->elementAt(patIndex))->fInitialChars8->contains(c)) {
+                fByteStarts->addElement(patIndex, status);
+            }
+        }
+    }
+    fByteStartIndex->addElement(fByteStarts->size(), status);
+
+    int32_t numSets = combined->fSets->size();
+    combined->fSets8 = new Regex8BitSet[numSets];
+    if (combined->fSets8 == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    for (int32_t i = 0; i < numSets; i++) {
+        combined->fSets8[i].init((UnicodeSet *)combined->fSets->elementAt(i));
+    }
+    if (U_SUCCESS(status) && combinedPat->size() > 0) {
+        fCombinedMatcher = combined->matcher(status);
+    }
+}
+
+
+int32_t RegexSet::size() const {
+    return fPatterns->size();
+}
+
+
+const RegexPattern *RegexSet::getPattern(int32_t index) const {
+    if (index < 0 || index >= fPatterns->size()) {
+        return NULL;
+    }
+    return (const RegexPattern *)fPatterns->elementAt(index);
+}
+
+
+//--------------------------------------------------------------------------
+//
+//   findAll
+//
+//--------------------------------------------------------------------------
+int32_t RegexSet::findAll(const UnicodeString &input, int32_t *indexes, int32_t capacity,
+                          UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    UText inputText = UTEXT_INITIALIZER;
+    utext_openConstUnicodeString(&inputText, &input, &status);
+    int32_t count = findAll(&inputText, indexes, capacity, status);
+    utext_close(&inputText);
+    return count;
+}
+
+
+int32_t RegexSet::findAll(UText *input, int32_t *indexes, int32_t capacity, UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    if (input == NULL || capacity < 0 || (indexes == NULL && capacity > 0)) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    int32_t patternCount = fPatterns->size();
+    for (int32_t i = 0; i < patternCount; i++) {
+        fMatched[i]  = FALSE;
+        fExcluded[i] = FALSE;
+    }
+
+    if (fCombinedMatcher != NULL) {
+        fCombinedMatcher->reset(input);
+        // A pattern with a literal string that all of its matches contain, or begin with,
+        //   can not match if the string is not in the input.  Leave it out of the
+        //   combined pass.
+        UText   *text        = fCombinedMatcher->fInputText;
+        int64_t  inputLength = fCombinedMatcher->fInputLength;
+        if (UTEXT_FULL_TEXT_IN_CHUNK(text, inputLength)) {
+            const int32_t *startLocs = fStartLocs->getBuffer();
+            for (int32_t i = 0; i < patternCount; i++) {
+                if (startLocs[i] < 0) {
+                    continue;
+                }
+                const RegexPattern      *pattern     = (const RegexPattern *)fPatterns->elementAt(i);
+                const UChar             *literalText = pattern->fLiteralText.getBuffer();
+                const RegexStringSearch *required    = pattern->fRequiredStringSearch;
+                if (required->fStringLen == 0 && pattern->fStartType == START_STRING) {
+                    required = pattern->fInitialStringSearch;
+                }
+                if (required->fStringLen > 0 &&
+                        required->search(literalText, text->chunkContents, 0, (int32_t)inputLength) < 0) {
+                    fMatched[i]  = TRUE;
+                    fExcluded[i] = TRUE;
+                }
+            }
+        }
+        fCombinedMatcher->MatchNFASet(*this, fMatched, status);
+        for (int32_t i = 0; i < patternCount; i++) {
+            if (fExcluded[i]) {
+                fMatched[i] = FALSE;
+            }
+        }
+    }
+    for (int32_t i = 0; i < patternCount && U_SUCCESS(status); i++) {
+        if (fMatchers[i] != NULL) {
+            fMatchers[i]->reset(input);
+            fMatched[i] = fMatchers[i]->find(status);
+        }
+    }
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+
+    int32_t count = 0;
+    for (int32_t i = 0; i < patternCount; i++) {
+        if (fMatched[i]) {
+            if (count < capacity) {
+                indexes[count] = i;
+            }
+            count++;
+        }
+    }
+    if (count > capacity) {
+        status = U_BUFFER_OVERFLOW_ERROR;
+    }
+    return count;
+}
+
+U_NAMESPACE_END
+
+#endif  // !UCONFIG_NO_REGULAR_EXPRESSIONS
@@ -16,6 +16,7 @@
 
 #include <cmath>
 #include <functional>
+#include <mutex>
 #include "unicode/dtfmtsym.h"
 #include "unicode/ucasemap.h"
 #include "unicode/ureldatefmt.h"
@@ -30,7 +31,9 @@
 #include "unicode/simpleformatter.h"
 #include "uresimp.h"
 #include "unicode/ures.h"
+#include "cmemory.h"
 #include "cstring.h"
+#include "hash.h"
 #include "ucln_in.h"
 #include "mutex.h"
 #include "charstr.h"
@@ -746,13 +749,97 @@ FormattedRelativeDateTimeData::~FormattedRelativeDateTimeData() = default;
 UPRV_FORMATTED_VALUE_SUBCLASS_AUTO_IMPL(FormattedRelativeDateTime)
 
 
+namespace {
+
+// Memo keys start with one of these, for the format function,
+// followed by the function's arguments.
+enum {
+    kMemoFormat,
+    kMemoFormatNumeric,
+    kMemoFormatAbsolute,
+    kMemoFormatRelative
+};
+
+// Only small whole quantities, like "in 3 days", repeat often enough to memoize.
+// Other quantities, and -0 which formats differently from 0, are not memoized.
+const int32_t MAX_MEMO_QUANTITY = 100;
+
+UBool appendArgToMemoKey(UnicodeString &key, double d) {
+    if (!(-MAX_MEMO_QUANTITY <= d && d <= MAX_MEMO_QUANTITY) ||
+            d != std::floor(d) || (d == 0 && std::signbit(d))) {
+        return FALSE;
+    }
+    key.append((char16_t)(int32_t)d);
+    return TRUE;
+}
+
+UBool appendArgToMemoKey(UnicodeString &key, int32_t i) {
+    key.append((char16_t)i);
+    return TRUE;
+}
+
+UBool appendToMemoKey(UnicodeString &) { return TRUE; }
+
+/**
+ * Appends the format function arguments to the memo key.
+ * Returns FALSE if the result is not to be memoized.
+ */
+template<typename T, typename... Args>
+UBool appendToMemoKey(UnicodeString &key, T arg, Args... args) {
+    return appendArgToMemoKey(key, arg) && appendToMemoKey(key, args...);
+}
+
+}  // namespace
+
+// Results of the UnicodeString format functions, keyed by function and arguments.
+// The results depend only on the formatter's immutable state,
+// so the memo is shared by a formatter and its copies, and has its own lock.
+class RelativeDateTimeFormatMemo : public SharedObject {
+public:
+    RelativeDateTimeFormatMemo(UErrorCode &status) : fResults(status) {
+        if (U_SUCCESS(status)) {
+            fResults.setValueDeleter(uprv_deleteUObject);
+        }
+    }
+    virtual ~RelativeDateTimeFormatMemo();
+    /** Appends the result for the key and returns TRUE, or returns FALSE if there is none. */
+    UBool get(const UnicodeString &key, UnicodeString &appendTo) const {
+        std::lock_guard<std::mutex> lock(fMutex);
+        const UnicodeString *result = static_cast<const UnicodeString *>(fResults.get(key));
+        if (result == nullptr) {
+            return FALSE;
+        }
+        appendTo.append(*result);
+        return TRUE;
+    }
+    void put(const UnicodeString &key, const UnicodeString &result, UErrorCode &status) {
+        std::lock_guard<std::mutex> lock(fMutex);
+        if (fResults.count() >= MAX_RESULTS) {
+            fResults.removeAll();
+        }
+        LocalPointer<UnicodeString> value(new UnicodeString(result), status);
+        if (U_SUCCESS(status)) {
+            fResults.put(key, value.orphan(), status);
+        }
+    }
+private:
+    // Bound on the number of results; the memo starts over when it is full.
+    static const int32_t MAX_RESULTS = 256;
+    mutable std::mutex fMutex;
+    Hashtable fResults;
+};
+
+RelativeDateTimeFormatMemo::~RelativeDateTimeFormatMemo() {}
+
+
 RelativeDateTimeFormatter::RelativeDateTimeFormatter(UErrorCode& status) :
         fCache(nullptr),
         fNumberFormat(nullptr),
         fPluralRules(nullptr),
         fStyle(UDAT_STYLE_LONG),
         fContext(UDISPCTX_CAPITALIZATION_NONE),
-        fOptBreakIterator(nullptr) {
+        fOptBreakIterator(nullptr),
+        fMemo(nullptr) {
     init(nullptr, nullptr, status);
 }
 
@@ -764,7 +851,8 @@ RelativeDateTimeFormatter::RelativeDateTimeFormatter(
         fStyle(UDAT_STYLE_LONG),
         fContext(UDISPCTX_CAPITALIZATION_NONE),
         fOptBreakIterator(nullptr),
-        fLocale(locale) {
+        fLocale(locale),
+        fMemo(nullptr) {
     init(nullptr, nullptr, status);
 }
 
@@ -776,7 +864,8 @@ RelativeDateTimeFormatter::RelativeDateTimeFormatter(
         fStyle(UDAT_STYLE_LONG),
         fContext(UDISPCTX_CAPITALIZATION_NONE),
         fOptBreakIterator(nullptr),
-        fLocale(locale) {
+        fLocale(locale),
+        fMemo(nullptr) {
     init(nfToAdopt, nullptr, status);
 }
 
@@ -792,7 +881,8 @@ RelativeDateTimeFormatter::RelativeDateTimeFormatter(
         fStyle(styl),
         fContext(capitalizationContext),
         fOptBreakIterator(nullptr),
-        fLocale(locale) {
+        fLocale(locale),
+        fMemo(nullptr) {
     if (U_FAILURE(status)) {
         return;
     }
@@ -820,13 +910,17 @@ RelativeDateTimeFormatter::RelativeDateTimeFormatter(
           fStyle(other.fStyle),
           fContext(other.fContext),
           fOptBreakIterator(other.fOptBreakIterator),
-          fLocale(other.fLocale) {
+          fLocale(other.fLocale),
+          fMemo(other.fMemo) {
     fCache->addRef();
     fNumberFormat->addRef();
     fPluralRules->addRef();
     if (fOptBreakIterator != nullptr) {
       fOptBreakIterator->addRef();
     }
+    if (fMemo != nullptr) {
+      fMemo->addRef();
+    }
 }
 
 RelativeDateTimeFormatter& RelativeDateTimeFormatter::operator=(
@@ -839,6 +933,15 @@ RelativeDateTimeFormatter& RelativeDateTimeFormatter::operator=(
         fStyle = other.fStyle;
         fContext = other.fContext;
         fLocale = other.fLocale;
+        if (fMemo != other.fMemo) {
+            if (fMemo != nullptr) {
+                fMemo->removeRef();
+            }
+            fMemo = other.fMemo;
+            if (fMemo != nullptr) {
+                fMemo->addRef();
+            }
+        }
     }
     return *this;
 }
@@ -856,6 +959,9 @@ RelativeDateTimeFormatter::~RelativeDateTimeFormatter() {
     if (fOptBreakIterator != nullptr) {
         fOptBreakIterator->removeRef();
     }
+    if (fMemo != nullptr) {
+        fMemo->removeRef();
+    }
 }
 
 const NumberFormat& RelativeDateTimeFormatter::getNumberFormat() const {
@@ -873,20 +979,40 @@ UDateRelativeDateTimeFormatterStyle RelativeDateTimeFormatter::getFormatStyle()
 
 // To reduce boilerplate code, we use a helper function that forwards variadic
 // arguments to the formatImpl function.
+// Most callers format the same few small quantities and units over and over,
+// so those results are memoized.
 
 template<typename F, typename... Args>
 UnicodeString& RelativeDateTimeFormatter::doFormat(
         F callback,
+        char16_t memoKind,
         UnicodeString& appendTo,
         UErrorCode& status,
         Args... args) const {
+    if (U_FAILURE(status)) {
+        return appendTo;
+    }
+    UnicodeString memoKey(memoKind);
+    RelativeDateTimeFormatMemo *memo = nullptr;
+    if (fMemo != nullptr && appendToMemoKey(memoKey, args...)) {
+        if (fMemo->get(memoKey, appendTo)) {
+            return appendTo;
+        }
+        memo = fMemo;
+    }
     FormattedRelativeDateTimeData output;
     (this->*callback)(std::forward<Args>(args)..., output, status);
     if (U_FAILURE(status)) {
         return appendTo;
     }
     UnicodeString result = output.getStringRef().toUnicodeString();
-    return appendTo.append(adjustForContext(result));
+    adjustForContext(result);
+    if (memo != nullptr) {
+        // The memo is an optimization: Ignore failures to add to it.
+        UErrorCode memoStatus = U_ZERO_ERROR;
+        memo->put(memoKey, result, memoStatus);
+    }
+    return appendTo.append(result);
 }
 
 template<typename F, typename... Args>
@@ -915,6 +1041,7 @@ UnicodeString& RelativeDateTimeFormatter::format(
         UErrorCode& status) const {
     return doFormat(
         &RelativeDateTimeFormatter::formatImpl,
+        kMemoFormat,
         appendTo,
         status,
         quantity,
@@ -982,6 +1109,7 @@ UnicodeString& RelativeDateTimeFormatter::formatNumeric(
         UErrorCode& status) const {
     return doFormat(
         &RelativeDateTimeFormatter::formatNumericImpl,
+        kMemoFormatNumeric,
         appendTo,
         status,
         offset,
@@ -1050,6 +1178,7 @@ UnicodeString& RelativeDateTimeFormatter::format(
         UErrorCode& status) const {
     return doFormat(
         &RelativeDateTimeFormatter::formatAbsoluteImpl,
+        kMemoFormatAbsolute,
         appendTo,
         status,
         direction,
@@ -1094,6 +1223,7 @@ UnicodeString& RelativeDateTimeFormatter::format(
         UErrorCode& status) const {
     return doFormat(
         &RelativeDateTimeFormatter::formatRelativeImpl,
+        kMemoFormatRelative,
         appendTo,
         status,
         offset,
@@ -1254,6 +1384,16 @@ void RelativeDateTimeFormatter::init(
         bi.orphan();
         SharedObject::copyPtr(shared, fOptBreakIterator);
     }
+    // The memo is an optimization: Ignore failures to start it.
+    if (fMemo == nullptr) {
+        UErrorCode memoStatus = U_ZERO_ERROR;
+        LocalPointer<RelativeDateTimeFormatMemo> memo(
+            new RelativeDateTimeFormatMemo(memoStatus), memoStatus);
+        if (U_SUCCESS(memoStatus)) {
+            fMemo = memo.orphan();
+            fMemo->addRef();
+        }
+    }
 }
 
 U_NAMESPACE_END
@@ -23,6 +23,7 @@
 #include "unicode/rbbi.h"
 #include "unicode/utf.h"
 #include "unicode/utf16.h"
+#include "unicode/utf8.h"
 #include "uassert.h"
 #include "cmemory.h"
 #include "cstr.h"
@@ -53,6 +54,12 @@ static const int32_t DEFAULT_BACKTRACK_STACK_CAPACITY = 8000000;
 //   This constant determines that state saves per tick number.
 static const int32_t TIMER_INITIAL_VALUE = 10000;
 
+// Backtrack stack capacity for matchers made by RegexPattern::acquireMatcher(),
+//   in stack frames of the pattern, and the most that a pooled matcher keeps,
+//   in 64 bit stack elements.
+static const int32_t POOLED_MATCHER_STACK_FRAMES = 64;
+static const int32_t POOLED_MATCHER_STACK_RETAIN = 65536;
+
 
 // Test for any of the Unicode line terminating characters.
 static inline UBool isLineTerminator(UChar32 c) {
@@ -179,6 +186,7 @@ RegexMatcher::~RegexMatcher() {
     delete fWordBreakItr;
     delete fGCBreakItr;
     #endif
+    delete fNFAWorkspace;
 }
 
 //
@@ -215,6 +223,8 @@ void RegexMatcher::init(UErrorCode &status) {
     fTime              = 0;
     fTickCounter       = 0;
     fStackLimit        = DEFAULT_BACKTRACK_STACK_CAPACITY;
+    fMaxStackSize      = 0;
+    fStateSaves        = 0;
     fCallbackFn        = NULL;
     fCallbackContext   = NULL;
     fFindProgressCallbackFn      = NULL;
@@ -224,6 +234,7 @@ void RegexMatcher::init(UErrorCode &status) {
     fData              = fSmallData;
     fWordBreakItr      = NULL;
     fGCBreakItr        = NULL;
+    fNFAWorkspace      = NULL;
 
     fStack             = NULL;
     fInputText         = NULL;
@@ -231,6 +242,7 @@ void RegexMatcher::init(UErrorCode &status) {
     fInput             = NULL;
     fInputLength       = 0;
     fInputUniStrMaybeMutable = FALSE;
+    fInputUTF8         = NULL;
 }
 
 //
@@ -637,6 +649,9 @@ UBool RegexMatcher::find(UErrorCode &status) {
         return FALSE;
     }
 
+    if (fInputUTF8 != NULL) {
+        return findUsingUTF8(status);
+    }
     if (UTEXT_FULL_TEXT_IN_CHUNK(fInputText, fInputLength)) {
         return findUsingChunk(status);
     }
@@ -691,6 +706,18 @@ UBool RegexMatcher::find(UErrorCode &status) {
         testStartLimit = fActiveLimit - (fPattern->fMinMatchLen > 0 ? 1 : 0);
     }
 
+    if (fPattern->fUseNFAEngine && fPattern->fStartType != START_START) {
+        // The linear time engine tries all of the start positions in one pass.
+        MatchNFA(startPos, FALSE, TRUE, status);
+        if (U_FAILURE(status)) {
+            return FALSE;
+        }
+        if (!fMatch) {
+            fHitEnd = TRUE;
+        }
+        return fMatch;
+    }
+
     UChar32  c;
     U_ASSERT(startPos >= 0);
 
@@ -967,6 +994,43 @@ UBool RegexMatcher::findUsingChunk(UErrorCode &status) {
         return FALSE;
     }
 
+    // If there is a literal string that all matches contain, and it does not
+    //   occur in the remaining input, no match is possible.
+    //   Matches anchored at the start are tried once, and left to MatchChunkAt(),
+    //   which determines hitEnd precisely.
+    const UChar *literalText = fPattern->fLiteralText.getBuffer();
+    const RegexStringSearch *required = fPattern->fRequiredStringSearch;
+    if (required->fStringLen > 0 && fPattern->fStartType != START_START &&
+            required->search(literalText, inputBuf, startPos, (int32_t)fActiveLimit) < 0) {
+        fMatch = FALSE;
+        fHitEnd = TRUE;
+        return FALSE;
+    }
+
+    if (fPattern->fUseNFAEngine && fPattern->fStartType != START_START) {
+        // The linear time engine tries all of the start positions in one pass,
+        //   beginning with the first occurrence of any initial string.
+        if (fPattern->fStartType == START_STRING) {
+            int32_t pos = fPattern->fInitialStringSearch->search(literalText, inputBuf,
+                                                                 startPos, (int32_t)fActiveLimit);
+            if (pos < 0 || pos > testLen) {
+                fMatch = FALSE;
+                fHitEnd = TRUE;
+                return FALSE;
+            }
+            U16_SET_CP_START(inputBuf, startPos, pos);
+            startPos = pos;
+        }
+        MatchNFA(startPos, FALSE, TRUE, status);
+        if (U_FAILURE(status)) {
+            return FALSE;
+        }
+        if (!fMatch) {
+            fHitEnd = TRUE;
+        }
+        return fMatch;
+    }
+
     UChar32  c;
     U_ASSERT(startPos >= 0);
 
@@ -1038,6 +1102,42 @@ UBool RegexMatcher::findUsingChunk(UErrorCode &status) {
     UPRV_UNREACHABLE;
 
     case START_STRING:
+    {
+        // Match starts with a literal string.
+        //   Search for the string, then try a match at each place it occurs.
+        U_ASSERT(fPattern->fMinMatchLen > 0);
+        const RegexStringSearch *initial = fPattern->fInitialStringSearch;
+        int32_t searchStart = startPos;
+        for (;;) {
+            int32_t pos = initial->search(literalText, inputBuf, startPos, (int32_t)fActiveLimit);
+            if (pos < 0 || pos > testLen) {
+                fMatch = FALSE;
+                fHitEnd = TRUE;
+                return FALSE;
+            }
+            startPos = pos + 1;
+            // A string that starts with an unpaired trail surrogate can not match
+            //   the second half of a surrogate pair.
+            if (!(U16_IS_TRAIL(inputBuf[pos]) && pos > searchStart && U16_IS_LEAD(inputBuf[pos-1]))) {
+                MatchChunkAt(pos, FALSE, status);
+                if (U_FAILURE(status)) {
+                    return FALSE;
+                }
+                if (fMatch) {
+                    return TRUE;
+                }
+            }
+            if (startPos > testLen) {
+                fMatch = FALSE;
+                fHitEnd = TRUE;
+                return FALSE;
+            }
+            if  (findProgressInterrupt(startPos, status))
+                return FALSE;
+        }
+    }
+    UPRV_UNREACHABLE;
+
     case START_CHAR:
     {
         // Match starts on exactly one char.
@@ -1142,248 +1242,516 @@ UBool RegexMatcher::findUsingChunk(UErrorCode &status) {
 }
 
 
-
 //--------------------------------------------------------------------------------
 //
-//  group()
+//   findUsingUTF8() -- like find(), but for UTF-8 input set with resetUTF8().
+//                      Start positions are scanned for directly in the input bytes.
 //
 //--------------------------------------------------------------------------------
-UnicodeString RegexMatcher::group(UErrorCode &status) const {
-    return group(0, status);
-}
-
-//  Return immutable shallow clone
-UText *RegexMatcher::group(UText *dest, int64_t &group_len, UErrorCode &status) const {
-    return group(0, dest, group_len, status);
-}
-
-//  Return immutable shallow clone
-UText *RegexMatcher::group(int32_t groupNum, UText *dest, int64_t &group_len, UErrorCode &status) const {
-    group_len = 0;
-    if (U_FAILURE(status)) {
-        return dest;
-    }
-    if (U_FAILURE(fDeferredStatus)) {
-        status = fDeferredStatus;
-    } else if (fMatch == FALSE) {
-        status = U_REGEX_INVALID_STATE;
-    } else if (groupNum < 0 || groupNum > fPattern->fGroupMap->size()) {
-        status = U_INDEX_OUTOFBOUNDS_ERROR;
-    }
-
-    if (U_FAILURE(status)) {
-        return dest;
-    }
-
-    int64_t s, e;
-    if (groupNum == 0) {
-        s = fMatchStart;
-        e = fMatchEnd;
-    } else {
-        int32_t groupOffset = fPattern->fGroupMap->elementAti(groupNum-1);
-        U_ASSERT(groupOffset < fPattern->fFrameSize);
-        U_ASSERT(groupOffset >= 0);
-        s = fFrame->fExtra[groupOffset];
-        e = fFrame->fExtra[groupOffset+1];
-    }
+UBool RegexMatcher::findUsingUTF8(UErrorCode &status) {
+    // Start at the position of the last match end.  (Will be zero if the
+    //   matcher has been reset.
+    //
 
-    if (s < 0) {
-        // A capture group wasn't part of the match
-        return utext_clone(dest, fInputText, FALSE, TRUE, &status);
+    int32_t startPos = (int32_t)fMatchEnd;
+    if (startPos==0) {
+        startPos = (int32_t)fActiveStart;
     }
-    U_ASSERT(s <= e);
-    group_len = e - s;
-
-    dest = utext_clone(dest, fInputText, FALSE, TRUE, &status);
-    if (dest)
-        UTEXT_SETNATIVEINDEX(dest, s);
-    return dest;
-}
 
-UnicodeString RegexMatcher::group(int32_t groupNum, UErrorCode &status) const {
-    UnicodeString result;
-    int64_t groupStart = start64(groupNum, status);
-    int64_t groupEnd = end64(groupNum, status);
-    if (U_FAILURE(status) || groupStart == -1 || groupStart == groupEnd) {
-        return result;
-    }
+    const uint8_t *inputBuf = fInputUTF8;
 
-    // Get the group length using a utext_extract preflight.
-    //    UText is actually pretty efficient at this when underlying encoding is UTF-16.
-    int32_t length = utext_extract(fInputText, groupStart, groupEnd, NULL, 0, &status);
-    if (status != U_BUFFER_OVERFLOW_ERROR) {
-        return result;
-    }
+    if (fMatch) {
+        // Save the position of any previous successful match.
+        fLastMatchEnd = fMatchEnd;
 
-    status = U_ZERO_ERROR;
-    UChar *buf = result.getBuffer(length);
-    if (buf == NULL) {
-        status = U_MEMORY_ALLOCATION_ERROR;
+        if (fMatchStart == fMatchEnd) {
+            // Previous match had zero length.  Move start position up one position
+            //  to avoid sending find() into a loop on zero-length matches.
+            if (startPos >= fActiveLimit) {
+                fMatch = FALSE;
+                fHitEnd = TRUE;
+                return FALSE;
+            }
+            U8_FWD_1(inputBuf, startPos, fInputLength);
+        }
     } else {
-        int32_t extractLength = utext_extract(fInputText, groupStart, groupEnd, buf, length, &status);
-        result.releaseBuffer(extractLength);
-        U_ASSERT(length == extractLength);
+        if (fLastMatchEnd >= 0) {
+            // A previous find() failed to match.  Don't try again.
+            //   (without this test, a pattern with a zero-length match
+            //    could match again at the end of an input string.)
+            fHitEnd = TRUE;
+            return FALSE;
+        }
     }
-    return result;
-}
 
 
-//--------------------------------------------------------------------------------
-//
-//  appendGroup() -- currently internal only, appends a group to a UText rather
-//                   than replacing its contents
-//
-//--------------------------------------------------------------------------------
-
-int64_t RegexMatcher::appendGroup(int32_t groupNum, UText *dest, UErrorCode &status) const {
-    if (U_FAILURE(status)) {
-        return 0;
-    }
-    if (U_FAILURE(fDeferredStatus)) {
-        status = fDeferredStatus;
-        return 0;
+    // Compute the position in the input string beyond which a match can not begin, because
+    //   the minimum length match would extend past the end of the input.
+    //   The minimum match length is in UTF-16 code units, each of which takes at least
+    //   one byte, so it is also a lower bound on the length in bytes.
+    //   Note:  some patterns that cannot match anything will have fMinMatchLength==Max Int.
+    //          Be aware of possible overflows if making changes here.
+    //   Note:  a match can begin at inputBuf + testLen; it is an inclusive limit.
+    int32_t testLen  = (int32_t)(fActiveLimit - fPattern->fMinMatchLen);
+    if (startPos > testLen) {
+        fMatch = FALSE;
+        fHitEnd = TRUE;
+        return FALSE;
     }
-    int64_t destLen = utext_nativeLength(dest);
 
-    if (fMatch == FALSE) {
-        status = U_REGEX_INVALID_STATE;
-        return utext_replace(dest, destLen, destLen, NULL, 0, &status);
-    }
-    if (groupNum < 0 || groupNum > fPattern->fGroupMap->size()) {
-        status = U_INDEX_OUTOFBOUNDS_ERROR;
-        return utext_replace(dest, destLen, destLen, NULL, 0, &status);
+    if (fPattern->fUseNFAEngine && fPattern->fStartType != START_START) {
+        // The linear time engine tries all of the start positions in one pass.
+        MatchNFA(startPos, FALSE, TRUE, status);
+        if (U_FAILURE(status)) {
+            return FALSE;
+        }
+        if (!fMatch) {
+            fHitEnd = TRUE;
+        }
+        return fMatch;
     }
 
-    int64_t s, e;
-    if (groupNum == 0) {
-        s = fMatchStart;
-        e = fMatchEnd;
-    } else {
-        int32_t groupOffset = fPattern->fGroupMap->elementAti(groupNum-1);
-        U_ASSERT(groupOffset < fPattern->fFrameSize);
-        U_ASSERT(groupOffset >= 0);
-        s = fFrame->fExtra[groupOffset];
-        e = fFrame->fExtra[groupOffset+1];
-    }
+    UChar32  c;
+    U_ASSERT(startPos >= 0);
 
-    if (s < 0) {
-        // A capture group wasn't part of the match
-        return utext_replace(dest, destLen, destLen, NULL, 0, &status);
-    }
-    U_ASSERT(s <= e);
+    switch (fPattern->fStartType) {
+    case START_NO_INFO:
+        // No optimization was found.
+        //  Try a match at each input position.
+        for (;;) {
+            MatchUTF8At(startPos, FALSE, status);
+            if (U_FAILURE(status)) {
+                return FALSE;
+            }
+            if (fMatch) {
+                return TRUE;
+            }
+            if (startPos >= testLen) {
+                fHitEnd = TRUE;
+                return FALSE;
+            }
+            U8_FWD_1(inputBuf, startPos, fActiveLimit);
+            // Note that it's perfectly OK for a pattern to have a zero-length
+            //   match at the end of a string, so we must make sure that the loop
+            //   runs with startPos == testLen the last time through.
+            if  (findProgressInterrupt(startPos, status))
+                return FALSE;
+        }
+        UPRV_UNREACHABLE;
 
-    int64_t deltaLen;
-    if (UTEXT_FULL_TEXT_IN_CHUNK(fInputText, fInputLength)) {
-        U_ASSERT(e <= fInputLength);
-        deltaLen = utext_replace(dest, destLen, destLen, fInputText->chunkContents+s, (int32_t)(e-s), &status);
-    } else {
-        int32_t len16;
-        if (UTEXT_USES_U16(fInputText)) {
-            len16 = (int32_t)(e-s);
-        } else {
-            UErrorCode lengthStatus = U_ZERO_ERROR;
-            len16 = utext_extract(fInputText, s, e, NULL, 0, &lengthStatus);
+    case START_START:
+        // Matches are only possible at the start of the input string
+        //   (pattern begins with ^ or \A)
+        if (startPos > fActiveStart) {
+            fMatch = FALSE;
+            return FALSE;
         }
-        UChar *groupChars = (UChar *)uprv_malloc(sizeof(UChar)*(len16+1));
-        if (groupChars == NULL) {
-            status = U_MEMORY_ALLOCATION_ERROR;
-            return 0;
+        MatchUTF8At(startPos, FALSE, status);
+        if (U_FAILURE(status)) {
+            return FALSE;
         }
-        utext_extract(fInputText, s, e, groupChars, len16+1, &status);
+        return fMatch;
 
-        deltaLen = utext_replace(dest, destLen, destLen, groupChars, len16, &status);
-        uprv_free(groupChars);
-    }
-    return deltaLen;
-}
 
+    case START_SET:
+    {
+        // Match may start on any char from a pre-computed set.
+        //   ASCII bytes are tested directly, without decoding; trail bytes
+        //   never start a character and are skipped.
+        U_ASSERT(fPattern->fMinMatchLen > 0);
+        Regex8BitSet *initialChars8 = fPattern->fInitialChars8;
+        for (;;) {
+            int32_t pos = startPos;
+            c = inputBuf[startPos];
+            if (U8_IS_SINGLE(c)) {
+                ++startPos;
+            } else {
+                U8_NEXT_OR_FFFD(inputBuf, startPos, fActiveLimit, c);
+            }
+            if ((c<256 && initialChars8->contains(c)) ||
+                (c>=256 && fPattern->fInitialChars->contains(c))) {
+                MatchUTF8At(pos, FALSE, status);
+                if (U_FAILURE(status)) {
+                    return FALSE;
+                }
+                if (fMatch) {
+                    return TRUE;
+                }
+            }
+            if (startPos > testLen) {
+                fMatch = FALSE;
+                fHitEnd = TRUE;
+                return FALSE;
+            }
+            if  (findProgressInterrupt(startPos, status))
+                return FALSE;
+        }
+    }
+    UPRV_UNREACHABLE;
 
+    case START_STRING:
+    case START_CHAR:
+    {
+        // Match starts on exactly one char, or with a literal string.
+        //   Try a match at each occurrence of the first char; an ASCII one is
+        //   searched for with memchr().
+        U_ASSERT(fPattern->fMinMatchLen > 0);
+        UChar32 theChar = fPattern->fInitialChar;
+        for (;;) {
+            if (theChar < 0x80) {
+                const uint8_t *p = (const uint8_t *)uprv_memchr(inputBuf + startPos, theChar,
+                                                                testLen + 1 - startPos);
+                if (p == NULL) {
+                    fMatch = FALSE;
+                    fHitEnd = TRUE;
+                    return FALSE;
+                }
+                startPos = (int32_t)(p - inputBuf);
+            }
+            int32_t pos = startPos;
+            U8_NEXT_OR_FFFD(inputBuf, startPos, fActiveLimit, c);
+            if (c == theChar) {
+                MatchUTF8At(pos, FALSE, status);
+                if (U_FAILURE(status)) {
+                    return FALSE;
+                }
+                if (fMatch) {
+                    return TRUE;
+                }
+            }
+            if (startPos > testLen) {
+                fMatch = FALSE;
+                fHitEnd = TRUE;
+                return FALSE;
+            }
+            if  (findProgressInterrupt(startPos, status))
+                return FALSE;
+        }
+    }
+    UPRV_UNREACHABLE;
 
-//--------------------------------------------------------------------------------
-//
-//  groupCount()
-//
-//--------------------------------------------------------------------------------
-int32_t RegexMatcher::groupCount() const {
-    return fPattern->fGroupMap->size();
-}
+    case START_LINE:
+    {
+        UChar32 ch;
+        if (startPos == fAnchorStart) {
+            MatchUTF8At(startPos, FALSE, status);
+            if (U_FAILURE(status)) {
+                return FALSE;
+            }
+            if (fMatch) {
+                return TRUE;
+            }
+            U8_FWD_1(inputBuf, startPos, fActiveLimit);
+        }
 
-//--------------------------------------------------------------------------------
-//
-//  hasAnchoringBounds()
-//
-//--------------------------------------------------------------------------------
-UBool RegexMatcher::hasAnchoringBounds() const {
-    return fAnchoringBounds;
-}
+        if (fPattern->fFlags & UREGEX_UNIX_LINES) {
+            for (;;) {
+                ch = inputBuf[startPos-1];
+                if (ch == 0x0a) {
+                    MatchUTF8At(startPos, FALSE, status);
+                    if (U_FAILURE(status)) {
+                        return FALSE;
+                    }
+                    if (fMatch) {
+                        return TRUE;
+                    }
+                }
+                if (startPos >= testLen) {
+                    fMatch = FALSE;
+                    fHitEnd = TRUE;
+                    return FALSE;
+                }
+                U8_FWD_1(inputBuf, startPos, fActiveLimit);
+                // Note that it's perfectly OK for a pattern to have a zero-length
+                //   match at the end of a string, so we must make sure that the loop
+                //   runs with startPos == testLen the last time through.
+                if  (findProgressInterrupt(startPos, status))
+                    return FALSE;
+            }
+        } else {
+            for (;;) {
+                ch = inputBuf[startPos-1];
+                if (!U8_IS_SINGLE(ch)) {
+                    int32_t ix = startPos;
+                    U8_PREV_OR_FFFD(inputBuf, 0, ix, ch);
+                }
+                if (isLineTerminator(ch)) {
+                    if (ch == 0x0d && startPos < fActiveLimit && inputBuf[startPos] == 0x0a) {
+                        startPos++;
+                    }
+                    MatchUTF8At(startPos, FALSE, status);
+                    if (U_FAILURE(status)) {
+                        return FALSE;
+                    }
+                    if (fMatch) {
+                        return TRUE;
+                    }
+                }
+                if (startPos >= testLen) {
+                    fMatch = FALSE;
+                    fHitEnd = TRUE;
+                    return FALSE;
+                }
+                U8_FWD_1(inputBuf, startPos, fActiveLimit);
+                // Note that it's perfectly OK for a pattern to have a zero-length
+                //   match at the end of a string, so we must make sure that the loop
+                //   runs with startPos == testLen the last time through.
+                if  (findProgressInterrupt(startPos, status))
+                    return FALSE;
+            }
+        }
+    }
 
+    default:
+        UPRV_UNREACHABLE;
+    }
 
-//--------------------------------------------------------------------------------
-//
-//  hasTransparentBounds()
-//
-//--------------------------------------------------------------------------------
-UBool RegexMatcher::hasTransparentBounds() const {
-    return fTransparentBounds;
+    UPRV_UNREACHABLE;
 }
 
 
 
 //--------------------------------------------------------------------------------
 //
-//  hitEnd()
+//  group()
 //
 //--------------------------------------------------------------------------------
-UBool RegexMatcher::hitEnd() const {
-    return fHitEnd;
+UnicodeString RegexMatcher::group(UErrorCode &status) const {
+    return group(0, status);
 }
 
+//  Return immutable shallow clone
+UText *RegexMatcher::group(UText *dest, int64_t &group_len, UErrorCode &status) const {
+    return group(0, dest, group_len, status);
+}
 
-//--------------------------------------------------------------------------------
-//
-//  input()
-//
-//--------------------------------------------------------------------------------
-const UnicodeString &RegexMatcher::input() const {
-    if (!fInput) {
-        UErrorCode status = U_ZERO_ERROR;
-        int32_t len16;
-        if (UTEXT_USES_U16(fInputText)) {
-            len16 = (int32_t)fInputLength;
-        } else {
-            len16 = utext_extract(fInputText, 0, fInputLength, NULL, 0, &status);
-            status = U_ZERO_ERROR; // overflow, length status
-        }
-        UnicodeString *result = new UnicodeString(len16, 0, 0);
+//  Return immutable shallow clone
+UText *RegexMatcher::group(int32_t groupNum, UText *dest, int64_t &group_len, UErrorCode &status) const {
+    group_len = 0;
+    if (U_FAILURE(status)) {
+        return dest;
+    }
+    if (U_FAILURE(fDeferredStatus)) {
+        status = fDeferredStatus;
+    } else if (fMatch == FALSE) {
+        status = U_REGEX_INVALID_STATE;
+    } else if (groupNum < 0 || groupNum > fPattern->fGroupMap->size()) {
+        status = U_INDEX_OUTOFBOUNDS_ERROR;
+    }
 
-        UChar *inputChars = result->getBuffer(len16);
-        utext_extract(fInputText, 0, fInputLength, inputChars, len16, &status); // unterminated warning
-        result->releaseBuffer(len16);
+    if (U_FAILURE(status)) {
+        return dest;
+    }
 
-        (*(const UnicodeString **)&fInput) = result; // pointer assignment, rather than operator=
+    int64_t s, e;
+    if (groupNum == 0) {
+        s = fMatchStart;
+        e = fMatchEnd;
+    } else {
+        int32_t groupOffset = fPattern->fGroupMap->elementAti(groupNum-1);
+        U_ASSERT(groupOffset < fPattern->fFrameSize);
+        U_ASSERT(groupOffset >= 0);
+        s = fFrame->fExtra[groupOffset];
+        e = fFrame->fExtra[groupOffset+1];
     }
 
-    return *fInput;
+    if (s < 0) {
+        // A capture group wasn't part of the match
+        return utext_clone(dest, fInputText, FALSE, TRUE, &status);
+    }
+    U_ASSERT(s <= e);
+    group_len = e - s;
+
+    dest = utext_clone(dest, fInputText, FALSE, TRUE, &status);
+    if (dest)
+        UTEXT_SETNATIVEINDEX(dest, s);
+    return dest;
 }
 
-//--------------------------------------------------------------------------------
-//
-//  inputText()
-//
-//--------------------------------------------------------------------------------
-UText *RegexMatcher::inputText() const {
-    return fInputText;
+UnicodeString RegexMatcher::group(int32_t groupNum, UErrorCode &status) const {
+    UnicodeString result;
+    int64_t groupStart = start64(groupNum, status);
+    int64_t groupEnd = end64(groupNum, status);
+    if (U_FAILURE(status) || groupStart == -1 || groupStart == groupEnd) {
+        return result;
+    }
+
+    // Get the group length using a utext_extract preflight.
+    //    UText is actually pretty efficient at this when underlying encoding is UTF-16.
+    int32_t length = utext_extract(fInputText, groupStart, groupEnd, NULL, 0, &status);
+    if (status != U_BUFFER_OVERFLOW_ERROR) {
+        return result;
+    }
+
+    status = U_ZERO_ERROR;
+    UChar *buf = result.getBuffer(length);
+    if (buf == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+    } else {
+        int32_t extractLength = utext_extract(fInputText, groupStart, groupEnd, buf, length, &status);
+        result.releaseBuffer(extractLength);
+        U_ASSERT(length == extractLength);
+    }
+    return result;
 }
 
 
 //--------------------------------------------------------------------------------
 //
-//  getInput() -- like inputText(), but makes a clone or copies into another UText
+//  appendGroup() -- currently internal only, appends a group to a UText rather
+//                   than replacing its contents
 //
 //--------------------------------------------------------------------------------
-UText *RegexMatcher::getInput (UText *dest, UErrorCode &status) const {
+
+int64_t RegexMatcher::appendGroup(int32_t groupNum, UText *dest, UErrorCode &status) const {
     if (U_FAILURE(status)) {
-        return dest;
+        return 0;
+    }
+    if (U_FAILURE(fDeferredStatus)) {
+        status = fDeferredStatus;
+        return 0;
+    }
+    int64_t destLen = utext_nativeLength(dest);
+
+    if (fMatch == FALSE) {
+        status = U_REGEX_INVALID_STATE;
+        return utext_replace(dest, destLen, destLen, NULL, 0, &status);
+    }
+    if (groupNum < 0 || groupNum > fPattern->fGroupMap->size()) {
+        status = U_INDEX_OUTOFBOUNDS_ERROR;
+        return utext_replace(dest, destLen, destLen, NULL, 0, &status);
+    }
+
+    int64_t s, e;
+    if (groupNum == 0) {
+        s = fMatchStart;
+        e = fMatchEnd;
+    } else {
+        int32_t groupOffset = fPattern->fGroupMap->elementAti(groupNum-1);
+        U_ASSERT(groupOffset < fPattern->fFrameSize);
+        U_ASSERT(groupOffset >= 0);
+        s = fFrame->fExtra[groupOffset];
+        e = fFrame->fExtra[groupOffset+1];
+    }
+
+    if (s < 0) {
+        // A capture group wasn't part of the match
+        return utext_replace(dest, destLen, destLen, NULL, 0, &status);
+    }
+    U_ASSERT(s <= e);
+
+    int64_t deltaLen;
+    if (UTEXT_FULL_TEXT_IN_CHUNK(fInputText, fInputLength)) {
+        U_ASSERT(e <= fInputLength);
+        deltaLen = utext_replace(dest, destLen, destLen, fInputText->chunkContents+s, (int32_t)(e-s), &status);
+    } else {
+        int32_t len16;
+        if (UTEXT_USES_U16(fInputText)) {
+            len16 = (int32_t)(e-s);
+        } else {
+            UErrorCode lengthStatus = U_ZERO_ERROR;
+            len16 = utext_extract(fInputText, s, e, NULL, 0, &lengthStatus);
+        }
+        UChar *groupChars = (UChar *)uprv_malloc(sizeof(UChar)*(len16+1));
+        if (groupChars == NULL) {
+            status = U_MEMORY_ALLOCATION_ERROR;
+            return 0;
+        }
+        utext_extract(fInputText, s, e, groupChars, len16+1, &status);
+
+        deltaLen = utext_replace(dest, destLen, destLen, groupChars, len16, &status);
+        uprv_free(groupChars);
+    }
+    return deltaLen;
+}
+
+
+
+//--------------------------------------------------------------------------------
+//
+//  groupCount()
+//
+//--------------------------------------------------------------------------------
+int32_t RegexMatcher::groupCount() const {
+    return fPattern->fGroupMap->size();
+}
+
+//--------------------------------------------------------------------------------
+//
+//  hasAnchoringBounds()
+//
+//--------------------------------------------------------------------------------
+UBool RegexMatcher::hasAnchoringBounds() const {
+    return fAnchoringBounds;
+}
+
+
+//--------------------------------------------------------------------------------
+//
+//  hasTransparentBounds()
+//
+//--------------------------------------------------------------------------------
+UBool RegexMatcher::hasTransparentBounds() const {
+    return fTransparentBounds;
+}
+
+
+
+//--------------------------------------------------------------------------------
+//
+//  hitEnd()
+//
+//--------------------------------------------------------------------------------
+UBool RegexMatcher::hitEnd() const {
+    return fHitEnd;
+}
+
+
+//--------------------------------------------------------------------------------
+//
+//  input()
+//
+//--------------------------------------------------------------------------------
+const UnicodeString &RegexMatcher::input() const {
+    if (!fInput) {
+        UErrorCode status = U_ZERO_ERROR;
+        int32_t len16;
+        if (UTEXT_USES_U16(fInputText)) {
+            len16 = (int32_t)fInputLength;
+        } else {
+            len16 = utext_extract(fInputText, 0, fInputLength, NULL, 0, &status);
+            status = U_ZERO_ERROR; // overflow, length status
+        }
+        UnicodeString *result = new UnicodeString(len16, 0, 0);
+
+        UChar *inputChars = result->getBuffer(len16);
+        utext_extract(fInputText, 0, fInputLength, inputChars, len16, &status); // unterminated warning
+        result->releaseBuffer(len16);
+
+        (*(const UnicodeString **)&fInput) = result; // pointer assignment, rather than operator=
+    }
+
+    return *fInput;
+}
+
+//--------------------------------------------------------------------------------
+//
+//  inputText()
+//
+//--------------------------------------------------------------------------------
+UText *RegexMatcher::inputText() const {
+    return fInputText;
+}
+
+
+//--------------------------------------------------------------------------------
+//
+//  getInput() -- like inputText(), but makes a clone or copies into another UText
+//
+//--------------------------------------------------------------------------------
+UText *RegexMatcher::getInput (UText *dest, UErrorCode &status) const {
+    if (U_FAILURE(status)) {
+        return dest;
     }
     if (U_FAILURE(fDeferredStatus)) {
         status = fDeferredStatus;
@@ -1469,7 +1837,9 @@ UBool RegexMatcher::lookingAt(UErrorCode &status) {
     else {
         resetPreserveRegion();
     }
-    if (UTEXT_FULL_TEXT_IN_CHUNK(fInputText, fInputLength)) {
+    if (fInputUTF8 != NULL) {
+        MatchUTF8At((int32_t)fActiveStart, FALSE, status);
+    } else if (UTEXT_FULL_TEXT_IN_CHUNK(fInputText, fInputLength)) {
         MatchChunkAt((int32_t)fActiveStart, FALSE, status);
     } else {
         MatchAt(fActiveStart, FALSE, status);
@@ -1507,7 +1877,9 @@ UBool RegexMatcher::lookingAt(int64_t start, UErrorCode &status) {
         return FALSE;
     }
 
-    if (UTEXT_FULL_TEXT_IN_CHUNK(fInputText, fInputLength)) {
+    if (fInputUTF8 != NULL) {
+        MatchUTF8At((int32_t)nativeStart, FALSE, status);
+    } else if (UTEXT_FULL_TEXT_IN_CHUNK(fInputText, fInputLength)) {
         MatchChunkAt((int32_t)nativeStart, FALSE, status);
     } else {
         MatchAt(nativeStart, FALSE, status);
@@ -1541,7 +1913,9 @@ UBool RegexMatcher::matches(UErrorCode &status) {
         resetPreserveRegion();
     }
 
-    if (UTEXT_FULL_TEXT_IN_CHUNK(fInputText, fInputLength)) {
+    if (fInputUTF8 != NULL) {
+        MatchUTF8At((int32_t)fActiveStart, TRUE, status);
+    } else if (UTEXT_FULL_TEXT_IN_CHUNK(fInputText, fInputLength)) {
         MatchChunkAt((int32_t)fActiveStart, TRUE, status);
     } else {
         MatchAt(fActiveStart, TRUE, status);
@@ -1579,7 +1953,9 @@ UBool RegexMatcher::matches(int64_t start, UErrorCode &status) {
         return FALSE;
     }
 
-    if (UTEXT_FULL_TEXT_IN_CHUNK(fInputText, fInputLength)) {
+    if (fInputUTF8 != NULL) {
+        MatchUTF8At((int32_t)nativeStart, TRUE, status);
+    } else if (UTEXT_FULL_TEXT_IN_CHUNK(fInputText, fInputLength)) {
         MatchChunkAt((int32_t)nativeStart, TRUE, status);
     } else {
         MatchAt(nativeStart, TRUE, status);
@@ -1834,6 +2210,8 @@ void RegexMatcher::resetPreserveRegion() {
     fRequireEnd     = FALSE;
     fTime           = 0;
     fTickCounter    = TIMER_INITIAL_VALUE;
+    fMaxStackSize   = 0;
+    fStateSaves     = 0;
     //resetStack(); // more expensive than it looks...
 }
 
@@ -1855,6 +2233,7 @@ RegexMatcher &RegexMatcher::reset(const UnicodeString &input) {
     //  Do the following for any UnicodeString.
     //  This is for compatibility for those clients who modify the input string "live" during regex operations.
     fInputUniStrMaybeMutable = TRUE;
+    fInputUTF8 = NULL;
 
 #if UCONFIG_NO_BREAK_ITERATION==0
     if (fWordBreakItr) {
@@ -1892,6 +2271,43 @@ RegexMatcher &RegexMatcher::reset(UText *input) {
     }
     reset();
     fInputUniStrMaybeMutable = FALSE;
+    fInputUTF8 = NULL;
+
+    return *this;
+}
+
+
+RegexMatcher &RegexMatcher::resetUTF8(StringPiece input, UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return *this;
+    }
+    // The UText serves everything other than matching: group extraction,
+    //   replacement, break iteration.  Its native indexes are byte offsets,
+    //   like those of the UTF-8 match engine.
+    fInputText = utext_openUTF8(fInputText, input.data(), input.length(), &fDeferredStatus);
+    if (fPattern->fNeedsAltInput) {
+        fAltInputText = utext_clone(fAltInputText, fInputText, FALSE, TRUE, &fDeferredStatus);
+    }
+    if (U_FAILURE(fDeferredStatus)) {
+        status = fDeferredStatus;
+        return *this;
+    }
+    fInputLength = input.length();
+
+    reset();
+    delete fInput;
+    fInput = NULL;
+    fInputUniStrMaybeMutable = FALSE;
+    fInputUTF8 = (const uint8_t *)input.data();
+
+#if UCONFIG_NO_BREAK_ITERATION==0
+    if (fWordBreakItr) {
+        fWordBreakItr->setText(fInputText, fDeferredStatus);
+    }
+    if (fGCBreakItr) {
+        fGCBreakItr->setText(fInputText, fDeferredStatus);
+    }
+#endif
 
     return *this;
 }
@@ -1940,6 +2356,7 @@ RegexMatcher &RegexMatcher::refreshInputText(UText *input, UErrorCode &status) {
         return *this;
     }
     utext_setNativeIndex(fInputText, pos);
+    fInputUTF8 = NULL;
 
     if (fAltInputText != NULL) {
         pos = utext_getNativeIndex(fAltInputText);
@@ -2419,6 +2836,73 @@ int32_t RegexMatcher::getStackLimit() const {
 }
 
 
+//--------------------------------------------------------------------------------
+//
+//     Match statistics.  getMaxStackSize() reports in the units of setStackLimit(),
+//                        which counts the stack's int64_t elements as 32 bit words.
+//
+//--------------------------------------------------------------------------------
+int32_t RegexMatcher::getMaxStackSize() const {
+    return fMaxStackSize * (int32_t)sizeof(int32_t);
+}
+
+int64_t RegexMatcher::getStateSaveCount() const {
+    return fStateSaves;
+}
+
+int64_t RegexMatcher::getMatchSteps() const {
+    return (int64_t)fTime * TIMER_INITIAL_VALUE + (TIMER_INITIAL_VALUE - fTickCounter);
+}
+
+
+//--------------------------------------------------------------------------------
+//
+//     preallocateStack    Give the backtrack stack of a new pooled matcher room for
+//                         some frames up front, within the stack limit.
+//                         The stack keeps whatever it grows to after that.
+//
+//--------------------------------------------------------------------------------
+void RegexMatcher::preallocateStack(UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return;
+    }
+    int32_t capacity = fPattern->fFrameSize * POOLED_MATCHER_STACK_FRAMES;
+    if (fStackLimit > 0 && capacity > fStackLimit / (int32_t)sizeof(int32_t)) {
+        capacity = fStackLimit / (int32_t)sizeof(int32_t);
+    }
+    fStack->ensureCapacity(capacity, status);
+}
+
+
+//--------------------------------------------------------------------------------
+//
+//     resetForPool    Return a released matcher to the state of one newly
+//                     made by RegexPattern::acquireMatcher(), keeping its storage.
+//                     Returns FALSE if the matcher is unusable, and should be deleted.
+//
+//--------------------------------------------------------------------------------
+UBool RegexMatcher::resetForPool() {
+    if (U_FAILURE(fDeferredStatus) || fPatternOwned != NULL) {
+        return FALSE;
+    }
+    fTimeLimit         = 0;
+    fCallbackFn        = NULL;
+    fCallbackContext   = NULL;
+    fFindProgressCallbackFn      = NULL;
+    fFindProgressCallbackContext = NULL;
+    fTransparentBounds = FALSE;
+    fAnchoringBounds   = TRUE;
+    fTraceDebug        = FALSE;
+
+    // Do not let one pathological match leave a huge stack in the pool.
+    fStack->setMaxCapacity(POOLED_MATCHER_STACK_RETAIN);
+    UErrorCode status = U_ZERO_ERROR;
+    setStackLimit(DEFAULT_BACKTRACK_STACK_CAPACITY, status);
+    reset(RegexStaticSets::gStaticSets->fEmptyText);
+    return U_SUCCESS(status) && U_SUCCESS(fDeferredStatus);
+}
+
+
 //--------------------------------------------------------------------------------
 //
 //     setMatchCallback
@@ -2508,6 +2992,9 @@ REStackFrame *RegexMatcher::resetStack() {
     if(U_FAILURE(fDeferredStatus)) {
         return NULL;
     }
+    if (fMaxStackSize < fStack->size()) {
+        fMaxStackSize = fStack->size();
+    }
 
     int32_t i;
     for (i=0; i<fPattern->fFrameSize-RESTACKFRAME_HDRCOUNT; i++) {
@@ -2609,35 +3096,74 @@ UBool RegexMatcher::isChunkWordBoundary(int32_t pos) {
     return isBoundary;
 }
 
-//--------------------------------------------------------------------------------
-//
-//   isUWordBoundary
-//
-//         Test for a word boundary using RBBI word break.
-//
-//          parameters:   pos   - the current position in the input buffer
-//
-//--------------------------------------------------------------------------------
-UBool RegexMatcher::isUWordBoundary(int64_t pos, UErrorCode &status) {
-    UBool       returnVal = FALSE;
+UBool RegexMatcher::isUTF8WordBoundary(int32_t pos) {
+    UBool isBoundary = FALSE;
+    UBool cIsWord    = FALSE;
 
-#if UCONFIG_NO_BREAK_ITERATION==0
-    // Note: this point will never be reached if break iteration is configured out.
-    //       Regex patterns that would require this function will fail to compile.
+    const uint8_t *inputBuf = fInputUTF8;
 
-    // If we haven't yet created a break iterator for this matcher, do it now.
-    if (fWordBreakItr == nullptr) {
-        fWordBreakItr = BreakIterator::createWordInstance(Locale::getEnglish(), status);
-        if (U_FAILURE(status)) {
+    if (pos >= fLookLimit) {
+        fHitEnd = TRUE;
+    } else {
+        // Determine whether char c at current position is a member of the word set of chars.
+        // If we're off the end of the string, behave as though we're not at a word char.
+        UChar32 c;
+        U8_GET_OR_FFFD(inputBuf, (int32_t)fLookStart, pos, fLookLimit, c);
+        if (u_hasBinaryProperty(c, UCHAR_GRAPHEME_EXTEND) || u_charType(c) == U_FORMAT_CHAR) {
+            // Current char is a combining one.  Not a boundary.
             return FALSE;
         }
-        fWordBreakItr->setText(fInputText, status);
+        cIsWord = RegexStaticSets::gStaticSets->fPropSets[URX_ISWORD_SET].contains(c);
     }
 
-    // Note: zero width boundary tests like \b see through transparent region bounds,
-    //       which is why fLookLimit is used here, rather than fActiveLimit.
-    if (pos >= fLookLimit) {
-        fHitEnd = TRUE;
+    // Back up until we come to a non-combining char, determine whether
+    //  that char is a word char.
+    UBool prevCIsWord = FALSE;
+    for (;;) {
+        if (pos <= fLookStart) {
+            break;
+        }
+        UChar32 prevChar;
+        U8_PREV_OR_FFFD(inputBuf, (int32_t)fLookStart, pos, prevChar);
+        if (!(u_hasBinaryProperty(prevChar, UCHAR_GRAPHEME_EXTEND)
+              || u_charType(prevChar) == U_FORMAT_CHAR)) {
+            prevCIsWord = RegexStaticSets::gStaticSets->fPropSets[URX_ISWORD_SET].contains(prevChar);
+            break;
+        }
+    }
+    isBoundary = cIsWord ^ prevCIsWord;
+    return isBoundary;
+}
+
+//--------------------------------------------------------------------------------
+//
+//   isUWordBoundary
+//
+//         Test for a word boundary using RBBI word break.
+//
+//          parameters:   pos   - the current position in the input buffer
+//
+//--------------------------------------------------------------------------------
+UBool RegexMatcher::isUWordBoundary(int64_t pos, UErrorCode &status) {
+    UBool       returnVal = FALSE;
+
+#if UCONFIG_NO_BREAK_ITERATION==0
+    // Note: this point will never be reached if break iteration is configured out.
+    //       Regex patterns that would require this function will fail to compile.
+
+    // If we haven't yet created a break iterator for this matcher, do it now.
+    if (fWordBreakItr == nullptr) {
+        fWordBreakItr = BreakIterator::createWordInstance(Locale::getEnglish(), status);
+        if (U_FAILURE(status)) {
+            return FALSE;
+        }
+        fWordBreakItr->setText(fInputText, status);
+    }
+
+    // Note: zero width boundary tests like \b see through transparent region bounds,
+    //       which is why fLookLimit is used here, rather than fActiveLimit.
+    if (pos >= fLookLimit) {
+        fHitEnd = TRUE;
         returnVal = TRUE;   // With Unicode word rules, only positions within the interior of "real"
                             //    words are not boundaries.  All non-word chars stand by themselves,
                             //    with word boundaries on both sides.
@@ -2736,6 +3262,10 @@ inline REStackFrame *RegexMatcher::StateSave(REStackFrame *fp, int64_t savePatId
         return fp;
     }
     fp = (REStackFrame *)(newFP - fFrameSize);  // in case of realloc of stack.
+    if (fMaxStackSize < fStack->size()) {
+        fMaxStackSize = fStack->size();
+    }
+    fStateSaves++;
 
     // New stack frame = copy of old top frame.
     int64_t *source = (int64_t *)fp;
@@ -2796,6 +3326,10 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
     if (U_FAILURE(status)) {
         return;
     }
+    if (fPattern->fUseNFAEngine) {
+        MatchNFA(startIdx, toEnd, FALSE, status);
+        return;
+    }
 
     //  Cache frequently referenced items from the compiled pattern
     //
@@ -4270,17 +4804,144 @@ void RegexMatcher::MatchAt(int64_t startIdx, UBool toEnd, UErrorCode &status) {
 
 //--------------------------------------------------------------------------------
 //
-//   MatchChunkAt   This is the actual matching engine. Like MatchAt, but with the
-//                  assumption that the entire string is available in the UText's
-//                  chunk buffer. For now, that means we can use int32_t indexes,
-//                  except for anything that needs to be saved (like group starts
-//                  and ends).
+//   Input access for MatchBufferAt(), which matches against an input string
+//   that is entirely available in memory.
+//
+//   UTF16ChunkInput:   the UText's chunk buffer, for findUsingChunk().
+//   UTF8Input:         the UTF-8 string set with resetUTF8(), for findUsingUTF8().
+//                      Ill-formed sequences read as U+FFFD.
+//
+//--------------------------------------------------------------------------------
+namespace {
+
+struct UTF16ChunkInput {
+    typedef UChar Unit;
+    typedef CaseFoldingUCharIterator CaseFoldingIterator;
+
+    static const UBool   kIsUTF8 = FALSE;
+    static const int32_t kMaxLineEndLength = 2;     // CR/LF
+    static const int32_t kMaxUnitsPerUChar = 1;     // Scales utf-16 lengths from the pattern.
+
+    static inline const UChar *getBuffer(const UText *text, const uint8_t * /*utf8*/) {
+        return text->chunkContents;
+    }
+    template<typename Index>
+    static inline void next(const UChar *s, Index &i, int64_t length, UChar32 &c) {
+        U16_NEXT(s, i, length, c);
+    }
+    template<typename Index>
+    static inline void prev(const UChar *s, int32_t start, Index &i, UChar32 &c) {
+        U16_PREV(s, start, i, c);
+    }
+    static inline void back1(const UChar *s, int32_t start, int32_t &i) {
+        U16_BACK_1(s, start, i);
+    }
+    static inline void setCPStart(const UChar *s, int32_t start, int32_t &i) {
+        U16_SET_CP_START(s, start, i);
+    }
+    // True if the text before limit ends with an unpaired lead surrogate,
+    //   and the input at index continues it with a trail surrogate.
+    static inline UBool splitsCharacter(const UChar *s, int64_t limit, int64_t index, int64_t inputLimit) {
+        return U16_IS_LEAD(s[limit-1]) && index < inputLimit && U16_IS_TRAIL(s[index]);
+    }
+    // Compares the input at ix with a literal string from the pattern,
+    //   and advances ix past it if they are equal.
+    static inline UBool matchLiteral(const UChar *s, int32_t &ix, int64_t limit,
+                                     const UChar *pPat, int32_t stringLen, UBool &hitEnd) {
+        const UChar * pInp = s + ix;
+        const UChar * pInpLimit = s + limit;
+        const UChar * pEnd = pInp + stringLen;
+        while (pInp < pEnd) {
+            if (pInp >= pInpLimit) {
+                hitEnd = TRUE;
+                return FALSE;
+            }
+            if (*pInp++ != *pPat++) {
+                return FALSE;
+            }
+        }
+        ix += stringLen;
+        return TRUE;
+    }
+};
+
+struct UTF8Input {
+    typedef uint8_t Unit;
+    typedef CaseFoldingUTF8Iterator CaseFoldingIterator;
+
+    static const UBool   kIsUTF8 = TRUE;
+    static const int32_t kMaxLineEndLength = 3;     // U+0085, U+2028, U+2029
+    static const int32_t kMaxUnitsPerUChar = 3;
+
+    static inline const uint8_t *getBuffer(const UText * /*text*/, const uint8_t *utf8) {
+        return utf8;
+    }
+    template<typename Index>
+    static inline void next(const uint8_t *s, Index &i, int64_t length, UChar32 &c) {
+        U8_NEXT_OR_FFFD(s, i, length, c);
+    }
+    template<typename Index>
+    static inline void prev(const uint8_t *s, int32_t start, Index &i, UChar32 &c) {
+        U8_PREV_OR_FFFD(s, start, i, c);
+    }
+    static inline void back1(const uint8_t *s, int32_t start, int32_t &i) {
+        U8_BACK_1(s, start, i);
+    }
+    static inline void setCPStart(const uint8_t *s, int32_t start, int32_t &i) {
+        U8_SET_CP_START(s, start, i);
+    }
+    // True if the input at index continues a truncated sequence.
+    static inline UBool splitsCharacter(const uint8_t *s, int64_t /*limit*/, int64_t index, int64_t inputLimit) {
+        return index < inputLimit && U8_IS_TRAIL(s[index]);
+    }
+    // The literal text is UTF-16.  Compare it code point by code point,
+    //   except for ASCII, which is the same in both forms.
+    static inline UBool matchLiteral(const uint8_t *s, int32_t &ix, int64_t limit,
+                                     const UChar *pPat, int32_t stringLen, UBool &hitEnd) {
+        int32_t i = ix;
+        int32_t patIdx = 0;
+        while (patIdx < stringLen) {
+            if (i >= limit) {
+                hitEnd = TRUE;
+                return FALSE;
+            }
+            UChar32 cPat = pPat[patIdx];
+            if (cPat < 0x80) {
+                ++patIdx;
+                if (s[i++] != cPat) {
+                    return FALSE;
+                }
+            } else {
+                UChar32 c;
+                U16_NEXT(pPat, patIdx, stringLen, cPat);
+                U8_NEXT_OR_FFFD(s, i, limit, c);
+                if (c != cPat) {
+                    return FALSE;
+                }
+            }
+        }
+        ix = i;
+        return TRUE;
+    }
+};
+
+}  // namespace
+
+
+//--------------------------------------------------------------------------------
+//
+//   MatchBufferAt  This is the actual matching engine. Like MatchAt, but with the
+//                  assumption that the entire string is available in memory,
+//                  read through the Input class above. For now, that means we can
+//                  use int32_t indexes, except for anything that needs to be saved
+//                  (like group starts and ends).
 //
 //                  startIdx:    begin matching a this index.
 //                  toEnd:       if true, match must extend to end of the input region
 //
 //--------------------------------------------------------------------------------
-void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &status) {
+template<typename Input>
+void RegexMatcher::MatchBufferAt(int32_t startIdx, UBool toEnd, UErrorCode &status) {
     UBool       isMatch  = FALSE;      // True if the we have a match.
 
     int32_t     backSearchIndex = INT32_MAX; // used after greedy single-character matches for searching backwards
@@ -4300,6 +4961,10 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
     if (U_FAILURE(status)) {
         return;
     }
+    if (fPattern->fUseNFAEngine) {
+        MatchNFA(startIdx, toEnd, FALSE, status);
+        return;
+    }
 
     //  Cache frequently referenced items from the compiled pattern
     //
@@ -4308,7 +4973,7 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
     const UChar         *litText       = fPattern->fLiteralText.getBuffer();
     UVector             *fSets         = fPattern->fSets;
 
-    const UChar         *inputBuf      = fInputText->chunkContents;
+    const typename Input::Unit *inputBuf = Input::getBuffer(fInputText, fInputUTF8);
 
     fFrameSize = fPattern->fFrameSize;
     REStackFrame        *fp            = resetStack();
@@ -4362,7 +5027,7 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
         case URX_ONECHAR:
             if (fp->fInputIdx < fActiveLimit) {
                 UChar32 c;
-                U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+                Input::next(inputBuf, fp->fInputIdx, fActiveLimit, c);
                 if (c == opValue) {
                     break;
                 }
@@ -4388,25 +5053,10 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                 U_ASSERT(opType == URX_STRING_LEN);
                 U_ASSERT(stringLen >= 2);
 
-                const UChar * pInp = inputBuf + fp->fInputIdx;
-                const UChar * pInpLimit = inputBuf + fActiveLimit;
                 const UChar * pPat = litText+stringStartIdx;
-                const UChar * pEnd = pInp + stringLen;
-                UBool success = TRUE;
-                while (pInp < pEnd) {
-                    if (pInp >= pInpLimit) {
-                        fHitEnd = TRUE;
-                        success = FALSE;
-                        break;
-                    }
-                    if (*pInp++ != *pPat++) {
-                        success = FALSE;
-                        break;
-                    }
-                }
-
-                if (success) {
-                    fp->fInputIdx += stringLen;
+                int32_t ix = (int32_t)fp->fInputIdx;
+                if (Input::matchLiteral(inputBuf, ix, fActiveLimit, pPat, stringLen, fHitEnd)) {
+                    fp->fInputIdx = ix;
                 } else {
                     fp = (REStackFrame *)fStack->popFrame(fFrameSize);
                 }
@@ -4452,7 +5102,8 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
 
         case URX_DOLLAR:                   //  $, test for End of line
             //     or for position before new line at end of input
-            if (fp->fInputIdx < fAnchorLimit-2) {
+            //     A line ending takes up to kMaxLineEndLength code units.
+            if (fp->fInputIdx < fAnchorLimit-Input::kMaxLineEndLength) {
                 // We are no where near the end of input.  Fail.
                 //   This is the common case.  Keep it first.
                 fp = (REStackFrame *)fStack->popFrame(fFrameSize);
@@ -4467,11 +5118,12 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
 
             // If we are positioned just before a new-line that is located at the
             //   end of input, succeed.
-            if (fp->fInputIdx == fAnchorLimit-1) {
+            {
                 UChar32 c;
-                U16_GET(inputBuf, fAnchorStart, fp->fInputIdx, fAnchorLimit, c);
+                int32_t ix = (int32_t)fp->fInputIdx;
+                Input::next(inputBuf, ix, fAnchorLimit, c);
 
-                if (isLineTerminator(c)) {
+                if (ix == fAnchorLimit && isLineTerminator(c)) {
                     if ( !(c==0x0a && fp->fInputIdx>fAnchorStart && inputBuf[fp->fInputIdx-1]==0x0d)) {
                         // At new-line at end of input. Success
                         fHitEnd = TRUE;
@@ -4479,11 +5131,12 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                         break;
                     }
                 }
-            } else if (fp->fInputIdx == fAnchorLimit-2 &&
-                inputBuf[fp->fInputIdx]==0x0d && inputBuf[fp->fInputIdx+1]==0x0a) {
-                    fHitEnd = TRUE;
-                    fRequireEnd = TRUE;
-                    break;                         // At CR/LF at end of input.  Success
+                if (fp->fInputIdx == fAnchorLimit-2 &&
+                    inputBuf[fp->fInputIdx]==0x0d && inputBuf[fp->fInputIdx+1]==0x0a) {
+                        fHitEnd = TRUE;
+                        fRequireEnd = TRUE;
+                        break;                     // At CR/LF at end of input.  Success
+                }
             }
 
             fp = (REStackFrame *)fStack->popFrame(fFrameSize);
@@ -4524,7 +5177,9 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                 }
                 // If we are positioned just before a new-line, succeed.
                 // It makes no difference where the new-line is within the input.
-                UChar32 c = inputBuf[fp->fInputIdx];
+                UChar32 c;
+                int32_t ix = (int32_t)fp->fInputIdx;
+                Input::next(inputBuf, ix, fAnchorLimit, c);
                 if (isLineTerminator(c)) {
                     // At a line end, except for the odd chance of  being in the middle of a CR/LF sequence
                     //  In multi-line mode, hitting a new-line just before the end of input does not
@@ -4571,7 +5226,9 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                 }
                 // Check whether character just before the current pos is a new-line
                 //   unless we are at the end of input
-                UChar  c = inputBuf[fp->fInputIdx - 1];
+                UChar32 c;
+                int32_t ix = (int32_t)fp->fInputIdx;
+                Input::prev(inputBuf, 0, ix, c);
                 if ((fp->fInputIdx < fAnchorLimit) &&
                     isLineTerminator(c)) {
                     //  It's a new-line.  ^ is true.  Success.
@@ -4603,7 +5260,8 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
 
         case URX_BACKSLASH_B:          // Test for word boundaries
             {
-                UBool success = isChunkWordBoundary((int32_t)fp->fInputIdx);
+                UBool success = Input::kIsUTF8 ? isUTF8WordBoundary((int32_t)fp->fInputIdx) :
+                                                 isChunkWordBoundary((int32_t)fp->fInputIdx);
                 success ^= (UBool)(opValue != 0);     // flip sense for \B
                 if (!success) {
                     fp = (REStackFrame *)fStack->popFrame(fFrameSize);
@@ -4632,7 +5290,7 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                 }
 
                 UChar32 c;
-                U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+                Input::next(inputBuf, fp->fInputIdx, fActiveLimit, c);
                 int8_t ctype = u_charType(c);     // TODO:  make a unicode set for this.  Will be faster.
                 UBool success = (ctype == U_DECIMAL_DIGIT_NUMBER);
                 success ^= (UBool)(opValue != 0);        // flip sense for \D
@@ -4658,7 +5316,7 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                     break;
                 }
                 UChar32 c;
-                U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+                Input::next(inputBuf, fp->fInputIdx, fActiveLimit, c);
                 int8_t ctype = u_charType(c);
                 UBool success = (ctype == U_SPACE_SEPARATOR || c == 9);  // SPACE_SEPARATOR || TAB
                 success ^= (UBool)(opValue != 0);        // flip sense for \H
@@ -4677,14 +5335,12 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                     break;
                 }
                 UChar32 c;
-                U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+                Input::next(inputBuf, fp->fInputIdx, fActiveLimit, c);
                 if (isLineTerminator(c)) {
                     if (c == 0x0d && fp->fInputIdx < fActiveLimit) {
                         // Check for CR/LF sequence. Consume both together when found.
-                        UChar c2;
-                        U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c2);
-                        if (c2 != 0x0a) {
-                            U16_PREV(inputBuf, 0, fp->fInputIdx, c2);
+                        if (inputBuf[fp->fInputIdx] == 0x0a) {
+                            fp->fInputIdx++;
                         }
                     }
                 } else {
@@ -4702,7 +5358,7 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                     break;
                 }
                 UChar32 c;
-                U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+                Input::next(inputBuf, fp->fInputIdx, fActiveLimit, c);
                 UBool success = isLineTerminator(c);
                 success ^= (UBool)(opValue != 0);        // flip sense for \V
                 if (!success) {
@@ -4759,7 +5415,7 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                 U_ASSERT(opValue > 0 && opValue < URX_LAST_SET);
 
                 UChar32 c;
-                U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+                Input::next(inputBuf, fp->fInputIdx, fActiveLimit, c);
                 if (c < 256) {
                     Regex8BitSet &s8 = RegexStaticSets::gStaticSets->fPropSets8[opValue];
                     if (s8.contains(c)) {
@@ -4791,7 +5447,7 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                 U_ASSERT(opValue > 0 && opValue < URX_LAST_SET);
 
                 UChar32  c;
-                U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+                Input::next(inputBuf, fp->fInputIdx, fActiveLimit, c);
                 if (c < 256) {
                     Regex8BitSet &s8 = RegexStaticSets::gStaticSets->fPropSets8[opValue];
                     if (s8.contains(c) == FALSE) {
@@ -4820,7 +5476,7 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
 
                 // There is input left.  Pick up one char and test it for set membership.
                 UChar32  c;
-                U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+                Input::next(inputBuf, fp->fInputIdx, fActiveLimit, c);
                 if (c<256) {
                     Regex8BitSet *s8 = &fPattern->fSets8[opValue];
                     if (s8->contains(c)) {
@@ -4853,7 +5509,7 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
 
                 // There is input left.  Advance over one char, unless we've hit end-of-line
                 UChar32  c;
-                U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+                Input::next(inputBuf, fp->fInputIdx, fActiveLimit, c);
                 if (isLineTerminator(c)) {
                     // End of line in normal mode.   . does not match.
                     fp = (REStackFrame *)fStack->popFrame(fFrameSize);
@@ -4876,11 +5532,11 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                 // There is input left.  Advance over one char, except if we are
                 //   at a cr/lf, advance over both of them.
                 UChar32 c;
-                U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+                Input::next(inputBuf, fp->fInputIdx, fActiveLimit, c);
                 if (c==0x0d && fp->fInputIdx < fActiveLimit) {
                     // In the case of a CR/LF, we need to advance over both.
                     if (inputBuf[fp->fInputIdx] == 0x0a) {
-                        U16_FWD_1(inputBuf, fp->fInputIdx, fActiveLimit);
+                        fp->fInputIdx++;
                     }
                 }
             }
@@ -4900,7 +5556,7 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
 
                 // There is input left.  Advance over one char, unless we've hit end-of-line
                 UChar32 c;
-                U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+                Input::next(inputBuf, fp->fInputIdx, fActiveLimit, c);
                 if (c == 0x0a) {
                     // End of line in normal mode.   '.' does not match the \n
                     fp = (REStackFrame *)fStack->popFrame(fFrameSize);
@@ -5135,10 +5791,10 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                         break;
                     }
                 }
-                if (success && groupStartIdx < groupEndIdx && U16_IS_LEAD(inputBuf[groupEndIdx-1]) &&
-                        inputIndex < fActiveLimit && U16_IS_TRAIL(inputBuf[inputIndex])) {
-                    // Capture group ended with an unpaired lead surrogate.
-                    // Back reference is not permitted to match lead only of a surrogatge pair.
+                if (success && groupStartIdx < groupEndIdx &&
+                        Input::splitsCharacter(inputBuf, groupEndIdx, inputIndex, fActiveLimit)) {
+                    // Capture group ended in the middle of a character, which the input continues.
+                    // Back reference is not permitted to match part of a character.
                     success = FALSE;
                 }
                 if (success) {
@@ -5160,8 +5816,8 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                     fp = (REStackFrame *)fStack->popFrame(fFrameSize);   // FAIL, no match.
                     break;
                 }
-                CaseFoldingUCharIterator captureGroupItr(inputBuf, groupStartIdx, groupEndIdx);
-                CaseFoldingUCharIterator inputItr(inputBuf, fp->fInputIdx, fActiveLimit);
+                typename Input::CaseFoldingIterator captureGroupItr(inputBuf, groupStartIdx, groupEndIdx);
+                typename Input::CaseFoldingIterator inputItr(inputBuf, fp->fInputIdx, fActiveLimit);
 
                 //   Note: if the capture group match was of an empty string the backref
                 //         match succeeds.  Verified by testing:  Perl matches succeed
@@ -5269,441 +5925,1378 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
             }
             break;
 
-        case URX_ONECHAR_I:
-            if (fp->fInputIdx < fActiveLimit) {
-                UChar32 c;
-                U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
-                if (u_foldCase(c, U_FOLD_CASE_DEFAULT) == opValue) {
+        case URX_ONECHAR_I:
+            if (fp->fInputIdx < fActiveLimit) {
+                UChar32 c;
+                Input::next(inputBuf, fp->fInputIdx, fActiveLimit, c);
+                if (u_foldCase(c, U_FOLD_CASE_DEFAULT) == opValue) {
+                    break;
+                }
+            } else {
+                fHitEnd = TRUE;
+            }
+            fp = (REStackFrame *)fStack->popFrame(fFrameSize);
+            break;
+
+        case URX_STRING_I:
+            // Case-insensitive test input against a literal string.
+            // Strings require two slots in the compiled pattern, one for the
+            //   offset to the string text, and one for the length.
+            //   The compiled string has already been case folded.
+            {
+                const UChar *patternString = litText + opValue;
+
+                op      = (int32_t)pat[fp->fPatIdx];
+                fp->fPatIdx++;
+                opType  = URX_TYPE(op);
+                opValue = URX_VAL(op);
+                U_ASSERT(opType == URX_STRING_LEN);
+                int32_t patternStringLen = opValue;  // Length of the string from the pattern.
+
+                UChar32      cText;
+                UChar32      cPattern;
+                UBool        success = TRUE;
+                int32_t      patternStringIdx  = 0;
+                typename Input::CaseFoldingIterator inputIterator(inputBuf, fp->fInputIdx, fActiveLimit);
+                while (patternStringIdx < patternStringLen) {
+                    U16_NEXT(patternString, patternStringIdx, patternStringLen, cPattern);
+                    cText = inputIterator.next();
+                    if (cText != cPattern) {
+                        success = FALSE;
+                        if (cText == U_SENTINEL) {
+                            fHitEnd = TRUE;
+                        }
+                        break;
+                    }
+                }
+                if (inputIterator.inExpansion()) {
+                    success = FALSE;
+                }
+
+                if (success) {
+                    fp->fInputIdx = inputIterator.getIndex();
+                } else {
+                    fp = (REStackFrame *)fStack->popFrame(fFrameSize);
+                }
+            }
+            break;
+
+        case URX_LB_START:
+            {
+                // Entering a look-behind block.
+                // Save Stack Ptr, Input Pos and active input region.
+                //   TODO:  implement transparent bounds.  Ticket #6067
+                U_ASSERT(opValue>=0 && opValue+4<fPattern->fDataSize);
+                fData[opValue]   = fStack->size();
+                fData[opValue+1] = fp->fInputIdx;
+                // Save input string length, then reset to pin any matches to end at
+                //   the current position.
+                fData[opValue+2] = fActiveStart;
+                fData[opValue+3] = fActiveLimit;
+                fActiveStart     = fRegionStart;
+                fActiveLimit     = fp->fInputIdx;
+                // Init the variable containing the start index for attempted matches.
+                fData[opValue+4] = -1;
+            }
+            break;
+
+
+        case URX_LB_CONT:
+            {
+                // Positive Look-Behind, at top of loop checking for matches of LB expression
+                //    at all possible input starting positions.
+
+                // Fetch the min and max possible match lengths.  They are the operands
+                //   of this op in the pattern.
+                int32_t minML = (int32_t)pat[fp->fPatIdx++];
+                int32_t maxML = (int32_t)pat[fp->fPatIdx++];
+                // The pattern compiler counts utf-16 code units.
+                maxML *= Input::kMaxUnitsPerUChar;
+                U_ASSERT(minML <= maxML);
+                U_ASSERT(minML >= 0);
+
+                // Fetch (from data) the last input index where a match was attempted.
+                U_ASSERT(opValue>=0 && opValue+4<fPattern->fDataSize);
+                int64_t  &lbStartIdx = fData[opValue+4];
+                if (lbStartIdx < 0) {
+                    // First time through loop.
+                    lbStartIdx = fp->fInputIdx - minML;
+                    if (lbStartIdx > 0 && lbStartIdx < fInputLength) {
+                        int32_t ix = (int32_t)lbStartIdx;
+                        Input::setCPStart(inputBuf, 0, ix);
+                        lbStartIdx = ix;
+                    }
+                } else {
+                    // 2nd through nth time through the loop.
+                    // Back up start position for match by one.
+                    if (lbStartIdx == 0) {
+                        lbStartIdx--;
+                    } else {
+                        int32_t ix = (int32_t)lbStartIdx;
+                        Input::back1(inputBuf, 0, ix);
+                        lbStartIdx = ix;
+                    }
+                }
+
+                if (lbStartIdx < 0 || lbStartIdx < fp->fInputIdx - maxML) {
+                    // We have tried all potential match starting points without
+                    //  getting a match.  Backtrack out, and out of the
+                    //   Look Behind altogether.
+                    fp = (REStackFrame *)fStack->popFrame(fFrameSize);
+                    fActiveStart = fData[opValue+2];
+                    fActiveLimit = fData[opValue+3];
+                    U_ASSERT(fActiveStart >= 0);
+                    U_ASSERT(fActiveLimit <= fInputLength);
+                    break;
+                }
+
+                //    Save state to this URX_LB_CONT op, so failure to match will repeat the loop.
+                //      (successful match will fall off the end of the loop.)
+                fp = StateSave(fp, fp->fPatIdx-3, status);
+                fp->fInputIdx =  lbStartIdx;
+            }
+            break;
+
+        case URX_LB_END:
+            // End of a look-behind block, after a successful match.
+            {
+                U_ASSERT(opValue>=0 && opValue+4<fPattern->fDataSize);
+                if (fp->fInputIdx != fActiveLimit) {
+                    //  The look-behind expression matched, but the match did not
+                    //    extend all the way to the point that we are looking behind from.
+                    //  FAIL out of here, which will take us back to the LB_CONT, which
+                    //     will retry the match starting at another position or fail
+                    //     the look-behind altogether, whichever is appropriate.
+                    fp = (REStackFrame *)fStack->popFrame(fFrameSize);
+                    break;
+                }
+
+                // Look-behind match is good.  Restore the orignal input string region,
+                //   which had been truncated to pin the end of the lookbehind match to the
+                //   position being looked-behind.
+                fActiveStart = fData[opValue+2];
+                fActiveLimit = fData[opValue+3];
+                U_ASSERT(fActiveStart >= 0);
+                U_ASSERT(fActiveLimit <= fInputLength);
+            }
+            break;
+
+
+        case URX_LBN_CONT:
+            {
+                // Negative Look-Behind, at top of loop checking for matches of LB expression
+                //    at all possible input starting positions.
+
+                // Fetch the extra parameters of this op.
+                int32_t minML       = (int32_t)pat[fp->fPatIdx++];
+                int32_t maxML       = (int32_t)pat[fp->fPatIdx++] * Input::kMaxUnitsPerUChar;
+                int32_t continueLoc = (int32_t)pat[fp->fPatIdx++];
+                continueLoc = URX_VAL(continueLoc);
+                U_ASSERT(minML <= maxML);
+                U_ASSERT(minML >= 0);
+                U_ASSERT(continueLoc > fp->fPatIdx);
+
+                // Fetch (from data) the last input index where a match was attempted.
+                U_ASSERT(opValue>=0 && opValue+4<fPattern->fDataSize);
+                int64_t  &lbStartIdx = fData[opValue+4];
+                if (lbStartIdx < 0) {
+                    // First time through loop.
+                    lbStartIdx = fp->fInputIdx - minML;
+                    if (lbStartIdx > 0 && lbStartIdx < fInputLength) {
+                        int32_t ix = (int32_t)lbStartIdx;
+                        Input::setCPStart(inputBuf, 0, ix);
+                        lbStartIdx = ix;
+                    }
+                } else {
+                    // 2nd through nth time through the loop.
+                    // Back up start position for match by one.
+                    if (lbStartIdx == 0) {
+                        lbStartIdx--;   // Because back1() is unsafe starting at 0.
+                    } else {
+                        int32_t ix = (int32_t)lbStartIdx;
+                        Input::back1(inputBuf, 0, ix);
+                        lbStartIdx = ix;
+                    }
+                }
+
+                if (lbStartIdx < 0 || lbStartIdx < fp->fInputIdx - maxML) {
+                    // We have tried all potential match starting points without
+                    //  getting a match, which means that the negative lookbehind as
+                    //  a whole has succeeded.  Jump forward to the continue location
+                    fActiveStart = fData[opValue+2];
+                    fActiveLimit = fData[opValue+3];
+                    U_ASSERT(fActiveStart >= 0);
+                    U_ASSERT(fActiveLimit <= fInputLength);
+                    fp->fPatIdx = continueLoc;
+                    break;
+                }
+
+                //    Save state to this URX_LB_CONT op, so failure to match will repeat the loop.
+                //      (successful match will cause a FAIL out of the loop altogether.)
+                fp = StateSave(fp, fp->fPatIdx-4, status);
+                fp->fInputIdx =  lbStartIdx;
+            }
+            break;
+
+        case URX_LBN_END:
+            // End of a negative look-behind block, after a successful match.
+            {
+                U_ASSERT(opValue>=0 && opValue+4<fPattern->fDataSize);
+                if (fp->fInputIdx != fActiveLimit) {
+                    //  The look-behind expression matched, but the match did not
+                    //    extend all the way to the point that we are looking behind from.
+                    //  FAIL out of here, which will take us back to the LB_CONT, which
+                    //     will retry the match starting at another position or succeed
+                    //     the look-behind altogether, whichever is appropriate.
+                    fp = (REStackFrame *)fStack->popFrame(fFrameSize);
+                    break;
+                }
+
+                // Look-behind expression matched, which means look-behind test as
+                //   a whole Fails
+
+                //   Restore the orignal input string length, which had been truncated
+                //   inorder to pin the end of the lookbehind match
+                //   to the position being looked-behind.
+                fActiveStart = fData[opValue+2];
+                fActiveLimit = fData[opValue+3];
+                U_ASSERT(fActiveStart >= 0);
+                U_ASSERT(fActiveLimit <= fInputLength);
+
+                // Restore original stack position, discarding any state saved
+                //   by the successful pattern match.
+                U_ASSERT(opValue>=0 && opValue+1<fPattern->fDataSize);
+                int32_t newStackSize = (int32_t)fData[opValue];
+                U_ASSERT(fStack->size() > newStackSize);
+                fStack->setSize(newStackSize);
+
+                //  FAIL, which will take control back to someplace
+                //  prior to entering the look-behind test.
+                fp = (REStackFrame *)fStack->popFrame(fFrameSize);
+            }
+            break;
+
+
+        case URX_LOOP_SR_I:
+            // Loop Initialization for the optimized implementation of
+            //     [some character set]*
+            //   This op scans through all matching input.
+            //   The following LOOP_C op emulates stack unwinding if the following pattern fails.
+            {
+                U_ASSERT(opValue > 0 && opValue < fSets->size());
+                Regex8BitSet *s8 = &fPattern->fSets8[opValue];
+                UnicodeSet   *s  = (UnicodeSet *)fSets->elementAt(opValue);
+
+                // Loop through input, until either the input is exhausted or
+                //   we reach a character that is not a member of the set.
+                int32_t ix = (int32_t)fp->fInputIdx;
+                for (;;) {
+                    if (ix >= fActiveLimit) {
+                        fHitEnd = TRUE;
+                        break;
+                    }
+                    UChar32   c = inputBuf[ix];
+                    if (c < 0x80) {
+                        // ASCII, the common case: test the code unit itself.
+                        if (s8->contains(c) == FALSE) {
+                            break;
+                        }
+                        ++ix;
+                        continue;
+                    }
+                    int32_t   nextIx = ix;
+                    Input::next(inputBuf, nextIx, fActiveLimit, c);
+                    if (c<256) {
+                        if (s8->contains(c) == FALSE) {
+                            break;
+                        }
+                    } else {
+                        if (s->contains(c) == FALSE) {
+                            break;
+                        }
+                    }
+                    ix = nextIx;
+                }
+
+                // If there were no matching characters, skip over the loop altogether.
+                //   The loop doesn't run at all, a * op always succeeds.
+                if (ix == fp->fInputIdx) {
+                    fp->fPatIdx++;   // skip the URX_LOOP_C op.
+                    break;
+                }
+
+                // Peek ahead in the compiled pattern, to the URX_LOOP_C that
+                //   must follow.  It's operand is the stack location
+                //   that holds the starting input index for the match of this [set]*
+                int32_t loopcOp = (int32_t)pat[fp->fPatIdx];
+                U_ASSERT(URX_TYPE(loopcOp) == URX_LOOP_C);
+                int32_t stackLoc = URX_VAL(loopcOp);
+                U_ASSERT(stackLoc >= 0 && stackLoc < fFrameSize);
+                fp->fExtra[stackLoc] = fp->fInputIdx;
+                fp->fInputIdx = ix;
+
+                // Save State to the URX_LOOP_C op that follows this one,
+                //   so that match failures in the following code will return to there.
+                //   Then bump the pattern idx so the LOOP_C is skipped on the way out of here.
+                fp = StateSave(fp, fp->fPatIdx, status);
+                fp->fPatIdx++;
+            }
+            break;
+
+
+        case URX_LOOP_DOT_I:
+            // Loop Initialization for the optimized implementation of .*
+            //   This op scans through all remaining input.
+            //   The following LOOP_C op emulates stack unwinding if the following pattern fails.
+            {
+                // Loop through input until the input is exhausted (we reach an end-of-line)
+                // In DOTALL mode, we can just go straight to the end of the input.
+                int32_t ix;
+                if ((opValue & 1) == 1) {
+                    // Dot-matches-All mode.  Jump straight to the end of the string.
+                    ix = (int32_t)fActiveLimit;
+                    fHitEnd = TRUE;
+                } else {
+                    // NOT DOT ALL mode.  Line endings do not match '.'
+                    // Scan forward until a line ending or end of input.
+                    ix = (int32_t)fp->fInputIdx;
+                    for (;;) {
+                        if (ix >= fActiveLimit) {
+                            fHitEnd = TRUE;
+                            break;
+                        }
+                        UChar32   c;
+                        int32_t   nextIx = ix;
+                        Input::next(inputBuf, nextIx, fActiveLimit, c);   // c = inputBuf[ix++]
+                        if ((c & 0x7f) <= 0x29) {          // Fast filter of non-new-line-s
+                            if ((c == 0x0a) ||             //  0x0a is newline in both modes.
+                                (((opValue & 2) == 0) &&    // IF not UNIX_LINES mode
+                                   isLineTerminator(c))) {
+                                //  char is a line ending.  Leave the input pos at the
+                                //    line ending char, and exit the scanning loop.
+                                break;
+                            }
+                        }
+                        ix = nextIx;
+                    }
+                }
+
+                // If there were no matching characters, skip over the loop altogether.
+                //   The loop doesn't run at all, a * op always succeeds.
+                if (ix == fp->fInputIdx) {
+                    fp->fPatIdx++;   // skip the URX_LOOP_C op.
+                    break;
+                }
+
+                // Peek ahead in the compiled pattern, to the URX_LOOP_C that
+                //   must follow.  It's operand is the stack location
+                //   that holds the starting input index for the match of this .*
+                int32_t loopcOp = (int32_t)pat[fp->fPatIdx];
+                U_ASSERT(URX_TYPE(loopcOp) == URX_LOOP_C);
+                int32_t stackLoc = URX_VAL(loopcOp);
+                U_ASSERT(stackLoc >= 0 && stackLoc < fFrameSize);
+                fp->fExtra[stackLoc] = fp->fInputIdx;
+                fp->fInputIdx = ix;
+
+                // Save State to the URX_LOOP_C op that follows this one,
+                //   so that match failures in the following code will return to there.
+                //   Then bump the pattern idx so the LOOP_C is skipped on the way out of here.
+                fp = StateSave(fp, fp->fPatIdx, status);
+                fp->fPatIdx++;
+            }
+            break;
+
+
+        case URX_LOOP_C:
+            {
+                U_ASSERT(opValue>=0 && opValue<fFrameSize);
+                backSearchIndex = (int32_t)fp->fExtra[opValue];
+                U_ASSERT(backSearchIndex <= fp->fInputIdx);
+                if (backSearchIndex == fp->fInputIdx) {
+                    // We've backed up the input idx to the point that the loop started.
+                    // The loop is done.  Leave here without saving state.
+                    //  Subsequent failures won't come back here.
+                    break;
+                }
+                // Set up for the next iteration of the loop, with input index
+                //   backed up by one from the last time through,
+                //   and a state save to this instruction in case the following code fails again.
+                //   (We're going backwards because this loop emulates stack unwinding, not
+                //    the initial scan forward.)
+                U_ASSERT(fp->fInputIdx > 0);
+                UChar32 prevC;
+                int32_t ix = (int32_t)fp->fInputIdx;
+                Input::prev(inputBuf, 0, ix, prevC);
+                fp->fInputIdx = ix;
+
+                if (prevC == 0x0a &&
+                    fp->fInputIdx > backSearchIndex &&
+                    inputBuf[fp->fInputIdx-1] == 0x0d) {
+                    int32_t prevOp = (int32_t)pat[fp->fPatIdx-2];
+                    if (URX_TYPE(prevOp) == URX_LOOP_DOT_I) {
+                        // .*, stepping back over CRLF pair.
+                        fp->fInputIdx--;
+                    }
+                }
+
+
+                fp = StateSave(fp, fp->fPatIdx-1, status);
+            }
+            break;
+
+
+
+        default:
+            // Trouble.  The compiled pattern contains an entry with an
+            //           unrecognized type tag.
+            UPRV_UNREACHABLE;
+        }
+
+        if (U_FAILURE(status)) {
+            isMatch = FALSE;
+            break;
+        }
+    }
+
+breakFromLoop:
+    fMatch = isMatch;
+    if (isMatch) {
+        fLastMatchEnd = fMatchEnd;
+        fMatchStart   = startIdx;
+        fMatchEnd     = fp->fInputIdx;
+    }
+
+#ifdef REGEX_RUN_DEBUG
+    if (fTraceDebug) {
+        if (isMatch) {
+            printf("Match.  start=%ld   end=%ld\n\n", fMatchStart, fMatchEnd);
+        } else {
+            printf("No match\n\n");
+        }
+    }
+#endif
+
+    fFrame = fp;                // The active stack frame when the engine stopped.
+                                //   Contains the capture group results that we need to
+                                //    access later.
+
+    return;
+}
+
+
+//--------------------------------------------------------------------------------
+//
+//   MatchChunkAt   MatchBufferAt() on the UText's chunk buffer.
+//   MatchUTF8At    MatchBufferAt() on UTF-8 input set with resetUTF8().
+//                  Native indexes are byte offsets.
+//
+//--------------------------------------------------------------------------------
+void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &status) {
+    MatchBufferAt<UTF16ChunkInput>(startIdx, toEnd, status);
+}
+
+void RegexMatcher::MatchUTF8At(int32_t startIdx, UBool toEnd, UErrorCode &status) {
+    MatchBufferAt<UTF8Input>(startIdx, toEnd, status);
+}
+
+
+
+//--------------------------------------------------------------------------------
+//
+//   MatchNFA      The linear time match engine.
+//
+//                 Simulates the compiled pattern as an NFA, advancing a list of threads,
+//                 one per distinct NFA state, over the input one character at a time.
+//                 The threads are kept in the order in which MatchAt() would try
+//                 them, and a thread that reaches the end of the pattern discards all
+//                 threads after it, so that the match found, and its capture groups,
+//                 are the same as those found by backtracking.
+//
+//                 Each NFA state is added to a list at most once per input position,
+//                 making the run time proportional to the length of the input times
+//                 the size of the pattern, whatever the pattern.
+//
+//                 With unanchored set, a new thread is started at each input position
+//                 until a match is found, making a single pass do the work of find().
+//
+//--------------------------------------------------------------------------------
+void RegexMatcher::MatchNFA(int64_t startIdx, UBool toEnd, UBool unanchored, UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return;
+    }
+    if (U_FAILURE(fDeferredStatus)) {
+        status = fDeferredStatus;
+        return;
+    }
+
+    NFAInitWorkspace(status);
+    if (U_FAILURE(status)) {
+        return;
+    }
+    RegexNFAWorkspace &ws = *fNFAWorkspace;
+    ws.fSetMode = FALSE;
+
+    UVector64     *threads     = &ws.fThreads1;
+    UVector64     *nextThreads = &ws.fThreads2;
+    REStackFrame  *frame       = (REStackFrame *)ws.fFrame.getBuffer();
+    UBool          isMatch     = FALSE;
+    int32_t        startType   = unanchored ? fPattern->fStartType : START_NO_INFO;
+    int64_t        pos         = startIdx;
+
+    if (++ws.fGeneration == INT32_MAX) {
+        uprv_memset(ws.fMarks.getBuffer(), 0, ws.fMarks.size() * sizeof(int32_t));
+        ws.fGeneration = 1;
+    }
+    threads->removeAllElements();
+
+    //
+    //  Main loop, one iteration per input character.
+    //
+    while (U_SUCCESS(status)) {
+        // Start a new thread at this input position, with the lowest priority,
+        //   at the positions that find() would try.
+        if (!isMatch && (unanchored || pos == startIdx)) {
+            UBool mayStart = TRUE;
+            if (startType == START_CHAR || startType == START_SET || startType == START_STRING) {
+                // Matches start with a character from fInitialChars.  With no threads
+                //   running, skip ahead to the next one.
+                if (fInputUTF8 != NULL) {
+                    // UTF-8 input: test ASCII bytes without decoding them.
+                    int32_t ix = (int32_t)pos;
+                    for (;;) {
+                        if (ix >= fActiveLimit) {
+                            mayStart = FALSE;
+                            break;
+                        }
+                        UChar32 c = fInputUTF8[ix];
+                        int32_t nextIx = ix + 1;
+                        if (!U8_IS_SINGLE(c)) {
+                            nextIx = ix;
+                            U8_NEXT_OR_FFFD(fInputUTF8, nextIx, fActiveLimit, c);
+                        }
+                        mayStart = (c < 256 && fPattern->fInitialChars8->contains(c)) ||
+                                   (c >= 256 && fPattern->fInitialChars->contains(c));
+                        if (mayStart || threads->size() > 0) {
+                            break;
+                        }
+                        ix = nextIx;
+                    }
+                    pos = ix;
+                } else {
+                    UTEXT_SETNATIVEINDEX(fInputText, pos);
+                    for (;;) {
+                        UChar32 c = UTEXT_CURRENT32(fInputText);
+                        mayStart = pos < fActiveLimit && c >= 0 &&
+                                   ((c < 256 && fPattern->fInitialChars8->contains(c)) ||
+                                    (c >= 256 && fPattern->fInitialChars->contains(c)));
+                        if (mayStart || pos >= fActiveLimit || threads->size() > 0) {
+                            break;
+                        }
+                        (void)UTEXT_NEXT32(fInputText);
+                        pos = UTEXT_GETNATIVEINDEX(fInputText);
+                    }
+                }
+            } else if (startType == START_LINE && pos != fAnchorStart) {
+                // After a line end, but not between the CR and LF of a CR/LF.
+                UTEXT_SETNATIVEINDEX(fInputText, pos);
+                UChar32 c = UTEXT_PREVIOUS32(fInputText);
+                if (fPattern->fFlags & UREGEX_UNIX_LINES) {
+                    mayStart = c == 0x0a;
+                } else {
+                    UTEXT_SETNATIVEINDEX(fInputText, pos);
+                    mayStart = isLineTerminator(c) &&
+                               !(c == 0x0d && pos < fActiveLimit && UTEXT_CURRENT32(fInputText) == 0x0a);
+                }
+            }
+            if (mayStart) {
+                frame->fInputIdx = pos;
+                for (int32_t i = 0; i < fFrameSize - RESTACKFRAME_HDRCOUNT; i++) {
+                    frame->fExtra[i] = -1;
+                }
+                isMatch = NFAAddThread(threads, 0, pos, toEnd, status);
+            }
+        }
+
+        int32_t threadCount = threads->size() / fFrameSize;
+        if (threadCount == 0 && (isMatch || !unanchored)) {
+            break;
+        }
+        if (pos >= fActiveLimit) {
+            if (threadCount > 0) {
+                // Threads are still waiting for input.
+                fHitEnd = TRUE;
+            }
+            break;
+        }
+
+        UChar32 c;
+        int64_t nextPos;
+        if (fInputUTF8 != NULL) {
+            int32_t ix = (int32_t)pos;
+            U8_NEXT_OR_FFFD(fInputUTF8, ix, fActiveLimit, c);
+            nextPos = ix;
+        } else {
+            UTEXT_SETNATIVEINDEX(fInputText, pos);
+            c = UTEXT_NEXT32(fInputText);
+            nextPos = UTEXT_GETNATIVEINDEX(fInputText);
+        }
+
+        if (++ws.fGeneration == INT32_MAX) {
+            uprv_memset(ws.fMarks.getBuffer(), 0, ws.fMarks.size() * sizeof(int32_t));
+            ws.fGeneration = 1;
+        }
+        nextThreads->removeAllElements();
+
+        // Advance each thread, in priority order, over the character c.
+        const int64_t *thread = threads->getBuffer();
+        for (int32_t t = 0; t < threadCount; t++, thread += fFrameSize) {
+            int64_t next = NFANextState(((const REStackFrame *)thread)->fPatIdx, c);
+            if (next >= 0) {
+                uprv_memcpy(frame, thread, fFrameSize * sizeof(int64_t));
+                if (NFAAddThread(nextThreads, next, nextPos, toEnd, status)) {
+                    // A match.  The threads that follow this one have lower priority.
+                    isMatch = TRUE;
+                    break;
+                }
+            }
+        }
+
+        fTickCounter -= threadCount + 1;
+        if (fTickCounter <= 0) {
+            IncrementTime(status);
+        }
+
+        if (unanchored && !isMatch && findProgressInterrupt(nextPos, status)) {
+            break;
+        }
+
+        UVector64 *t = threads;
+        threads = nextThreads;
+        nextThreads = t;
+        pos = nextPos;
+    }
+
+    if (U_FAILURE(status)) {
+        isMatch = FALSE;
+    }
+    fMatch = isMatch;
+    REStackFrame *fp = resetStack();
+    if (isMatch && fp != NULL) {
+        const REStackFrame *matchFrame = (const REStackFrame *)ws.fMatchFrame.getBuffer();
+        uprv_memcpy(fp->fExtra, matchFrame->fExtra, (fFrameSize - RESTACKFRAME_HDRCOUNT) * sizeof(int64_t));
+        fp->fInputIdx = ws.fMatchEnd;
+        fLastMatchEnd = fMatchEnd;
+        fMatchStart   = matchFrame->fInputIdx;
+        fMatchEnd     = ws.fMatchEnd;
+    }
+    fFrame = fp;
+}
+
+
+//--------------------------------------------------------------------------------
+//
+//   NFAAddThread   Add a thread for an NFA state to a thread list for input position pos,
+//                  following all transitions that do not consume input first.
+//                  The capture groups and match start of the thread are in the
+//                  workspace's fFrame.
+//
+//                  Alternatives are followed depth first, higher priority first, with
+//                  capture group changes undone before moving on to the next.
+//                  States already in the list are skipped; they were added with higher
+//                  priority.  Threads end up in the list in priority order.
+//
+//                  Returns TRUE if the end of the pattern was reached, a match.
+//                  The match replaces any earlier one in fMatchFrame, and remaining
+//                  lower priority alternatives are dropped.
+//
+//--------------------------------------------------------------------------------
+UBool RegexMatcher::NFAAddThread(UVector64 *threads, int64_t state, int64_t pos,
+                                 UBool toEnd, UErrorCode &status) {
+    RegexNFAWorkspace &ws         = *fNFAWorkspace;
+    const int64_t     *pat        = fPattern->fCompiledPat->getBuffer();
+    const int32_t     *stateIndex = ws.fStateIndex.getBuffer();
+    int32_t           *marks      = ws.fMarks.getBuffer();
+    REStackFrame      *fp         = (REStackFrame *)ws.fFrame.getBuffer();
+    UVector64         &jobs       = ws.fJobs;
+
+    // Jobs are pairs of (value, kind).  A kind of -1 is an alternative state to explore,
+    //   other kinds are the index in the frame of a value to restore.
+    jobs.removeAllElements();
+    for (;;) {
+        UBool alive = TRUE;
+        while (alive) {
+            int32_t pc  = (int32_t)state;
+            int32_t sub = (int32_t)(state >> 32);
+            int32_t *mark = marks + stateIndex[pc] + sub;
+            if (*mark == ws.fGeneration) {
+                break;
+            }
+            *mark = ws.fGeneration;
+
+            int32_t op      = (int32_t)pat[pc];
+            int32_t opValue = URX_VAL(op);
+            switch (URX_TYPE(op)) {
+            case URX_NOP:
+            case URX_LOOP_C:
+                state = pc + 1;
+                break;
+
+            case URX_BACKTRACK:
+            case URX_FAIL:
+                alive = FALSE;
+                break;
+
+            case URX_JMP:
+                state = opValue;
+                break;
+
+            case URX_STATE_SAVE:
+                jobs.push(opValue, status);
+                jobs.push(-1, status);
+                state = pc + 1;
+                break;
+
+            case URX_JMP_SAV:
+                jobs.push(pc + 1, status);
+                jobs.push(-1, status);
+                state = opValue;
+                break;
+
+            case URX_START_CAPTURE:
+                if (ws.fSetMode) {
+                    // RegexSet matching does not report capture groups.
+                    state = pc + 1;
+                    break;
+                }
+                U_ASSERT(opValue >= 0 && opValue < fFrameSize-3);
+                jobs.push(fp->fExtra[opValue+2], status);
+                jobs.push(RESTACKFRAME_HDRCOUNT + opValue + 2, status);
+                fp->fExtra[opValue+2] = pos;
+                state = pc + 1;
+                break;
+
+            case URX_END_CAPTURE:
+                if (ws.fSetMode) {
+                    state = pc + 1;
                     break;
                 }
-            } else {
-                fHitEnd = TRUE;
-            }
-            fp = (REStackFrame *)fStack->popFrame(fFrameSize);
-            break;
+                U_ASSERT(opValue >= 0 && opValue < fFrameSize-3);
+                jobs.push(fp->fExtra[opValue], status);
+                jobs.push(RESTACKFRAME_HDRCOUNT + opValue, status);
+                jobs.push(fp->fExtra[opValue+1], status);
+                jobs.push(RESTACKFRAME_HDRCOUNT + opValue + 1, status);
+                fp->fExtra[opValue]   = fp->fExtra[opValue+2];
+                fp->fExtra[opValue+1] = pos;
+                state = pc + 1;
+                break;
 
-        case URX_STRING_I:
-            // Case-insensitive test input against a literal string.
-            // Strings require two slots in the compiled pattern, one for the
-            //   offset to the string text, and one for the length.
-            //   The compiled string has already been case folded.
-            {
-                const UChar *patternString = litText + opValue;
+            case URX_END:
+                if (ws.fSetMode) {
+                    // One of the patterns of a RegexSet has a match.  MatchNFASet() only
+                    //   needs to know which one.
+                    ws.fMatchedEnds.addElement(pc, status);
+                    alive = FALSE;
+                    break;
+                }
+                if (toEnd && pos != fActiveLimit) {
+                    alive = FALSE;
+                    break;
+                }
+                uprv_memcpy(ws.fMatchFrame.getBuffer(), fp, fFrameSize * sizeof(int64_t));
+                ws.fMatchEnd = pos;
+                return TRUE;
 
-                op      = (int32_t)pat[fp->fPatIdx];
-                fp->fPatIdx++;
-                opType  = URX_TYPE(op);
-                opValue = URX_VAL(op);
-                U_ASSERT(opType == URX_STRING_LEN);
-                int32_t patternStringLen = opValue;  // Length of the string from the pattern.
+            case URX_STRING:
+            case URX_STRING_I:
+                if (sub == URX_VAL(pat[pc+1])) {
+                    // The whole string has been matched.
+                    state = pc + 2;
+                    break;
+                }
+                U_FALLTHROUGH;
+            case URX_ONECHAR:
+            case URX_ONECHAR_I:
+            case URX_STATIC_SETREF:
+            case URX_STAT_SETREF_N:
+            case URX_SETREF:
+            case URX_DOTANY:
+            case URX_DOTANY_UNIX:
+            case URX_BACKSLASH_D:
+            case URX_BACKSLASH_H:
+            case URX_BACKSLASH_V:
+                {
+                    int64_t *thread = threads->reserveBlock(fFrameSize, status);
+                    if (thread != NULL) {
+                        uprv_memcpy(thread, fp, fFrameSize * sizeof(int64_t));
+                        ((REStackFrame *)thread)->fPatIdx = state;
+                    }
+                    alive = FALSE;
+                }
+                break;
 
-                UChar32      cText;
-                UChar32      cPattern;
-                UBool        success = TRUE;
-                int32_t      patternStringIdx  = 0;
-                CaseFoldingUCharIterator inputIterator(inputBuf, fp->fInputIdx, fActiveLimit);
-                while (patternStringIdx < patternStringLen) {
-                    U16_NEXT(patternString, patternStringIdx, patternStringLen, cPattern);
-                    cText = inputIterator.next();
-                    if (cText != cPattern) {
-                        success = FALSE;
-                        if (cText == U_SENTINEL) {
-                            fHitEnd = TRUE;
-                        }
+            case URX_DOTANY_ALL:
+            case URX_BACKSLASH_R:
+            case URX_LOOP_DOT_I:
+                if (sub == 1) {
+                    // A CR has been matched.  A following LF must be matched with it.
+                    UTEXT_SETNATIVEINDEX(fInputText, pos);
+                    if (pos >= fActiveLimit || UTEXT_CURRENT32(fInputText) != 0x0a) {
+                        state = URX_TYPE(op) == URX_LOOP_DOT_I ? pc : pc + 1;
                         break;
                     }
                 }
-                if (inputIterator.inExpansion()) {
-                    success = FALSE;
+                {
+                    int64_t *thread = threads->reserveBlock(fFrameSize, status);
+                    if (thread != NULL) {
+                        uprv_memcpy(thread, fp, fFrameSize * sizeof(int64_t));
+                        ((REStackFrame *)thread)->fPatIdx = state;
+                    }
                 }
-
-                if (success) {
-                    fp->fInputIdx = inputIterator.getIndex();
+                if (URX_TYPE(op) == URX_LOOP_DOT_I && sub == 0) {
+                    // Leaving the .* loop has lower priority than staying in it.
+                    state = pc + 2;
                 } else {
-                    fp = (REStackFrame *)fStack->popFrame(fFrameSize);
+                    alive = FALSE;
                 }
-            }
-            break;
+                break;
 
-        case URX_LB_START:
-            {
-                // Entering a look-behind block.
-                // Save Stack Ptr, Input Pos and active input region.
-                //   TODO:  implement transparent bounds.  Ticket #6067
-                U_ASSERT(opValue>=0 && opValue+4<fPattern->fDataSize);
-                fData[opValue]   = fStack->size();
-                fData[opValue+1] = fp->fInputIdx;
-                // Save input string length, then reset to pin any matches to end at
-                //   the current position.
-                fData[opValue+2] = fActiveStart;
-                fData[opValue+3] = fActiveLimit;
-                fActiveStart     = fRegionStart;
-                fActiveLimit     = fp->fInputIdx;
-                // Init the variable containing the start index for attempted matches.
-                fData[opValue+4] = -1;
-            }
-            break;
+            case URX_LOOP_SR_I:
+                {
+                    int64_t *thread = threads->reserveBlock(fFrameSize, status);
+                    if (thread != NULL) {
+                        uprv_memcpy(thread, fp, fFrameSize * sizeof(int64_t));
+                        ((REStackFrame *)thread)->fPatIdx = state;
+                    }
+                    state = pc + 2;
+                }
+                break;
 
+            case URX_CARET:
+                alive = pos == fAnchorStart;
+                state = pc + 1;
+                break;
 
-        case URX_LB_CONT:
-            {
-                // Positive Look-Behind, at top of loop checking for matches of LB expression
-                //    at all possible input starting positions.
+            case URX_CARET_M:
+                if (pos != fAnchorStart) {
+                    UTEXT_SETNATIVEINDEX(fInputText, pos);
+                    UChar32  c = UTEXT_PREVIOUS32(fInputText);
+                    alive = pos < fAnchorLimit && isLineTerminator(c);
+                }
+                state = pc + 1;
+                break;
 
-                // Fetch the min and max possible match lengths.  They are the operands
-                //   of this op in the pattern.
-                int32_t minML = (int32_t)pat[fp->fPatIdx++];
-                int32_t maxML = (int32_t)pat[fp->fPatIdx++];
-                U_ASSERT(minML <= maxML);
-                U_ASSERT(minML >= 0);
+            case URX_CARET_M_UNIX:
+                if (pos > fAnchorStart) {
+                    UTEXT_SETNATIVEINDEX(fInputText, pos);
+                    alive = UTEXT_PREVIOUS32(fInputText) == 0x0a;
+                }
+                state = pc + 1;
+                break;
 
-                // Fetch (from data) the last input index where a match was attempted.
-                U_ASSERT(opValue>=0 && opValue+4<fPattern->fDataSize);
-                int64_t  &lbStartIdx = fData[opValue+4];
-                if (lbStartIdx < 0) {
-                    // First time through loop.
-                    lbStartIdx = fp->fInputIdx - minML;
-                    if (lbStartIdx > 0 && lbStartIdx < fInputLength) {
-                        U16_SET_CP_START(inputBuf, 0, lbStartIdx);
-                    }
+            case URX_DOLLAR:
+                if (pos >= fAnchorLimit) {
+                    fHitEnd = TRUE;
+                    fRequireEnd = TRUE;
                 } else {
-                    // 2nd through nth time through the loop.
-                    // Back up start position for match by one.
-                    if (lbStartIdx == 0) {
-                        lbStartIdx--;
+                    alive = FALSE;
+                    UTEXT_SETNATIVEINDEX(fInputText, pos);
+                    UChar32 c = UTEXT_NEXT32(fInputText);
+                    if (UTEXT_GETNATIVEINDEX(fInputText) >= fAnchorLimit) {
+                        // At a new-line at end of input, if not in the middle of a CR/LF sequence.
+                        if (isLineTerminator(c) &&
+                                !(c==0x0a && pos>fAnchorStart &&
+                                  ((void)UTEXT_PREVIOUS32(fInputText), UTEXT_PREVIOUS32(fInputText))==0x0d)) {
+                            alive = TRUE;
+                        }
                     } else {
-                        U16_BACK_1(inputBuf, 0, lbStartIdx);
+                        UChar32 nextC = UTEXT_NEXT32(fInputText);
+                        if (c == 0x0d && nextC == 0x0a && UTEXT_GETNATIVEINDEX(fInputText) >= fAnchorLimit) {
+                            alive = TRUE;
+                        }
+                    }
+                    if (alive) {
+                        fHitEnd = TRUE;
+                        fRequireEnd = TRUE;
                     }
                 }
+                state = pc + 1;
+                break;
 
-                if (lbStartIdx < 0 || lbStartIdx < fp->fInputIdx - maxML) {
-                    // We have tried all potential match starting points without
-                    //  getting a match.  Backtrack out, and out of the
-                    //   Look Behind altogether.
-                    fp = (REStackFrame *)fStack->popFrame(fFrameSize);
-                    fActiveStart = fData[opValue+2];
-                    fActiveLimit = fData[opValue+3];
-                    U_ASSERT(fActiveStart >= 0);
-                    U_ASSERT(fActiveLimit <= fInputLength);
-                    break;
+            case URX_DOLLAR_D:
+                if (pos < fAnchorLimit) {
+                    UTEXT_SETNATIVEINDEX(fInputText, pos);
+                    UChar32 c = UTEXT_NEXT32(fInputText);
+                    alive = c == 0x0a && UTEXT_GETNATIVEINDEX(fInputText) == fAnchorLimit;
                 }
+                if (alive) {
+                    fHitEnd = TRUE;
+                    fRequireEnd = TRUE;
+                }
+                state = pc + 1;
+                break;
 
-                //    Save state to this URX_LB_CONT op, so failure to match will repeat the loop.
-                //      (successful match will fall off the end of the loop.)
-                fp = StateSave(fp, fp->fPatIdx-3, status);
-                fp->fInputIdx =  lbStartIdx;
-            }
-            break;
-
-        case URX_LB_END:
-            // End of a look-behind block, after a successful match.
-            {
-                U_ASSERT(opValue>=0 && opValue+4<fPattern->fDataSize);
-                if (fp->fInputIdx != fActiveLimit) {
-                    //  The look-behind expression matched, but the match did not
-                    //    extend all the way to the point that we are looking behind from.
-                    //  FAIL out of here, which will take us back to the LB_CONT, which
-                    //     will retry the match starting at another position or fail
-                    //     the look-behind altogether, whichever is appropriate.
-                    fp = (REStackFrame *)fStack->popFrame(fFrameSize);
-                    break;
+            case URX_DOLLAR_M:
+                if (pos >= fAnchorLimit) {
+                    fHitEnd = TRUE;
+                    fRequireEnd = TRUE;
+                } else {
+                    // At a line end, except in the middle of a CR/LF sequence.
+                    UTEXT_SETNATIVEINDEX(fInputText, pos);
+                    UChar32 c = UTEXT_CURRENT32(fInputText);
+                    alive = isLineTerminator(c) &&
+                            !(c==0x0a && pos>fAnchorStart && UTEXT_PREVIOUS32(fInputText)==0x0d);
                 }
+                state = pc + 1;
+                break;
 
-                // Look-behind match is good.  Restore the orignal input string region,
-                //   which had been truncated to pin the end of the lookbehind match to the
-                //   position being looked-behind.
-                fActiveStart = fData[opValue+2];
-                fActiveLimit = fData[opValue+3];
-                U_ASSERT(fActiveStart >= 0);
-                U_ASSERT(fActiveLimit <= fInputLength);
-            }
-            break;
+            case URX_DOLLAR_MD:
+                if (pos >= fAnchorLimit) {
+                    fHitEnd = TRUE;
+                    fRequireEnd = TRUE;
+                } else {
+                    UTEXT_SETNATIVEINDEX(fInputText, pos);
+                    alive = UTEXT_CURRENT32(fInputText) == 0x0a;
+                }
+                state = pc + 1;
+                break;
 
+            case URX_BACKSLASH_B:
+                alive = (fInputUTF8 != NULL ? isUTF8WordBoundary((int32_t)pos) : isWordBoundary(pos)) ^
+                        (UBool)(opValue != 0);
+                state = pc + 1;
+                break;
 
-        case URX_LBN_CONT:
-            {
-                // Negative Look-Behind, at top of loop checking for matches of LB expression
-                //    at all possible input starting positions.
+            case URX_BACKSLASH_BU:
+                alive = isUWordBoundary(pos, status) ^ (UBool)(opValue != 0);
+                state = pc + 1;
+                break;
 
-                // Fetch the extra parameters of this op.
-                int32_t minML       = (int32_t)pat[fp->fPatIdx++];
-                int32_t maxML       = (int32_t)pat[fp->fPatIdx++];
-                int32_t continueLoc = (int32_t)pat[fp->fPatIdx++];
-                continueLoc = URX_VAL(continueLoc);
-                U_ASSERT(minML <= maxML);
-                U_ASSERT(minML >= 0);
-                U_ASSERT(continueLoc > fp->fPatIdx);
+            case URX_BACKSLASH_G:
+                alive = (fMatch && pos==fMatchEnd) || (fMatch==FALSE && pos==fActiveStart);
+                state = pc + 1;
+                break;
 
-                // Fetch (from data) the last input index where a match was attempted.
-                U_ASSERT(opValue>=0 && opValue+4<fPattern->fDataSize);
-                int64_t  &lbStartIdx = fData[opValue+4];
-                if (lbStartIdx < 0) {
-                    // First time through loop.
-                    lbStartIdx = fp->fInputIdx - minML;
-                    if (lbStartIdx > 0 && lbStartIdx < fInputLength) {
-                        U16_SET_CP_START(inputBuf, 0, lbStartIdx);
-                    }
+            case URX_BACKSLASH_Z:
+                if (pos < fAnchorLimit) {
+                    alive = FALSE;
                 } else {
-                    // 2nd through nth time through the loop.
-                    // Back up start position for match by one.
-                    if (lbStartIdx == 0) {
-                        lbStartIdx--;   // Because U16_BACK is unsafe starting at 0.
-                    } else {
-                        U16_BACK_1(inputBuf, 0, lbStartIdx);
-                    }
+                    fHitEnd = TRUE;
+                    fRequireEnd = TRUE;
                 }
+                state = pc + 1;
+                break;
 
-                if (lbStartIdx < 0 || lbStartIdx < fp->fInputIdx - maxML) {
-                    // We have tried all potential match starting points without
-                    //  getting a match, which means that the negative lookbehind as
-                    //  a whole has succeeded.  Jump forward to the continue location
-                    fActiveStart = fData[opValue+2];
-                    fActiveLimit = fData[opValue+3];
-                    U_ASSERT(fActiveStart >= 0);
-                    U_ASSERT(fActiveLimit <= fInputLength);
-                    fp->fPatIdx = continueLoc;
-                    break;
-                }
+            default:
+                // RegexCompile::chooseMatchEngine() only picks this engine for
+                //   patterns using the ops above.
+                UPRV_UNREACHABLE;
+            }
+        }
 
-                //    Save state to this URX_LB_CONT op, so failure to match will repeat the loop.
-                //      (successful match will cause a FAIL out of the loop altogether.)
-                fp = StateSave(fp, fp->fPatIdx-4, status);
-                fp->fInputIdx =  lbStartIdx;
+        // Undo capture changes back to the most recent alternative, and explore it.
+        for (;;) {
+            if (jobs.size() == 0 || U_FAILURE(status)) {
+                return FALSE;
             }
-            break;
+            int32_t kind  = (int32_t)jobs.popi();
+            int64_t value = jobs.popi();
+            if (kind < 0) {
+                state = value;
+                break;
+            }
+            ((int64_t *)fp)[kind] = value;
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------
+//
+//   NFAInitWorkspace   Allocate the storage used by the linear time match engine,
+//                      when first needed.
+//
+//--------------------------------------------------------------------------------
+void RegexMatcher::NFAInitWorkspace(UErrorCode &status) {
+    const int64_t *pat     = fPattern->fCompiledPat->getBuffer();
+    int32_t        patSize = fPattern->fCompiledPat->size();
+
+    fFrameSize = fPattern->fFrameSize;
+    if (fNFAWorkspace == NULL) {
+        fNFAWorkspace = new RegexNFAWorkspace(status);
+        if (fNFAWorkspace == NULL) {
+            status = U_MEMORY_ALLOCATION_ERROR;
+            return;
+        }
+        // Number the NFA states.  Each pattern op has one state; string ops have one more
+        //   for each offset into the string, and ops that can match a CR/LF pair have one
+        //   more for having matched the CR.
+        int32_t stateCount = 0;
+        for (int32_t pc = 0; pc < patSize; pc++) {
+            fNFAWorkspace->fStateIndex.addElement(stateCount, status);
+            int32_t opType = URX_TYPE(pat[pc]);
+            if (opType == URX_STRING || opType == URX_STRING_I) {
+                stateCount += URX_VAL(pat[pc+1]);
+            } else if (opType == URX_DOTANY_ALL || opType == URX_BACKSLASH_R || opType == URX_LOOP_DOT_I) {
+                stateCount += 2;
+            } else {
+                stateCount++;
+            }
+        }
+        if (fNFAWorkspace->fMarks.ensureCapacity(stateCount, status) &&
+                fNFAWorkspace->fFrame.ensureCapacity(fFrameSize, status) &&
+                fNFAWorkspace->fMatchFrame.ensureCapacity(fFrameSize, status)) {
+            fNFAWorkspace->fMarks.setSize(stateCount);
+            fNFAWorkspace->fFrame.setSize(fFrameSize);
+            fNFAWorkspace->fMatchFrame.setSize(fFrameSize);
+        }
+        if (U_FAILURE(status)) {
+            delete fNFAWorkspace;
+            fNFAWorkspace = NULL;
+            return;
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------
+//
+//   NFANextState   Advance a thread in an NFA state over the input character c.
+//                  Returns the new state, or -1 if the thread fails.
+//
+//--------------------------------------------------------------------------------
+int64_t RegexMatcher::NFANextState(int64_t state, UChar32 c) {
+    const int64_t       *pat           = fPattern->fCompiledPat->getBuffer();
+    const UChar         *litText       = fPattern->fLiteralText.getBuffer();
+    UVector             *fSets         = fPattern->fSets;
 
-        case URX_LBN_END:
-            // End of a negative look-behind block, after a successful match.
-            {
-                U_ASSERT(opValue>=0 && opValue+4<fPattern->fDataSize);
-                if (fp->fInputIdx != fActiveLimit) {
-                    //  The look-behind expression matched, but the match did not
-                    //    extend all the way to the point that we are looking behind from.
-                    //  FAIL out of here, which will take us back to the LB_CONT, which
-                    //     will retry the match starting at another position or succeed
-                    //     the look-behind altogether, whichever is appropriate.
-                    fp = (REStackFrame *)fStack->popFrame(fFrameSize);
-                    break;
-                }
+    int32_t              pc            = (int32_t)state;
+    int32_t              sub           = (int32_t)(state >> 32);
+    int32_t              op            = (int32_t)pat[pc];
+    int32_t              opValue       = URX_VAL(op);
+    int64_t              next          = -1;
 
-                // Look-behind expression matched, which means look-behind test as
-                //   a whole Fails
+    switch (URX_TYPE(op)) {
+    case URX_ONECHAR:
+        if (c == opValue) {
+            next = pc + 1;
+        }
+        break;
 
-                //   Restore the orignal input string length, which had been truncated
-                //   inorder to pin the end of the lookbehind match
-                //   to the position being looked-behind.
-                fActiveStart = fData[opValue+2];
-                fActiveLimit = fData[opValue+3];
-                U_ASSERT(fActiveStart >= 0);
-                U_ASSERT(fActiveLimit <= fInputLength);
+    case URX_ONECHAR_I:
+        if (u_foldCase(c, U_FOLD_CASE_DEFAULT) == opValue) {
+            next = pc + 1;
+        }
+        break;
 
-                // Restore original stack position, discarding any state saved
-                //   by the successful pattern match.
-                U_ASSERT(opValue>=0 && opValue+1<fPattern->fDataSize);
-                int32_t newStackSize = (int32_t)fData[opValue];
-                U_ASSERT(fStack->size() > newStackSize);
-                fStack->setSize(newStackSize);
+    case URX_STRING:
+        {
+            // sub is the offset of the next code point to match in the string.
+            const UChar *patternString = litText + opValue;
+            int32_t  stringLen = URX_VAL(pat[pc+1]);
+            UChar32  patternChar;
+            U16_NEXT(patternString, sub, stringLen, patternChar);
+            if (c == patternChar) {
+                next = pc | ((int64_t)sub << 32);
+            }
+        }
+        break;
 
-                //  FAIL, which will take control back to someplace
-                //  prior to entering the look-behind test.
-                fp = (REStackFrame *)fStack->popFrame(fFrameSize);
+    case URX_STRING_I:
+        {
+            // The string from the pattern is already case folded.  The full case folding
+            //   of c must match the string at offset sub.
+            const UChar *foldChars;
+            UChar        foldBuf[U16_MAX_LENGTH];
+            int32_t      foldLength = ucase_toFullFolding(c, &foldChars, U_FOLD_CASE_DEFAULT);
+            if (foldLength >= UCASE_MAX_STRING_LENGTH || foldLength < 0) {
+                // c folds to a single code point.  See ucase.h for the return values.
+                UChar32 foldedC = foldLength < 0 ? ~foldLength : foldLength;
+                foldLength = 0;
+                U16_APPEND_UNSAFE(foldBuf, foldLength, foldedC);
+                foldChars = foldBuf;
+            }
+            int32_t stringLen = URX_VAL(pat[pc+1]);
+            if (sub + foldLength <= stringLen &&
+                    uprv_memcmp(litText + opValue + sub, foldChars, foldLength * U_SIZEOF_UCHAR) == 0) {
+                next = pc | ((int64_t)(sub + foldLength) << 32);
             }
-            break;
+        }
+        break;
 
+    case URX_STATIC_SETREF:
+        {
+            UBool success = ((opValue & URX_NEG_SET) == URX_NEG_SET);
+            opValue &= ~URX_NEG_SET;
+            U_ASSERT(opValue > 0 && opValue < URX_LAST_SET);
+            if (c < 256) {
+                if (RegexStaticSets::gStaticSets->fPropSets8[opValue].contains(c)) {
+                    success = !success;
+                }
+            } else if (RegexStaticSets::gStaticSets->fPropSets[opValue].contains(c)) {
+                success = !success;
+            }
+            if (success) {
+                next = pc + 1;
+            }
+        }
+        break;
 
-        case URX_LOOP_SR_I:
-            // Loop Initialization for the optimized implementation of
-            //     [some character set]*
-            //   This op scans through all matching input.
-            //   The following LOOP_C op emulates stack unwinding if the following pattern fails.
-            {
-                U_ASSERT(opValue > 0 && opValue < fSets->size());
-                Regex8BitSet *s8 = &fPattern->fSets8[opValue];
-                UnicodeSet   *s  = (UnicodeSet *)fSets->elementAt(opValue);
+    case URX_STAT_SETREF_N:
+        U_ASSERT(opValue > 0 && opValue < URX_LAST_SET);
+        if (c < 256) {
+            if (RegexStaticSets::gStaticSets->fPropSets8[opValue].contains(c) == FALSE) {
+                next = pc + 1;
+            }
+        } else if (RegexStaticSets::gStaticSets->fPropSets[opValue].contains(c) == FALSE) {
+            next = pc + 1;
+        }
+        break;
 
-                // Loop through input, until either the input is exhausted or
-                //   we reach a character that is not a member of the set.
-                int32_t ix = (int32_t)fp->fInputIdx;
-                for (;;) {
-                    if (ix >= fActiveLimit) {
-                        fHitEnd = TRUE;
-                        break;
-                    }
-                    UChar32   c;
-                    U16_NEXT(inputBuf, ix, fActiveLimit, c);
-                    if (c<256) {
-                        if (s8->contains(c) == FALSE) {
-                            U16_BACK_1(inputBuf, 0, ix);
-                            break;
-                        }
-                    } else {
-                        if (s->contains(c) == FALSE) {
-                            U16_BACK_1(inputBuf, 0, ix);
-                            break;
-                        }
-                    }
-                }
+    case URX_SETREF:
+    case URX_LOOP_SR_I:
+        {
+            U_ASSERT(opValue > 0 && opValue < fSets->size());
+            UBool inSet;
+            if (c < 256) {
+                inSet = fPattern->fSets8[opValue].contains(c);
+            } else {
+                inSet = ((UnicodeSet *)fSets->elementAt(opValue))->contains(c);
+            }
+            if (inSet) {
+                // A [set]* loop stays on its op for more characters.
+                next = URX_TYPE(op) == URX_SETREF ? pc + 1 : pc;
+            }
+        }
+        break;
 
-                // If there were no matching characters, skip over the loop altogether.
-                //   The loop doesn't run at all, a * op always succeeds.
-                if (ix == fp->fInputIdx) {
-                    fp->fPatIdx++;   // skip the URX_LOOP_C op.
-                    break;
-                }
+    case URX_DOTANY:
+        if (!isLineTerminator(c)) {
+            next = pc + 1;
+        }
+        break;
 
-                // Peek ahead in the compiled pattern, to the URX_LOOP_C that
-                //   must follow.  It's operand is the stack location
-                //   that holds the starting input index for the match of this [set]*
-                int32_t loopcOp = (int32_t)pat[fp->fPatIdx];
-                U_ASSERT(URX_TYPE(loopcOp) == URX_LOOP_C);
-                int32_t stackLoc = URX_VAL(loopcOp);
-                U_ASSERT(stackLoc >= 0 && stackLoc < fFrameSize);
-                fp->fExtra[stackLoc] = fp->fInputIdx;
-                fp->fInputIdx = ix;
+    case URX_DOTANY_UNIX:
+        if (c != 0x0a) {
+            next = pc + 1;
+        }
+        break;
+
+    case URX_DOTANY_ALL:
+    case URX_BACKSLASH_R:
+        // sub == 1 after a CR.  The thread is only in the list if c is the LF
+        //   following the CR, which must be matched as a unit with it.
+        if (sub == 1) {
+            next = pc + 1;
+        } else if (URX_TYPE(op) == URX_DOTANY_ALL || isLineTerminator(c)) {
+            next = c == 0x0d ? pc | ((int64_t)1 << 32) : pc + 1;
+        }
+        break;
+
+    case URX_LOOP_DOT_I:
+        if (sub == 1) {
+            next = pc;
+        } else if ((opValue & 1) == 1) {
+            // Dot-matches-All mode.  A CR/LF is matched as a unit.
+            next = c == 0x0d ? pc | ((int64_t)1 << 32) : pc;
+        } else if (!(c == 0x0a || ((opValue & 2) == 0 && isLineTerminator(c)))) {
+            next = pc;
+        }
+        break;
 
-                // Save State to the URX_LOOP_C op that follows this one,
-                //   so that match failures in the following code will return to there.
-                //   Then bump the pattern idx so the LOOP_C is skipped on the way out of here.
-                fp = StateSave(fp, fp->fPatIdx, status);
-                fp->fPatIdx++;
+    case URX_BACKSLASH_D:
+        if ((u_charType(c) == U_DECIMAL_DIGIT_NUMBER) ^ (UBool)(opValue != 0)) {
+            next = pc + 1;
+        }
+        break;
+
+    case URX_BACKSLASH_H:
+        {
+            int8_t ctype = u_charType(c);
+            if ((ctype == U_SPACE_SEPARATOR || c == 9) ^ (UBool)(opValue != 0)) {
+                next = pc + 1;
             }
-            break;
+        }
+        break;
 
+    case URX_BACKSLASH_V:
+        if (isLineTerminator(c) ^ (UBool)(opValue != 0)) {
+            next = pc + 1;
+        }
+        break;
 
-        case URX_LOOP_DOT_I:
-            // Loop Initialization for the optimized implementation of .*
-            //   This op scans through all remaining input.
-            //   The following LOOP_C op emulates stack unwinding if the following pattern fails.
-            {
-                // Loop through input until the input is exhausted (we reach an end-of-line)
-                // In DOTALL mode, we can just go straight to the end of the input.
-                int32_t ix;
-                if ((opValue & 1) == 1) {
-                    // Dot-matches-All mode.  Jump straight to the end of the string.
-                    ix = (int32_t)fActiveLimit;
-                    fHitEnd = TRUE;
-                } else {
-                    // NOT DOT ALL mode.  Line endings do not match '.'
-                    // Scan forward until a line ending or end of input.
-                    ix = (int32_t)fp->fInputIdx;
-                    for (;;) {
-                        if (ix >= fActiveLimit) {
-                            fHitEnd = TRUE;
-                            break;
-                        }
-                        UChar32   c;
-                        U16_NEXT(inputBuf, ix, fActiveLimit, c);   // c = inputBuf[ix++]
-                        if ((c & 0x7f) <= 0x29) {          // Fast filter of non-new-line-s
-                            if ((c == 0x0a) ||             //  0x0a is newline in both modes.
-                                (((opValue & 2) == 0) &&    // IF not UNIX_LINES mode
-                                   isLineTerminator(c))) {
-                                //  char is a line ending.  Put the input pos back to the
-                                //    line ending char, and exit the scanning loop.
-                                U16_BACK_1(inputBuf, 0, ix);
-                                break;
-                            }
-                        }
-                    }
-                }
+    default:
+        // Only character matching ops are left in thread lists.
+        UPRV_UNREACHABLE;
+    }
 
-                // If there were no matching characters, skip over the loop altogether.
-                //   The loop doesn't run at all, a * op always succeeds.
-                if (ix == fp->fInputIdx) {
-                    fp->fPatIdx++;   // skip the URX_LOOP_C op.
-                    break;
-                }
+    return next;
+}
 
-                // Peek ahead in the compiled pattern, to the URX_LOOP_C that
-                //   must follow.  It's operand is the stack location
-                //   that holds the starting input index for the match of this .*
-                int32_t loopcOp = (int32_t)pat[fp->fPatIdx];
-                U_ASSERT(URX_TYPE(loopcOp) == URX_LOOP_C);
-                int32_t stackLoc = URX_VAL(loopcOp);
-                U_ASSERT(stackLoc >= 0 && stackLoc < fFrameSize);
-                fp->fExtra[stackLoc] = fp->fInputIdx;
-                fp->fInputIdx = ix;
 
-                // Save State to the URX_LOOP_C op that follows this one,
-                //   so that match failures in the following code will return to there.
-                //   Then bump the pattern idx so the LOOP_C is skipped on the way out of here.
-                fp = StateSave(fp, fp->fPatIdx, status);
-                fp->fPatIdx++;
-            }
-            break;
+//--------------------------------------------------------------------------------
+//
+//   MatchNFASet   Run the combined program of a RegexSet over the input, finding
+//                 which of its patterns have a match.
+//
+//                 At each input position a thread is started for each pattern, not
+//                 yet matched, whose matches can start there.  Which match is found
+//                 does not matter, only whether there is one, so a pattern's threads
+//                 are dropped once it has matched, and the scan stops once all
+//                 of the combined patterns have.
+//
+//--------------------------------------------------------------------------------
+void RegexMatcher::MatchNFASet(const RegexSet &set, UBool *matched, UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return;
+    }
+    if (U_FAILURE(fDeferredStatus)) {
+        status = fDeferredStatus;
+        return;
+    }
+    NFAInitWorkspace(status);
+    if (U_FAILURE(status)) {
+        return;
+    }
+    RegexNFAWorkspace &ws = *fNFAWorkspace;
+    ws.fSetMode = TRUE;
+
+    const int32_t *startLocs      = set.fStartLocs->getBuffer();
+    const int32_t *patternOfOp    = set.fPatternOfOp->getBuffer();
+    const int32_t *byteStartIndex = set.fByteStartIndex->getBuffer();
+    const int32_t *byteStarts     = set.fByteStarts->getBuffer();
+    const int32_t *wideStarts     = set.fWideStarts->getBuffer();
+    int32_t        wideCount      = set.fWideStarts->size();
+    const int32_t *anyStarts      = set.fAnyStarts->getBuffer();
+    int32_t        anyCount       = set.fAnyStarts->size();
+    const int32_t *firstStarts    = set.fFirstStarts->getBuffer();
+    int32_t        firstCount     = set.fFirstStarts->size();
+
+    int32_t remaining = 0;
+    for (int32_t i = 0; i < set.fStartLocs->size(); i++) {
+        if (startLocs[i] >= 0 && !matched[i]) {
+            remaining++;
+        }
+    }
 
+    UVector64     *threads     = &ws.fThreads1;
+    UVector64     *nextThreads = &ws.fThreads2;
+    REStackFrame  *frame       = (REStackFrame *)ws.fFrame.getBuffer();
+    int64_t        pos         = fActiveStart;
+    const UChar   *chunk       = UTEXT_FULL_TEXT_IN_CHUNK(fInputText, fInputLength) ?
+                                     fInputText->chunkContents : NULL;
 
-        case URX_LOOP_C:
-            {
-                U_ASSERT(opValue>=0 && opValue<fFrameSize);
-                backSearchIndex = (int32_t)fp->fExtra[opValue];
-                U_ASSERT(backSearchIndex <= fp->fInputIdx);
-                if (backSearchIndex == fp->fInputIdx) {
-                    // We've backed up the input idx to the point that the loop started.
-                    // The loop is done.  Leave here without saving state.
-                    //  Subsequent failures won't come back here.
+    if (++ws.fGeneration == INT32_MAX) {
+        uprv_memset(ws.fMarks.getBuffer(), 0, ws.fMarks.size() * sizeof(int32_t));
+        ws.fGeneration = 1;
+    }
+    threads->removeAllElements();
+    ws.fMatchedEnds.removeAllElements();
+
+    while (remaining > 0 && U_SUCCESS(status)) {
+        UTEXT_SETNATIVEINDEX(fInputText, pos);
+        if (threads->size() == 0 && anyCount == 0 && (pos != fActiveStart || firstCount == 0)) {
+            // Nothing is in progress.  Skip ahead to a character that can start a match.
+            while (pos < fActiveLimit) {
+                UChar32 c = UTEXT_CURRENT32(fInputText);
+                if (c < 256 ? byteStartIndex[c] < byteStartIndex[c+1] : wideCount > 0) {
                     break;
                 }
-                // Set up for the next iteration of the loop, with input index
-                //   backed up by one from the last time through,
-                //   and a state save to this instruction in case the following code fails again.
-                //   (We're going backwards because this loop emulates stack unwinding, not
-                //    the initial scan forward.)
-                U_ASSERT(fp->fInputIdx > 0);
-                UChar32 prevC;
-                U16_PREV(inputBuf, 0, fp->fInputIdx, prevC); // !!!: should this 0 be one of f*Limit?
+                (void)UTEXT_NEXT32(fInputText);
+                pos = UTEXT_GETNATIVEINDEX(fInputText);
+            }
+        }
 
-                if (prevC == 0x0a &&
-                    fp->fInputIdx > backSearchIndex &&
-                    inputBuf[fp->fInputIdx-1] == 0x0d) {
-                    int32_t prevOp = (int32_t)pat[fp->fPatIdx-2];
-                    if (URX_TYPE(prevOp) == URX_LOOP_DOT_I) {
-                        // .*, stepping back over CRLF pair.
-                        U16_BACK_1(inputBuf, 0, fp->fInputIdx);
+        // Start threads for the patterns that can match from here.
+        UChar32 c = pos < fActiveLimit ? UTEXT_CURRENT32(fInputText) : U_SENTINEL;
+        for (int32_t kind = 0; kind < 4; kind++) {
+            const int32_t *starts = NULL;
+            int32_t        count  = 0;
+            if (kind == 0 && pos == fActiveStart) {
+                starts = firstStarts;
+                count  = firstCount;
+            } else if (kind == 1) {
+                starts = anyStarts;
+                count  = anyCount;
+            } else if (kind == 2 && c >= 0 && c < 256) {
+                starts = byteStarts + byteStartIndex[c];
+                count  = byteStartIndex[c+1] - byteStartIndex[c];
+            } else if (kind == 3 && c >= 256) {
+                starts = wideStarts;
+                count  = wideCount;
+            }
+            for (int32_t i = 0; i < count; i++) {
+                int32_t patIndex = starts[i];
+                if (matched[patIndex]) {
+                    continue;
+                }
+                if (kind >= 2) {
+                    const RegexPattern *pattern = (const RegexPattern *)set.fPatterns->elementAt(patIndex);
+                    if (kind == 3 && !pattern->fInitialChars->contains(c)) {
+                        continue;
+                    }
+                    if (pattern->fStartType == START_STRING && chunk != NULL) {
+                        // Only start where the pattern's initial string is.
+                        int32_t len = pattern->fInitialStringLen;
+                        if (pos + len > fActiveLimit ||
+                                uprv_memcmp(chunk + pos, pattern->fLiteralText.getBuffer() + pattern->fInitialStringIdx,
+                                            len * U_SIZEOF_UCHAR) != 0) {
+                            continue;
+                        }
                     }
                 }
-
-
-                fp = StateSave(fp, fp->fPatIdx-1, status);
+                frame->fInputIdx = pos;
+                for (int32_t j = 0; j < fFrameSize - RESTACKFRAME_HDRCOUNT; j++) {
+                    frame->fExtra[j] = -1;
+                }
+                NFAAddThread(threads, startLocs[patIndex], pos, FALSE, status);
             }
-            break;
-
-
-
-        default:
-            // Trouble.  The compiled pattern contains an entry with an
-            //           unrecognized type tag.
-            UPRV_UNREACHABLE;
         }
 
-        if (U_FAILURE(status)) {
-            isMatch = FALSE;
+        // Record the patterns that reached their END, here or while advancing
+        //   to this position.
+        for (int32_t i = 0; i < ws.fMatchedEnds.size(); i++) {
+            int32_t patIndex = patternOfOp[ws.fMatchedEnds.elementAti(i)];
+            if (!matched[patIndex]) {
+                matched[patIndex] = TRUE;
+                remaining--;
+            }
+        }
+        ws.fMatchedEnds.removeAllElements();
+        if (remaining == 0 || pos >= fActiveLimit) {
             break;
         }
-    }
 
-breakFromLoop:
-    fMatch = isMatch;
-    if (isMatch) {
-        fLastMatchEnd = fMatchEnd;
-        fMatchStart   = startIdx;
-        fMatchEnd     = fp->fInputIdx;
-    }
+        // Adding threads may have moved the input text's index.
+        UTEXT_SETNATIVEINDEX(fInputText, pos);
+        (void)UTEXT_NEXT32(fInputText);
+        int64_t nextPos = UTEXT_GETNATIVEINDEX(fInputText);
 
-#ifdef REGEX_RUN_DEBUG
-    if (fTraceDebug) {
-        if (isMatch) {
-            printf("Match.  start=%ld   end=%ld\n\n", fMatchStart, fMatchEnd);
-        } else {
-            printf("No match\n\n");
+        if (++ws.fGeneration == INT32_MAX) {
+            uprv_memset(ws.fMarks.getBuffer(), 0, ws.fMarks.size() * sizeof(int32_t));
+            ws.fGeneration = 1;
         }
-    }
-#endif
+        nextThreads->removeAllElements();
 
-    fFrame = fp;                // The active stack frame when the engine stopped.
-                                //   Contains the capture group results that we need to
-                                //    access later.
+        int32_t        threadCount = threads->size() / fFrameSize;
+        const int64_t *thread      = threads->getBuffer();
+        for (int32_t t = 0; t < threadCount; t++, thread += fFrameSize) {
+            int64_t state = ((const REStackFrame *)thread)->fPatIdx;
+            if (matched[patternOfOp[(int32_t)state]]) {
+                continue;
+            }
+            int64_t next = NFANextState(state, c);
+            if (next >= 0) {
+                uprv_memcpy(frame, thread, fFrameSize * sizeof(int64_t));
+                NFAAddThread(nextThreads, next, nextPos, FALSE, status);
+            }
+        }
 
-    return;
+        UVector64 *t = threads;
+        threads = nextThreads;
+        nextThreads = t;
+        pos = nextPos;
+    }
+    ws.fSetMode = FALSE;
 }
 
 
@@ -18,6 +18,7 @@
 #include "unicode/uclean.h"
 #include "cmemory.h"
 #include "cstr.h"
+#include "mutex.h"
 #include "uassert.h"
 #include "uhash.h"
 #include "uvector.h"
@@ -29,6 +30,12 @@
 
 U_NAMESPACE_BEGIN
 
+// Guards the matcher pools of all RegexPatterns.
+static UMutex gMatcherPoolMutex;
+
+// The most idle matchers that a pattern keeps for acquireMatcher().
+static const int32_t MAX_POOLED_MATCHERS = 8;
+
 //--------------------------------------------------------------------------
 //
 //    RegexPattern    Default Constructor
@@ -105,6 +112,9 @@ RegexPattern &RegexPattern::operator = (const RegexPattern &other) {
     fInitialChar      = other.fInitialChar;
     *fInitialChars8   = *other.fInitialChars8;
     fNeedsAltInput    = other.fNeedsAltInput;
+    *fInitialStringSearch  = *other.fInitialStringSearch;
+    *fRequiredStringSearch = *other.fRequiredStringSearch;
+    fUseNFAEngine     = other.fUseNFAEngine;
 
     //  Copy the pattern.  It's just values, nothing deep to copy.
     fCompiledPat->assign(*other.fCompiledPat, fDeferredStatus);
@@ -180,7 +190,11 @@ void RegexPattern::init() {
     fInitialChar      = 0;
     fInitialChars8    = NULL;
     fNeedsAltInput    = FALSE;
+    fInitialStringSearch  = NULL;
+    fRequiredStringSearch = NULL;
+    fUseNFAEngine     = FALSE;
     fNamedCaptureMap  = NULL;
+    fMatcherPool      = NULL;
 
     fPattern          = NULL; // will be set later
     fPatternString    = NULL; // may be set later
@@ -189,11 +203,16 @@ void RegexPattern::init() {
     fSets             = new UVector(fDeferredStatus);
     fInitialChars     = new UnicodeSet;
     fInitialChars8    = new Regex8BitSet;
+    fInitialStringSearch  = new RegexStringSearch;
+    fRequiredStringSearch = new RegexStringSearch;
+    fMatcherPool      = new UVector(fDeferredStatus);
     if (U_FAILURE(fDeferredStatus)) {
         return;
     }
     if (fCompiledPat == NULL  || fGroupMap == NULL || fSets == NULL ||
-            fInitialChars == NULL || fInitialChars8 == NULL) {
+            fInitialChars == NULL || fInitialChars8 == NULL ||
+            fInitialStringSearch == NULL || fRequiredStringSearch == NULL ||
+            fMatcherPool == NULL) {
         fDeferredStatus = U_MEMORY_ALLOCATION_ERROR;
         return;
     }
@@ -227,6 +246,14 @@ bool RegexPattern::initNamedCaptureMap() {
 //
 //--------------------------------------------------------------------------
 void RegexPattern::zap() {
+    // Pooled matchers refer to this pattern's data, so they go first.
+    if (fMatcherPool != NULL) {
+        for (int32_t i=0; i<fMatcherPool->size(); i++) {
+            delete (RegexMatcher *)fMatcherPool->elementAt(i);
+        }
+        delete fMatcherPool;
+        fMatcherPool = NULL;
+    }
     delete fCompiledPat;
     fCompiledPat = NULL;
     int i;
@@ -247,6 +274,10 @@ void RegexPattern::zap() {
     fInitialChars = NULL;
     delete fInitialChars8;
     fInitialChars8 = NULL;
+    delete fInitialStringSearch;
+    fInitialStringSearch = NULL;
+    delete fRequiredStringSearch;
+    fRequiredStringSearch = NULL;
     if (fPattern != NULL) {
         utext_close(fPattern);
         fPattern = NULL;
@@ -325,9 +356,11 @@ RegexPattern::compile(const UnicodeString &regex,
 
     const uint32_t allFlags = UREGEX_CANON_EQ | UREGEX_CASE_INSENSITIVE | UREGEX_COMMENTS |
     UREGEX_DOTALL   | UREGEX_MULTILINE        | UREGEX_UWORD |
-    UREGEX_ERROR_ON_UNKNOWN_ESCAPES           | UREGEX_UNIX_LINES | UREGEX_LITERAL;
+    UREGEX_ERROR_ON_UNKNOWN_ESCAPES           | UREGEX_UNIX_LINES | UREGEX_LITERAL |
+    UREGEX_LINEAR_TIME | UREGEX_BACKTRACKING;
 
-    if ((flags & ~allFlags) != 0) {
+    if ((flags & ~allFlags) != 0 ||
+            (flags & (UREGEX_LINEAR_TIME | UREGEX_BACKTRACKING)) == (UREGEX_LINEAR_TIME | UREGEX_BACKTRACKING)) {
         status = U_REGEX_INVALID_FLAG;
         return NULL;
     }
@@ -376,9 +409,11 @@ RegexPattern::compile(UText                *regex,
 
     const uint32_t allFlags = UREGEX_CANON_EQ | UREGEX_CASE_INSENSITIVE | UREGEX_COMMENTS |
                               UREGEX_DOTALL   | UREGEX_MULTILINE        | UREGEX_UWORD |
-                              UREGEX_ERROR_ON_UNKNOWN_ESCAPES           | UREGEX_UNIX_LINES | UREGEX_LITERAL;
+                              UREGEX_ERROR_ON_UNKNOWN_ESCAPES           | UREGEX_UNIX_LINES | UREGEX_LITERAL |
+                              UREGEX_LINEAR_TIME | UREGEX_BACKTRACKING;
 
-    if ((flags & ~allFlags) != 0) {
+    if ((flags & ~allFlags) != 0 ||
+            (flags & (UREGEX_LINEAR_TIME | UREGEX_BACKTRACKING)) == (UREGEX_LINEAR_TIME | UREGEX_BACKTRACKING)) {
         status = U_REGEX_INVALID_FLAG;
         return NULL;
     }
@@ -512,6 +547,70 @@ RegexMatcher *RegexPattern::matcher(UErrorCode &status)  const {
 }
 
 
+//---------------------------------------------------------------------
+//
+//   acquireMatcher      Take a matcher from the pool, or make a new one.
+//                       There is no thread_local storage in ICU; the pool is
+//                       a mutex-guarded list, and each matcher in use belongs
+//                       to the thread that acquired it.
+//
+//---------------------------------------------------------------------
+RegexMatcher *RegexPattern::acquireMatcher(UErrorCode &status) const {
+    if (U_FAILURE(status)) {
+        return NULL;
+    }
+    if (U_FAILURE(fDeferredStatus)) {
+        status = fDeferredStatus;
+        return NULL;
+    }
+    {
+        Mutex lock(&gMatcherPoolMutex);
+        int32_t size = fMatcherPool->size();
+        if (size > 0) {
+            return (RegexMatcher *)fMatcherPool->orphanElementAt(size - 1);
+        }
+    }
+
+    RegexMatcher *retMatcher = matcher(status);
+    if (retMatcher == NULL) {
+        return NULL;
+    }
+    if (U_SUCCESS(retMatcher->fDeferredStatus)) {
+        retMatcher->preallocateStack(retMatcher->fDeferredStatus);
+    }
+    if (U_FAILURE(retMatcher->fDeferredStatus)) {
+        status = retMatcher->fDeferredStatus;
+        delete retMatcher;
+        return NULL;
+    }
+    return retMatcher;
+}
+
+
+//---------------------------------------------------------------------
+//
+//   releaseMatcher      Return a matcher to the pool.
+//
+//---------------------------------------------------------------------
+void RegexPattern::releaseMatcher(RegexMatcher *matcher) const {
+    if (matcher == NULL) {
+        return;
+    }
+    U_ASSERT(matcher->fPattern == this);
+    if (matcher->fPattern == this && matcher->resetForPool()) {
+        Mutex lock(&gMatcherPoolMutex);
+        if (fMatcherPool->size() < MAX_POOLED_MATCHERS) {
+            UErrorCode status = U_ZERO_ERROR;
+            fMatcherPool->addElement(matcher, status);
+            if (U_SUCCESS(status)) {
+                return;
+            }
+        }
+    }
+    delete matcher;
+}
+
+
 
 //---------------------------------------------------------------------
 //
@@ -844,6 +943,12 @@ void RegexPattern::dumpPattern() const {
                 printf("%#x\n", fInitialChar);
             }
     }
+    if (fRequiredStringSearch->fStringLen > 0) {
+        UnicodeString requiredString(fLiteralText, fRequiredStringSearch->fStringIdx,
+                                     fRequiredStringSearch->fStringLen);
+        printf("   Required string: \"%s\"\n", CStr(requiredString)());
+    }
+    printf("   Match engine:      %s\n", fUseNFAEngine ? "NFA" : "Backtracking");
 
     printf("Named Capture Groups:\n");
     if (!fNamedCaptureMap || uhash_count(fNamedCaptureMap) == 0) {
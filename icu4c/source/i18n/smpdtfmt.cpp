@@ -74,6 +74,8 @@
 #include "dayperiodrules.h"
 #include "tznames_impl.h"   // ZONE_NAME_U16_MAX
 #include "number_utypes.h"
+#include "gregoimp.h"
+#include "sharedobject.h"
 
 #if defined( U_DEBUG_CALSVC ) || defined (U_DEBUG_CAL)
 #include <stdio.h>
@@ -173,6 +175,27 @@ static const UChar SUPPRESS_NEGATIVE_PREFIX[] = {0xAB00, 0};
  */
 static const UChar QUOTE = 0x27; // Single quote
 
+/*
+ * fCompiledPattern: Units at or above COMPILED_FIELD start a field,
+ * smaller ones are the length of the literal text that follows.
+ */
+static const UChar COMPILED_FIELD = 0x8000;
+
+// Appends the literal text as compiled pattern items and empties it.
+static void compileLiteral(UnicodeString &compiled, UnicodeString &literal) {
+    int32_t start = 0;
+    int32_t length = literal.length();
+    while (start < length) {
+        int32_t itemLength = length - start;
+        if (itemLength >= COMPILED_FIELD) {
+            itemLength = COMPILED_FIELD - 1;
+        }
+        compiled.append((UChar)itemLength).append(literal, start, itemLength);
+        start += itemLength;
+    }
+    literal.remove();
+}
+
 /*
  * The field range check bias for each UDateFormatField.
  * The bias is added to the minimum and maximum values
@@ -580,6 +603,8 @@ SimpleDateFormat& SimpleDateFormat::operator=(const SimpleDateFormat& other)
     fHaveDefaultCentury          = other.fHaveDefaultCentury;
 
     fPattern = other.fPattern;
+    fCompiledPattern = other.fCompiledPattern;
+    fGregorianPattern = other.fGregorianPattern;
     fHasMinute = other.fHasMinute;
     fHasSecond = other.fHasSecond;
 
@@ -961,6 +986,55 @@ SimpleDateFormat::format(Calendar& cal, UnicodeString& appendTo,
 
 //----------------------------------------------------------------------
 
+// Fields that formatGregorian() computes from the Gregorian date, the time of day
+// and the time zone. Week fields depend on the Calendar's week data, and the
+// day period fields on extra locale data, so they are left to subFormat().
+static const uint64_t kGregorianFields =
+    ((uint64_t)1 << UDAT_ERA_FIELD) |
+    ((uint64_t)1 << UDAT_YEAR_FIELD) |
+    ((uint64_t)1 << UDAT_MONTH_FIELD) |
+    ((uint64_t)1 << UDAT_DATE_FIELD) |
+    ((uint64_t)1 << UDAT_HOUR_OF_DAY1_FIELD) |
+    ((uint64_t)1 << UDAT_HOUR_OF_DAY0_FIELD) |
+    ((uint64_t)1 << UDAT_MINUTE_FIELD) |
+    ((uint64_t)1 << UDAT_SECOND_FIELD) |
+    ((uint64_t)1 << UDAT_FRACTIONAL_SECOND_FIELD) |
+    ((uint64_t)1 << UDAT_DAY_OF_WEEK_FIELD) |
+    ((uint64_t)1 << UDAT_DAY_OF_YEAR_FIELD) |
+    ((uint64_t)1 << UDAT_DAY_OF_WEEK_IN_MONTH_FIELD) |
+    ((uint64_t)1 << UDAT_AM_PM_FIELD) |
+    ((uint64_t)1 << UDAT_HOUR1_FIELD) |
+    ((uint64_t)1 << UDAT_HOUR0_FIELD) |
+    ((uint64_t)1 << UDAT_TIMEZONE_FIELD) |
+    ((uint64_t)1 << UDAT_MILLISECONDS_IN_DAY_FIELD) |
+    ((uint64_t)1 << UDAT_TIMEZONE_RFC_FIELD) |
+    ((uint64_t)1 << UDAT_TIMEZONE_GENERIC_FIELD) |
+    ((uint64_t)1 << UDAT_STANDALONE_MONTH_FIELD) |
+    ((uint64_t)1 << UDAT_QUARTER_FIELD) |
+    ((uint64_t)1 << UDAT_STANDALONE_QUARTER_FIELD) |
+    ((uint64_t)1 << UDAT_TIMEZONE_SPECIAL_FIELD) |
+    ((uint64_t)1 << UDAT_TIMEZONE_LOCALIZED_GMT_OFFSET_FIELD) |
+    ((uint64_t)1 << UDAT_TIMEZONE_ISO_FIELD) |
+    ((uint64_t)1 << UDAT_TIMEZONE_ISO_LOCAL_FIELD);
+
+// Formatting without a Calendar covers dates from after the Gregorian cutover year
+// up to about the year 5,000,000, well within the range of Calendar.
+static const UDate kMaxGregorianDate = 1.5e17;
+
+// GregorianCalendar shifts DAY_OF_YEAR for the rest of the cutover year,
+// so formatting without a Calendar starts with the following year,
+// one day late so that the local date is also in that year.
+static UDate getMinGregorianDate(const GregorianCalendar &gc) {
+    UDate cutover = gc.getGregorianChange();
+    if (cutover < -kMaxGregorianDate || kMaxGregorianDate < cutover) {
+        // Pure Gregorian or pure Julian calendar.
+        return cutover + U_MILLIS_PER_DAY;
+    }
+    int32_t year, month, dom, dow;
+    Grego::dayToFields(uprv_floor(cutover / U_MILLIS_PER_DAY), year, month, dom, dow);
+    return (Grego::fieldsToDay(year + 1, 0, 1) + 1) * U_MILLIS_PER_DAY;
+}
+
 UnicodeString&
 SimpleDateFormat::_format(Calendar& cal, UnicodeString& appendTo,
                             FieldPositionHandler& handler, UErrorCode& status) const
@@ -986,51 +1060,40 @@ SimpleDateFormat::_format(Calendar& cal, UnicodeString& appendTo,
         }
     }
 
-    UBool inQuote = FALSE;
-    UChar prevCh = 0;
-    int32_t count = 0;
+    // Gregorian dates with patterns without week fields need not compute
+    // all of the Calendar fields.
+    const GregorianCalendar *gc = dynamic_cast<const GregorianCalendar *>(workCal);
+    if (gc != NULL && canFormatGregorian() && uprv_strcmp(gc->getType(), "gregorian") == 0) {
+        UDate date = workCal->getTime(status);
+        if (U_SUCCESS(status) &&
+                getMinGregorianDate(*gc) <= date && date <= kMaxGregorianDate) {
+            formatGregorian(date, workCal->getTimeZone(), appendTo, handler, status);
+            delete calClone;
+            return appendTo;
+        }
+    }
+
     int32_t fieldNum = 0;
     UDisplayContext capitalizationContext = getContext(UDISPCTX_TYPE_CAPITALIZATION, status);
 
-    // loop through the pattern string character by character
-    for (int32_t i = 0; i < fPattern.length() && U_SUCCESS(status); ++i) {
-        UChar ch = fPattern[i];
-
-        // Use subFormat() to format a repeated pattern character
-        // when a different pattern or non-pattern character is seen
-        if (ch != prevCh && count > 0) {
-            subFormat(appendTo, prevCh, count, capitalizationContext, fieldNum++,
-                      prevCh, handler, *workCal, status);
-            count = 0;
-        }
-        if (ch == QUOTE) {
-            // Consecutive single quotes are a single quote literal,
-            // either outside of quotes or between quotes
-            if ((i+1) < fPattern.length() && fPattern[i+1] == QUOTE) {
-                appendTo += (UChar)QUOTE;
-                ++i;
-            } else {
-                inQuote = ! inQuote;
-            }
-        }
-        else if (!inQuote && isSyntaxChar(ch)) {
-            // ch is a date-time pattern character to be interpreted
-            // by subFormat(); count the number of times it is repeated
-            prevCh = ch;
-            ++count;
-        }
-        else {
-            // Append quoted characters and unquoted non-pattern characters
-            appendTo += ch;
+    // Run the pattern program built by parsePattern():
+    // append the literal text, and use subFormat() for each field.
+    const UChar *items = fCompiledPattern.getBuffer();
+    int32_t itemsLength = fCompiledPattern.length();
+    for (int32_t i = 0; i < itemsLength && U_SUCCESS(status);) {
+        UChar unit = items[i++];
+        if (unit < COMPILED_FIELD) {
+            appendTo.append(items, i, unit);
+            i += unit;
+        } else {
+            int32_t count = ((int32_t)(unit - COMPILED_FIELD) << 16) | items[i];
+            UChar ch = items[i + 1];
+            i += 2;
+            subFormat(appendTo, ch, count, capitalizationContext, fieldNum++,
+                      ch, handler, *workCal, status);
         }
     }
 
-    // Format the last item in the pattern, if any
-    if (count > 0) {
-        subFormat(appendTo, prevCh, count, capitalizationContext, fieldNum++,
-                  prevCh, handler, *workCal, status);
-    }
-
     if (calClone != NULL) {
         delete calClone;
     }
@@ -1224,6 +1287,112 @@ _appendSymbolWithMonthPattern(UnicodeString& dst, int32_t value, const UnicodeSt
 
 //----------------------------------------------------------------------
 
+// Formats a time zone field ('z', 'Z', 'v', 'V', 'O', 'X' or 'x'),
+// and sets the type of capitalization context in which its text is used.
+static void
+_formatTimeZone(const TimeZoneFormat &tzfmt, UDateFormatField patternCharIndex, int32_t count,
+                const TimeZone &tz, UDate date, UnicodeString &zoneString,
+                DateFormatSymbols::ECapitalizationContextUsageType &capContextUsageType) {
+    if (patternCharIndex == UDAT_TIMEZONE_FIELD) {
+        if (count < 4) {
+            // "z", "zz", "zzz"
+            tzfmt.format(UTZFMT_STYLE_SPECIFIC_SHORT, tz, date, zoneString);
+            capContextUsageType = DateFormatSymbols::kCapContextUsageMetazoneShort;
+        } else {
+            // "zzzz" or longer
+            tzfmt.format(UTZFMT_STYLE_SPECIFIC_LONG, tz, date, zoneString);
+            capContextUsageType = DateFormatSymbols::kCapContextUsageMetazoneLong;
+        }
+    }
+    else if (patternCharIndex == UDAT_TIMEZONE_RFC_FIELD) {
+        if (count < 4) {
+            // "Z"
+            tzfmt.format(UTZFMT_STYLE_ISO_BASIC_LOCAL_FULL, tz, date, zoneString);
+        } else if (count == 5) {
+            // "ZZZZZ"
+            tzfmt.format(UTZFMT_STYLE_ISO_EXTENDED_FULL, tz, date, zoneString);
+        } else {
+            // "ZZ", "ZZZ", "ZZZZ"
+            tzfmt.format(UTZFMT_STYLE_LOCALIZED_GMT, tz, date, zoneString);
+        }
+    }
+    else if (patternCharIndex == UDAT_TIMEZONE_GENERIC_FIELD) {
+        if (count == 1) {
+            // "v"
+            tzfmt.format(UTZFMT_STYLE_GENERIC_SHORT, tz, date, zoneString);
+            capContextUsageType = DateFormatSymbols::kCapContextUsageMetazoneShort;
+        } else if (count == 4) {
+            // "vvvv"
+            tzfmt.format(UTZFMT_STYLE_GENERIC_LONG, tz, date, zoneString);
+            capContextUsageType = DateFormatSymbols::kCapContextUsageMetazoneLong;
+        }
+    }
+    else if (patternCharIndex == UDAT_TIMEZONE_SPECIAL_FIELD) {
+        if (count == 1) {
+            // "V"
+            tzfmt.format(UTZFMT_STYLE_ZONE_ID_SHORT, tz, date, zoneString);
+        } else if (count == 2) {
+            // "VV"
+            tzfmt.format(UTZFMT_STYLE_ZONE_ID, tz, date, zoneString);
+        } else if (count == 3) {
+            // "VVV"
+            tzfmt.format(UTZFMT_STYLE_EXEMPLAR_LOCATION, tz, date, zoneString);
+        } else if (count == 4) {
+            // "VVVV"
+            tzfmt.format(UTZFMT_STYLE_GENERIC_LOCATION, tz, date, zoneString);
+            capContextUsageType = DateFormatSymbols::kCapContextUsageZoneLong;
+        }
+    }
+    else if (patternCharIndex == UDAT_TIMEZONE_LOCALIZED_GMT_OFFSET_FIELD) {
+        if (count == 1) {
+            // "O"
+            tzfmt.format(UTZFMT_STYLE_LOCALIZED_GMT_SHORT, tz, date, zoneString);
+        } else if (count == 4) {
+            // "OOOO"
+            tzfmt.format(UTZFMT_STYLE_LOCALIZED_GMT, tz, date, zoneString);
+        }
+    }
+    else if (patternCharIndex == UDAT_TIMEZONE_ISO_FIELD) {
+        if (count == 1) {
+            // "X"
+            tzfmt.format(UTZFMT_STYLE_ISO_BASIC_SHORT, tz, date, zoneString);
+        } else if (count == 2) {
+            // "XX"
+            tzfmt.format(UTZFMT_STYLE_ISO_BASIC_FIXED, tz, date, zoneString);
+        } else if (count == 3) {
+            // "XXX"
+            tzfmt.format(UTZFMT_STYLE_ISO_EXTENDED_FIXED, tz, date, zoneString);
+        } else if (count == 4) {
+            // "XXXX"
+            tzfmt.format(UTZFMT_STYLE_ISO_BASIC_FULL, tz, date, zoneString);
+        } else if (count == 5) {
+            // "XXXXX"
+            tzfmt.format(UTZFMT_STYLE_ISO_EXTENDED_FULL, tz, date, zoneString);
+        }
+    }
+    else if (patternCharIndex == UDAT_TIMEZONE_ISO_LOCAL_FIELD) {
+        if (count == 1) {
+            // "x"
+            tzfmt.format(UTZFMT_STYLE_ISO_BASIC_LOCAL_SHORT, tz, date, zoneString);
+        } else if (count == 2) {
+            // "xx"
+            tzfmt.format(UTZFMT_STYLE_ISO_BASIC_LOCAL_FIXED, tz, date, zoneString);
+        } else if (count == 3) {
+            // "xxx"
+            tzfmt.format(UTZFMT_STYLE_ISO_EXTENDED_LOCAL_FIXED, tz, date, zoneString);
+        } else if (count == 4) {
+            // "xxxx"
+            tzfmt.format(UTZFMT_STYLE_ISO_BASIC_LOCAL_FULL, tz, date, zoneString);
+        } else if (count == 5) {
+            // "xxxxx"
+            tzfmt.format(UTZFMT_STYLE_ISO_EXTENDED_LOCAL_FULL, tz, date, zoneString);
+        }
+    }
+    else {
+        UPRV_UNREACHABLE;
+    }
+}
+
 static number::LocalizedNumberFormatter*
 createFastFormatter(const DecimalFormat* df, int32_t minInt, int32_t maxInt, UErrorCode& status) {
     const number::LocalizedNumberFormatter* lnfBase = df->toNumberFormatter(status);
@@ -1456,7 +1625,6 @@ SimpleDateFormat::subFormat(UnicodeString &appendTo,
         status = U_INTERNAL_PROGRAM_ERROR;
         return;
     }
-    UnicodeString hebr("hebr", 4, US_INV);
 
     switch (patternCharIndex) {
 
@@ -1498,7 +1666,7 @@ SimpleDateFormat::subFormat(UnicodeString &appendTo,
 //AD 12345 12345     45   12345    12345     12345
     case UDAT_YEAR_FIELD:
     case UDAT_YEAR_WOY_FIELD:
-        if (fDateOverride.compare(hebr)==0 && value>HEBREW_CAL_CUR_MILLENIUM_START_YEAR && value<HEBREW_CAL_CUR_MILLENIUM_END_YEAR) {
+        if (fDateOverride.compare(u"hebr", 4)==0 && value>HEBREW_CAL_CUR_MILLENIUM_START_YEAR && value<HEBREW_CAL_CUR_MILLENIUM_END_YEAR) {
             value-=HEBREW_CAL_CUR_MILLENIUM_START_YEAR;
         }
         if(count == 2)
@@ -1701,104 +1869,7 @@ SimpleDateFormat::subFormat(UnicodeString &appendTo,
             UDate date = cal.getTime(status);
             const TimeZoneFormat *tzfmt = tzFormat(status);
             if (U_SUCCESS(status)) {
-                if (patternCharIndex == UDAT_TIMEZONE_FIELD) {
-                    if (count < 4) {
-                        // "z", "zz", "zzz"
-                        tzfmt->format(UTZFMT_STYLE_SPECIFIC_SHORT, tz, date, zoneString);
-                        capContextUsageType = DateFormatSymbols::kCapContextUsageMetazoneShort;
-                    } else {
-                        // "zzzz" or longer
-                        tzfmt->format(UTZFMT_STYLE_SPECIFIC_LONG, tz, date, zoneString);
-                        capContextUsageType = DateFormatSymbols::kCapContextUsageMetazoneLong;
-                    }
-                }
-                else if (patternCharIndex == UDAT_TIMEZONE_RFC_FIELD) {
-                    if (count < 4) {
-                        // "Z"
-                        tzfmt->format(UTZFMT_STYLE_ISO_BASIC_LOCAL_FULL, tz, date, zoneString);
-                    } else if (count == 5) {
-                        // "ZZZZZ"
-                        tzfmt->format(UTZFMT_STYLE_ISO_EXTENDED_FULL, tz, date, zoneString);
-                    } else {
-                        // "ZZ", "ZZZ", "ZZZZ"
-                        tzfmt->format(UTZFMT_STYLE_LOCALIZED_GMT, tz, date, zoneString);
-                    }
-                }
-                else if (patternCharIndex == UDAT_TIMEZONE_GENERIC_FIELD) {
-                    if (count == 1) {
-                        // "v"
-                        tzfmt->format(UTZFMT_STYLE_GENERIC_SHORT, tz, date, zoneString);
-                        capContextUsageType = DateFormatSymbols::kCapContextUsageMetazoneShort;
-                    } else if (count == 4) {
-                        // "vvvv"
-                        tzfmt->format(UTZFMT_STYLE_GENERIC_LONG, tz, date, zoneString);
-                        capContextUsageType = DateFormatSymbols::kCapContextUsageMetazoneLong;
-                    }
-                }
-                else if (patternCharIndex == UDAT_TIMEZONE_SPECIAL_FIELD) {
-                    if (count == 1) {
-                        // "V"
-                        tzfmt->format(UTZFMT_STYLE_ZONE_ID_SHORT, tz, date, zoneString);
-                    } else if (count == 2) {
-                        // "VV"
-                        tzfmt->format(UTZFMT_STYLE_ZONE_ID, tz, date, zoneString);
-                    } else if (count == 3) {
-                        // "VVV"
-                        tzfmt->format(UTZFMT_STYLE_EXEMPLAR_LOCATION, tz, date, zoneString);
-                    } else if (count == 4) {
-                        // "VVVV"
-                        tzfmt->format(UTZFMT_STYLE_GENERIC_LOCATION, tz, date, zoneString);
-                        capContextUsageType = DateFormatSymbols::kCapContextUsageZoneLong;
-                    }
-                }
-                else if (patternCharIndex == UDAT_TIMEZONE_LOCALIZED_GMT_OFFSET_FIELD) {
-                    if (count == 1) {
-                        // "O"
-                        tzfmt->format(UTZFMT_STYLE_LOCALIZED_GMT_SHORT, tz, date, zoneString);
-                    } else if (count == 4) {
-                        // "OOOO"
-                        tzfmt->format(UTZFMT_STYLE_LOCALIZED_GMT, tz, date, zoneString);
-                    }
-                }
-                else if (patternCharIndex == UDAT_TIMEZONE_ISO_FIELD) {
-                    if (count == 1) {
-                        // "X"
-                        tzfmt->format(UTZFMT_STYLE_ISO_BASIC_SHORT, tz, date, zoneString);
-                    } else if (count == 2) {
-                        // "XX"
-                        tzfmt->format(UTZFMT_STYLE_ISO_BASIC_FIXED, tz, date, zoneString);
-                    } else if (count == 3) {
-                        // "XXX"
-                        tzfmt->format(UTZFMT_STYLE_ISO_EXTENDED_FIXED, tz, date, zoneString);
-                    } else if (count == 4) {
-                        // "XXXX"
-                        tzfmt->format(UTZFMT_STYLE_ISO_BASIC_FULL, tz, date, zoneString);
-                    } else if (count == 5) {
-                        // "XXXXX"
-                        tzfmt->format(UTZFMT_STYLE_ISO_EXTENDED_FULL, tz, date, zoneString);
-                    }
-                }
-                else if (patternCharIndex == UDAT_TIMEZONE_ISO_LOCAL_FIELD) {
-                    if (count == 1) {
-                        // "x"
-                        tzfmt->format(UTZFMT_STYLE_ISO_BASIC_LOCAL_SHORT, tz, date, zoneString);
-                    } else if (count == 2) {
-                        // "xx"
-                        tzfmt->format(UTZFMT_STYLE_ISO_BASIC_LOCAL_FIXED, tz, date, zoneString);
-                    } else if (count == 3) {
-                        // "xxx"
-                        tzfmt->format(UTZFMT_STYLE_ISO_EXTENDED_LOCAL_FIXED, tz, date, zoneString);
-                    } else if (count == 4) {
-                        // "xxxx"
-                        tzfmt->format(UTZFMT_STYLE_ISO_BASIC_LOCAL_FULL, tz, date, zoneString);
-                    } else if (count == 5) {
-                        // "xxxxx"
-                        tzfmt->format(UTZFMT_STYLE_ISO_EXTENDED_LOCAL_FULL, tz, date, zoneString);
-                    }
-                }
-                else {
-                    UPRV_UNREACHABLE;
-                }
+                _formatTimeZone(*tzfmt, patternCharIndex, count, tz, date, zoneString, capContextUsageType);
             }
             appendTo += zoneString;
         }
@@ -2009,6 +2080,534 @@ SimpleDateFormat::subFormat(UnicodeString &appendTo,
 
 //----------------------------------------------------------------------
 
+UBool
+SimpleDateFormat::canFormatGregorian() const
+{
+    UErrorCode status = U_ZERO_ERROR;
+    return fGregorianPattern && fSymbols != NULL &&
+        getContext(UDISPCTX_TYPE_CAPITALIZATION, status) == UDISPCTX_CAPITALIZATION_NONE &&
+        fDateOverride.compare(u"hebr", 4) != 0;
+}
+
+void
+SimpleDateFormat::formatGregorian(UDate date, const TimeZone &zone,
+                                  UnicodeString &appendTo,
+                                  FieldPositionHandler &handler, UErrorCode &status) const
+{
+    if (U_FAILURE(status)) {
+        return;
+    }
+    // The fields as Calendar::computeFields() and GregorianCalendar compute them.
+    int32_t rawOffset, dstOffset;
+    zone.getOffset(date, FALSE, rawOffset, dstOffset, status);
+    if (U_FAILURE(status)) {
+        return;
+    }
+    // The day of week and day of year are computed only for the fields that need them.
+    GregorianLocalTime local(date + rawOffset + dstOffset);
+    int32_t year = local.getExtendedYear();
+    int32_t month = local.getMonth();
+    int32_t dom = local.getDayOfMonth();
+    int32_t millisInDay = local.getMillisInDay();
+    int32_t era = GregorianCalendar::AD;
+    if (year < 1) {
+        era = GregorianCalendar::BC;
+        year = 1 - year;
+    }
+    int32_t hourOfDay = millisInDay / U_MILLIS_PER_HOUR;
+    const int32_t maxIntCount = 10;
+
+    // Run the compiled pattern as _format() does, with subFormat()'s output for each field.
+    const UChar *items = fCompiledPattern.getBuffer();
+    int32_t itemsLength = fCompiledPattern.length();
+    for (int32_t i = 0; i < itemsLength && U_SUCCESS(status);) {
+        UChar unit = items[i++];
+        if (unit < COMPILED_FIELD) {
+            appendTo.append(items, i, unit);
+            i += unit;
+            continue;
+        }
+        int32_t count = ((int32_t)(unit - COMPILED_FIELD) << 16) | items[i];
+        UChar ch = items[i + 1];
+        i += 2;
+        UDateFormatField patternCharIndex = DateFormatSymbols::getPatternCharIndex(ch);
+        if (patternCharIndex == UDAT_FIELD_COUNT) {
+            continue;  // 'l'
+        }
+        const NumberFormat *currentNumberFormat = getNumberFormatByIndex(patternCharIndex);
+        if (currentNumberFormat == NULL) {
+            status = U_INTERNAL_PROGRAM_ERROR;
+            return;
+        }
+        int32_t beginOffset = appendTo.length();
+        switch (patternCharIndex) {
+        case UDAT_ERA_FIELD:
+            if (count == 5) {
+                _appendSymbol(appendTo, era, fSymbols->fNarrowEras, fSymbols->fNarrowErasCount);
+            } else if (count == 4) {
+                _appendSymbol(appendTo, era, fSymbols->fEraNames, fSymbols->fEraNamesCount);
+            } else {
+                _appendSymbol(appendTo, era, fSymbols->fEras, fSymbols->fErasCount);
+            }
+            break;
+        case UDAT_YEAR_FIELD:
+            if (count == 2) {
+                zeroPaddingNumber(currentNumberFormat, appendTo, year, 2, 2);
+            } else {
+                zeroPaddingNumber(currentNumberFormat, appendTo, year, count, maxIntCount);
+            }
+            break;
+        case UDAT_MONTH_FIELD:
+        case UDAT_STANDALONE_MONTH_FIELD: {
+            // Gregorian months are never leap months.
+            UBool isFormat = patternCharIndex == UDAT_MONTH_FIELD;
+            if (count == 5) {
+                if (isFormat) {
+                    _appendSymbol(appendTo, month, fSymbols->fNarrowMonths, fSymbols->fNarrowMonthsCount);
+                } else {
+                    _appendSymbol(appendTo, month, fSymbols->fStandaloneNarrowMonths,
+                                  fSymbols->fStandaloneNarrowMonthsCount);
+                }
+            } else if (count == 4) {
+                if (isFormat) {
+                    _appendSymbol(appendTo, month, fSymbols->fMonths, fSymbols->fMonthsCount);
+                } else {
+                    _appendSymbol(appendTo, month, fSymbols->fStandaloneMonths,
+                                  fSymbols->fStandaloneMonthsCount);
+                }
+            } else if (count == 3) {
+                if (isFormat) {
+                    _appendSymbol(appendTo, month, fSymbols->fShortMonths, fSymbols->fShortMonthsCount);
+                } else {
+                    _appendSymbol(appendTo, month, fSymbols->fStandaloneShortMonths,
+                                  fSymbols->fStandaloneShortMonthsCount);
+                }
+            } else {
+                zeroPaddingNumber(currentNumberFormat, appendTo, month + 1, count, maxIntCount);
+            }
+            break;
+        }
+        case UDAT_DATE_FIELD:
+            zeroPaddingNumber(currentNumberFormat, appendTo, dom, count, maxIntCount);
+            break;
+        case UDAT_HOUR_OF_DAY1_FIELD:
+            zeroPaddingNumber(currentNumberFormat, appendTo, hourOfDay == 0 ? 24 : hourOfDay,
+                              count, maxIntCount);
+            break;
+        case UDAT_HOUR_OF_DAY0_FIELD:
+            zeroPaddingNumber(currentNumberFormat, appendTo, hourOfDay, count, maxIntCount);
+            break;
+        case UDAT_MINUTE_FIELD:
+            zeroPaddingNumber(currentNumberFormat, appendTo, (millisInDay / U_MILLIS_PER_MINUTE) % 60,
+                              count, maxIntCount);
+            break;
+        case UDAT_SECOND_FIELD:
+            zeroPaddingNumber(currentNumberFormat, appendTo, (millisInDay / U_MILLIS_PER_SECOND) % 60,
+                              count, maxIntCount);
+            break;
+        case UDAT_FRACTIONAL_SECOND_FIELD: {
+            // Fractional seconds left-justify
+            int32_t value = millisInDay % U_MILLIS_PER_SECOND;
+            int32_t minDigits = (count > 3) ? 3 : count;
+            if (count == 1) {
+                value /= 100;
+            } else if (count == 2) {
+                value /= 10;
+            }
+            zeroPaddingNumber(currentNumberFormat, appendTo, value, minDigits, maxIntCount);
+            if (count > 3) {
+                zeroPaddingNumber(currentNumberFormat, appendTo, 0, count - 3, maxIntCount);
+            }
+            break;
+        }
+        case UDAT_DAY_OF_WEEK_FIELD: {
+            int32_t dow = local.getDayOfWeek();
+            if (count == 5) {
+                _appendSymbol(appendTo, dow, fSymbols->fNarrowWeekdays, fSymbols->fNarrowWeekdaysCount);
+            } else if (count == 4) {
+                _appendSymbol(appendTo, dow, fSymbols->fWeekdays, fSymbols->fWeekdaysCount);
+            } else if (count == 6) {
+                _appendSymbol(appendTo, dow, fSymbols->fShorterWeekdays, fSymbols->fShorterWeekdaysCount);
+            } else {
+                _appendSymbol(appendTo, dow, fSymbols->fShortWeekdays, fSymbols->fShortWeekdaysCount);
+            }
+            break;
+        }
+        case UDAT_DAY_OF_YEAR_FIELD:
+            zeroPaddingNumber(currentNumberFormat, appendTo, local.getDayOfYear(), count, maxIntCount);
+            break;
+        case UDAT_DAY_OF_WEEK_IN_MONTH_FIELD:
+            zeroPaddingNumber(currentNumberFormat, appendTo, (dom - 1) / 7 + 1, count, maxIntCount);
+            break;
+        case UDAT_AM_PM_FIELD:
+            if (count < 5) {
+                _appendSymbol(appendTo, hourOfDay / 12, fSymbols->fAmPms, fSymbols->fAmPmsCount);
+            } else {
+                _appendSymbol(appendTo, hourOfDay / 12, fSymbols->fNarrowAmPms, fSymbols->fNarrowAmPmsCount);
+            }
+            break;
+        case UDAT_HOUR1_FIELD:
+            zeroPaddingNumber(currentNumberFormat, appendTo, hourOfDay % 12 == 0 ? 12 : hourOfDay % 12,
+                              count, maxIntCount);
+            break;
+        case UDAT_HOUR0_FIELD:
+            zeroPaddingNumber(currentNumberFormat, appendTo, hourOfDay % 12, count, maxIntCount);
+            break;
+        case UDAT_MILLISECONDS_IN_DAY_FIELD:
+            zeroPaddingNumber(currentNumberFormat, appendTo, millisInDay, count, maxIntCount);
+            break;
+        case UDAT_QUARTER_FIELD:
+            if (count >= 4) {
+                _appendSymbol(appendTo, month / 3, fSymbols->fQuarters, fSymbols->fQuartersCount);
+            } else if (count == 3) {
+                _appendSymbol(appendTo, month / 3, fSymbols->fShortQuarters, fSymbols->fShortQuartersCount);
+            } else {
+                zeroPaddingNumber(currentNumberFormat, appendTo, (month / 3) + 1, count, maxIntCount);
+            }
+            break;
+        case UDAT_STANDALONE_QUARTER_FIELD:
+            if (count >= 4) {
+                _appendSymbol(appendTo, month / 3, fSymbols->fStandaloneQuarters,
+                              fSymbols->fStandaloneQuartersCount);
+            } else if (count == 3) {
+                _appendSymbol(appendTo, month / 3, fSymbols->fStandaloneShortQuarters,
+                              fSymbols->fStandaloneShortQuartersCount);
+            } else {
+                zeroPaddingNumber(currentNumberFormat, appendTo, (month / 3) + 1, count, maxIntCount);
+            }
+            break;
+        case UDAT_TIMEZONE_FIELD:
+        case UDAT_TIMEZONE_RFC_FIELD:
+        case UDAT_TIMEZONE_GENERIC_FIELD:
+        case UDAT_TIMEZONE_SPECIAL_FIELD:
+        case UDAT_TIMEZONE_LOCALIZED_GMT_OFFSET_FIELD:
+        case UDAT_TIMEZONE_ISO_FIELD:
+        case UDAT_TIMEZONE_ISO_LOCAL_FIELD: {
+            UChar zsbuf[ZONE_NAME_U16_MAX];
+            UnicodeString zoneString(zsbuf, 0, UPRV_LENGTHOF(zsbuf));
+            DateFormatSymbols::ECapitalizationContextUsageType capContextUsageType;
+            const TimeZoneFormat *tzfmt = tzFormat(status);
+            if (U_SUCCESS(status)) {
+                _formatTimeZone(*tzfmt, patternCharIndex, count, zone, date, zoneString, capContextUsageType);
+            }
+            appendTo += zoneString;
+            break;
+        }
+        default:
+            // Excluded by canFormatGregorian().
+            status = U_INTERNAL_PROGRAM_ERROR;
+            return;
+        }
+        handler.addAttribute(patternCharIndex, beginOffset, appendTo.length());
+    }
+}
+
+//----------------------------------------------------------------------
+
+// Writes the value as exactly width ASCII digits.
+static inline UChar *writeFixedDigits(UChar *p, int32_t value, int32_t width) {
+    for (int32_t i = width - 1; i >= 0; --i) {
+        p[i] = (UChar)(u'0' + value % 10);
+        value /= 10;
+    }
+    return p + width;
+}
+
+// Reads exactly width ASCII digits. Returns -1 if there is another character.
+static inline int32_t readFixedDigits(const UChar *p, int32_t width) {
+    int32_t value = 0;
+    for (int32_t i = 0; i < width; ++i) {
+        int32_t digit = (int32_t)p[i] - u'0';
+        if (digit < 0 || 9 < digit) {
+            return -1;
+        }
+        value = value * 10 + digit;
+    }
+    return value;
+}
+
+int32_t
+SimpleDateFormat::getFixedNumericLength() const
+{
+    // parseFixedNumeric() resolves local times like a Calendar with the default options.
+    if (fCalendar == NULL ||
+            fCalendar->getRepeatedWallTimeOption() != UCAL_WALLTIME_LAST ||
+            fCalendar->getSkippedWallTimeOption() != UCAL_WALLTIME_LAST) {
+        return 0;
+    }
+    int32_t length = 0;
+    UBool afterShortZone = FALSE;
+    const UChar *items = fCompiledPattern.getBuffer();
+    int32_t itemsLength = fCompiledPattern.length();
+    for (int32_t i = 0; i < itemsLength;) {
+        UChar unit = items[i++];
+        if (unit < COMPILED_FIELD) {
+            // Digits in the literal text would run into the fields when parsing.
+            for (int32_t j = i; j < i + unit; ++j) {
+                if (u'0' <= items[j] && items[j] <= u'9') {
+                    return 0;
+                }
+            }
+            length += unit;
+            i += unit;
+            afterShortZone = FALSE;
+            continue;
+        }
+        int32_t count = ((int32_t)(unit - COMPILED_FIELD) << 16) | items[i];
+        UChar ch = items[i + 1];
+        i += 2;
+        if (afterShortZone) {
+            // The optional minutes of X or x would run into this field.
+            return 0;
+        }
+        switch (ch) {
+        case u'y':
+            if (count != 4) {
+                return 0;
+            }
+            length += 4;
+            break;
+        case u'M':
+        case u'd':
+        case u'H':
+        case u'm':
+        case u's':
+            if (count != 2) {
+                return 0;
+            }
+            length += 2;
+            break;
+        case u'S':
+            if (count > 3) {
+                return 0;
+            }
+            length += count;
+            break;
+        case u'X':
+        case u'x':
+        case u'Z':
+            // "+hhmm", or "+hh:mm" for XXX and xxx
+            if (count > 3) {
+                return 0;
+            }
+            length += count == 3 && ch != u'Z' ? 6 : 5;
+            afterShortZone = count == 1 && ch != u'Z';
+            continue;
+        default:
+            return 0;
+        }
+        const DecimalFormat *df = dynamic_cast<const DecimalFormat *>(
+            getNumberFormatByIndex(DateFormatSymbols::getPatternCharIndex(ch)));
+        if (df == NULL ||
+                df->getDecimalFormatSymbols()->getConstDigitSymbol(0) != UnicodeString(u'0')) {
+            return 0;
+        }
+    }
+    return length;
+}
+
+int32_t
+SimpleDateFormat::formatFixedNumeric(UDate date, const TimeZone &zone,
+                                     UChar *dest, UErrorCode &status) const
+{
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    int32_t rawOffset, dstOffset;
+    zone.getOffset(date, FALSE, rawOffset, dstOffset, status);
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    int32_t offset = rawOffset + dstOffset;
+    GregorianLocalTime local(date + offset);
+    int32_t year = local.getExtendedYear();
+    int32_t millisInDay = local.getMillisInDay();
+    if (year < 1 || 9999 < year) {
+        return -1;
+    }
+    UChar *p = dest;
+    const UChar *items = fCompiledPattern.getBuffer();
+    int32_t itemsLength = fCompiledPattern.length();
+    for (int32_t i = 0; i < itemsLength;) {
+        UChar unit = items[i++];
+        if (unit < COMPILED_FIELD) {
+            u_memcpy(p, items + i, unit);
+            p += unit;
+            i += unit;
+            continue;
+        }
+        int32_t count = items[i];  // getFixedNumericLength() checked that count<=4
+        UChar ch = items[i + 1];
+        i += 2;
+        switch (ch) {
+        case u'y':
+            p = writeFixedDigits(p, year, 4);
+            break;
+        case u'M':
+            p = writeFixedDigits(p, local.getMonth() + 1, 2);
+            break;
+        case u'd':
+            p = writeFixedDigits(p, local.getDayOfMonth(), 2);
+            break;
+        case u'H':
+            p = writeFixedDigits(p, millisInDay / U_MILLIS_PER_HOUR, 2);
+            break;
+        case u'm':
+            p = writeFixedDigits(p, (millisInDay / U_MILLIS_PER_MINUTE) % 60, 2);
+            break;
+        case u's':
+            p = writeFixedDigits(p, (millisInDay / U_MILLIS_PER_SECOND) % 60, 2);
+            break;
+        case u'S': {
+            // Fractional seconds left-justify
+            int32_t value = millisInDay % U_MILLIS_PER_SECOND;
+            if (count == 1) {
+                value /= 100;
+            } else if (count == 2) {
+                value /= 10;
+            }
+            p = writeFixedDigits(p, value, count);
+            break;
+        }
+        default: {  // X, x, Z: ISO 8601 offsets as TimeZoneFormat writes them
+            if (offset % U_MILLIS_PER_MINUTE != 0) {
+                return -1;  // Leave offsets with seconds to TimeZoneFormat.
+            }
+            if (offset == 0 && ch == u'X') {
+                *p++ = u'Z';
+                break;
+            }
+            int32_t minutes = offset / U_MILLIS_PER_MINUTE;
+            *p++ = minutes < 0 ? u'-' : u'+';
+            if (minutes < 0) {
+                minutes = -minutes;
+            }
+            p = writeFixedDigits(p, minutes / 60, 2);
+            if (count == 3 && ch != u'Z') {
+                *p++ = u':';
+                p = writeFixedDigits(p, minutes % 60, 2);
+            } else if (count == 2 || ch == u'Z' || minutes % 60 != 0) {
+                p = writeFixedDigits(p, minutes % 60, 2);
+            }
+            break;
+        }
+        }
+    }
+    return (int32_t)(p - dest);
+}
+
+UBool
+SimpleDateFormat::parseFixedNumeric(const UChar *text, int32_t length, const TimeZone &zone,
+                                    UDate &date, UErrorCode &status) const
+{
+    if (U_FAILURE(status)) {
+        return FALSE;
+    }
+    // The defaults of a cleared Calendar.
+    int32_t year = 1970, month = 1, dom = 1;
+    int32_t hour = 0, minute = 0, second = 0, millis = 0;
+    UBool hasOffset = FALSE;
+    int32_t offset = 0;
+    const UChar *p = text;
+    const UChar *limit = text + length;
+    const UChar *items = fCompiledPattern.getBuffer();
+    int32_t itemsLength = fCompiledPattern.length();
+    for (int32_t i = 0; i < itemsLength;) {
+        UChar unit = items[i++];
+        if (unit < COMPILED_FIELD) {
+            if ((limit - p) < unit || u_memcmp(p, items + i, unit) != 0) {
+                return FALSE;
+            }
+            p += unit;
+            i += unit;
+            continue;
+        }
+        int32_t count = items[i];
+        UChar ch = items[i + 1];
+        i += 2;
+        if (ch == u'X' || ch == u'x' || ch == u'Z') {
+            hasOffset = TRUE;
+            if (p < limit && *p == u'Z' && ch == u'X') {
+                offset = 0;
+                ++p;
+                continue;
+            }
+            if ((limit - p) < 3 || (*p != u'+' && *p != u'-')) {
+                return FALSE;
+            }
+            UBool negative = *p == u'-';
+            int32_t hours = readFixedDigits(p + 1, 2);
+            int32_t minutes = 0;
+            p += 3;
+            if (count == 3 && ch != u'Z') {
+                if ((limit - p) < 3 || *p != u':' || (minutes = readFixedDigits(p + 1, 2)) < 0) {
+                    return FALSE;
+                }
+                p += 3;
+            } else if (count == 2 || ch == u'Z' || ((limit - p) >= 2 && readFixedDigits(p, 2) >= 0)) {
+                if ((limit - p) < 2 || (minutes = readFixedDigits(p, 2)) < 0) {
+                    return FALSE;
+                }
+                p += 2;
+            }
+            if (hours < 0 || 23 < hours || 59 < minutes) {
+                return FALSE;
+            }
+            offset = (hours * 60 + minutes) * U_MILLIS_PER_MINUTE;
+            if (negative) {
+                offset = -offset;
+            }
+            continue;
+        }
+        int32_t width = ch == u'y' ? 4 : ch == u'S' ? count : 2;
+        int32_t value;
+        if ((limit - p) < width || (value = readFixedDigits(p, width)) < 0) {
+            return FALSE;
+        }
+        p += width;
+        switch (ch) {
+        case u'y': year = value; break;
+        case u'M': month = value; break;
+        case u'd': dom = value; break;
+        case u'H': hour = value; break;
+        case u'm': minute = value; break;
+        case u's': second = value; break;
+        default:  // S
+            millis = count == 1 ? value * 100 : count == 2 ? value * 10 : value;
+            break;
+        }
+    }
+    // Out-of-range values are left to the Calendar and its leniency.
+    if (p != limit || year < 1 || month < 1 || 12 < month ||
+            dom < 1 || Grego::monthLength(year, month - 1) < dom ||
+            23 < hour || 59 < minute || 59 < second) {
+        return FALSE;
+    }
+    UDate local = Grego::fieldsToDay(year, month - 1, dom) * U_MILLIS_PER_DAY +
+        (((hour * 60 + minute) * 60 + second) * U_MILLIS_PER_SECOND + millis);
+    if (!hasOffset) {
+        // As Calendar::computeZoneOffset() does with the default wall time options.
+        int32_t rawOffset, dstOffset;
+        if (dynamic_cast<const OlsonTimeZone *>(&zone) != NULL ||
+                dynamic_cast<const SimpleTimeZone *>(&zone) != NULL ||
+                dynamic_cast<const RuleBasedTimeZone *>(&zone) != NULL ||
+                dynamic_cast<const VTimeZone *>(&zone) != NULL) {
+            static_cast<const BasicTimeZone &>(zone).getOffsetFromLocal(
+                local, BasicTimeZone::kFormer, BasicTimeZone::kLatter, rawOffset, dstOffset, status);
+        } else {
+            zone.getOffset(local, TRUE, rawOffset, dstOffset, status);
+        }
+        if (U_FAILURE(status)) {
+            return FALSE;
+        }
+        offset = rawOffset + dstOffset;
+    }
+    date = local - offset;
+    return TRUE;
+}
+
+//----------------------------------------------------------------------
+
 void SimpleDateFormat::adoptNumberFormat(NumberFormat *formatToAdopt) {
     fixNumberFormatForDates(*formatToAdopt);
     delete fNumberFormat;
@@ -2101,15 +2700,20 @@ SimpleDateFormat::zeroPaddingNumber(
         }
     }
     if (fastFormatter != nullptr) {
-        // Can use fast path
-        number::impl::UFormattedNumberData result;
-        result.quantity.setToInt(value);
+        // Can use fast path: Format into a stack buffer, without a FormattedNumber.
+        // Ten digits plus a sign fit, unless the number symbols are unusually long.
+        char16_t stackBuffer[32];
         UErrorCode localStatus = U_ZERO_ERROR;
-        fastFormatter->formatImpl(&result, localStatus);
+        int32_t length = fastFormatter->formatInt(value, stackBuffer, UPRV_LENGTHOF(stackBuffer), localStatus);
+        if (localStatus == U_BUFFER_OVERFLOW_ERROR) {
+            localStatus = U_ZERO_ERROR;
+            appendTo.append(fastFormatter->formatInt(value, localStatus).toTempString(localStatus));
+            return;
+        }
         if (U_FAILURE(localStatus)) {
             return;
         }
-        appendTo.append(result.getStringRef().toTempUnicodeString());
+        appendTo.append(stackBuffer, 0, length);
         return;
     }
 
@@ -3949,6 +4553,8 @@ SimpleDateFormat::applyLocalizedPattern(const UnicodeString& pattern,
     translatePattern(pattern, fPattern,
                      fSymbols->fLocalPatternChars,
                      UnicodeString(DateFormatSymbols::getPatternUChars()), status);
+    // Keep the compiled pattern in sync with fPattern, even if it is incomplete.
+    parsePattern();
 }
 
 //----------------------------------------------------------------------
@@ -4295,6 +4901,349 @@ void SimpleDateFormat::parsePattern() {
             }
         }
     }
+
+    // Compile the pattern for format(): Split it into literal text and runs of
+    // pattern characters, the same way as it was scanned for each format() call.
+    fCompiledPattern.remove();
+    fGregorianPattern = TRUE;
+    UnicodeString literal;
+    UChar prevCh = 0;
+    int32_t count = 0;
+    inQuote = FALSE;
+    for (int32_t i = 0; i <= len; ++i) {
+        UChar ch = i < len ? fPattern[i] : 0;
+        // A run of a pattern character ends at a different character.
+        if ((ch != prevCh || i == len) && count > 0) {
+            compileLiteral(fCompiledPattern, literal);
+            fCompiledPattern.append((UChar)(COMPILED_FIELD + (count >> 16)))
+                            .append((UChar)count)
+                            .append(prevCh);
+            UDateFormatField patternCharIndex = DateFormatSymbols::getPatternCharIndex(prevCh);
+            if (patternCharIndex == UDAT_FIELD_COUNT) {
+                if (prevCh != 0x6C) {  // 'l' is ignored, other unknown characters are errors
+                    fGregorianPattern = FALSE;
+                }
+            } else if ((kGregorianFields & ((uint64_t)1 << patternCharIndex)) == 0) {
+                fGregorianPattern = FALSE;
+            }
+            count = 0;
+        }
+        if (i == len) {
+            break;
+        }
+        if (ch == QUOTE) {
+            // Consecutive single quotes are a single quote literal,
+            // either outside of quotes or between quotes
+            if ((i+1) < len && fPattern[i+1] == QUOTE) {
+                literal.append((UChar)QUOTE);
+                ++i;
+            } else {
+                inQuote = ! inQuote;
+            }
+        }
+        else if (!inQuote && isSyntaxChar(ch)) {
+            prevCh = ch;
+            ++count;
+        }
+        else {
+            literal.append(ch);
+        }
+    }
+    compileLiteral(fCompiledPattern, literal);
+}
+
+//----------------------------------------------------------------------
+// CompiledDateFormatter
+//----------------------------------------------------------------------
+
+/**
+ * The data shared by copies of a CompiledDateFormatter:
+ * A SimpleDateFormat that is never modified after construction,
+ * and the range of dates for its Gregorian fast path.
+ */
+class CompiledDateFormatData : public SharedObject {
+public:
+    CompiledDateFormatData(SimpleDateFormat *formatToAdopt, UDate minGregorian, UDate maxGregorian,
+                           int32_t fixedLength)
+            : format(formatToAdopt), minGregorianDate(minGregorian), maxGregorianDate(maxGregorian),
+              fixedNumericLength(fixedLength) {}
+    virtual ~CompiledDateFormatData();
+
+    LocalPointer<SimpleDateFormat> format;
+    // formatGregorian() is used for minGregorianDate <= date <= maxGregorianDate.
+    // The range is empty if the pattern or the calendar need a Calendar object.
+    UDate minGregorianDate;
+    UDate maxGregorianDate;
+    // getFixedNumericLength(): >0 if the batch functions can use
+    // formatFixedNumeric() and parseFixedNumeric() in the Gregorian range.
+    int32_t fixedNumericLength;
+};
+
+CompiledDateFormatData::~CompiledDateFormatData() {}
+
+CompiledDateFormatter
+SimpleDateFormat::compile(UErrorCode &status) const
+{
+    if (U_FAILURE(status)) {
+        return CompiledDateFormatter();
+    }
+    LocalPointer<SimpleDateFormat> format(clone(), status);
+    if (U_FAILURE(status)) {
+        return CompiledDateFormatter();
+    }
+    // Create the TimeZoneFormat now if the pattern might need it,
+    // rather than lazily while the format is shared.
+    for (int32_t i = 0; i < format->fPattern.length(); ++i) {
+        UChar ch = format->fPattern[i];
+        if (ch != 0 && u_strchr(u"zZvVOXx", ch) != NULL) {
+            format->tzFormat(status);
+            break;
+        }
+    }
+    if (U_FAILURE(status)) {
+        return CompiledDateFormatter();
+    }
+    // Empty range unless formatGregorian() works with this pattern.
+    UDate minGregorianDate = kMaxGregorianDate;
+    UDate maxGregorianDate = -kMaxGregorianDate;
+    int32_t fixedNumericLength = 0;
+    if (uprv_strcmp(format->fCalendar->getType(), "gregorian") == 0 &&
+            dynamic_cast<const GregorianCalendar *>(format->fCalendar) != NULL &&
+            format->canFormatGregorian()) {
+        const GregorianCalendar *gc = static_cast<const GregorianCalendar *>(format->fCalendar);
+        minGregorianDate = getMinGregorianDate(*gc);
+        maxGregorianDate = kMaxGregorianDate;
+        fixedNumericLength = format->getFixedNumericLength();
+    }
+    LocalPointer<CompiledDateFormatData> data(
+        new CompiledDateFormatData(format.getAlias(), minGregorianDate, maxGregorianDate,
+                                   fixedNumericLength), status);
+    if (U_FAILURE(status)) {
+        return CompiledDateFormatter();
+    }
+    format.orphan();
+    return CompiledDateFormatter(data.orphan());
+}
+
+CompiledDateFormatter
+CompiledDateFormatter::forPattern(const UnicodeString &pattern, const Locale &locale,
+                                  UErrorCode &status)
+{
+    SimpleDateFormat format(pattern, locale, status);
+    return format.compile(status);
+}
+
+CompiledDateFormatter::CompiledDateFormatter(const CompiledDateFormatData *data) : fData(data) {
+    fData->addRef();
+}
+
+CompiledDateFormatter::CompiledDateFormatter(const CompiledDateFormatter &other) : fData(other.fData) {
+    if (fData != nullptr) {
+        fData->addRef();
+    }
+}
+
+CompiledDateFormatter::CompiledDateFormatter(CompiledDateFormatter &&src) U_NOEXCEPT
+        : fData(src.fData) {
+    src.fData = nullptr;
+}
+
+CompiledDateFormatter &CompiledDateFormatter::operator=(const CompiledDateFormatter &other) {
+    SharedObject::copyPtr(other.fData, fData);
+    return *this;
+}
+
+CompiledDateFormatter &CompiledDateFormatter::operator=(CompiledDateFormatter &&src) U_NOEXCEPT {
+    if (this != &src) {
+        SharedObject::clearPtr(fData);
+        fData = src.fData;
+        src.fData = nullptr;
+    }
+    return *this;
+}
+
+CompiledDateFormatter::~CompiledDateFormatter() {
+    SharedObject::clearPtr(fData);
+}
+
+UnicodeString &
+CompiledDateFormatter::format(UDate date, const TimeZone &zone, UnicodeString &appendTo,
+                              UErrorCode &status) const
+{
+    if (U_FAILURE(status)) {
+        return appendTo;
+    }
+    if (fData == nullptr) {
+        status = U_INVALID_STATE_ERROR;
+        return appendTo;
+    }
+    const SimpleDateFormat &format = *fData->format;
+    if (fData->minGregorianDate <= date && date <= fData->maxGregorianDate) {
+        FieldPosition pos(FieldPosition::DONT_CARE);
+        FieldPositionOnlyHandler handler(pos);
+        format.formatGregorian(date, zone, appendTo, handler, status);
+        return appendTo;
+    }
+    // Other patterns, calendars and dates need a Calendar.
+    // Use a temporary one: The shared format's Calendar must not be modified.
+    LocalPointer<Calendar> cal(format.getCalendar()->clone(), status);
+    if (U_FAILURE(status)) {
+        return appendTo;
+    }
+    cal->setTimeZone(zone);
+    cal->setTime(date, status);
+    FieldPosition pos(FieldPosition::DONT_CARE);
+    FieldPositionOnlyHandler handler(pos);
+    return format._format(*cal, appendTo, handler, status);
+}
+
+int32_t
+CompiledDateFormatter::format(UDate date, const TimeZone &zone, char16_t *dest, int32_t capacity,
+                              UErrorCode &status) const
+{
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    if (capacity < 0 || (dest == nullptr && capacity > 0)) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    // Format into a stack buffer; longer results (rare) move to the heap.
+    UChar stackBuffer[64];
+    UnicodeString result(stackBuffer, 0, UPRV_LENGTHOF(stackBuffer));
+    format(date, zone, result, status);
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    return result.extract(dest, capacity, status);
+}
+
+int32_t
+CompiledDateFormatter::formatDates(const UDate *dates, int32_t count, const TimeZone &zone,
+                                   char16_t *dest, int32_t capacity, int32_t *offsets,
+                                   UErrorCode &status) const
+{
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    if (fData == nullptr) {
+        status = U_INVALID_STATE_ERROR;
+        return 0;
+    }
+    if (count < 0 || (dates == nullptr && count > 0) ||
+            capacity < 0 || (dest == nullptr && capacity > 0)) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    const SimpleDateFormat &format = *fData->format;
+    int32_t fixedLength = fData->fixedNumericLength;
+    // Fixed-width results go straight into dest while there is room for the longest one.
+    MaybeStackArray<char16_t, 64> scratch;
+    if (fixedLength > scratch.getCapacity() && scratch.resize(fixedLength) == nullptr) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return 0;
+    }
+    UChar stackBuffer[64];
+    UnicodeString result(stackBuffer, 0, UPRV_LENGTHOF(stackBuffer));
+    int32_t length = 0;
+    for (int32_t i = 0; i < count; ++i) {
+        if (offsets != nullptr) {
+            offsets[i] = length;
+        }
+        UDate date = dates[i];
+        int32_t itemLength = -1;
+        if (fixedLength > 0 && fData->minGregorianDate <= date && date <= fData->maxGregorianDate) {
+            if (fixedLength <= (capacity - length)) {
+                itemLength = format.formatFixedNumeric(date, zone, dest + length, status);
+                if (U_FAILURE(status)) {
+                    return 0;
+                }
+                if (itemLength >= 0) {
+                    length += itemLength;
+                    continue;
+                }
+            } else {
+                itemLength = format.formatFixedNumeric(date, zone, scratch.getAlias(), status);
+            }
+        }
+        const char16_t *item;
+        if (itemLength >= 0) {
+            item = scratch.getAlias();
+        } else {
+            result.remove();
+            this->format(date, zone, result, status);
+            item = result.getBuffer();
+            itemLength = result.length();
+        }
+        if (U_FAILURE(status)) {
+            return 0;
+        }
+        if (itemLength <= (capacity - length)) {
+            u_memcpy(dest + length, item, itemLength);
+        }
+        length += itemLength;
+    }
+    if (offsets != nullptr) {
+        offsets[count] = length;
+    }
+    return u_terminateUChars(dest, capacity, length, &status);
+}
+
+int32_t
+CompiledDateFormatter::parseDates(const char16_t *text, const int32_t *offsets, int32_t count,
+                                  const TimeZone &zone, UDate *dates, UErrorCode &status) const
+{
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    if (fData == nullptr) {
+        status = U_INVALID_STATE_ERROR;
+        return 0;
+    }
+    if (count < 0 || (count > 0 && (text == nullptr || offsets == nullptr || dates == nullptr))) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    const SimpleDateFormat &format = *fData->format;
+    // Created for the first string that needs parse().
+    LocalPointer<Calendar> cal;
+    for (int32_t i = 0; i < count; ++i) {
+        int32_t start = offsets[i];
+        int32_t length = offsets[i + 1] - start;
+        if (start < 0 || length < 0) {
+            status = U_ILLEGAL_ARGUMENT_ERROR;
+            return i;
+        }
+        if (fData->fixedNumericLength > 0 &&
+                format.parseFixedNumeric(text + start, length, zone, dates[i], status) &&
+                fData->minGregorianDate <= dates[i] && dates[i] <= fData->maxGregorianDate) {
+            continue;
+        }
+        if (U_FAILURE(status)) {
+            return i;
+        }
+        // As DateFormat::parse() does, with a Calendar in the zone.
+        if (cal.isNull()) {
+            cal.adoptInsteadAndCheckErrorCode(format.getCalendar()->clone(), status);
+            if (U_FAILURE(status)) {
+                return i;
+            }
+            cal->setTimeZone(zone);
+        }
+        cal->clear();
+        UnicodeString s(FALSE, text + start, length);
+        ParsePosition pos(0);
+        format.parse(s, *cal, pos);
+        if (pos.getIndex() == 0 || pos.getIndex() != length || pos.getErrorIndex() >= 0) {
+            status = U_PARSE_ERROR;
+            return i;
+        }
+        dates[i] = cal->getTime(status);
+        if (U_FAILURE(status)) {
+            return i;
+        }
+    }
+    return count;
 }
 
 U_NAMESPACE_END
@@ -2729,7 +2729,7 @@ class ZoneIdMatchHandler : public TextTrieMapSearchResultHandler {
     ZoneIdMatchHandler();
     virtual ~ZoneIdMatchHandler();
 
-    UBool handleMatch(int32_t matchLength, const CharacterNode *node, UErrorCode &status);
+    UBool handleMatch(int32_t matchLength, const TextTrieMapValues *values, UErrorCode &status);
     const UChar* getID();
     int32_t getMatchLen();
 private:
@@ -2745,12 +2745,12 @@ ZoneIdMatchHandler::~ZoneIdMatchHandler() {
 }
 
 UBool
-ZoneIdMatchHandler::handleMatch(int32_t matchLength, const CharacterNode *node, UErrorCode &status) {
+ZoneIdMatchHandler::handleMatch(int32_t matchLength, const TextTrieMapValues *values, UErrorCode &status) {
     if (U_FAILURE(status)) {
         return FALSE;
     }
-    if (node->hasValues()) {
-        const UChar* id = (const UChar*)node->getValue(0);
+    if (values->hasValues()) {
+        const UChar* id = (const UChar*)values->getValue(0);
         if (id != NULL) {
             if (fLen < matchLength) {
                 fID = id;
@@ -195,7 +195,7 @@ class GNameSearchHandler : public TextTrieMapSearchResultHandler {
     GNameSearchHandler(uint32_t types);
     virtual ~GNameSearchHandler();
 
-    UBool handleMatch(int32_t matchLength, const CharacterNode *node, UErrorCode &status);
+    UBool handleMatch(int32_t matchLength, const TextTrieMapValues *values, UErrorCode &status);
     UVector* getMatches(int32_t& maxMatchLen);
 
 private:
@@ -215,14 +215,14 @@ GNameSearchHandler::~GNameSearchHandler() {
 }
 
 UBool
-GNameSearchHandler::handleMatch(int32_t matchLength, const CharacterNode *node, UErrorCode &status) {
+GNameSearchHandler::handleMatch(int32_t matchLength, const TextTrieMapValues *values, UErrorCode &status) {
     if (U_FAILURE(status)) {
         return FALSE;
     }
-    if (node->hasValues()) {
-        int32_t valuesCount = node->countValues();
+    if (values->hasValues()) {
+        int32_t valuesCount = values->countValues();
         for (int32_t i = 0; i < valuesCount; i++) {
-            GNameInfo *nameinfo = (ZNameInfo *)node->getValue(i);
+            GNameInfo *nameinfo = (ZNameInfo *)values->getValue(i);
             if (nameinfo == NULL) {
                 break;
             }
@@ -16,6 +16,8 @@
 #if !UCONFIG_NO_FORMATTING
 
 #include "unicode/strenum.h"
+#include "unicode/ucharstrie.h"
+#include "unicode/ucharstriebuilder.h"
 #include "unicode/ustring.h"
 #include "unicode/timezone.h"
 #include "unicode/utf16.h"
@@ -25,7 +27,9 @@
 #include "charstr.h"
 #include "cmemory.h"
 #include "cstring.h"
+#include "uarrsort.h"
 #include "uassert.h"
+#include "ucase.h"
 #include "mutex.h"
 #include "resource.h"
 #include "ulocimp.h"
@@ -112,98 +116,53 @@ struct ZMatchInfo {
 // Helper functions
 static void mergeTimeZoneKey(const UnicodeString& mzID, char* result);
 
-#define DEFAULT_CHARACTERNODE_CAPACITY 1
-
-// ---------------------------------------------------
-// CharacterNode class implementation
-// ---------------------------------------------------
-void CharacterNode::clear() {
-    uprv_memset(this, 0, sizeof(*this));
-}
-
-void CharacterNode::deleteValues(UObjectDeleter *valueDeleter) {
-    if (fValues == NULL) {
-        // Do nothing.
-    } else if (!fHasValuesVector) {
-        if (valueDeleter) {
-            valueDeleter(fValues);
-        }
-    } else {
-        delete (UVector *)fValues;
-    }
-}
-
-void
-CharacterNode::addValue(void *value, UObjectDeleter *valueDeleter, UErrorCode &status) {
-    if (U_FAILURE(status)) {
-        if (valueDeleter) {
-            valueDeleter(value);
-        }
-        return;
-    }
-    if (fValues == NULL) {
-        fValues = value;
-    } else {
-        // At least one value already.
-        if (!fHasValuesVector) {
-            // There is only one value so far, and not in a vector yet.
-            // Create a vector and add the old value.
-            UVector *values = new UVector(valueDeleter, NULL, DEFAULT_CHARACTERNODE_CAPACITY, status);
-            if (U_FAILURE(status)) {
-                if (valueDeleter) {
-                    valueDeleter(value);
-                }
-                return;
-            }
-            values->addElement(fValues, status);
-            fValues = values;
-            fHasValuesVector = TRUE;
-        }
-        // Add the new value.
-        ((UVector *)fValues)->addElement(value, status);
-    }
-}
-
 // ---------------------------------------------------
 // TextTrieMapSearchResultHandler class implementation
 // ---------------------------------------------------
 TextTrieMapSearchResultHandler::~TextTrieMapSearchResultHandler(){
 }
 
+U_CDECL_BEGIN
+static int32_t U_CALLCONV
+compareIndexedNames(const void *context, const void *left, const void *right) {
+    // Equal names stay in the order in which they were collected.
+    const UnicodeString *names = static_cast<const UnicodeString *>(context);
+    int32_t leftIndex = *static_cast<const int32_t *>(left);
+    int32_t rightIndex = *static_cast<const int32_t *>(right);
+    int32_t result = names[leftIndex].compare(names[rightIndex]);
+    return result != 0 ? result : leftIndex - rightIndex;
+}
+U_CDECL_END
+
 // ---------------------------------------------------
 // TextTrieMap class implementation
 // ---------------------------------------------------
 TextTrieMap::TextTrieMap(UBool ignoreCase, UObjectDeleter *valueDeleter)
-: fIgnoreCase(ignoreCase), fNodes(NULL), fNodesCapacity(0), fNodesCount(0), 
-  fLazyContents(NULL), fIsEmpty(TRUE), fValueDeleter(valueDeleter) {
+: fIgnoreCase(ignoreCase), fContents(NULL), fFrozenCount(0),
+  fIsEmpty(TRUE), fValueDeleter(valueDeleter) {
 }
 
 TextTrieMap::~TextTrieMap() {
-    int32_t index;
-    for (index = 0; index < fNodesCount; ++index) {
-        fNodes[index].deleteValues(fValueDeleter);
-    }
-    uprv_free(fNodes);
-    if (fLazyContents != NULL) {
-        for (int32_t i=0; i<fLazyContents->size(); i+=2) {
+    if (fContents != NULL) {
+        for (int32_t i=0; i<fContents->size(); i+=2) {
             if (fValueDeleter) {
-                fValueDeleter(fLazyContents->elementAt(i+1));
+                fValueDeleter(fContents->elementAt(i+1));
             }
-        } 
-        delete fLazyContents;
+        }
+        delete fContents;
     }
 }
 
 int32_t TextTrieMap::isEmpty() const {
     // Use a separate field for fIsEmpty because it will remain unchanged once the
-    //   Trie is built, while fNodes and fLazyContents change with the lazy init
-    //   of the nodes structure.  Trying to test the changing fields has
+    //   Trie is built, while fContents and fFrozenCount change with the lazy init
+    //   of the trie.  Trying to test the changing fields has
     //   thread safety complications.
     return fIsEmpty;
 }
 
 
-//  We defer actually building the TextTrieMap node structure until the first time a
+//  We defer actually building the trie until the first time a
 //     search is performed.  put() simply saves the parameters in case we do
 //     eventually need to build it.
 //     
@@ -218,228 +177,206 @@ TextTrieMap::put(const UnicodeString &key, void *value, ZNStringPool &sp, UError
 void
 TextTrieMap::put(const UChar *key, void *value, UErrorCode &status) {
     fIsEmpty = FALSE;
-    if (fLazyContents == NULL) {
-        fLazyContents = new UVector(status);
-        if (fLazyContents == NULL) {
+    if (fContents == NULL) {
+        fContents = new UVector(status);
+        if (fContents == NULL) {
             status = U_MEMORY_ALLOCATION_ERROR;
         }
     }
-    if (U_FAILURE(status)) {
-        if (fValueDeleter) {
-            fValueDeleter((void*) key);
-        }
-        return;
+    if (U_SUCCESS(status)) {
+        // Make room for the key and the value together, so that they are added as a pair.
+        fContents->ensureCapacity(fContents->size() + 2, status);
     }
-    U_ASSERT(fLazyContents != NULL);
-
-    UChar *s = const_cast<UChar *>(key);
-    fLazyContents->addElement(s, status);
     if (U_FAILURE(status)) {
         if (fValueDeleter) {
-            fValueDeleter((void*) key);
+            fValueDeleter(value);
         }
         return;
     }
 
-    fLazyContents->addElement(value, status);
-}
-
-void
-TextTrieMap::putImpl(const UnicodeString &key, void *value, UErrorCode &status) {
-    if (fNodes == NULL) {
-        fNodesCapacity = 512;
-        fNodes = (CharacterNode *)uprv_malloc(fNodesCapacity * sizeof(CharacterNode));
-        if (fNodes == NULL) {
-            status = U_MEMORY_ALLOCATION_ERROR;
-            return;
-        }
-        fNodes[0].clear();  // Init root node.
-        fNodesCount = 1;
-    }
-
-    UnicodeString foldedKey;
-    const UChar *keyBuffer;
-    int32_t keyLength;
-    if (fIgnoreCase) {
-        // Ok to use fastCopyFrom() because we discard the copy when we return.
-        foldedKey.fastCopyFrom(key).foldCase();
-        keyBuffer = foldedKey.getBuffer();
-        keyLength = foldedKey.length();
-    } else {
-        keyBuffer = key.getBuffer();
-        keyLength = key.length();
-    }
-
-    CharacterNode *node = fNodes;
-    int32_t index;
-    for (index = 0; index < keyLength; ++index) {
-        node = addChildNode(node, keyBuffer[index], status);
-    }
-    node->addValue(value, fValueDeleter, status);
-}
-
-UBool
-TextTrieMap::growNodes() {
-    if (fNodesCapacity == 0xffff) {
-        return FALSE;  // We use 16-bit node indexes.
-    }
-    int32_t newCapacity = fNodesCapacity + 1000;
-    if (newCapacity > 0xffff) {
-        newCapacity = 0xffff;
-    }
-    CharacterNode *newNodes = (CharacterNode *)uprv_malloc(newCapacity * sizeof(CharacterNode));
-    if (newNodes == NULL) {
-        return FALSE;
-    }
-    uprv_memcpy(newNodes, fNodes, fNodesCount * sizeof(CharacterNode));
-    uprv_free(fNodes);
-    fNodes = newNodes;
-    fNodesCapacity = newCapacity;
-    return TRUE;
+    UChar *s = const_cast<UChar *>(key);
+    fContents->addElement(s, status);
+    fContents->addElement(value, status);
 }
 
-CharacterNode*
-TextTrieMap::addChildNode(CharacterNode *parent, UChar c, UErrorCode &status) {
+// freeze() - Build the trie from all of the entries that were put so far.
+//            The trie is only needed for parsing operations, which are less common
+//            than formatting, which is why its creation is deferred until first use.
+void TextTrieMap::freeze(UErrorCode &status) {
     if (U_FAILURE(status)) {
-        return NULL;
-    }
-    // Linear search of the sorted list of children.
-    uint16_t prevIndex = 0;
-    uint16_t nodeIndex = parent->fFirstChild;
-    while (nodeIndex > 0) {
-        CharacterNode *current = fNodes + nodeIndex;
-        UChar childCharacter = current->fCharacter;
-        if (childCharacter == c) {
-            return current;
-        } else if (childCharacter > c) {
-            break;
-        }
-        prevIndex = nodeIndex;
-        nodeIndex = current->fNextSibling;
+        return;
     }
-
-    // Ensure capacity. Grow fNodes[] if needed.
-    if (fNodesCount == fNodesCapacity) {
-        int32_t parentIndex = (int32_t)(parent - fNodes);
-        if (!growNodes()) {
+    int32_t count = fContents->size() / 2;
+    LocalArray<UnicodeString> keys(new UnicodeString[count], status);
+    LocalMemory<int32_t> order;
+    LocalMemory<void *> values;
+    LocalMemory<int32_t> valueStarts;
+    if (U_FAILURE(status) ||
+            order.allocateInsteadAndCopy(count, 0) == NULL ||
+            values.allocateInsteadAndCopy(count, 0) == NULL ||
+            valueStarts.allocateInsteadAndCopy(count + 1, 0) == NULL) {
+        if (U_SUCCESS(status)) {
             status = U_MEMORY_ALLOCATION_ERROR;
-            return NULL;
         }
-        parent = fNodes + parentIndex;
+        return;
     }
-
-    // Insert a new child node with c in sorted order.
-    CharacterNode *node = fNodes + fNodesCount;
-    node->clear();
-    node->fCharacter = c;
-    node->fNextSibling = nodeIndex;
-    if (prevIndex == 0) {
-        parent->fFirstChild = (uint16_t)fNodesCount;
-    } else {
-        fNodes[prevIndex].fNextSibling = (uint16_t)fNodesCount;
-    }
-    ++fNodesCount;
-    return node;
-}
-
-CharacterNode*
-TextTrieMap::getChildNode(CharacterNode *parent, UChar c) const {
-    // Linear search of the sorted list of children.
-    uint16_t nodeIndex = parent->fFirstChild;
-    while (nodeIndex > 0) {
-        CharacterNode *current = fNodes + nodeIndex;
-        UChar childCharacter = current->fCharacter;
-        if (childCharacter == c) {
-            return current;
-        } else if (childCharacter > c) {
-            break;
+    for (int32_t i = 0; i < count; ++i) {
+        // Alias the persistent key, and fold a copy if needed.
+        keys[i].setTo(TRUE, (const UChar *)fContents->elementAt(2 * i), -1);
+        if (fIgnoreCase) {
+            keys[i].foldCase();
         }
-        nodeIndex = current->fNextSibling;
-    }
-    return NULL;
-}
-
-
-// buildTrie() - The Trie node structure is needed.  Create it from the data that was
-//               saved at the time the ZoneStringFormatter was created.  The Trie is only
-//               needed for parsing operations, which are less common than formatting,
-//               and the Trie is big, which is why its creation is deferred until first use.
-void TextTrieMap::buildTrie(UErrorCode &status) {
-    if (fLazyContents != NULL) {
-        for (int32_t i=0; i<fLazyContents->size(); i+=2) {
-            const UChar *key = (UChar *)fLazyContents->elementAt(i);
-            void  *val = fLazyContents->elementAt(i+1);
-            UnicodeString keyString(TRUE, key, -1);  // Aliasing UnicodeString constructor.
-            putImpl(keyString, val, status);
-        }
-        delete fLazyContents;
-        fLazyContents = NULL; 
+        order[i] = i;
+    }
+
+    // Sort the keys, and write each distinct key's group of values.
+    uprv_sortArray(order.getAlias(), count, (int32_t)sizeof(int32_t),
+                   compareIndexedNames, keys.getAlias(), FALSE, &status);
+    UCharsTrieBuilder builder(status);
+    int32_t groupCount = 0;
+    for (int32_t i = 0; i < count && U_SUCCESS(status);) {
+        const UnicodeString &key = keys[order[i]];
+        builder.add(key, groupCount, status);
+        valueStarts[groupCount++] = i;
+        do {
+            values[i] = fContents->elementAt(2 * order[i] + 1);
+            ++i;
+        } while (i < count && keys[order[i]] == key);
+    }
+    valueStarts[groupCount] = count;
+    UnicodeString trie;
+    builder.buildUnicodeString(USTRINGTRIE_BUILD_SMALL, trie, status);
+    if (U_SUCCESS(status)) {
+        // Copy the trie out of the builder's buffer.
+        fTrie = trie;
+        fValues.adoptInstead(values.orphan());
+        fValueStarts.adoptInstead(valueStarts.orphan());
+        fFrozenCount = count;
     }
 }
 
 void
 TextTrieMap::search(const UnicodeString &text, int32_t start,
                   TextTrieMapSearchResultHandler *handler, UErrorCode &status) const {
+    if (U_FAILURE(status)) {
+        return;
+    }
     {
-        // TODO: if locking the mutex for each check proves to be a performance problem,
-        //       add a flag of type atomic_int32_t to class TextTrieMap, and use only
-        //       the ICU atomic safe functions for assigning and testing.
-        //       Don't test the pointer fLazyContents.
-        //       Don't do unless it's really required.
-
-        // Mutex for protecting the lazy creation of the Trie node structure on the first call to search().
+        // Mutex for protecting the lazy creation of the trie in search().
         static UMutex TextTrieMutex;
 
         Mutex lock(&TextTrieMutex);
-        if (fLazyContents != NULL) {
+        // Freeze all entries on the first search, and again when enough
+        // have been put since then to outweigh rebuilding the trie.
+        int32_t unfrozenCount = (fContents != NULL ? fContents->size() / 2 : 0) - fFrozenCount;
+        if (unfrozenCount > 0 && unfrozenCount * 16 > fFrozenCount) {
             TextTrieMap *nonConstThis = const_cast<TextTrieMap *>(this);
-            nonConstThis->buildTrie(status);
+            nonConstThis->freeze(status);
         }
     }
-    if (fNodes == NULL) {
+    if (U_FAILURE(status)) {
+        return;
+    }
+    if (fFrozenCount > 0 && !searchTrie(text, start, handler, status)) {
         return;
     }
-    search(fNodes, text, start, start, handler, status);
+    if (fContents != NULL && U_SUCCESS(status)) {
+        searchUnfrozen(text, start, handler, status);
+    }
 }
 
-void
-TextTrieMap::search(CharacterNode *node, const UnicodeString &text, int32_t start,
-                  int32_t index, TextTrieMapSearchResultHandler *handler, UErrorCode &status) const {
-    if (U_FAILURE(status)) {
-        return;
+// Reports the frozen keys that match the text at start, shortest first,
+// in a single pass over the text.
+// Returns FALSE if the handler stopped the search.
+UBool
+TextTrieMap::searchTrie(const UnicodeString &text, int32_t start,
+                  TextTrieMapSearchResultHandler *handler, UErrorCode &status) const {
+    UCharsTrie trie(fTrie.getBuffer());
+    UStringTrieResult result = trie.current();
+    int32_t index = start;
+    for (;;) {
+        if (USTRINGTRIE_HAS_VALUE(result)) {
+            int32_t group = trie.getValue();
+            TextTrieMapValues values = {
+                fValues.getAlias() + fValueStarts[group],
+                fValueStarts[group + 1] - fValueStarts[group]
+            };
+            if (!handler->handleMatch(index - start, &values, status) || U_FAILURE(status)) {
+                return FALSE;
+            }
+        }
+        if (!USTRINGTRIE_HAS_NEXT(result) || index >= text.length()) {
+            return TRUE;
+        }
+        if (fIgnoreCase) {
+            // Match the full case folding of each code point, as for the keys.
+            UChar32 c = text.char32At(index);
+            index += U16_LENGTH(c);
+            const UChar *folded;
+            int32_t foldedLength = ucase_toFullFolding(c, &folded, U_FOLD_CASE_DEFAULT);
+            if (foldedLength < 0) {
+                result = trie.nextForCodePoint(~foldedLength);
+            } else if (foldedLength > UCASE_MAX_STRING_LENGTH) {
+                result = trie.nextForCodePoint(foldedLength);
+            } else {
+                for (int32_t i = 0; i < foldedLength && USTRINGTRIE_MATCHES(result); ++i) {
+                    result = trie.next(folded[i]);
+                }
+            }
+        } else {
+            result = trie.next(text.charAt(index++));
+        }
     }
-    if (node->hasValues()) {
-        if (!handler->handleMatch(index - start, node, status)) {
-            return;
-        }
-        if (U_FAILURE(status)) {
-            return;
-        }
-    }
-    if (fIgnoreCase) {
-        // for folding we need to get a complete code point.
-        // size of character may grow after fold operation;
-        // then we need to get result as UTF16 code units.
-        UChar32 c32 = text.char32At(index);
-        index += U16_LENGTH(c32);
-        UnicodeString tmp(c32);
-        tmp.foldCase();
-        int32_t tmpidx = 0;
-        while (tmpidx < tmp.length()) {
-            UChar c = tmp.charAt(tmpidx++);
-            node = getChildNode(node, c);
-            if (node == NULL) {
-                break;
+}
+
+// Reports the entries that were put after the trie was built, and match the text at start.
+void
+TextTrieMap::searchUnfrozen(const UnicodeString &text, int32_t start,
+                  TextTrieMapSearchResultHandler *handler, UErrorCode &status) const {
+    for (int32_t i = 2 * fFrozenCount; i < fContents->size(); i += 2) {
+        int32_t matchLength = matchKey((const UChar *)fContents->elementAt(i), text, start);
+        if (matchLength >= 0) {
+            void *value = fContents->elementAt(i + 1);
+            TextTrieMapValues values = { &value, 1 };
+            if (!handler->handleMatch(matchLength, &values, status) || U_FAILURE(status)) {
+                return;
             }
         }
-    } else {
-        // here we just get the next UTF16 code unit
-        UChar c = text.charAt(index++);
-        node = getChildNode(node, c);
     }
-    if (node != NULL) {
-        search(node, text, start, index, handler, status);
+}
+
+// Returns the length of the text at start that matches the key, or -1 if it does not match.
+int32_t
+TextTrieMap::matchKey(const UChar *key, const UnicodeString &text, int32_t start) const {
+    UnicodeString keyString(TRUE, key, -1);  // Aliasing UnicodeString constructor.
+    if (!fIgnoreCase) {
+        int32_t keyLength = keyString.length();
+        return text.compare(start, keyLength, keyString) == 0 ? keyLength : -1;
+    }
+    keyString.foldCase();
+    int32_t keyIndex = 0;
+    int32_t index = start;
+    while (keyIndex < keyString.length()) {
+        if (index >= text.length()) {
+            return -1;
+        }
+        UChar32 c = text.char32At(index);
+        index += U16_LENGTH(c);
+        const UChar *folded;
+        int32_t foldedLength = ucase_toFullFolding(c, &folded, U_FOLD_CASE_DEFAULT);
+        UChar buffer[U16_MAX_LENGTH];
+        if (foldedLength < 0 || foldedLength > UCASE_MAX_STRING_LENGTH) {
+            c = foldedLength < 0 ? ~foldedLength : foldedLength;
+            foldedLength = 0;
+            U16_APPEND_UNSAFE(buffer, foldedLength, c);
+            folded = buffer;
+        }
+        if (keyString.compare(keyIndex, foldedLength, folded, 0, foldedLength) != 0) {
+            return -1;
+        }
+        keyIndex += foldedLength;
     }
+    return index - start;
 }
 
 // ---------------------------------------------------
@@ -912,6 +849,21 @@ MetaZoneIDsEnumeration::~MetaZoneIDsEnumeration() {
 }
 
 
+// ---------------------------------------------------
+// ZNamesIndex
+// ---------------------------------------------------
+/**
+ * A frozen index of all of the names of a TimeZoneNamesImpl:
+ * A UCharsTrie maps each case-folded name to the index of its first ZNameInfo.
+ * The ZNameInfo for one name are contiguous, and each group ends with
+ * one whose type is UTZNM_UNKNOWN.
+ */
+class ZNamesIndex : public UMemory {
+public:
+    UnicodeString trie;
+    LocalMemory<ZNameInfo> nameinfos;
+};
+
 // ---------------------------------------------------
 // ZNameSearchHandler
 // ---------------------------------------------------
@@ -920,10 +872,14 @@ class ZNameSearchHandler : public TextTrieMapSearchResultHandler {
     ZNameSearchHandler(uint32_t types);
     virtual ~ZNameSearchHandler();
 
-    UBool handleMatch(int32_t matchLength, const CharacterNode *node, UErrorCode &status);
+    UBool handleMatch(int32_t matchLength, const TextTrieMapValues *values, UErrorCode &status);
+    // Adds the names of a TimeZoneNamesImpl names index group, up to the UTZNM_UNKNOWN one.
+    void addMatches(int32_t matchLength, const ZNameInfo *nameinfos, UErrorCode &status);
     TimeZoneNames::MatchInfoCollection* getMatches(int32_t& maxMatchLen);
 
 private:
+    void addMatch(int32_t matchLength, const ZNameInfo *nameinfo, UErrorCode &status);
+
     uint32_t fTypes;
     int32_t fMaxMatchLen;
     TimeZoneNames::MatchInfoCollection* fResults;
@@ -940,43 +896,55 @@ ZNameSearchHandler::~ZNameSearchHandler() {
 }
 
 UBool
-ZNameSearchHandler::handleMatch(int32_t matchLength, const CharacterNode *node, UErrorCode &status) {
+ZNameSearchHandler::handleMatch(int32_t matchLength, const TextTrieMapValues *values, UErrorCode &status) {
     if (U_FAILURE(status)) {
         return FALSE;
     }
-    if (node->hasValues()) {
-        int32_t valuesCount = node->countValues();
+    if (values->hasValues()) {
+        int32_t valuesCount = values->countValues();
         for (int32_t i = 0; i < valuesCount; i++) {
-            ZNameInfo *nameinfo = (ZNameInfo *)node->getValue(i);
+            ZNameInfo *nameinfo = (ZNameInfo *)values->getValue(i);
             if (nameinfo == NULL) {
                 continue;
             }
-            if ((nameinfo->type & fTypes) != 0) {
-                // matches a requested type
-                if (fResults == NULL) {
-                    fResults = new TimeZoneNames::MatchInfoCollection();
-                    if (fResults == NULL) {
-                        status = U_MEMORY_ALLOCATION_ERROR;
-                    }
-                }
-                if (U_SUCCESS(status)) {
-                    U_ASSERT(fResults != NULL);
-                    if (nameinfo->tzID) {
-                        fResults->addZone(nameinfo->type, matchLength, UnicodeString(nameinfo->tzID, -1), status);
-                    } else {
-                        U_ASSERT(nameinfo->mzID);
-                        fResults->addMetaZone(nameinfo->type, matchLength, UnicodeString(nameinfo->mzID, -1), status);
-                    }
-                    if (U_SUCCESS(status) && matchLength > fMaxMatchLen) {
-                        fMaxMatchLen = matchLength;
-                    }
-                }
-            }
+            addMatch(matchLength, nameinfo, status);
         }
     }
     return TRUE;
 }
 
+void
+ZNameSearchHandler::addMatches(int32_t matchLength, const ZNameInfo *nameinfos, UErrorCode &status) {
+    for (; nameinfos->type != UTZNM_UNKNOWN && U_SUCCESS(status); ++nameinfos) {
+        addMatch(matchLength, nameinfos, status);
+    }
+}
+
+void
+ZNameSearchHandler::addMatch(int32_t matchLength, const ZNameInfo *nameinfo, UErrorCode &status) {
+    if ((nameinfo->type & fTypes) != 0) {
+        // matches a requested type
+        if (fResults == NULL) {
+            fResults = new TimeZoneNames::MatchInfoCollection();
+            if (fResults == NULL) {
+                status = U_MEMORY_ALLOCATION_ERROR;
+            }
+        }
+        if (U_SUCCESS(status)) {
+            U_ASSERT(fResults != NULL);
+            if (nameinfo->tzID) {
+                fResults->addZone(nameinfo->type, matchLength, UnicodeString(nameinfo->tzID, -1), status);
+            } else {
+                U_ASSERT(nameinfo->mzID);
+                fResults->addMetaZone(nameinfo->type, matchLength, UnicodeString(nameinfo->mzID, -1), status);
+            }
+            if (U_SUCCESS(status) && matchLength > fMaxMatchLen) {
+                fMaxMatchLen = matchLength;
+            }
+        }
+    }
+}
+
 TimeZoneNames::MatchInfoCollection*
 ZNameSearchHandler::getMatches(int32_t& maxMatchLen) {
     // give the ownership to the caller
@@ -1022,9 +990,9 @@ TimeZoneNamesImpl::TimeZoneNamesImpl(const Locale& locale, UErrorCode& status)
   fZoneStrings(NULL),
   fTZNamesMap(NULL),
   fMZNamesMap(NULL),
-  fNamesTrieFullyLoaded(FALSE),
   fNamesFullyLoaded(FALSE),
-  fNamesTrie(TRUE, deleteZNameInfo) {
+  fNamesTrie(TRUE, deleteZNameInfo),
+  fNamesIndex(NULL) {
     initialize(locale, status);
 }
 
@@ -1102,6 +1070,8 @@ TimeZoneNamesImpl::cleanup() {
         uhash_close(fTZNamesMap);
         fTZNamesMap = NULL;
     }
+    delete fNamesIndex;
+    fNamesIndex = NULL;
 }
 
 UBool
@@ -1360,35 +1330,42 @@ TimeZoneNamesImpl::find(const UnicodeString& text, int32_t start, uint32_t types
     {
         Mutex lock(&gDataMutex);
 
-        // First try of lookup.
-        matches = doFind(handler, text, start, status);
-        if (U_FAILURE(status)) { return NULL; }
-        if (matches != NULL) {
-            return matches;
-        }
-
-        // All names are not yet loaded into the trie.
-        // We may have loaded names for formatting several time zones,
-        // and might be parsing one of those.
-        // Populate the parsing trie from all of the already-loaded names.
-        nonConstThis->addAllNamesIntoTrie(status);
+        if (fNamesIndex == NULL && !fNamesFullyLoaded) {
+            // First try of lookup.
+            matches = doFind(handler, text, start, status);
+            if (U_FAILURE(status)) { return NULL; }
+            if (matches != NULL) {
+                return matches;
+            }
 
-        // Second try of lookup.
-        matches = doFind(handler, text, start, status);
-        if (U_FAILURE(status)) { return NULL; }
-        if (matches != NULL) {
-            return matches;
+            // All names are not yet loaded into the trie.
+            // We may have loaded names for formatting several time zones,
+            // and might be parsing one of those.
+            // Populate the parsing trie from all of the already-loaded names.
+            nonConstThis->addAllNamesIntoTrie(status);
+
+            // Second try of lookup.
+            matches = doFind(handler, text, start, status);
+            if (U_FAILURE(status)) { return NULL; }
+            if (matches != NULL) {
+                return matches;
+            }
         }
 
-        // There are still some names we haven't loaded into the trie yet.
-        // Load everything now.
-        nonConstThis->internalLoadAllDisplayNames(status);
-        nonConstThis->addAllNamesIntoTrie(status);
-        nonConstThis->fNamesTrieFullyLoaded = TRUE;
-        if (U_FAILURE(status)) { return NULL; }
+        if (fNamesIndex == NULL) {
+            // There are still some names we haven't loaded yet.
+            // Load everything now, and index all of the names at once
+            // rather than adding them to the trie.
+            nonConstThis->internalLoadAllDisplayNames(status);
+            nonConstThis->buildNamesIndex(status);
+            if (U_FAILURE(status)) { return NULL; }
+        }
 
         // Third try: we must return this one.
-        return doFind(handler, text, start, status);
+        searchNamesIndex(handler, text, start, status);
+        if (U_FAILURE(status)) { return NULL; }
+        int32_t maxLen = 0;
+        return handler.getMatches(maxLen);
     }
 }
 
@@ -1401,8 +1378,8 @@ TimeZoneNamesImpl::doFind(ZNameSearchHandler& handler,
 
     int32_t maxLen = 0;
     TimeZoneNames::MatchInfoCollection* matches = handler.getMatches(maxLen);
-    if (matches != NULL && ((maxLen == (text.length() - start)) || fNamesTrieFullyLoaded)) {
-        // perfect match, or no more names available
+    if (matches != NULL && maxLen == (text.length() - start)) {
+        // perfect match
         return matches;
     }
     delete matches;
@@ -1434,6 +1411,121 @@ void TimeZoneNamesImpl::addAllNamesIntoTrie(UErrorCode& status) {
     }
 }
 
+// Caller must synchronize.
+void TimeZoneNamesImpl::buildNamesIndex(UErrorCode& status) {
+    if (U_FAILURE(status)) return;
+
+    // Collect the case-folded names with their IDs and types.
+    int32_t count = 0;
+    UHashtable* maps[] = { fMZNamesMap, fTZNamesMap };
+    for (UHashtable* map : maps) {
+        int32_t pos = UHASH_FIRST;
+        const UHashElement* element;
+        while ((element = uhash_nextElement(map, &pos)) != NULL) {
+            if (element->value.pointer == EMPTY) { continue; }
+            const ZNames* znames = (const ZNames*) element->value.pointer;
+            for (int32_t i = 0; i < UTZNM_INDEX_COUNT; i++) {
+                if (znames->fNames[i] != NULL && znames->fNames[i][0] != 0) {
+                    ++count;
+                }
+            }
+        }
+    }
+    // Each group of names ends with one UTZNM_UNKNOWN entry.
+    int32_t capacity = count > 0 ? count : 1;
+    LocalPointer<ZNamesIndex> namesIndex(new ZNamesIndex(), status);
+    LocalArray<UnicodeString> names(new UnicodeString[capacity], status);
+    LocalMemory<ZNameInfo> nameinfos;
+    LocalMemory<int32_t> order;
+    if (U_FAILURE(status) ||
+            nameinfos.allocateInsteadAndCopy(capacity, 0) == NULL ||
+            order.allocateInsteadAndCopy(capacity, 0) == NULL ||
+            namesIndex->nameinfos.allocateInsteadAndCopy(2 * capacity, 0) == NULL) {
+        if (U_SUCCESS(status)) {
+            status = U_MEMORY_ALLOCATION_ERROR;
+        }
+        return;
+    }
+    int32_t index = 0;
+    for (UHashtable* map : maps) {
+        int32_t pos = UHASH_FIRST;
+        const UHashElement* element;
+        while ((element = uhash_nextElement(map, &pos)) != NULL) {
+            if (element->value.pointer == EMPTY) { continue; }
+            const UChar* id = (const UChar*) element->key.pointer;
+            const ZNames* znames = (const ZNames*) element->value.pointer;
+            for (int32_t i = 0; i < UTZNM_INDEX_COUNT; i++) {
+                const UChar* name = znames->fNames[i];
+                if (name == NULL || name[0] == 0) { continue; }
+                names[index].setTo(TRUE, name, -1).foldCase();
+                ZNameInfo &nameinfo = nameinfos[index];
+                nameinfo.type = ZNames::getTZNameType((UTimeZoneNameTypeIndex)i);
+                nameinfo.tzID = map == fTZNamesMap ? id : NULL;
+                nameinfo.mzID = map == fMZNamesMap ? id : NULL;
+                order[index] = index;
+                ++index;
+            }
+        }
+    }
+
+    // Sort the names, and write each distinct name's group of name infos.
+    uprv_sortArray(order.getAlias(), count, (int32_t)sizeof(int32_t),
+                   compareIndexedNames, names.getAlias(), FALSE, &status);
+    UCharsTrieBuilder builder(status);
+    int32_t length = 0;
+    for (int32_t i = 0; i < count && U_SUCCESS(status);) {
+        const UnicodeString &name = names[order[i]];
+        builder.add(name, length, status);
+        do {
+            namesIndex->nameinfos[length++] = nameinfos[order[i++]];
+        } while (i < count && names[order[i]] == name);
+        ZNameInfo &end = namesIndex->nameinfos[length++];
+        end.type = UTZNM_UNKNOWN;
+        end.tzID = NULL;
+        end.mzID = NULL;
+    }
+    if (count > 0) {
+        // Copy the trie out of the builder's buffer.
+        UnicodeString trie;
+        namesIndex->trie = builder.buildUnicodeString(USTRINGTRIE_BUILD_FAST, trie, status);
+    }
+    if (U_SUCCESS(status)) {
+        fNamesIndex = namesIndex.orphan();
+    }
+}
+
+void TimeZoneNamesImpl::searchNamesIndex(ZNameSearchHandler& handler,
+        const UnicodeString& text, int32_t start, UErrorCode& status) const {
+    if (U_FAILURE(status) || fNamesIndex->trie.isEmpty()) return;
+
+    // Match the full case folding of each code point, as for the trie.
+    UCharsTrie trie(fNamesIndex->trie.getBuffer());
+    for (int32_t index = start; index < text.length();) {
+        UChar32 c = text.char32At(index);
+        index += U16_LENGTH(c);
+        const UChar *folded;
+        int32_t foldedLength = ucase_toFullFolding(c, &folded, U_FOLD_CASE_DEFAULT);
+        UStringTrieResult result;
+        if (foldedLength < 0) {
+            result = trie.nextForCodePoint(~foldedLength);
+        } else if (foldedLength > UCASE_MAX_STRING_LENGTH) {
+            result = trie.nextForCodePoint(foldedLength);
+        } else {
+            result = trie.current();
+            for (int32_t i = 0; i < foldedLength && USTRINGTRIE_MATCHES(result); ++i) {
+                result = trie.next(folded[i]);
+            }
+        }
+        if (USTRINGTRIE_HAS_VALUE(result)) {
+            handler.addMatches(index - start, fNamesIndex->nameinfos.getAlias() + trie.getValue(), status);
+            if (U_FAILURE(status)) { return; }
+        }
+        if (!USTRINGTRIE_HAS_NEXT(result)) {
+            break;
+        }
+    }
+}
+
 U_CDECL_BEGIN
 static void U_CALLCONV
 deleteZNamesLoader(void* obj) {
@@ -1891,7 +1983,7 @@ class TZDBNameSearchHandler : public TextTrieMapSearchResultHandler {
     TZDBNameSearchHandler(uint32_t types, const char* region);
     virtual ~TZDBNameSearchHandler();
 
-    UBool handleMatch(int32_t matchLength, const CharacterNode *node, UErrorCode &status);
+    UBool handleMatch(int32_t matchLength, const TextTrieMapValues *values, UErrorCode &status);
     TimeZoneNames::MatchInfoCollection* getMatches(int32_t& maxMatchLen);
 
 private:
@@ -1912,7 +2004,7 @@ TZDBNameSearchHandler::~TZDBNameSearchHandler() {
 }
 
 UBool
-TZDBNameSearchHandler::handleMatch(int32_t matchLength, const CharacterNode *node, UErrorCode &status) {
+TZDBNameSearchHandler::handleMatch(int32_t matchLength, const TextTrieMapValues *values, UErrorCode &status) {
     if (U_FAILURE(status)) {
         return FALSE;
     }
@@ -1920,10 +2012,10 @@ TZDBNameSearchHandler::handleMatch(int32_t matchLength, const CharacterNode *nod
     TZDBNameInfo *match = NULL;
     TZDBNameInfo *defaultRegionMatch = NULL;
 
-    if (node->hasValues()) {
-        int32_t valuesCount = node->countValues();
+    if (values->hasValues()) {
+        int32_t valuesCount = values->countValues();
         for (int32_t i = 0; i < valuesCount; i++) {
-            TZDBNameInfo *ninfo = (TZDBNameInfo *)node->getValue(i);
+            TZDBNameInfo *ninfo = (TZDBNameInfo *)values->getValue(i);
             if (ninfo == NULL) {
                 continue;
             }
@@ -23,6 +23,8 @@
 #include "unicode/tznames.h"
 #include "unicode/ures.h"
 #include "unicode/locid.h"
+#include "cmemory.h"
+#include "uassert.h"
 #include "uhash.h"
 #include "uvector.h"
 #include "umutex.h"
@@ -70,50 +72,29 @@ class U_I18N_API ZNStringPool: public UMemory {
 };
 
 /*
- * Character node used by TextTrieMap
+ * The values that a TextTrieMap holds for one key, in the order in which they were put.
+ * Passed to the search result handler for each matching key.
  */
-struct CharacterNode {
-    // No constructor or destructor.
-    // We malloc and free an uninitalized array of CharacterNode objects
-    // and clear and delete them ourselves.
-
-    void clear();
-    void deleteValues(UObjectDeleter *valueDeleter);
-
-    void addValue(void *value, UObjectDeleter *valueDeleter, UErrorCode &status);
+struct TextTrieMapValues {
     inline UBool hasValues() const;
     inline int32_t countValues() const;
     inline const void *getValue(int32_t index) const;
 
-    void     *fValues;      // Union of one single value vs. UVector of values.
-    UChar    fCharacter;    // UTF-16 code unit.
-    uint16_t fFirstChild;   // 0 if no children.
-    uint16_t fNextSibling;  // 0 terminates the list.
-    UBool    fHasValuesVector;
-    UBool    fPadding;
-
-    // No value:   fValues == NULL               and  fHasValuesVector == FALSE
-    // One value:  fValues == value              and  fHasValuesVector == FALSE
-    // >=2 values: fValues == UVector of values  and  fHasValuesVector == TRUE
+    void *const *fValues;
+    int32_t     fCount;
 };
 
-inline UBool CharacterNode::hasValues() const {
-    return (UBool)(fValues != NULL);
+inline UBool TextTrieMapValues::hasValues() const {
+    return (UBool)(fCount > 0);
 }
 
-inline int32_t CharacterNode::countValues() const {
-    return
-        fValues == NULL ? 0 :
-        !fHasValuesVector ? 1 :
-        ((const UVector *)fValues)->size();
+inline int32_t TextTrieMapValues::countValues() const {
+    return fCount;
 }
 
-inline const void *CharacterNode::getValue(int32_t index) const {
-    if (!fHasValuesVector) {
-        return fValues;  // Assume index == 0.
-    } else {
-        return ((const UVector *)fValues)->elementAt(index);
-    }
+inline const void *TextTrieMapValues::getValue(int32_t index) const {
+    U_ASSERT(0 <= index && index < fCount);
+    return fValues[index];
 }
 
 /*
@@ -122,13 +103,19 @@ inline const void *CharacterNode::getValue(int32_t index) const {
 class TextTrieMapSearchResultHandler : public UMemory {
 public:
     virtual UBool handleMatch(int32_t matchLength,
-                              const CharacterNode *node, UErrorCode& status) = 0;
+                              const TextTrieMapValues *values, UErrorCode& status) = 0;
     virtual ~TextTrieMapSearchResultHandler(); //added to avoid warning
 };
 
 /**
  * TextTrieMap is a trie implementation for supporting
  * fast prefix match for the string key.
+ *
+ * The keys and values are collected by put(), and frozen into a UCharsTrie of the
+ * (case-folded) keys when they are first searched. The trie maps each key to
+ * its group of values in one array.
+ * Entries put after that are matched linearly until there are enough of them
+ * to be worth rebuilding the trie.
  */
 class U_I18N_API TextTrieMap : public UMemory {
 public:
@@ -143,22 +130,27 @@ class U_I18N_API TextTrieMap : public UMemory {
 
 private:
     UBool           fIgnoreCase;
-    CharacterNode   *fNodes;
-    int32_t         fNodesCapacity;
-    int32_t         fNodesCount;
 
-    UVector         *fLazyContents;
+    // Alternating keys and values of all entries, in the order of put().
+    // The first fFrozenCount entries are in fTrie.
+    UVector         *fContents;
+    int32_t         fFrozenCount;
+    // Maps each distinct (folded) key of the frozen entries to its group number.
+    UnicodeString   fTrie;
+    // Values of the frozen entries, grouped by key:
+    // Group i is fValues[fValueStarts[i]..fValueStarts[i+1][.
+    LocalMemory<void *>  fValues;
+    LocalMemory<int32_t> fValueStarts;
+
     UBool           fIsEmpty;
     UObjectDeleter  *fValueDeleter;
 
-    UBool growNodes();
-    CharacterNode* addChildNode(CharacterNode *parent, UChar c, UErrorCode &status);
-    CharacterNode* getChildNode(CharacterNode *parent, UChar c) const;
-
-    void putImpl(const UnicodeString &key, void *value, UErrorCode &status);
-    void buildTrie(UErrorCode &status);
-    void search(CharacterNode *node, const UnicodeString &text, int32_t start,
-        int32_t index, TextTrieMapSearchResultHandler *handler, UErrorCode &status) const;
+    void freeze(UErrorCode &status);
+    UBool searchTrie(const UnicodeString &text, int32_t start,
+        TextTrieMapSearchResultHandler *handler, UErrorCode &status) const;
+    void searchUnfrozen(const UnicodeString &text, int32_t start,
+        TextTrieMapSearchResultHandler *handler, UErrorCode &status) const;
+    int32_t matchKey(const UChar *key, const UnicodeString &text, int32_t start) const;
 };
 
 
@@ -166,6 +158,7 @@ class U_I18N_API TextTrieMap : public UMemory {
 class ZNames;
 class TextTrieMap;
 class ZNameSearchHandler;
+class ZNamesIndex;
 
 class TimeZoneNamesImpl : public TimeZoneNames {
 public:
@@ -208,10 +201,13 @@ class TimeZoneNamesImpl : public TimeZoneNames {
     UHashtable* fTZNamesMap;
     UHashtable* fMZNamesMap;
 
-    UBool fNamesTrieFullyLoaded;
     UBool fNamesFullyLoaded;
     TextTrieMap fNamesTrie;
 
+    // Index of all of the names, built once when parsing needs names that
+    // were not loaded for formatting. Replaces fNamesTrie once built.
+    ZNamesIndex* fNamesIndex;
+
     void initialize(const Locale& locale, UErrorCode& status);
     void cleanup();
 
@@ -222,6 +218,9 @@ class TimeZoneNamesImpl : public TimeZoneNames {
     TimeZoneNames::MatchInfoCollection* doFind(ZNameSearchHandler& handler,
         const UnicodeString& text, int32_t start, UErrorCode& status) const;
     void addAllNamesIntoTrie(UErrorCode& errorCode);
+    void buildNamesIndex(UErrorCode& errorCode);
+    void searchNamesIndex(ZNameSearchHandler& handler,
+        const UnicodeString& text, int32_t start, UErrorCode& status) const;
 
     void internalLoadAllDisplayNames(UErrorCode& status);
 
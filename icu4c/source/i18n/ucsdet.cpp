@@ -170,6 +170,26 @@ ucsdet_enableInputFilter(UCharsetDetector *ucsd, UBool filter)
     return prev;
 }
 
+U_CAPI  UBool U_EXPORT2
+ucsdet_isFastDetectionEnabled(const UCharsetDetector *ucsd)
+{
+    if (ucsd == NULL) {
+        return FALSE;
+    }
+
+    return ((CharsetDetector *) ucsd)->getFastDetectionFlag();
+}
+
+U_CAPI  UBool U_EXPORT2
+ucsdet_enableFastDetection(UCharsetDetector *ucsd, UBool fast)
+{
+    if (ucsd == NULL) {
+        return FALSE;
+    }
+
+    return ((CharsetDetector *) ucsd)->setFastDetectionFlag(fast);
+}
+
 U_CAPI  int32_t U_EXPORT2
 ucsdet_getUChars(const UCharsetMatch *ucsm,
                  UChar *buf, int32_t cap, UErrorCode *status)
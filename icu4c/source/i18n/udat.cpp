@@ -907,6 +907,13 @@ U_NAMESPACE_BEGIN
  */
 class DateFormatSymbolsSingleSetter /* not : public UObject because all methods are static */ {
 public:
+    static void
+        unshare(DateFormatSymbols *syms)
+    {
+        // The arrays may be shared with cached symbols: Copy them before writing.
+        syms->unshareArrays();
+    }
+
     static void
         setSymbol(UnicodeString *array, int32_t count, int32_t index,
         const UChar *value, int32_t valueLength, UErrorCode &errorCode)
@@ -1105,6 +1112,7 @@ udat_setSymbols(    UDateFormat             *format,
     if(U_FAILURE(*status)) return;
 
     DateFormatSymbols *syms = (DateFormatSymbols *)((SimpleDateFormat *)format)->getDateFormatSymbols();
+    DateFormatSymbolsSingleSetter::unshare(syms);
 
     switch(type) {
     case UDAT_ERAS:
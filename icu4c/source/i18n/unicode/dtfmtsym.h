@@ -43,6 +43,7 @@ U_NAMESPACE_BEGIN
 /* forward declaration */
 class SimpleDateFormat;
 class Hashtable;
+class SharedDateFormatSymbols;
 
 /**
  * DateFormatSymbols is a public class for encapsulating localizable date-time
@@ -901,6 +902,12 @@ class U_I18N_API DateFormatSymbols U_FINAL : public UObject  {
     UnicodeString  *fStandaloneNarrowDayPeriods;
     int32_t         fStandaloneNarrowDayPeriodsCount;
 
+    /**
+     * The cached symbols whose arrays this object aliases instead of owning them,
+     * or NULL if it owns its arrays. They are copied before any of them is modified.
+     */
+    const SharedDateFormatSymbols *fSharedArrays;
+
 private:
     /** valid/actual locale information 
      *  these are always ICU locales, so the length should not be a problem
@@ -910,6 +917,11 @@ class U_I18N_API DateFormatSymbols U_FINAL : public UObject  {
 
     DateFormatSymbols(); // default constructor not implemented
 
+    /**
+     * Constructs symbols that alias the arrays of the cached ones.
+     */
+    DateFormatSymbols(const SharedDateFormatSymbols &shared);
+
     /**
      * Called by the constructors to actually load data from the resources
      *
@@ -955,6 +967,25 @@ class U_I18N_API DateFormatSymbols U_FINAL : public UObject  {
      */
     void createZoneStrings(const UnicodeString *const * otherStrings);
 
+    /**
+     * Copy an array, or alias it if this object shares the other's arrays.
+     */
+    void copyArray(UnicodeString*& dstArray,
+                   int32_t& dstCount,
+                   const UnicodeString* srcArray,
+                   int32_t srcCount);
+
+    /**
+     * Copy or alias all of the other's symbol arrays, except for the zone strings.
+     */
+    void copyArrays(const DateFormatSymbols& other);
+
+    /**
+     * Make this object own its arrays, copying them if they are shared.
+     * Called before modifying any of them.
+     */
+    void unshareArrays(void);
+
     /**
      * Delete all the storage owned by this object.
      */
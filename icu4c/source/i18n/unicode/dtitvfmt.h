@@ -775,10 +775,37 @@ class U_I18N_API DateIntervalFormat : public Format {
      *  Below are for generating interval patterns local to the formatter
      */
 
+    /**
+     * Format a calendar with one of the patterns that formatImpl() uses,
+     * or with the full pattern of the date formatter.
+     *
+     * gFormatterMutex must already be locked when calling this function.
+     *
+     * @param patternIndex      index into fPatternFormats, or -1 for the full pattern
+     * @param cal               calendar set to the date to be formatted
+     * @param appendTo          Output parameter to receive result.
+     *                          Result is appended to existing contents.
+     * @param fphandler         See formatImpl for more information.
+     * @param status            output param set to success/failure code on exit
+     * @internal (private)
+     */
+    void formatPattern(int32_t patternIndex,
+                       Calendar& cal,
+                       UnicodeString& appendTo,
+                       FieldPositionHandler& fphandler,
+                       UErrorCode& status) const;
+
+    /**
+     * Delete the formatters in fPatternFormats, after the patterns
+     * or the date formatter changed.
+     */
+    void resetPatternFormats();
+
     /** Like fallbackFormat, but only formats the range part of the fallback. */
     void fallbackFormatRange(
         Calendar& fromCalendar,
         Calendar& toCalendar,
+        int32_t patternIndex,
         UnicodeString& appendTo,
         int8_t& firstIndex,
         FieldPositionHandler& fphandler,
@@ -788,7 +815,7 @@ class U_I18N_API DateIntervalFormat : public Format {
      * Format 2 Calendars using fall-back interval pattern
      *
      * The full pattern used in this fall-back format is the
-     * full pattern of the date formatter.
+     * full pattern of the date formatter, or the pattern at patternIndex.
      *
      * gFormatterMutex must already be locked when calling this function.
      *
@@ -798,6 +825,7 @@ class U_I18N_API DateIntervalFormat : public Format {
      *                          to be formatted into date interval string
      * @param fromToOnSameDay   TRUE iff from and to dates are on the same day
      *                          (any difference is in ampm/hours or below)
+     * @param patternIndex      See formatPattern for more information.
      * @param appendTo          Output parameter to receive result.
      *                          Result is appended to existing contents.
      * @param firstIndex        See formatImpl for more information.
@@ -809,6 +837,7 @@ class U_I18N_API DateIntervalFormat : public Format {
     UnicodeString& fallbackFormat(Calendar& fromCalendar,
                                   Calendar& toCalendar,
                                   UBool fromToOnSameDay,
+                                  int32_t patternIndex,
                                   UnicodeString& appendTo,
                                   int8_t& firstIndex,
                                   FieldPositionHandler& fphandler,
@@ -1137,6 +1166,23 @@ class U_I18N_API DateIntervalFormat : public Format {
     UnicodeString* fDatePattern;
     UnicodeString* fTimePattern;
     UnicodeString* fDateTimeFormat;
+
+    /**
+     * Formatters for the patterns which formatImpl() would otherwise apply
+     * to fDateFormat and then restore: the first and second parts of each
+     * interval pattern, then the fallback time and date patterns.
+     * A pattern gets its own formatter once it has been used
+     * kPatternFormatMinUses times, which pays for cloning fDateFormat.
+     * Guarded by gFormatterMutex.
+     */
+    enum {
+        kTimePatternIndex = 2 * DateIntervalInfo::kIPI_MAX_INDEX,
+        kDatePatternIndex,
+        kPatternFormatCount,
+        kPatternFormatMinUses = 8
+    };
+    mutable SimpleDateFormat* fPatternFormats[kPatternFormatCount];
+    mutable uint8_t fPatternUses[kPatternFormatCount];
 };
 
 inline UBool
@@ -32,6 +32,9 @@
 
 U_NAMESPACE_BEGIN
 
+/* forward declaration */
+class SharedDateIntervalInfo;
+
 /**
  * DateIntervalInfo is a public class for encapsulating localizable
  * date time interval patterns. It is used by DateIntervalFormat.
@@ -340,6 +343,12 @@ class U_I18N_API DateIntervalInfo U_FINAL : public UObject {
      */
     friend class DateIntervalFormat;
 
+    /**
+     * The locale data is loaded once per locale into a
+     * SharedDateIntervalInfo, which needs initializeData().
+     */
+    friend class SharedDateIntervalInfo;
+
     /**
      * Internal struct used to load resource bundle data.
      */
@@ -40,6 +40,7 @@ class DistanceInfo;
 class PatternMap;
 class PtnSkeleton;
 class SharedDateTimePatternGenerator;
+class DTBestPatternMemo;
 
 /**
  * This class provides flexible generation of date format patterns, like "yy-MM-dd".
@@ -77,7 +78,9 @@ class U_I18N_API DateTimePatternGenerator : public UObject {
 #ifndef U_HIDE_INTERNAL_API
 
     /**
-     * For ICU use only
+     * For ICU use only.
+     * Builds a generator from the locale data, bypassing the cache
+     * of generators that createInstance() clones.
      *
      * @internal
      */
@@ -560,6 +563,9 @@ class U_I18N_API DateTimePatternGenerator : public UObject {
 
     int32_t fAllowedHourFormats[7];  // Actually an array of AllowedHourFormat enum type, ending with UNKNOWN.
 
+    // getBestPattern() results, shared with clones until modified.
+    DTBestPatternMemo *fBestPatternMemo;
+
     // Internal error code used for recording/reporting errors that occur during methods that do not
     // have a UErrorCode parameter. For example: the Copy Constructor, or the ::clone() method.
     // When this is set to an error the object is in an invalid state.
@@ -590,6 +596,8 @@ class U_I18N_API DateTimePatternGenerator : public UObject {
     void setFieldDisplayName(UDateTimePatternField field, UDateTimePGDisplayWidth width, const UnicodeString& value);
     UnicodeString& getMutableFieldDisplayName(UDateTimePatternField field, UDateTimePGDisplayWidth width);
     void getAppendName(UDateTimePatternField field, UnicodeString& value);
+    UnicodeString computeBestPattern(const UnicodeString& patternForm, UDateTimePatternMatchOptions options, UErrorCode& status);
+    void clearBestPatternMemo();
     UnicodeString mapSkeletonMetacharacters(const UnicodeString& patternForm, int32_t* flags, UErrorCode& status);
     const UnicodeString* getBestRaw(DateTimeMatcher& source, int32_t includeMask, DistanceInfo* missingFields, UErrorCode& status, const PtnSkeleton** specifiedSkeletonPtr = 0);
     UnicodeString adjustFieldTypes(const UnicodeString& pattern, const PtnSkeleton* specifiedSkeleton, int32_t flags, UDateTimePatternMatchOptions options = UDATPG_MATCH_NO_OPTIONS);
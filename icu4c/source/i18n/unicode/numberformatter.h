@@ -104,6 +104,7 @@ namespace number {  // icu::number
 // Forward declarations:
 class UnlocalizedNumberFormatter;
 class LocalizedNumberFormatter;
+class CompiledNumberFormatter;
 class FormattedNumber;
 class Notation;
 class ScientificNotation;
@@ -158,6 +159,7 @@ struct UFormattedNumberImpl;
 class MutablePatternModifier;
 class ImmutablePatternModifier;
 struct DecimalFormatWarehouse;
+class CompiledNumberFormatterData;
 
 /**
  * Used for NumberRangeFormatter and implemented in numrange_fluent.cpp.
@@ -2282,6 +2284,188 @@ class U_I18N_API LocalizedNumberFormatter
      */
     FormattedNumber formatDecimal(StringPiece value, UErrorCode& status) const;
 
+#ifndef U_HIDE_DRAFT_API
+    /**
+     * Format the given integer number into a caller-provided UTF-16 buffer.
+     *
+     * Unlike formatInt(int64_t, UErrorCode&), this does not create a FormattedNumber, and for common
+     * settings and values it does not allocate any memory once the formatter has been compiled
+     * (see threshold() and compile()). Field positions are not available.
+     *
+     * The string is NUL-terminated if there is room for the NUL.
+     * To preflight, call with capacity=0; dest may then be NULL.
+     *
+     * @param value
+     *            The number to format.
+     * @param dest
+     *            The destination buffer.
+     * @param capacity
+     *            The number of char16_t units available at dest.
+     * @param status
+     *            Set to an ErrorCode if one occurred in the setter chain or during formatting.
+     *            Set to U_BUFFER_OVERFLOW_ERROR if the formatted string does not fit.
+     * @return The length of the formatted string.
+     * @draft ICU 68
+     */
+    int32_t formatInt(int64_t value, char16_t* dest, int32_t capacity, UErrorCode& status) const;
+
+    /**
+     * Format the given float or double into a caller-provided UTF-16 buffer.
+     * See formatInt(int64_t, char16_t*, int32_t, UErrorCode&).
+     *
+     * @param value
+     *            The number to format.
+     * @param dest
+     *            The destination buffer.
+     * @param capacity
+     *            The number of char16_t units available at dest.
+     * @param status
+     *            Set to an ErrorCode if one occurred in the setter chain or during formatting.
+     *            Set to U_BUFFER_OVERFLOW_ERROR if the formatted string does not fit.
+     * @return The length of the formatted string.
+     * @draft ICU 68
+     */
+    int32_t formatDouble(double value, char16_t* dest, int32_t capacity, UErrorCode& status) const;
+
+    /**
+     * Format the given integer number into a caller-provided UTF-8 buffer.
+     * See formatInt(int64_t, char16_t*, int32_t, UErrorCode&).
+     *
+     * @param value
+     *            The number to format.
+     * @param dest
+     *            The destination buffer.
+     * @param capacity
+     *            The number of bytes available at dest.
+     * @param status
+     *            Set to an ErrorCode if one occurred in the setter chain or during formatting.
+     *            Set to U_BUFFER_OVERFLOW_ERROR if the formatted string does not fit.
+     * @return The length of the formatted string in bytes.
+     * @draft ICU 68
+     */
+    int32_t formatIntToUTF8(int64_t value, char* dest, int32_t capacity, UErrorCode& status) const;
+
+    /**
+     * Format the given float or double into a caller-provided UTF-8 buffer.
+     * See formatInt(int64_t, char16_t*, int32_t, UErrorCode&).
+     *
+     * @param value
+     *            The number to format.
+     * @param dest
+     *            The destination buffer.
+     * @param capacity
+     *            The number of bytes available at dest.
+     * @param status
+     *            Set to an ErrorCode if one occurred in the setter chain or during formatting.
+     *            Set to U_BUFFER_OVERFLOW_ERROR if the formatted string does not fit.
+     * @return The length of the formatted string in bytes.
+     * @draft ICU 68
+     */
+    int32_t formatDoubleToUTF8(double value, char* dest, int32_t capacity, UErrorCode& status) const;
+
+    /**
+     * Format an array of integer numbers into one caller-provided UTF-16 buffer, one after another.
+     * The formatted strings are not separated; offsets[i] is where the string for values[i] starts,
+     * and offsets[count] is the total length.
+     *
+     * This is much faster than formatting the values one at a time, because the formatter reuses
+     * its working memory and does not create a FormattedNumber for each value. The formatter can be
+     * shared by several threads, so that each formats a part of a large column.
+     *
+     * The result is NUL-terminated if there is room for the NUL.
+     * To preflight, call with capacity=0; dest may then be NULL. The offsets are set either way.
+     *
+     * @param values
+     *            The numbers to format.
+     * @param count
+     *            The number of values.
+     * @param dest
+     *            The destination buffer.
+     * @param capacity
+     *            The number of char16_t units available at dest.
+     * @param offsets
+     *            An array of count+1 entries which receives the string offsets. Can be NULL.
+     * @param status
+     *            Set to an ErrorCode if one occurred in the setter chain or during formatting.
+     *            Set to U_BUFFER_OVERFLOW_ERROR if the formatted strings do not fit.
+     * @return The total length of the formatted strings.
+     * @draft ICU 68
+     */
+    int32_t formatInts(const int64_t* values, int32_t count, char16_t* dest, int32_t capacity,
+                       int32_t* offsets, UErrorCode& status) const;
+
+    /**
+     * Format an array of doubles into one caller-provided UTF-16 buffer, one after another.
+     * See formatInts(const int64_t*, int32_t, char16_t*, int32_t, int32_t*, UErrorCode&).
+     *
+     * @param values
+     *            The numbers to format.
+     * @param count
+     *            The number of values.
+     * @param dest
+     *            The destination buffer.
+     * @param capacity
+     *            The number of char16_t units available at dest.
+     * @param offsets
+     *            An array of count+1 entries which receives the string offsets. Can be NULL.
+     * @param status
+     *            Set to an ErrorCode if one occurred in the setter chain or during formatting.
+     *            Set to U_BUFFER_OVERFLOW_ERROR if the formatted strings do not fit.
+     * @return The total length of the formatted strings.
+     * @draft ICU 68
+     */
+    int32_t formatDoubles(const double* values, int32_t count, char16_t* dest, int32_t capacity,
+                          int32_t* offsets, UErrorCode& status) const;
+
+    /**
+     * Format an array of integer numbers into one caller-provided UTF-8 buffer, one after another.
+     * See formatInts(const int64_t*, int32_t, char16_t*, int32_t, int32_t*, UErrorCode&);
+     * the offsets and lengths count bytes.
+     *
+     * @param values
+     *            The numbers to format.
+     * @param count
+     *            The number of values.
+     * @param dest
+     *            The destination buffer.
+     * @param capacity
+     *            The number of bytes available at dest.
+     * @param offsets
+     *            An array of count+1 entries which receives the string offsets. Can be NULL.
+     * @param status
+     *            Set to an ErrorCode if one occurred in the setter chain or during formatting.
+     *            Set to U_BUFFER_OVERFLOW_ERROR if the formatted strings do not fit.
+     * @return The total length of the formatted strings in bytes.
+     * @draft ICU 68
+     */
+    int32_t formatIntsToUTF8(const int64_t* values, int32_t count, char* dest, int32_t capacity,
+                             int32_t* offsets, UErrorCode& status) const;
+
+    /**
+     * Format an array of doubles into one caller-provided UTF-8 buffer, one after another.
+     * See formatInts(const int64_t*, int32_t, char16_t*, int32_t, int32_t*, UErrorCode&);
+     * the offsets and lengths count bytes.
+     *
+     * @param values
+     *            The numbers to format.
+     * @param count
+     *            The number of values.
+     * @param dest
+     *            The destination buffer.
+     * @param capacity
+     *            The number of bytes available at dest.
+     * @param offsets
+     *            An array of count+1 entries which receives the string offsets. Can be NULL.
+     * @param status
+     *            Set to an ErrorCode if one occurred in the setter chain or during formatting.
+     *            Set to U_BUFFER_OVERFLOW_ERROR if the formatted strings do not fit.
+     * @return The total length of the formatted strings in bytes.
+     * @draft ICU 68
+     */
+    int32_t formatDoublesToUTF8(const double* values, int32_t count, char* dest, int32_t capacity,
+                                int32_t* offsets, UErrorCode& status) const;
+#endif  /* U_HIDE_DRAFT_API */
+
 #ifndef U_HIDE_INTERNAL_API
 
     /** Internal method.
@@ -2323,6 +2507,22 @@ class U_I18N_API LocalizedNumberFormatter
      */
     Format* toFormat(UErrorCode& status) const;
 
+#ifndef U_HIDE_DRAFT_API
+    /**
+     * Builds the data structures for formatting with these settings now, and returns them as
+     * an immutable CompiledNumberFormatter.
+     *
+     * A LocalizedNumberFormatter builds these data structures itself only after it has been called
+     * a few times (see threshold()), and each copy of it builds its own. A CompiledNumberFormatter
+     * uses them from the first call, and its copies share them.
+     *
+     * @param status Set to an ErrorCode if one occurred in the setter chain or while building.
+     * @return The compiled formatter; empty if an error occurred.
+     * @draft ICU 68
+     */
+    CompiledNumberFormatter compile(UErrorCode& status) const;
+#endif  /* U_HIDE_DRAFT_API */
+
     /**
      * Default constructor: puts the formatter into a valid but undefined state.
      *
@@ -2400,6 +2600,16 @@ class U_I18N_API LocalizedNumberFormatter
 
     void resetCompiled();
 
+    // Formats into a builder, with the fast path of the compiled formatter if it applies.
+    void formatIntImpl(int64_t value, impl::DecimalQuantity& quantity, FormattedStringBuilder& string,
+                       UErrorCode& status) const;
+
+    void formatDoubleImpl(double value, impl::DecimalQuantity& quantity, FormattedStringBuilder& string,
+                          UErrorCode& status) const;
+
+    void formatImpl(impl::DecimalQuantity& quantity, FormattedStringBuilder& string,
+                    UErrorCode& status) const;
+
     void lnfMoveHelper(LocalizedNumberFormatter&& src);
 
     void lnfCopyHelper(const LocalizedNumberFormatter& src, UErrorCode& status);
@@ -2422,6 +2632,255 @@ class U_I18N_API LocalizedNumberFormatter
 #pragma warning(pop)
 #endif
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * A number formatter whose data structures have been built in advance with
+ * LocalizedNumberFormatter::compile(). It formats exactly like the LocalizedNumberFormatter it came from.
+ *
+ * Instances of this class are immutable and thread-safe. Copies share the compiled data, so a
+ * CompiledNumberFormatter is cheap to copy and to pass between threads. For example, a service can
+ * compile the formatters for all of its skeletons at startup:
+ *
+ * <pre>
+ * CompiledNumberFormatter cnf = CompiledNumberFormatter::forSkeleton(u"currency/EUR", "de", status);
+ * cnf.formatDouble(19.99, status).toString(status);  // "19,99 €"
+ * </pre>
+ *
+ * @draft ICU 68
+ */
+class U_I18N_API CompiledNumberFormatter : public UMemory {
+  public:
+    /**
+     * Compiles a formatter for a number skeleton string and a locale.
+     * Equivalent to NumberFormatter::forSkeleton(skeleton, status).locale(locale).compile(status).
+     *
+     * @param skeleton The skeleton string.
+     * @param locale The locale.
+     * @param status Set to U_NUMBER_SKELETON_SYNTAX_ERROR if the skeleton is invalid.
+     * @return The compiled formatter; empty if an error occurred.
+     * @draft ICU 68
+     */
+    static CompiledNumberFormatter forSkeleton(const UnicodeString& skeleton, const Locale& locale,
+                                               UErrorCode& status);
+
+    /**
+     * Default constructor: makes an empty formatter. Formatting with it fails with U_INVALID_STATE_ERROR.
+     * @draft ICU 68
+     */
+    CompiledNumberFormatter() = default;
+
+    /**
+     * Copy constructor: shares the compiled data.
+     * @draft ICU 68
+     */
+    CompiledNumberFormatter(const CompiledNumberFormatter& other);
+
+    /**
+     * Move constructor: leaves the source empty.
+     * @draft ICU 68
+     */
+    CompiledNumberFormatter(CompiledNumberFormatter&& src) U_NOEXCEPT;
+
+    /**
+     * Copy assignment operator: shares the compiled data.
+     * @draft ICU 68
+     */
+    CompiledNumberFormatter& operator=(const CompiledNumberFormatter& other);
+
+    /**
+     * Move assignment operator: leaves the source empty.
+     * @draft ICU 68
+     */
+    CompiledNumberFormatter& operator=(CompiledNumberFormatter&& src) U_NOEXCEPT;
+
+    /**
+     * Destructor.
+     * @draft ICU 68
+     */
+    ~CompiledNumberFormatter();
+
+    /**
+     * Format the given integer number.
+     *
+     * @param value The number to format.
+     * @param status Set to an ErrorCode if one occurred during formatting.
+     * @return A FormattedNumber object; call .toString() to get the string.
+     * @draft ICU 68
+     */
+    FormattedNumber formatInt(int64_t value, UErrorCode& status) const;
+
+    /**
+     * Format the given float or double.
+     *
+     * @param value The number to format.
+     * @param status Set to an ErrorCode if one occurred during formatting.
+     * @return A FormattedNumber object; call .toString() to get the string.
+     * @draft ICU 68
+     */
+    FormattedNumber formatDouble(double value, UErrorCode& status) const;
+
+    /**
+     * Format the given decimal number. See LocalizedNumberFormatter::formatDecimal().
+     *
+     * @param value The number to format.
+     * @param status Set to an ErrorCode if one occurred during formatting.
+     * @return A FormattedNumber object; call .toString() to get the string.
+     * @draft ICU 68
+     */
+    FormattedNumber formatDecimal(StringPiece value, UErrorCode& status) const;
+
+    /**
+     * Format the given integer number into a caller-provided UTF-16 buffer.
+     * See LocalizedNumberFormatter::formatInt(int64_t, char16_t*, int32_t, UErrorCode&).
+     *
+     * @param value The number to format.
+     * @param dest The destination buffer.
+     * @param capacity The number of char16_t units available at dest.
+     * @param status Set to U_BUFFER_OVERFLOW_ERROR if the formatted string does not fit.
+     * @return The length of the formatted string.
+     * @draft ICU 68
+     */
+    int32_t formatInt(int64_t value, char16_t* dest, int32_t capacity, UErrorCode& status) const;
+
+    /**
+     * Format the given float or double into a caller-provided UTF-16 buffer.
+     * See LocalizedNumberFormatter::formatInt(int64_t, char16_t*, int32_t, UErrorCode&).
+     *
+     * @param value The number to format.
+     * @param dest The destination buffer.
+     * @param capacity The number of char16_t units available at dest.
+     * @param status Set to U_BUFFER_OVERFLOW_ERROR if the formatted string does not fit.
+     * @return The length of the formatted string.
+     * @draft ICU 68
+     */
+    int32_t formatDouble(double value, char16_t* dest, int32_t capacity, UErrorCode& status) const;
+
+    /**
+     * Format the given integer number into a caller-provided UTF-8 buffer.
+     * See LocalizedNumberFormatter::formatInt(int64_t, char16_t*, int32_t, UErrorCode&).
+     *
+     * @param value The number to format.
+     * @param dest The destination buffer.
+     * @param capacity The number of bytes available at dest.
+     * @param status Set to U_BUFFER_OVERFLOW_ERROR if the formatted string does not fit.
+     * @return The length of the formatted string in bytes.
+     * @draft ICU 68
+     */
+    int32_t formatIntToUTF8(int64_t value, char* dest, int32_t capacity, UErrorCode& status) const;
+
+    /**
+     * Format the given float or double into a caller-provided UTF-8 buffer.
+     * See LocalizedNumberFormatter::formatInt(int64_t, char16_t*, int32_t, UErrorCode&).
+     *
+     * @param value The number to format.
+     * @param dest The destination buffer.
+     * @param capacity The number of bytes available at dest.
+     * @param status Set to U_BUFFER_OVERFLOW_ERROR if the formatted string does not fit.
+     * @return The length of the formatted string in bytes.
+     * @draft ICU 68
+     */
+    int32_t formatDoubleToUTF8(double value, char* dest, int32_t capacity, UErrorCode& status) const;
+
+    /**
+     * Format an array of integer numbers into one caller-provided UTF-16 buffer.
+     * See LocalizedNumberFormatter::formatInts().
+     *
+     * @param values The numbers to format.
+     * @param count The number of values.
+     * @param dest The destination buffer.
+     * @param capacity The number of char16_t units available at dest.
+     * @param offsets An array of count+1 entries which receives the string offsets. Can be NULL.
+     * @param status Set to U_BUFFER_OVERFLOW_ERROR if the formatted strings do not fit.
+     * @return The total length of the formatted strings.
+     * @draft ICU 68
+     */
+    int32_t formatInts(const int64_t* values, int32_t count, char16_t* dest, int32_t capacity,
+                       int32_t* offsets, UErrorCode& status) const;
+
+    /**
+     * Format an array of doubles into one caller-provided UTF-16 buffer.
+     * See LocalizedNumberFormatter::formatInts().
+     *
+     * @param values The numbers to format.
+     * @param count The number of values.
+     * @param dest The destination buffer.
+     * @param capacity The number of char16_t units available at dest.
+     * @param offsets An array of count+1 entries which receives the string offsets. Can be NULL.
+     * @param status Set to U_BUFFER_OVERFLOW_ERROR if the formatted strings do not fit.
+     * @return The total length of the formatted strings.
+     * @draft ICU 68
+     */
+    int32_t formatDoubles(const double* values, int32_t count, char16_t* dest, int32_t capacity,
+                          int32_t* offsets, UErrorCode& status) const;
+
+    /**
+     * Format an array of integer numbers into one caller-provided UTF-8 buffer.
+     * See LocalizedNumberFormatter::formatInts().
+     *
+     * @param values The numbers to format.
+     * @param count The number of values.
+     * @param dest The destination buffer.
+     * @param capacity The number of bytes available at dest.
+     * @param offsets An array of count+1 entries which receives the string offsets. Can be NULL.
+     * @param status Set to U_BUFFER_OVERFLOW_ERROR if the formatted strings do not fit.
+     * @return The total length of the formatted strings in bytes.
+     * @draft ICU 68
+     */
+    int32_t formatIntsToUTF8(const int64_t* values, int32_t count, char* dest, int32_t capacity,
+                             int32_t* offsets, UErrorCode& status) const;
+
+    /**
+     * Format an array of doubles into one caller-provided UTF-8 buffer.
+     * See LocalizedNumberFormatter::formatInts().
+     *
+     * @param values The numbers to format.
+     * @param count The number of values.
+     * @param dest The destination buffer.
+     * @param capacity The number of bytes available at dest.
+     * @param offsets An array of count+1 entries which receives the string offsets. Can be NULL.
+     * @param status Set to U_BUFFER_OVERFLOW_ERROR if the formatted strings do not fit.
+     * @return The total length of the formatted strings in bytes.
+     * @draft ICU 68
+     */
+    int32_t formatDoublesToUTF8(const double* values, int32_t count, char* dest, int32_t capacity,
+                                int32_t* offsets, UErrorCode& status) const;
+
+    /**
+     * Creates a skeleton string representation of this formatter's settings. Together with
+     * getLocale(), it can be passed to forSkeleton() to compile an equivalent formatter, for example
+     * in another process.
+     *
+     * @param status Set to U_UNSUPPORTED_ERROR if the settings cannot be represented by a skeleton.
+     * @return A number skeleton string.
+     * @draft ICU 68
+     */
+    UnicodeString toSkeleton(UErrorCode& status) const;
+
+    /**
+     * @return The locale of this formatter; the root locale if it is empty.
+     * @draft ICU 68
+     */
+    const Locale& getLocale() const;
+
+    /**
+     * @return true if this formatter is empty, that is, was default-constructed, moved from,
+     *         or returned with an error.
+     * @draft ICU 68
+     */
+    UBool isEmpty() const {
+        return fData == nullptr;
+    }
+
+  private:
+    const impl::CompiledNumberFormatterData* fData = nullptr;
+
+    explicit CompiledNumberFormatter(const impl::CompiledNumberFormatterData* data);
+
+    // To give LocalizedNumberFormatter::compile() access to the constructor:
+    friend class LocalizedNumberFormatter;
+};
+#endif  /* U_HIDE_DRAFT_API */
+
 /**
  * The result of a number formatting operation. This class allows the result to be exported in several data types,
  * including a UnicodeString and a FieldPositionIterator.
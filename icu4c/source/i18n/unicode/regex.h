@@ -40,6 +40,9 @@
  * expression pattern strings application code can be simplified and the explicit
  * need for `RegexPattern` objects can usually be eliminated.
  *
+ * Class `RegexSet` finds which of a number of patterns match an input text,
+ *  in a single pass over the text.
+ *
  */
 
 #include "unicode/utypes.h"
@@ -62,9 +65,12 @@ struct UHashtable;
 U_NAMESPACE_BEGIN
 
 struct Regex8BitSet;
+struct RegexStringSearch;
+struct RegexNFAWorkspace;
 class  RegexCImpl;
 class  RegexMatcher;
 class  RegexPattern;
+class  RegexSet;
 struct REStackFrame;
 class  BreakIterator;
 class  UnicodeSet;
@@ -378,6 +384,43 @@ class U_I18N_API RegexPattern U_FINAL : public UObject {
     */
     virtual RegexMatcher *matcher(UErrorCode  &status) const;
 
+#ifndef U_HIDE_DRAFT_API
+   /**
+    * Gets a RegexMatcher for this pattern from a pool of matchers kept by the pattern,
+    * or creates a new one if the pool is empty.  A pooled matcher keeps the storage
+    * its backtrack stack has grown to, so that repeated matching of similar input
+    * does not reallocate it.
+    *
+    * The matcher has no input text; call one of its reset() functions before using it.
+    * Its time limit, stack limit, callbacks and region bounds have their default values.
+    * The caller owns the matcher until it is given back with releaseMatcher(), or deleted.
+    *
+    * Unlike the RegexMatchers themselves, acquireMatcher() and releaseMatcher()
+    * may be called concurrently from several threads.  Each thread gets its own
+    * matcher, which it uses alone until it releases it.
+    *
+    * @param status   A reference to a UErrorCode to receive any errors.
+    * @return      A RegexMatcher object for this pattern.
+    *
+    * @draft ICU 68
+    */
+    RegexMatcher *acquireMatcher(UErrorCode &status) const;
+
+   /**
+    * Gives a RegexMatcher obtained from acquireMatcher() back to this pattern, for
+    * reuse by a later call to acquireMatcher().  The matcher is reset, forgetting its
+    * input text, and its settings are restored to the defaults.  The pool holds a
+    * small number of idle matchers; further ones are deleted.
+    *
+    * The caller must not use the matcher after releasing it.
+    *
+    * @param matcher  A matcher from acquireMatcher() on this pattern.  May be NULL.
+    *
+    * @draft ICU 68
+    */
+    void releaseMatcher(RegexMatcher *matcher) const;
+#endif  /* U_HIDE_DRAFT_API */
+
 
    /**
     * Test whether a string matches a regular expression.  This convenience function
@@ -620,11 +663,22 @@ class U_I18N_API RegexPattern U_FINAL : public UObject {
     Regex8BitSet   *fInitialChars8;
     UBool           fNeedsAltInput;
 
+    RegexStringSearch *fInitialStringSearch;  // Search for the initial string of a
+                                              //   START_STRING pattern.
+    RegexStringSearch *fRequiredStringSearch; // Search for a literal string that every
+                                              //   match contains.  Length 0 if none is known.
+
+    UBool           fUseNFAEngine; // Match with the linear time NFA simulation
+                                   //   rather than by backtracking.
+
     UHashtable     *fNamedCaptureMap;  // Map from capture group names to numbers.
 
+    UVector        *fMatcherPool;  // Idle matchers for acquireMatcher(), owned by the pattern.
+
     friend class RegexCompile;
     friend class RegexMatcher;
     friend class RegexCImpl;
+    friend class RegexSet;
 
     //
     //  Implementation Methods
@@ -1118,6 +1172,25 @@ class U_I18N_API RegexMatcher U_FINAL : public UObject {
     virtual RegexMatcher &reset(UText *input);
 
 
+#ifndef U_HIDE_DRAFT_API
+   /**
+    *   Resets this matcher with a new UTF-8 input string.  The matcher operates
+    *     directly on the bytes of the string, which is faster than matching
+    *     the same text through a UText from utext_openUTF8().
+    *   All indexes into the input, such as the start and end of a match or of a
+    *     capture group, are byte offsets.  Ill-formed UTF-8 matches as U+FFFD.
+    *   @param input  The new string on which subsequent pattern matches will operate.
+    *                 The string is not copied.  It is essential that the caller not
+    *                 modify or delete it until after regexp operations on it are done.
+    *   @param status A reference to a UErrorCode to receive any errors.
+    *   @return this RegexMatcher.
+    *
+    *   @draft ICU 68
+    */
+    RegexMatcher &resetUTF8(StringPiece input, UErrorCode &status);
+#endif  /* U_HIDE_DRAFT_API */
+
+
   /**
     *  Set the subject text string upon which the regular expression is looking for matches
     *  without changing any other aspect of the matching state.
@@ -1659,6 +1732,39 @@ class U_I18N_API RegexMatcher U_FINAL : public UObject {
     */
     virtual int32_t  getStackLimit() const;
 
+#ifndef U_HIDE_DRAFT_API
+  /**
+    *  Get the largest size that the backtrack stack has reached in the match
+    *  operations since this matcher was last reset, in the units of setStackLimit().
+    *  A stack limit at least this large lets the same operations run without
+    *  a U_REGEX_STACK_OVERFLOW error.
+    *
+    *  @return  the high water mark of the backtracking stack, in bytes.
+    *  @draft ICU 68
+    */
+    int32_t getMaxStackSize() const;
+
+  /**
+    *  Get the number of backtrack states saved by the match operations since
+    *  this matcher was last reset.  Patterns that run on the linear time match engine
+    *  do not save backtrack states.
+    *
+    *  @return  the number of states pushed onto the backtracking stack.
+    *  @draft ICU 68
+    */
+    int64_t getStateSaveCount() const;
+
+  /**
+    *  Get the amount of work done by the match operations since this matcher was
+    *  last reset, in steps of the match engine.  The time limit set with
+    *  setTimeLimit() is in units of 10000 of these steps.
+    *
+    *  @return  the number of match engine steps.
+    *  @draft ICU 68
+    */
+    int64_t getMatchSteps() const;
+#endif  /* U_HIDE_DRAFT_API */
+
 
   /**
     * Set a callback function for use with this Matcher.
@@ -1760,6 +1866,7 @@ class U_I18N_API RegexMatcher U_FINAL : public UObject {
 
     friend class RegexPattern;
     friend class RegexCImpl;
+    friend class RegexSet;
 public:
 #ifndef U_HIDE_INTERNAL_API
     /** @internal  */
@@ -1781,6 +1888,10 @@ class U_I18N_API RegexMatcher U_FINAL : public UObject {
     inline REStackFrame *StateSave(REStackFrame *fp, int64_t savePatIdx, UErrorCode &status);
     void                 IncrementTime(UErrorCode &status);
 
+    // Support for RegexPattern::acquireMatcher() and releaseMatcher().
+    void                 preallocateStack(UErrorCode &status);
+    UBool                resetForPool();
+
     // Call user find callback function, if set. Return TRUE if operation should be interrupted.
     inline UBool         findProgressInterrupt(int64_t matchIndex, UErrorCode &status);
     
@@ -1790,6 +1901,29 @@ class U_I18N_API RegexMatcher U_FINAL : public UObject {
     void                 MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &status);
     UBool                isChunkWordBoundary(int32_t pos);
 
+    // Counterparts of the above for UTF-8 input, set by resetUTF8().
+    UBool                findUsingUTF8(UErrorCode &status);
+    void                 MatchUTF8At(int32_t startIdx, UBool toEnd, UErrorCode &status);
+    UBool                isUTF8WordBoundary(int32_t pos);
+
+    // The matching engine shared by MatchChunkAt() and MatchUTF8At(),
+    //   templated on how it reads the input.  Defined and instantiated in rematch.cpp.
+    template<typename Input>
+    void                 MatchBufferAt(int32_t startIdx, UBool toEnd, UErrorCode &status);
+
+    // The linear time match engine, used in place of MatchAt() for patterns compiled
+    //   to use it.  With unanchored set, finds the first match starting at or after startIdx.
+    void                 MatchNFA(int64_t startIdx, UBool toEnd, UBool unanchored, UErrorCode &status);
+    UBool                NFAAddThread(UVector64 *threads, int64_t state, int64_t pos,
+                                      UBool toEnd, UErrorCode &status);
+    void                 NFAInitWorkspace(UErrorCode &status);
+    int64_t              NFANextState(int64_t state, UChar32 c);
+
+    // Run all of the linear time patterns of a RegexSet over the input in a single pass,
+    //   setting matched[i] for each pattern i that has a match.  Patterns with
+    //   matched[i] already set are not run.
+    void                 MatchNFASet(const RegexSet &set, UBool *matched, UErrorCode &status);
+
     const RegexPattern  *fPattern;
     RegexPattern        *fPatternOwned;    // Non-NULL if this matcher owns the pattern, and
                                            //   should delete it when through.
@@ -1854,6 +1988,9 @@ class U_I18N_API RegexMatcher U_FINAL : public UObject {
     int32_t             fStackLimit;       // Maximum memory size to use for the backtrack
                                            //   stack, in bytes.  Zero for unlimited.
 
+    int32_t             fMaxStackSize;     // High water mark of fStack->size() since the last reset.
+    int64_t             fStateSaves;       // Number of StateSave() calls since the last reset.
+
     URegexMatchCallback *fCallbackFn;       // Pointer to match progress callback funct.
                                            //   NULL if there is no callback.
     const void         *fCallbackContext;  // User Context ptr for callback function.
@@ -1865,6 +2002,9 @@ class U_I18N_API RegexMatcher U_FINAL : public UObject {
 
     UBool               fInputUniStrMaybeMutable;  // Set when fInputText wraps a UnicodeString that may be mutable - compatibility.
 
+    const uint8_t       *fInputUTF8;       // The UTF-8 input string from resetUTF8(), also
+                                           //   wrapped by fInputText.  NULL for other input.
+
     UBool               fTraceDebug;       // Set true for debug tracing of match engine.
 
     UErrorCode          fDeferredStatus;   // Save error state that cannot be immediately
@@ -1872,7 +2012,154 @@ class U_I18N_API RegexMatcher U_FINAL : public UObject {
 
     BreakIterator       *fWordBreakItr;
     BreakIterator       *fGCBreakItr;
+
+    RegexNFAWorkspace   *fNFAWorkspace;    // Storage for MatchNFA(), allocated when first used.
+};
+
+#ifndef U_HIDE_DRAFT_API
+/**
+  * Class `RegexSet` holds a set of compiled regular expressions, and finds which
+  * of them have a match in an input text.
+  *
+  * Finding which patterns of a set match by running each pattern's `find()`
+  * takes time proportional to the number of patterns.  `RegexSet` combines the
+  * patterns that can be run by the linear time match engine into a single program,
+  * with the sets of characters used by the patterns shared between them, and runs
+  * all of them over the input text in one pass.  Patterns that need the
+  * backtracking engine, for example those with back references or look-around
+  * assertions, are matched separately.
+  *
+  * A `RegexSet` is not thread safe; it holds the state of a match in progress, as a
+  * `RegexMatcher` does.  Use a separate `RegexSet` in each thread.
+  *
+  * Class RegexSet is not intended to be subclassed.
+  *
+  * @draft ICU 68
+  */
+class U_I18N_API RegexSet U_FINAL : public UObject {
+public:
+    /**
+     * Compile a set of regular expressions.
+     *
+     * @param patterns The regular expressions to be compiled.
+     * @param count    The number of patterns.
+     * @param flags    #URegexpFlag options, such as #UREGEX_CASE_INSENSITIVE,
+     *                 applied to all of the patterns.
+     * @param pe       Receives the position (line and column numbers) of any syntax
+     *                 error within the first pattern that fails to compile.
+     * @param status   A reference to a UErrorCode to receive any errors.
+     * @return         A newly created RegexSet, which the caller must delete, or
+     *                 NULL if an error occurred.
+     * @draft ICU 68
+     */
+    static RegexSet * U_EXPORT2 compile(const UnicodeString patterns[],
+                                        int32_t              count,
+                                        uint32_t             flags,
+                                        UParseError          &pe,
+                                        UErrorCode           &status);
+
+    /**
+     * Destructor.
+     *
+     * @draft ICU 68
+     */
+    virtual ~RegexSet();
+
+    /**
+     * Returns the number of patterns in this set.
+     *
+     * @return the number of patterns.
+     * @draft ICU 68
+     */
+    int32_t size() const;
+
+    /**
+     * Returns one of the compiled patterns of this set.
+     *
+     * @param index The index of the pattern, in the order passed to `compile()`.
+     * @return the pattern, owned by this set, or NULL if the index is out of range.
+     * @draft ICU 68
+     */
+    const RegexPattern *getPattern(int32_t index) const;
+
+    /**
+     * Find which patterns of the set have a match in the input text.
+     * A pattern matches if `RegexMatcher::find()` with that pattern would
+     * find a match in the input.
+     *
+     * The indexes of the matching patterns are written in ascending order.
+     * If there are more than `capacity` of them, the first `capacity` are written
+     * and status is set to U_BUFFER_OVERFLOW_ERROR; the return value is the
+     * total number, so that the call can be made with a capacity of zero to
+     * find the size needed.
+     *
+     * @param input    The text to be matched.
+     * @param indexes  Receives the indexes of the matching patterns.  May be NULL
+     *                 if capacity is zero.
+     * @param capacity The number of elements available in indexes.
+     * @param status   A reference to a UErrorCode to receive any errors.
+     * @return         The number of patterns with a match.
+     * @draft ICU 68
+     */
+    int32_t findAll(const UnicodeString &input, int32_t *indexes, int32_t capacity,
+                    UErrorCode &status);
+
+    /**
+     * Find which patterns of the set have a match in the input text.
+     * See the UnicodeString version of this function for details.
+     *
+     * @param input    The text to be matched.  The UText is not modified.
+     * @param indexes  Receives the indexes of the matching patterns.
+     * @param capacity The number of elements available in indexes.
+     * @param status   A reference to a UErrorCode to receive any errors.
+     * @return         The number of patterns with a match.
+     * @draft ICU 68
+     */
+    int32_t findAll(UText *input, int32_t *indexes, int32_t capacity, UErrorCode &status);
+
+    /**
+     * ICU "poor man's RTTI", returns a UClassID for the actual class.
+     *
+     * @draft ICU 68
+     */
+    virtual UClassID getDynamicClassID() const;
+
+    /**
+     * ICU "poor man's RTTI", returns a UClassID for this class.
+     *
+     * @draft ICU 68
+     */
+    static UClassID U_EXPORT2 getStaticClassID();
+
+private:
+    // Instances are created by compile(), and can not be copied or assigned.
+    RegexSet();
+    RegexSet(const RegexSet &other);
+    RegexSet &operator =(const RegexSet &other);
+
+    void        combine(UErrorCode &status);   // Build the combined program.
+
+    UVector       *fPatterns;        // The compiled patterns, RegexPattern *, owned.
+    RegexMatcher **fMatchers;        // Per pattern, a matcher for patterns matched on
+                                     //   their own, or NULL.
+    UBool         *fMatched;         // Per pattern, whether it matched the current input.
+    UBool         *fExcluded;        // Per pattern, whether it is known not to match
+                                     //   the current input without running it.
+
+    RegexPattern  *fCombinedPattern; // The linear time patterns, combined into one program.
+    RegexMatcher  *fCombinedMatcher;
+    UVector32     *fStartLocs;       // Per pattern, the start of its program within
+                                     //   the combined one, or -1 if not combined.
+    UVector32     *fPatternOfOp;     // Per op of the combined program, its pattern's index.
+    UVector32     *fByteStartIndex;  // Per Latin-1 char c, fByteStarts[c .. c+1] index the
+    UVector32     *fByteStarts;      //   patterns whose matches can start with c.
+    UVector32     *fWideStarts;      // Patterns whose matches can start with a char >= 256.
+    UVector32     *fAnyStarts;       // Patterns whose matches can start anywhere.
+    UVector32     *fFirstStarts;     // Patterns that can only match at the start of input.
+
+    friend class RegexMatcher;
 };
+#endif  /* U_HIDE_DRAFT_API */
 
 U_NAMESPACE_END
 #endif  // UCONFIG_NO_REGULAR_EXPRESSIONS
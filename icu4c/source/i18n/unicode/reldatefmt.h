@@ -256,6 +256,7 @@ U_NAMESPACE_BEGIN
 
 class BreakIterator;
 class RelativeDateTimeCacheData;
+class RelativeDateTimeFormatMemo;
 class SharedNumberFormat;
 class SharedPluralRules;
 class SharedBreakIterator;
@@ -700,6 +701,7 @@ class U_I18N_API RelativeDateTimeFormatter : public UObject {
     UDisplayContext fContext;
     const SharedBreakIterator *fOptBreakIterator;
     Locale fLocale;
+    RelativeDateTimeFormatMemo *fMemo;
     void init(
             NumberFormat *nfToAdopt,
             BreakIterator *brkIter,
@@ -710,6 +712,7 @@ class U_I18N_API RelativeDateTimeFormatter : public UObject {
     template<typename F, typename... Args>
     UnicodeString& doFormat(
             F callback,
+            char16_t memoKind,
             UnicodeString& appendTo,
             UErrorCode& status,
             Args... args) const;
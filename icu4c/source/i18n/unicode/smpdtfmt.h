@@ -52,6 +52,8 @@ class TimeZoneFormat;
 class SharedNumberFormat;
 class SimpleDateFormatMutableNFs;
 class DateIntervalFormat;
+class CompiledDateFormatter;
+class CompiledDateFormatData;
 
 namespace number {
 class LocalizedNumberFormatter;
@@ -1179,6 +1181,19 @@ class U_I18N_API SimpleDateFormat: public DateFormat {
      */
     const NumberFormat * getNumberFormatForField(char16_t field) const;
 
+#ifndef U_HIDE_DRAFT_API
+    /**
+     * Returns an immutable, thread-safe formatter with a copy of this formatter's
+     * pattern, symbols, number formats and calendar type.
+     * See CompiledDateFormatter.
+     *
+     * @param status Set to an error code if one occurred.
+     * @return The compiled formatter; empty if an error occurred.
+     * @draft ICU 68
+     */
+    CompiledDateFormatter compile(UErrorCode &status) const;
+#endif  /* U_HIDE_DRAFT_API */
+
 #ifndef U_HIDE_INTERNAL_API
     /**
      * This is for ICU internal use only. Please do not use.
@@ -1221,6 +1236,7 @@ class U_I18N_API SimpleDateFormat: public DateFormat {
 private:
     friend class DateFormat;
     friend class DateIntervalFormat;
+    friend class CompiledDateFormatter;
 
     void initializeDefaultCentury(void);
 
@@ -1605,10 +1621,71 @@ class U_I18N_API SimpleDateFormat: public DateFormat {
     UBool                fHasHanYearChar; // pattern contains the Han year character \u5E74
 
     /**
-     * Sets fHasMinutes and fHasSeconds.
+     * fPattern compiled by parsePattern(), so that format() need not scan it for
+     * quotes and runs of pattern characters.  A sequence of items: Literal text is
+     * its length (less than 0x8000) followed by the text.  A field is 0x8000 plus the
+     * high bits of its pattern character count, the low 16 bits of the count,
+     * and the pattern character.
+     */
+    UnicodeString        fCompiledPattern;
+
+    /**
+     * TRUE if fCompiledPattern has only fields that formatGregorian() can compute
+     * from the proleptic Gregorian date and the time zone offset (no week fields).
+     */
+    UBool                fGregorianPattern = FALSE;
+
+    /**
+     * Sets fHasMinutes and fHasSeconds, and compiles fPattern into fCompiledPattern.
      */
     void                 parsePattern();
 
+    /**
+     * Returns TRUE if formatGregorian() can format with this formatter's pattern
+     * and settings: No capitalization, and only fields that can be computed
+     * from the proleptic Gregorian date and the time zone offset.
+     * The caller checks that the calendar is a GregorianCalendar.
+     */
+    UBool                canFormatGregorian() const;
+
+    /**
+     * Formats the date in the zone like _format() but without a Calendar object,
+     * computing the fields on the stack. Only valid if canFormatGregorian(),
+     * and only for dates after the calendar's Gregorian cutover.
+     */
+    void                 formatGregorian(UDate date, const TimeZone &zone,
+                                         UnicodeString &appendTo,
+                                         FieldPositionHandler &handler, UErrorCode &status) const;
+
+    /**
+     * Returns the maximum length of a result of formatFixedNumeric() if the pattern
+     * has only fixed-width numeric fields with ASCII digits (yyyy, MM, dd, HH, mm, ss,
+     * S to SSS) and ISO 8601 zone offsets (X to XXX, x to xxx, Z to ZZZ).
+     * Returns 0 otherwise. The caller checks canFormatGregorian() and the calendar.
+     */
+    int32_t              getFixedNumericLength() const;
+
+    /**
+     * Formats the date in the zone like formatGregorian(), writing the digits directly.
+     * Only valid if getFixedNumericLength()>0, and only for dates after the calendar's
+     * Gregorian cutover. dest must have room for getFixedNumericLength() units.
+     *
+     * @return the length of the result, or -1 if the year or the zone offset
+     *         do not fit into the fixed-width fields
+     */
+    int32_t              formatFixedNumeric(UDate date, const TimeZone &zone,
+                                            UChar *dest, UErrorCode &status) const;
+
+    /**
+     * Parses text that matches the pattern exactly, with the pattern's number of digits
+     * for each field, and only valid field values. Only valid if getFixedNumericLength()>0.
+     * The zone resolves the local time unless the pattern has a zone offset field.
+     *
+     * @return TRUE if date was set; FALSE if the text needs to be parsed with parse()
+     */
+    UBool                parseFixedNumeric(const UChar *text, int32_t length, const TimeZone &zone,
+                                           UDate &date, UErrorCode &status) const;
+
     /**
      * See documentation for defaultCenturyStart.
      */
@@ -1655,6 +1732,174 @@ SimpleDateFormat::get2DigitYearStart(UErrorCode& /*status*/) const
     return fDefaultCenturyStart;
 }
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * An immutable date formatter that can be shared between threads, made with
+ * SimpleDateFormat::compile() or forPattern().
+ *
+ * Unlike a DateFormat, it has no Calendar whose state changes while formatting:
+ * The date and the time zone are arguments of each format() call. For a Gregorian
+ * calendar and the common date, time and zone fields, the calendar fields are
+ * computed on the stack, and formatting into a buffer does not allocate memory.
+ * Other patterns and calendars format with a temporary Calendar.
+ *
+ * Copies share the formatter data, so a CompiledDateFormatter is cheap to copy:
+ *
+ * <pre>
+ * CompiledDateFormatter cdf = CompiledDateFormatter::forPattern(
+ *     u"yyyy-MM-dd'T'HH:mm:ss.SSSXXX", Locale::getRoot(), status);
+ * LocalPointer<TimeZone> utc(TimeZone::createTimeZone(u"UTC"));
+ * UnicodeString s;
+ * cdf.format(0.0, *utc, s, status);  // "1970-01-01T00:00:00.000Z"
+ * </pre>
+ *
+ * @draft ICU 68
+ */
+class U_I18N_API CompiledDateFormatter : public UMemory {
+public:
+    /**
+     * Compiles a formatter for a pattern and a locale.
+     * Equivalent to SimpleDateFormat(pattern, locale, status).compile(status).
+     *
+     * @param pattern The SimpleDateFormat pattern.
+     * @param locale The locale.
+     * @param status Set to an error code if one occurred.
+     * @return The compiled formatter; empty if an error occurred.
+     * @draft ICU 68
+     */
+    static CompiledDateFormatter forPattern(const UnicodeString &pattern, const Locale &locale,
+                                            UErrorCode &status);
+
+    /**
+     * Default constructor: makes an empty formatter. Formatting with it fails with U_INVALID_STATE_ERROR.
+     * @draft ICU 68
+     */
+    CompiledDateFormatter() = default;
+
+    /**
+     * Copy constructor: shares the formatter data.
+     * @draft ICU 68
+     */
+    CompiledDateFormatter(const CompiledDateFormatter &other);
+
+    /**
+     * Move constructor: leaves the source empty.
+     * @draft ICU 68
+     */
+    CompiledDateFormatter(CompiledDateFormatter &&src) U_NOEXCEPT;
+
+    /**
+     * Copy assignment operator: shares the formatter data.
+     * @draft ICU 68
+     */
+    CompiledDateFormatter &operator=(const CompiledDateFormatter &other);
+
+    /**
+     * Move assignment operator: leaves the source empty.
+     * @draft ICU 68
+     */
+    CompiledDateFormatter &operator=(CompiledDateFormatter &&src) U_NOEXCEPT;
+
+    /**
+     * Destructor.
+     * @draft ICU 68
+     */
+    ~CompiledDateFormatter();
+
+    /**
+     * Formats a date in a time zone and appends the result.
+     *
+     * @param date The date to format.
+     * @param zone The time zone for the calendar fields and the zone fields.
+     * @param appendTo Output parameter to receive the result.
+     *                 The result is appended to existing contents.
+     * @param status Set to an error code if one occurred.
+     * @return appendTo
+     * @draft ICU 68
+     */
+    UnicodeString &format(UDate date, const TimeZone &zone, UnicodeString &appendTo,
+                          UErrorCode &status) const;
+
+    /**
+     * Formats a date in a time zone into a caller-provided buffer.
+     * The usual ICU string output conventions apply: The result is NUL-terminated
+     * if there is room, and U_BUFFER_OVERFLOW_ERROR is set (and the full length returned)
+     * if it does not fit, which allows for preflighting with capacity 0.
+     *
+     * @param date The date to format.
+     * @param zone The time zone for the calendar fields and the zone fields.
+     * @param dest Destination buffer; can be NULL if capacity==0.
+     * @param capacity Number of char16_t units available at dest.
+     * @param status Set to an error code if one occurred.
+     * @return The length of the result.
+     * @draft ICU 68
+     */
+    int32_t format(UDate date, const TimeZone &zone, char16_t *dest, int32_t capacity,
+                   UErrorCode &status) const;
+
+    /**
+     * Formats an array of dates in a time zone into one caller-provided buffer,
+     * one after another. The formatted strings are not separated; offsets[i] is
+     * where the string for dates[i] starts, and offsets[count] is the total length.
+     *
+     * This is much faster than formatting the dates one at a time.
+     * For a pattern with only fixed-width numeric fields and ISO 8601 zone offsets,
+     * like "yyyy-MM-dd'T'HH:mm:ss.SSSXXX", the digits are written directly
+     * and the time zone is only used to look up the offset of each date.
+     *
+     * The result is NUL-terminated if there is room for the NUL.
+     * To preflight, call with capacity=0; dest may then be NULL. The offsets are set either way.
+     *
+     * @param dates The dates to format.
+     * @param count The number of dates.
+     * @param zone The time zone for the calendar fields and the zone fields.
+     * @param dest The destination buffer.
+     * @param capacity The number of char16_t units available at dest.
+     * @param offsets An array of count+1 entries which receives the string offsets. Can be NULL.
+     * @param status Set to U_BUFFER_OVERFLOW_ERROR if the formatted strings do not fit.
+     * @return The total length of the formatted strings.
+     * @draft ICU 68
+     */
+    int32_t formatDates(const UDate *dates, int32_t count, const TimeZone &zone,
+                        char16_t *dest, int32_t capacity, int32_t *offsets,
+                        UErrorCode &status) const;
+
+    /**
+     * Parses an array of date strings that are stored one after another,
+     * as formatDates() writes them: The string for dates[i] starts at text+offsets[i]
+     * and ends at text+offsets[i+1]. Each string must be parsed completely.
+     *
+     * For a pattern with only fixed-width numeric fields and ISO 8601 zone offsets,
+     * strings that match the pattern exactly are parsed directly, and the time zone
+     * is only used to resolve local times when the pattern has no zone offset field.
+     * Other strings are parsed like SimpleDateFormat::parse() does, with a Calendar
+     * in the time zone.
+     *
+     * Parsing stops at the first string that cannot be parsed:
+     * Then status is set to U_PARSE_ERROR, and the index of that string is returned.
+     *
+     * @param text The date strings.
+     * @param offsets An array of count+1 string offsets into text.
+     * @param count The number of strings.
+     * @param zone The time zone for strings without zone fields.
+     * @param dates An array of count entries which receives the parsed dates.
+     * @param status Set to an error code if one occurred.
+     * @return The number of dates parsed: count if they were all parsed.
+     * @draft ICU 68
+     */
+    int32_t parseDates(const char16_t *text, const int32_t *offsets, int32_t count,
+                       const TimeZone &zone, UDate *dates, UErrorCode &status) const;
+
+private:
+    const CompiledDateFormatData *fData = nullptr;
+
+    explicit CompiledDateFormatter(const CompiledDateFormatData *data);
+
+    // To give SimpleDateFormat::compile() access to the constructor:
+    friend class SimpleDateFormat;
+};
+#endif  /* U_HIDE_DRAFT_API */
+
 U_NAMESPACE_END
 
 #endif /* #if !UCONFIG_NO_FORMATTING */
@@ -379,6 +379,49 @@ ucsdet_isInputFilterEnabled(const UCharsetDetector *ucsd);
 U_STABLE  UBool U_EXPORT2
 ucsdet_enableInputFilter(UCharsetDetector *ucsd, UBool filter);
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ *  Test whether fast detection is enabled.
+ *
+ *  @param ucsd  The charset detector to check.
+ *  @return TRUE if fast detection is enabled.
+ *  @see ucsdet_enableFastDetection
+ *  @draft ICU 68
+ */
+U_DRAFT  UBool U_EXPORT2
+ucsdet_isFastDetectionEnabled(const UCharsetDetector *ucsd);
+
+/**
+ * Enable fast detection. Fast detection runs the charset recognizers
+ * in stages, and stops as soon as the input has been identified with certainty:
+ * <ol>
+ *   <li>Byte order marks and the validity of UTF-8 are checked first,
+ *       followed by the other Unicode, multi-byte and ISO-2022 charsets.
+ *       If one of them matches with a confidence of 100,
+ *       then that is the only match that is reported.</li>
+ *   <li>If the input contains no bytes with the high bit set, then it is
+ *       reported as UTF-8 (or as whichever match from the first stage has
+ *       a higher confidence), without running the statistical
+ *       single-byte charset recognizers.</li>
+ *   <li>Otherwise, the single-byte charset recognizers are run as usual.</li>
+ * </ol>
+ * In addition, only a bounded prefix (the first 8kB) of the input is examined.
+ *
+ * This is intended for applications that detect the charset of large numbers
+ * of documents, most of which are in UTF-8 or ASCII. It trades the completeness
+ * of the list of matches, and the language of plain ASCII text, for speed.
+ * Note that ucsdet_getUChars() still converts the whole input text.
+ *
+ * @param ucsd   the charset detector to be modified.
+ * @param fast   <code>true</code> to enable fast detection.
+ * @return The previous setting.
+ *
+ * @draft ICU 68
+ */
+U_DRAFT  UBool U_EXPORT2
+ucsdet_enableFastDetection(UCharsetDetector *ucsd, UBool fast);
+#endif  /* U_HIDE_DRAFT_API */
+
 #ifndef U_HIDE_INTERNAL_API
 /**
   *  Get an iterator over the set of detectable charsets -
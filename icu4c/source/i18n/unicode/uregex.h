@@ -105,7 +105,28 @@ typedef enum URegexpFlag{
        *     escaped letters represent themselves.
        *     @stable ICU 4.0
        */
-     UREGEX_ERROR_ON_UNKNOWN_ESCAPES = 512
+     UREGEX_ERROR_ON_UNKNOWN_ESCAPES = 512,
+
+#ifndef U_HIDE_DRAFT_API
+     /**  Match in time linear in the length of the input.
+       *     Patterns without back references, look-around, atomic groups,
+       *     possessive quantifiers, \\X, or {min,max} intervals (other than
+       *     short ones on a single character or set) are matched this way by
+       *     default.  With this flag, opening a pattern that uses any of them
+       *     fails with U_REGEX_UNIMPLEMENTED.
+       *     May not be combined with UREGEX_BACKTRACKING.
+       *     @draft ICU 68
+       */
+     UREGEX_LINEAR_TIME = 1024,
+
+     /**  Always match with the backtracking engine, whose running time
+       *     may grow exponentially with the length of the input for some
+       *     patterns, and is only bounded by uregex_setTimeLimit().
+       *     May not be combined with UREGEX_LINEAR_TIME.
+       *     @draft ICU 68
+       */
+     UREGEX_BACKTRACKING = 2048
+#endif  /* U_HIDE_DRAFT_API */
 
 }  URegexpFlag;
 
@@ -348,6 +369,34 @@ uregex_setUText(URegularExpression *regexp,
                 UText              *text,
                 UErrorCode         *status);
 
+#ifndef U_HIDE_DRAFT_API
+/**
+  *  Set a UTF-8 subject text string upon which the regular expression will look for matches.
+  *  This function may be called any number of times, allowing the regular
+  *  expression pattern to be applied to different strings.
+  *  <p>
+  *  Matching operates directly on the UTF-8 bytes, which is faster than
+  *  matching the same text through a UText from utext_openUTF8().
+  *  All indexes into the text, such as match and group positions, are byte offsets.
+  *  <p>
+  *  The subject string data is not copied.  It must not be altered after calling
+  *  this function until after all regular expression operations involving this
+  *  string data are completed.
+  *
+  * @param regexp     The compiled regular expression.
+  * @param text       The subject text string, in UTF-8.
+  * @param textLength The length of the subject text, in bytes, or -1 if the string
+  *                   is NUL terminated.
+  * @param status     Receives errors detected by this function.
+  * @draft ICU 68
+  */
+U_DRAFT void U_EXPORT2
+uregex_setUTF8Text(URegularExpression *regexp,
+                   const char         *text,
+                   int32_t             textLength,
+                   UErrorCode         *status);
+#endif  /* U_HIDE_DRAFT_API */
+
 /**
   *  Get the subject text that is currently associated with this 
   *   regular expression object.  If the input was supplied using uregex_setText(),
@@ -1610,5 +1659,98 @@ uregex_getFindProgressCallback(const URegularExpression          *regexp,
                                 const void                        **context,
                                 UErrorCode                        *status);
 
+#ifndef U_HIDE_DRAFT_API
+struct URegexSet;
+/**
+  * Structure representing a set of compiled regular expressions, for finding
+  *    which of them match a text in a single pass over the text.
+  * @draft ICU 68
+  */
+typedef struct URegexSet URegexSet;
+
+/**
+  *  Open (compile) a set of ICU regular expressions.
+  *  The patterns that can be run by the linear time match engine are combined
+  *  into a single program; uregex_findSet() runs them all in one pass over the text.
+  *
+  *  A URegexSet holds the state of a match in progress, and must not be used
+  *  by more than one thread at a time.
+  *
+  * @param patterns       The regular expression patterns to be compiled.
+  * @param patternLengths The lengths of the patterns, or -1 for a pattern that
+  *                       is NUL terminated.  If NULL, all patterns are NUL terminated.
+  * @param count          The number of patterns.
+  * @param flags          Flags that alter the default matching behavior for
+  *                       all of the patterns.  See <code>enum URegexpFlag</code>.
+  * @param pe             Receives the position (line and column numbers) of any syntax
+  *                       error within the first pattern that fails to compile.  If this
+  *                       information is not wanted, pass NULL for this parameter.
+  * @param status         Receives error detected by this function.
+  * @return               The URegexSet, to be closed with uregex_closeSet().
+  * @draft ICU 68
+  */
+U_DRAFT URegexSet * U_EXPORT2
+uregex_openSet(const UChar * const *patterns,
+               const int32_t       *patternLengths,
+               int32_t              count,
+               uint32_t             flags,
+               UParseError         *pe,
+               UErrorCode          *status);
+
+/**
+  *  Close a URegexSet, releasing all of the storage associated with it.
+  *
+  * @param set   The URegexSet to be closed.
+  * @draft ICU 68
+  */
+U_DRAFT void U_EXPORT2
+uregex_closeSet(URegexSet *set);
+
+/**
+  *  Find which patterns of a URegexSet have a match in a text.  A pattern matches
+  *  if uregex_findNext() with that pattern would find a match in the text.
+  *
+  *  The indexes of the matching patterns are written in ascending order.  If there
+  *  are more than <code>capacity</code> of them, the status is set to
+  *  U_BUFFER_OVERFLOW_ERROR; the total number is always returned.
+  *
+  * @param set        The compiled set of regular expressions.
+  * @param text       The text to be matched.
+  * @param textLength The length of the text, or -1 if it is NUL terminated.
+  * @param indexes    Receives the indexes of the matching patterns.  May be NULL
+  *                   if capacity is zero.
+  * @param capacity   The number of elements available in indexes.
+  * @param status     A reference to a UErrorCode to receive any errors.
+  * @return           The number of patterns with a match.
+  * @draft ICU 68
+  */
+U_DRAFT int32_t U_EXPORT2
+uregex_findSet(URegexSet      *set,
+               const UChar    *text,
+               int32_t         textLength,
+               int32_t        *indexes,
+               int32_t         capacity,
+               UErrorCode     *status);
+
+#if U_SHOW_CPLUSPLUS_API
+
+U_NAMESPACE_BEGIN
+
+/**
+ * \class LocalURegexSetPointer
+ * "Smart pointer" class, closes a URegexSet via uregex_closeSet().
+ * For most methods see the LocalPointerBase base class.
+ *
+ * @see LocalPointerBase
+ * @see LocalPointer
+ * @draft ICU 68
+ */
+U_DEFINE_LOCAL_OPEN_POINTER(LocalURegexSetPointer, URegexSet, uregex_closeSet);
+
+U_NAMESPACE_END
+
+#endif
+#endif  /* U_HIDE_DRAFT_API */
+
 #endif   /*  !UCONFIG_NO_REGULAR_EXPRESSIONS  */
 #endif   /*  UREGEX_H  */
@@ -0,0 +1,160 @@
+// © 2020 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+/*
+*******************************************************************************
+*   file name:  uwarmup.h
+*   encoding:   UTF-8
+*   tab size:   8 (not used)
+*   indentation:4
+*
+*   Purpose: Load locale data and services ahead of their first use,
+*   and report what the service cache holds.
+*/
+
+#ifndef __UWARMUP_H__
+#define __UWARMUP_H__
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_FORMATTING
+
+#include "unicode/uloc.h"
+
+/**
+ * \file
+ * \brief C API: Warm up locale data and services, and report the service cache.
+ *
+ * The first number formatter, date formatter, plural rules, word break iterator
+ * or collator that is created for a locale loads its resource bundles and follows
+ * their fallback chains, and builds the data that later instances share.
+ * Servers that must not pay for this while handling a request can call
+ * uwarmup_loadLocales() at startup with the locales and services they use.
+ *
+ * uwarmup_loadLocales() is thread-safe. To warm up in parallel, call it
+ * on several threads, each with a part of the list of locales.
+ * When two threads need the same shared data, one of them builds it
+ * while the other waits for it.
+ *
+ * uwarmup_getCacheEntries() lists the entries of the cache of shared
+ * locale data, for checking which locales and services have been loaded.
+ * Entries that are not in use may be evicted when the cache grows,
+ * and all of them are removed by u_cleanup().
+ */
+
+#ifndef U_HIDE_DRAFT_API
+
+/**
+ * Services to warm up with uwarmup_loadLocales(). Can be combined with bitwise OR.
+ * @draft ICU 68
+ */
+typedef enum UWarmupService {
+    /**
+     * NumberFormat: the locale's decimal format and its symbols.
+     * @draft ICU 68
+     */
+    UWARMUP_NUMBER_FORMAT = 1,
+    /**
+     * DateFormat: the locale's calendar, date format symbols, date/time patterns,
+     * pattern generator and interval patterns.
+     * @draft ICU 68
+     */
+    UWARMUP_DATE_FORMAT = 2,
+    /**
+     * PluralRules: the locale's cardinal and ordinal rules.
+     * @draft ICU 68
+     */
+    UWARMUP_PLURAL_RULES = 4,
+    /**
+     * BreakIterator: the locale's word break rules.
+     * Ignored if break iteration is configured out.
+     * @draft ICU 68
+     */
+    UWARMUP_WORD_BREAK = 8,
+    /**
+     * Collator: the locale's tailoring.
+     * Ignored if collation is configured out.
+     * @draft ICU 68
+     */
+    UWARMUP_COLLATOR = 0x10,
+    /**
+     * All of the above.
+     * @draft ICU 68
+     */
+    UWARMUP_ALL_SERVICES = 0x1f
+} UWarmupService;
+
+/**
+ * Describes one entry of the cache of shared locale data.
+ * @see uwarmup_getCacheEntries
+ * @draft ICU 68
+ */
+typedef struct UWarmupCacheEntry {
+    /**
+     * The type of the cached data, like "SharedNumberFormat",
+     * NUL-terminated and truncated if necessary.
+     * @draft ICU 68
+     */
+    char type[48];
+    /**
+     * A description of the key, NUL-terminated and truncated if necessary:
+     * For most entries, this is the locale ID.
+     * @draft ICU 68
+     */
+    char key[ULOC_FULLNAME_CAPACITY];
+    /**
+     * The number of references to the data from outside the cache,
+     * for example from formatters.
+     * 0 if the data is only kept for future use.
+     * @draft ICU 68
+     */
+    int32_t refCount;
+    /**
+     * U_ZERO_ERROR or the warning from creating the data,
+     * or the error that prevented creating it. There is no data in the cache
+     * for an entry with an error; the entry records that it is not available.
+     * @draft ICU 68
+     */
+    UErrorCode creationStatus;
+} UWarmupCacheEntry;
+
+/**
+ * Loads the data for the given services and locales, by creating and
+ * deleting one instance of each service for each locale.
+ * Data that is shared between instances remains cached,
+ * and resource bundles remain open, for the services created later.
+ *
+ * Failures for one locale do not prevent loading the others.
+ *
+ * @param localeIDs the locale IDs; NULL or "" stands for the default locale
+ * @param count the number of locale IDs
+ * @param services one or more UWarmupService values, combined with bitwise OR
+ * @param status an in/out ICU UErrorCode. Set to U_ILLEGAL_ARGUMENT_ERROR
+ *               if localeIDs is NULL while count is positive, or if count is negative.
+ *               Otherwise set to the first failure from creating a service, if any.
+ * @draft ICU 68
+ */
+U_DRAFT void U_EXPORT2
+uwarmup_loadLocales(const char *const *localeIDs, int32_t count,
+                    uint32_t services, UErrorCode *status);
+
+/**
+ * Lists the entries of the cache of shared locale data.
+ * The cache may change at any time, so the list is a snapshot.
+ *
+ * @param entries the array to fill, can be NULL if capacity is 0
+ * @param capacity the number of elements in the entries array
+ * @param status an in/out ICU UErrorCode. Set to U_ILLEGAL_ARGUMENT_ERROR
+ *               if entries is NULL while capacity is positive, or if capacity is negative.
+ *               Set to U_BUFFER_OVERFLOW_ERROR if there are more entries than fit into the array.
+ * @return the number of entries in the cache; if greater than capacity,
+ *         only the first capacity entries were written
+ * @draft ICU 68
+ */
+U_DRAFT int32_t U_EXPORT2
+uwarmup_getCacheEntries(UWarmupCacheEntry *entries, int32_t capacity, UErrorCode *status);
+
+#endif  // U_HIDE_DRAFT_API
+
+#endif  // !UCONFIG_NO_FORMATTING
+
+#endif  // __UWARMUP_H__
@@ -20,6 +20,7 @@
 #include "unicode/uobject.h"
 #include "unicode/utf16.h"
 #include "cmemory.h"
+#include "cstring.h"
 #include "uassert.h"
 #include "uhash.h"
 #include "umutex.h"
@@ -427,6 +428,39 @@ uregex_setUText(URegularExpression *regexp2,
 }
 
 
+//------------------------------------------------------------------------------
+//
+//    uregex_setUTF8Text
+//
+//------------------------------------------------------------------------------
+U_CAPI void U_EXPORT2
+uregex_setUTF8Text(URegularExpression *regexp2,
+                   const char         *text,
+                   int32_t             textLength,
+                   UErrorCode         *status) {
+    RegularExpression *regexp = (RegularExpression*)regexp2;
+    if (validateRE(regexp, FALSE, status) == FALSE) {
+        return;
+    }
+    if (text == NULL || textLength < -1) {
+        *status = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    if (textLength == -1) {
+        textLength = (int32_t)uprv_strlen(text);
+    }
+
+    if (regexp->fOwnsText && regexp->fText != NULL) {
+        uprv_free((void *)regexp->fText);
+    }
+
+    regexp->fText       = NULL; // only fill it in on request
+    regexp->fTextLength = -1;
+    regexp->fOwnsText   = TRUE;
+    regexp->fMatcher->resetUTF8(StringPiece(text, textLength), *status);
+}
+
+
 
 //------------------------------------------------------------------------------
 //
@@ -1976,5 +2010,81 @@ uregex_splitUText(URegularExpression    *regexp2,
 }
 
 
+//------------------------------------------------------------------------------
+//
+//    uregex_openSet
+//
+//------------------------------------------------------------------------------
+U_CAPI URegexSet * U_EXPORT2
+uregex_openSet(const UChar * const *patterns,
+               const int32_t       *patternLengths,
+               int32_t              count,
+               uint32_t             flags,
+               UParseError         *pe,
+               UErrorCode          *status) {
+    if (U_FAILURE(*status)) {
+        return NULL;
+    }
+    if (count < 0 || (patterns == NULL && count > 0)) {
+        *status = U_ILLEGAL_ARGUMENT_ERROR;
+        return NULL;
+    }
+    LocalArray<UnicodeString> patternStrings(new UnicodeString[count + 1], *status);
+    if (U_FAILURE(*status)) {
+        return NULL;
+    }
+    for (int32_t i = 0; i < count; i++) {
+        int32_t length = patternLengths == NULL ? -1 : patternLengths[i];
+        if (patterns[i] == NULL || length < -1) {
+            *status = U_ILLEGAL_ARGUMENT_ERROR;
+            return NULL;
+        }
+        patternStrings[i].setTo(patterns[i], length);
+    }
+
+    UParseError localPE;
+    return (URegexSet *)RegexSet::compile(patternStrings.getAlias(), count, flags,
+                                          pe != NULL ? *pe : localPE, *status);
+}
+
+
+//------------------------------------------------------------------------------
+//
+//    uregex_closeSet
+//
+//------------------------------------------------------------------------------
+U_CAPI void U_EXPORT2
+uregex_closeSet(URegexSet *set) {
+    delete (RegexSet *)set;
+}
+
+
+//------------------------------------------------------------------------------
+//
+//    uregex_findSet
+//
+//------------------------------------------------------------------------------
+U_CAPI int32_t U_EXPORT2
+uregex_findSet(URegexSet      *set,
+               const UChar    *text,
+               int32_t         textLength,
+               int32_t        *indexes,
+               int32_t         capacity,
+               UErrorCode     *status) {
+    if (U_FAILURE(*status)) {
+        return 0;
+    }
+    if (set == NULL || text == NULL || textLength < -1) {
+        *status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    UText inputText = UTEXT_INITIALIZER;
+    utext_openUChars(&inputText, text, textLength, status);
+    int32_t count = ((RegexSet *)set)->findAll(&inputText, indexes, capacity, *status);
+    utext_close(&inputText);
+    return count;
+}
+
+
 #endif   // !UCONFIG_NO_REGULAR_EXPRESSIONS
 
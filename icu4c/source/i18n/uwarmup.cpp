@@ -0,0 +1,198 @@
+// © 2020 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+/*
+*******************************************************************************
+*   file name:  uwarmup.cpp
+*   encoding:   UTF-8
+*   tab size:   8 (not used)
+*   indentation:4
+*
+*   Load locale data and services ahead of their first use,
+*   and report what the service cache holds.
+*/
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_FORMATTING
+
+#include <typeinfo>
+
+#include "unicode/brkiter.h"
+#include "unicode/coll.h"
+#include "unicode/datefmt.h"
+#include "unicode/dtitvinf.h"
+#include "unicode/dtptngen.h"
+#include "unicode/localpointer.h"
+#include "unicode/locid.h"
+#include "unicode/numfmt.h"
+#include "unicode/plurrule.h"
+#include "unicode/uwarmup.h"
+#include "cmemory.h"
+#include "cstring.h"
+#include "unifiedcache.h"
+
+U_NAMESPACE_USE
+
+namespace {
+
+/**
+ * Keeps the first failure from creating a service in *status,
+ * and resets errorCode for the next service.
+ * Warnings, like using fallback data, are not failures.
+ */
+void keepFirstFailure(UErrorCode &errorCode, UErrorCode *status) {
+    if (U_FAILURE(errorCode) && U_SUCCESS(*status)) {
+        *status = errorCode;
+    }
+    errorCode = U_ZERO_ERROR;
+}
+
+void loadLocale(const Locale &locale, uint32_t services, UErrorCode *status) {
+    UErrorCode errorCode = U_ZERO_ERROR;
+    if (services & UWARMUP_NUMBER_FORMAT) {
+        LocalPointer<NumberFormat> nf(NumberFormat::createInstance(locale, errorCode));
+        keepFirstFailure(errorCode, status);
+    }
+    if (services & UWARMUP_DATE_FORMAT) {
+        LocalPointer<DateFormat> df(
+            DateFormat::createDateTimeInstance(DateFormat::kDefault, DateFormat::kDefault, locale));
+        if (df.isNull()) {
+            errorCode = U_MEMORY_ALLOCATION_ERROR;
+        }
+        keepFirstFailure(errorCode, status);
+        LocalPointer<DateTimePatternGenerator> dtpg(
+            DateTimePatternGenerator::createInstance(locale, errorCode));
+        keepFirstFailure(errorCode, status);
+        DateIntervalInfo dtitvinf(locale, errorCode);
+        keepFirstFailure(errorCode, status);
+    }
+    if (services & UWARMUP_PLURAL_RULES) {
+        LocalPointer<PluralRules> cardinal(
+            PluralRules::forLocale(locale, UPLURAL_TYPE_CARDINAL, errorCode));
+        keepFirstFailure(errorCode, status);
+        LocalPointer<PluralRules> ordinal(
+            PluralRules::forLocale(locale, UPLURAL_TYPE_ORDINAL, errorCode));
+        keepFirstFailure(errorCode, status);
+    }
+#if !UCONFIG_NO_BREAK_ITERATION
+    if (services & UWARMUP_WORD_BREAK) {
+        LocalPointer<BreakIterator> bi(BreakIterator::createWordInstance(locale, errorCode));
+        keepFirstFailure(errorCode, status);
+    }
+#endif
+#if !UCONFIG_NO_COLLATION
+    if (services & UWARMUP_COLLATOR) {
+        LocalPointer<Collator> coll(Collator::createInstance(locale, errorCode));
+        keepFirstFailure(errorCode, status);
+    }
+#endif
+}
+
+/**
+ * Copies the unqualified class name from a std::type_info name,
+ * which is implementation-defined.
+ * Handles names mangled as in the Itanium C++ ABI ("N6icu_6718SharedNumberFormatE")
+ * and readable names ("class icu_67::SharedNumberFormat").
+ */
+void copyTypeName(const char *name, char *dest, int32_t capacity) {
+    const char *start = name;
+    int32_t length = static_cast<int32_t>(uprv_strlen(name));
+    const char *p = name;
+    if (*p == 'N') {
+        ++p;
+    }
+    if ('0' <= *p && *p <= '9') {
+        // Sequence of <length><identifier>; the class name is the last one.
+        while ('0' <= *p && *p <= '9') {
+            char *end;
+            int32_t idLength = static_cast<int32_t>(uprv_strtol(p, &end, 10));
+            if (idLength <= 0 || idLength > static_cast<int32_t>(uprv_strlen(end))) {
+                break;
+            }
+            start = end;
+            length = idLength;
+            p = end + idLength;
+        }
+    } else {
+        for (const char *q = name; *q != 0; ++q) {
+            if (*q == ':' || *q == ' ') {
+                start = q + 1;
+            }
+        }
+        length = static_cast<int32_t>(uprv_strlen(start));
+    }
+    if (length >= capacity) {
+        length = capacity - 1;
+    }
+    uprv_memcpy(dest, start, length);
+    dest[length] = 0;
+}
+
+struct EntryList {
+    UWarmupCacheEntry *entries;
+    int32_t capacity;
+    int32_t count;
+};
+
+void addEntry(void *context, const CacheKeyBase &key,
+              const SharedObject *value, UErrorCode creationStatus) {
+    EntryList *list = static_cast<EntryList *>(context);
+    if (list->count < list->capacity) {
+        UWarmupCacheEntry &entry = list->entries[list->count];
+        if (value != nullptr) {
+            copyTypeName(typeid(*value).name(), entry.type, UPRV_LENGTHOF(entry.type));
+            entry.refCount = value->getRefCount();
+        } else {
+            entry.type[0] = 0;
+            entry.refCount = 0;
+        }
+        key.writeDescription(entry.key, UPRV_LENGTHOF(entry.key));
+        entry.creationStatus = creationStatus;
+    }
+    ++list->count;
+}
+
+}  // namespace
+
+U_CAPI void U_EXPORT2
+uwarmup_loadLocales(const char *const *localeIDs, int32_t count,
+                    uint32_t services, UErrorCode *status) {
+    if (status == nullptr || U_FAILURE(*status)) {
+        return;
+    }
+    if (count < 0 || (localeIDs == nullptr && count > 0)) {
+        *status = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    for (int32_t i = 0; i < count; ++i) {
+        const char *localeID = localeIDs[i];
+        if (localeID == nullptr || *localeID == 0) {
+            loadLocale(Locale::getDefault(), services, status);
+        } else {
+            loadLocale(Locale(localeID), services, status);
+        }
+    }
+}
+
+U_CAPI int32_t U_EXPORT2
+uwarmup_getCacheEntries(UWarmupCacheEntry *entries, int32_t capacity, UErrorCode *status) {
+    if (status == nullptr || U_FAILURE(*status)) {
+        return 0;
+    }
+    if (capacity < 0 || (entries == nullptr && capacity > 0)) {
+        *status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    const UnifiedCache *cache = UnifiedCache::getInstance(*status);
+    if (U_FAILURE(*status)) {
+        return 0;
+    }
+    EntryList list = { entries, capacity, 0 };
+    cache->visitEntries(addEntry, &list);
+    if (list.count > capacity) {
+        *status = U_BUFFER_OVERFLOW_ERROR;
+    }
+    return list.count;
+}
+
+#endif  // !UCONFIG_NO_FORMATTING
@@ -21,6 +21,7 @@
 #include "unicode/uloc.h"
 #include "unicode/ucnv.h"
 #include "unicode/ucnv_err.h"
+#include "unicode/ucnvpool.h"
 #include "unicode/putil.h"
 #include "unicode/uset.h"
 #include "unicode/ustring.h"
@@ -72,6 +73,7 @@ static void TestEBCDICSwapLFNL(void);
 static void TestConvertEx(void);
 static void TestConvertExFromUTF8(void);
 static void TestConvertExFromUTF8_C5F0(void);
+static void TestConvertExToUTF8(void);
 static void TestConvertAlgorithmic(void);
        void TestDefaultConverterError(void);    /* defined in cctest.c */
        void TestDefaultConverterSet(void);    /* defined in cctest.c */
@@ -83,6 +85,8 @@ static void TestSubstString(void);
 static void InvalidArguments(void);
 static void TestGetName(void);
 static void TestUTFBOM(void);
+static void TestCachePinning(void);
+static void TestConverterPool(void);
 
 void addTestConvert(TestNode** root);
 
@@ -107,6 +111,7 @@ void addTestConvert(TestNode** root)
     addTest(root, &TestConvertEx,               "tsconv/ccapitst/TestConvertEx");
     addTest(root, &TestConvertExFromUTF8,       "tsconv/ccapitst/TestConvertExFromUTF8");
     addTest(root, &TestConvertExFromUTF8_C5F0,  "tsconv/ccapitst/TestConvertExFromUTF8_C5F0");
+    addTest(root, &TestConvertExToUTF8,         "tsconv/ccapitst/TestConvertExToUTF8");
     addTest(root, &TestConvertAlgorithmic,      "tsconv/ccapitst/TestConvertAlgorithmic");
     addTest(root, &TestDefaultConverterError,   "tsconv/ccapitst/TestDefaultConverterError");
     addTest(root, &TestDefaultConverterSet,     "tsconv/ccapitst/TestDefaultConverterSet");
@@ -120,6 +125,8 @@ void addTestConvert(TestNode** root)
     addTest(root, &InvalidArguments,            "tsconv/ccapitst/InvalidArguments");
     addTest(root, &TestGetName,                 "tsconv/ccapitst/TestGetName");
     addTest(root, &TestUTFBOM,                  "tsconv/ccapitst/TestUTFBOM");
+    addTest(root, &TestCachePinning,            "tsconv/ccapitst/TestCachePinning");
+    addTest(root, &TestConverterPool,           "tsconv/ccapitst/TestConverterPool");
 }
 
 static void ListNames(void) {
@@ -2777,6 +2784,72 @@ static void TestConvertExFromUTF8_C5F0() {
     ucnv_close(utf8Cnv);
 }
 
+/*
+ * Test direct conversion from MBCS to UTF-8,
+ * mixed with sequences that need pivoting (fallbacks, unassigned, illegal, SI/SO).
+ * The expected output is computed by converting to UTF-16 first.
+ */
+static void TestConvertExToUTF8() {
+#if !UCONFIG_NO_LEGACY_CONVERSION
+    static const struct {
+        const char *name;
+        const char *bytes;
+    } cases[]={
+        /* a, U+3042, U+4E9C, U+FF61, unassigned, illegal, U+FF3C */
+        { "shift-jis", "a\x82\xa0\x88\x9f\xa1\x85\x40\x82\x39\x81\x5f" },
+        /* U+4F60, U+597D, a, U+20AC */
+        { "GBK", "\xc4\xe3\xba\xc3" "a\x80" },
+        /* U+20AC, U+00E9, A, unassigned */
+        { "windows-1252", "\x80\xe9" "A\x81" },
+        /* SI/SO-stateful EBCDIC */
+        { "ibm-930", "\xc1\x0e\x44\x5a\x45\x41\x0f\xc2" },
+        /* U+0080, U+10000, U+4E02 */
+        { "gb18030", "\x81\x30\x81\x30\x95\x32\x82\x36\x81\x40" }
+    };
+
+    UConverter *utf8Cnv, *cnv;
+    UErrorCode errorCode;
+    UChar utf16[40];
+    char expected[120];
+    int32_t i, length, utf16Length, expectedLength;
+
+    errorCode=U_ZERO_ERROR;
+    utf8Cnv=ucnv_open("UTF-8", &errorCode);
+    if(U_FAILURE(errorCode)) {
+        log_data_err("unable to open UTF-8 converter - %s\n", u_errorName(errorCode));
+        return;
+    }
+
+    for(i=0; i<UPRV_LENGTHOF(cases); ++i) {
+        errorCode=U_ZERO_ERROR;
+        cnv=ucnv_open(cases[i].name, &errorCode);
+        if(U_FAILURE(errorCode)) {
+            log_data_err("unable to open %s converter - %s\n", cases[i].name, u_errorName(errorCode));
+            continue;
+        }
+        length=(int32_t)strlen(cases[i].bytes);
+        utf16Length=ucnv_toUChars(cnv, utf16, UPRV_LENGTHOF(utf16), cases[i].bytes, length, &errorCode);
+        u_strToUTF8(expected, (int32_t)sizeof(expected), &expectedLength, utf16, utf16Length, &errorCode);
+        if(U_FAILURE(errorCode)) {
+            log_err("unable to convert %s test bytes via UTF-16 - %s\n", cases[i].name, u_errorName(errorCode));
+        } else {
+            convertExMultiStreaming(cnv, utf8Cnv,
+                                    cases[i].bytes, length,
+                                    expected, expectedLength,
+                                    cases[i].name,
+                                    U_ZERO_ERROR);
+            convertExStreaming(cnv, utf8Cnv,
+                               cases[i].bytes, length,
+                               expected, expectedLength,
+                               CHUNK_SIZE, cases[i].name,
+                               U_ZERO_ERROR);
+        }
+        ucnv_close(cnv);
+    }
+    ucnv_close(utf8Cnv);
+#endif
+}
+
 static void
 TestConvertAlgorithmic() {
 #if !UCONFIG_NO_LEGACY_CONVERSION
@@ -3756,3 +3829,105 @@ static void TestUTFBOM() {
         ucnv_close(cnv);
     }
 }
+
+static void TestCachePinning() {
+#if !UCONFIG_NO_LEGACY_CONVERSION
+    static const UChar abc[] = { 0x61, 0x62, 0x63, 0x20ac };
+    static const char expected[] = { 0x61, 0x62, 0x63, (char)0x80 };
+    char bytes[10];
+    int32_t i, length, flushCount;
+
+    /* unload unused converter data so that the next open loads and pins it */
+    ucnv_flushCache();
+
+    ucnv_setCachePinning(TRUE);
+    for (i = 0; i < 3; ++i) {
+        UErrorCode errorCode = U_ZERO_ERROR;
+        UConverter *cnv = ucnv_open("windows-1252", &errorCode);
+        if (U_FAILURE(errorCode)) {
+            log_data_err("Unable to open windows-1252 - %s\n", u_errorName(errorCode));
+            ucnv_setCachePinning(FALSE);
+            return;
+        }
+        length = ucnv_fromUChars(cnv, bytes, (int32_t)sizeof(bytes), abc, UPRV_LENGTHOF(abc), &errorCode);
+        if (U_FAILURE(errorCode) || length != 4 || 0 != memcmp(bytes, expected, length)) {
+            log_err("pinned windows-1252 converts wrongly - %s\n", u_errorName(errorCode));
+        }
+        ucnv_close(cnv);
+    }
+    ucnv_setCachePinning(FALSE);
+
+    /* pinned converter data is not unloaded */
+    if ((flushCount = ucnv_flushCache()) != 0) {
+        log_err("ucnv_flushCache() unloaded %d converters, expected 0 after pinning\n", flushCount);
+    }
+#endif
+}
+
+static void TestConverterPool() {
+#if !UCONFIG_NO_LEGACY_CONVERSION
+    static const char sjis[] = { (char)0x82, (char)0xa0 };
+    UErrorCode errorCode = U_ZERO_ERROR;
+    UConverterPool *pool;
+    UConverter *cnv1, *cnv2, *cnv3;
+    UConverterToUCallback toUAction = NULL;
+    const void *toUContext = NULL;
+    UChar u[4];
+    const char *source;
+    UChar *target;
+    int32_t length;
+
+    pool = ucnvpool_open(0, &errorCode);
+    if (errorCode != U_ILLEGAL_ARGUMENT_ERROR || pool != NULL) {
+        log_err("ucnvpool_open(0) did not fail with U_ILLEGAL_ARGUMENT_ERROR - %s\n", u_errorName(errorCode));
+    }
+    errorCode = U_ZERO_ERROR;
+    pool = ucnvpool_open(2, &errorCode);
+    if (U_FAILURE(errorCode)) {
+        log_err("ucnvpool_open(2) failed - %s\n", u_errorName(errorCode));
+        return;
+    }
+
+    cnv1 = ucnvpool_acquire(pool, "Shift_JIS", &errorCode);
+    cnv2 = ucnvpool_acquire(pool, "Shift_JIS", &errorCode);
+    if (U_FAILURE(errorCode)) {
+        log_data_err("ucnvpool_acquire(Shift_JIS) failed - %s\n", u_errorName(errorCode));
+        ucnvpool_close(pool);
+        return;
+    }
+    if (cnv1 == cnv2) {
+        log_err("ucnvpool_acquire() returned the same converter twice\n");
+    }
+
+    /* leave cnv1 with a partial character and a non-default callback */
+    ucnv_setToUCallBack(cnv1, UCNV_TO_U_CALLBACK_STOP, NULL, NULL, NULL, &errorCode);
+    source = sjis;
+    target = u;
+    ucnv_toUnicode(cnv1, &target, u + UPRV_LENGTHOF(u), &source, sjis + 1, NULL, FALSE, &errorCode);
+    if (U_FAILURE(errorCode) || ucnv_toUCountPending(cnv1, &errorCode) != 1) {
+        log_err("Shift_JIS converter did not keep a partial character - %s\n", u_errorName(errorCode));
+    }
+    ucnvpool_release(pool, cnv1);
+    ucnvpool_release(pool, cnv2);
+
+    /* an idle converter is reused, reset and with the default callback */
+    cnv3 = ucnvpool_acquire(pool, "Shift_JIS", &errorCode);
+    if (U_FAILURE(errorCode) || (cnv3 != cnv1 && cnv3 != cnv2)) {
+        log_err("ucnvpool_acquire(Shift_JIS) did not reuse an idle converter - %s\n", u_errorName(errorCode));
+    }
+    if (ucnv_toUCountPending(cnv3, &errorCode) != 0) {
+        log_err("ucnvpool_acquire() returned a converter that was not reset\n");
+    }
+    ucnv_getToUCallBack(cnv3, &toUAction, &toUContext);
+    if (toUAction != UCNV_TO_U_CALLBACK_SUBSTITUTE || toUContext != NULL) {
+        log_err("ucnvpool_acquire() returned a converter with a non-default callback\n");
+    }
+    length = ucnv_toUChars(cnv3, u, UPRV_LENGTHOF(u), sjis, 2, &errorCode);
+    if (U_FAILURE(errorCode) || length != 1 || u[0] != 0x3042) {
+        log_err("pooled Shift_JIS converter converts wrongly - %s\n", u_errorName(errorCode));
+    }
+    ucnvpool_release(pool, cnv3);
+    ucnvpool_release(pool, NULL);
+    ucnvpool_close(pool);
+#endif
+}
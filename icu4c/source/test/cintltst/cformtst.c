@@ -21,7 +21,11 @@
 
 #if !UCONFIG_NO_FORMATTING
 
+#include <string.h>
+
+#include "unicode/uwarmup.h"
 #include "cintltst.h"
+#include "cmemory.h"
 #include "cformtst.h"
 
 void addCalTest(TestNode**);
@@ -44,6 +48,8 @@ void addUFormattedValueTest(TestNode** root);
 
 void addFormatTest(TestNode** root);
 
+static void TestWarmup(void);
+
 void addFormatTest(TestNode** root)
 {
     addCalTest(root);
@@ -65,6 +71,78 @@ void addFormatTest(TestNode** root)
     addUListFmtTest(root);
     addUNumberFormatterTest(root);
     addUFormattedValueTest(root);
+    addTest(root, &TestWarmup, "tsformat/cformtst/TestWarmup");
+}
+
+static UBool hasCacheEntry(const UWarmupCacheEntry *entries, int32_t count,
+                           const char *type, const char *keyPrefix) {
+    int32_t i;
+    for (i = 0; i < count; ++i) {
+        if (strcmp(entries[i].type, type) == 0 &&
+                strncmp(entries[i].key, keyPrefix, strlen(keyPrefix)) == 0 &&
+                U_SUCCESS(entries[i].creationStatus)) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+static void TestWarmup() {
+    static const char *const locales[] = { "de_CH", "ja" };
+    UErrorCode status = U_ZERO_ERROR;
+    UWarmupCacheEntry *entries;
+    int32_t count, length;
+
+    uwarmup_loadLocales(NULL, -1, UWARMUP_ALL_SERVICES, &status);
+    if (status != U_ILLEGAL_ARGUMENT_ERROR) {
+        log_err("uwarmup_loadLocales(count=-1) - %s\n", u_errorName(status));
+    }
+    status = U_ZERO_ERROR;
+    uwarmup_loadLocales(NULL, 1, UWARMUP_ALL_SERVICES, &status);
+    if (status != U_ILLEGAL_ARGUMENT_ERROR) {
+        log_err("uwarmup_loadLocales(NULL, 1) - %s\n", u_errorName(status));
+    }
+    status = U_ZERO_ERROR;
+    uwarmup_loadLocales(locales, UPRV_LENGTHOF(locales), UWARMUP_ALL_SERVICES, &status);
+    if (U_FAILURE(status)) {
+        log_data_err("uwarmup_loadLocales(de_CH, ja) - %s (Are you missing data?)\n",
+                     u_errorName(status));
+        return;
+    }
+
+    count = uwarmup_getCacheEntries(NULL, 0, &status);
+    if (status != U_BUFFER_OVERFLOW_ERROR || count <= 0) {
+        log_err("uwarmup_getCacheEntries() preflighting returned %d - %s\n",
+                (int)count, u_errorName(status));
+        return;
+    }
+    entries = (UWarmupCacheEntry *)malloc(count * sizeof(UWarmupCacheEntry));
+    if (entries == NULL) {
+        log_err("out of memory\n");
+        return;
+    }
+    status = U_ZERO_ERROR;
+    length = uwarmup_getCacheEntries(entries, count, &status);
+    if (U_FAILURE(status) || length != count) {
+        log_err("uwarmup_getCacheEntries() returned %d - %s\n", (int)length, u_errorName(status));
+    } else {
+        if (!hasCacheEntry(entries, length, "SharedNumberFormat", "de_CH") ||
+                !hasCacheEntry(entries, length, "SharedNumberFormat", "ja")) {
+            log_err("no cached number formats for de_CH and ja\n");
+        }
+        if (!hasCacheEntry(entries, length, "SharedPluralRules", "de_CH")) {
+            log_err("no cached plural rules for de_CH\n");
+        }
+        if (!hasCacheEntry(entries, length, "SharedDateFormatSymbols", "ja")) {
+            log_err("no cached date format symbols for ja\n");
+        }
+#if !UCONFIG_NO_COLLATION
+        if (!hasCacheEntry(entries, length, "CollationCacheEntry", "ja")) {
+            log_err("no cached collation data for ja\n");
+        }
+#endif
+    }
+    free(entries);
 }
 /*Internal functions used*/
 
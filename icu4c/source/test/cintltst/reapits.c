@@ -171,6 +171,8 @@ static void TestUTextAPI(void);
 static void TestRefreshInput(void);
 static void TestBug8421(void);
 static void TestBug10815(void);
+static void TestRegexSetCAPI(void);
+static void TestUTF8Text(void);
 
 void addURegexTest(TestNode** root);
 
@@ -182,6 +184,8 @@ void addURegexTest(TestNode** root)
     addTest(root, &TestRefreshInput, "regex/TestRefreshInput");
     addTest(root, &TestBug8421,   "regex/TestBug8421");
     addTest(root, &TestBug10815,   "regex/TestBug10815");
+    addTest(root, &TestRegexSetCAPI, "regex/TestRegexSetCAPI");
+    addTest(root, &TestUTF8Text,  "regex/TestUTF8Text");
 }
 
 /*
@@ -2320,5 +2324,105 @@ static void TestBug10815() {
     uregex_close(re);
 }
 
+
+static void TestRegexSetCAPI(void) {
+    URegexSet *set;
+    UErrorCode status = U_ZERO_ERROR;
+    UParseError pe;
+    UChar    patterns[4][20];
+    const UChar *patternPtrs[4];
+    int32_t  patternLengths[4] = {-1, -1, -1, 2};
+    UChar    text[100];
+    int32_t  indexes[4];
+    int32_t  count;
+    int32_t  i;
+
+    u_uastrncpy(patterns[0], "abc", UPRV_LENGTHOF(patterns[0]));
+    u_uastrncpy(patterns[1], "[0-9]+", UPRV_LENGTHOF(patterns[1]));
+    u_uastrncpy(patterns[2], "(x)\\1", UPRV_LENGTHOF(patterns[2]));   /* needs backtracking */
+    u_uastrncpy(patterns[3], "zzz", UPRV_LENGTHOF(patterns[3]));       /* length 2, "zz" */
+    for (i = 0; i < 4; i++) {
+        patternPtrs[i] = patterns[i];
+    }
+    set = uregex_openSet(patternPtrs, patternLengths, 4, 0, &pe, &status);
+    TEST_ASSERT_SUCCESS(status);
+
+    u_uastrncpy(text, "xx 123 abzz", UPRV_LENGTHOF(text));
+    count = uregex_findSet(set, text, -1, indexes, UPRV_LENGTHOF(indexes), &status);
+    TEST_ASSERT_SUCCESS(status);
+    TEST_ASSERT(count == 3);
+    TEST_ASSERT(indexes[0] == 1 && indexes[1] == 2 && indexes[2] == 3);
+
+    /* Preflighting, and a text length. */
+    count = uregex_findSet(set, text, 6, indexes, 1, &status);
+    TEST_ASSERT(status == U_BUFFER_OVERFLOW_ERROR);
+    TEST_ASSERT(count == 2);
+    TEST_ASSERT(indexes[0] == 1);
+
+    status = U_ZERO_ERROR;
+    u_uastrncpy(text, "ab c", UPRV_LENGTHOF(text));
+    count = uregex_findSet(set, text, -1, NULL, 0, &status);
+    TEST_ASSERT_SUCCESS(status);
+    TEST_ASSERT(count == 0);
+
+    uregex_closeSet(set);
+
+    /* A syntax error in any of the patterns. */
+    u_uastrncpy(patterns[1], "[0-9", UPRV_LENGTHOF(patterns[1]));
+    set = uregex_openSet(patternPtrs, NULL, 3, 0, &pe, &status);
+    TEST_ASSERT(status == U_REGEX_MISSING_CLOSE_BRACKET);
+    TEST_ASSERT(set == NULL);
+}
+
+/*
+ * uregex_setUTF8Text().  Match positions are byte offsets into the UTF-8 text.
+ */
+static void TestUTF8Text(void) {
+    /* "Un caf\u00e9, deux CAF\u00c9S." */
+    static const char text[] = "Un caf\xC3\xA9, deux CAF\xC3\x89S.";
+    UErrorCode status = U_ZERO_ERROR;
+    URegularExpression *re;
+    UChar    pat[20];
+    UChar    expected[30];
+    const UChar *resultText;
+    int32_t  resultLength;
+
+    u_uastrncpy(pat, "(?i)caf(\\u00e9)", UPRV_LENGTHOF(pat));
+    re = uregex_open(pat, -1, 0, NULL, &status);
+    TEST_ASSERT_SUCCESS(status);
+
+    uregex_setUTF8Text(re, text, -1, &status);
+    TEST_ASSERT_SUCCESS(status);
+    TEST_ASSERT(uregex_findNext(re, &status));
+    TEST_ASSERT(uregex_start(re, 0, &status) == 3);
+    TEST_ASSERT(uregex_end(re, 0, &status) == 8);
+    TEST_ASSERT(uregex_start(re, 1, &status) == 6);
+    TEST_ASSERT(uregex_findNext(re, &status));
+    TEST_ASSERT(uregex_start(re, 0, &status) == 15);
+    TEST_ASSERT(uregex_end(re, 0, &status) == 20);
+    TEST_ASSERT(uregex_start(re, 1, &status) == 18);
+    TEST_ASSERT(uregex_findNext(re, &status) == FALSE);
+    TEST_ASSERT_SUCCESS(status);
+
+    /* The text can be retrieved as UTF-16. */
+    u_unescape("Un caf\\u00e9, deux CAF\\u00c9S.", expected, UPRV_LENGTHOF(expected));
+    resultText = uregex_getText(re, &resultLength, &status);
+    TEST_ASSERT_SUCCESS(status);
+    TEST_ASSERT(resultLength == 20);
+    TEST_ASSERT(resultText != NULL && u_strncmp(resultText, expected, 20) == 0);
+
+    /* A text length, in bytes. */
+    uregex_setUTF8Text(re, text + 3, 5, &status);
+    TEST_ASSERT_SUCCESS(status);
+    TEST_ASSERT(uregex_matches(re, 0, &status));
+    TEST_ASSERT(uregex_end(re, 0, &status) == 5);
+    TEST_ASSERT_SUCCESS(status);
+
+    uregex_setUTF8Text(re, NULL, 0, &status);
+    TEST_ASSERT(status == U_ILLEGAL_ARGUMENT_ERROR);
+
+    uregex_close(re);
+}
+
     
 #endif   /*  !UCONFIG_NO_REGULAR_EXPRESSIONS */
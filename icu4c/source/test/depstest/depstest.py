@@ -112,6 +112,9 @@ def _ReadLibrary(root_path, library_name):
   ("common/umutex.o", "__once_proxy"),
   ("common/umutex.o", "__tls_get_addr"),
   ("common/unifiedcache.o", "std::__throw_system_error(int)"),
+  ("common/ucnvpool.o", "std::__throw_system_error(int)"),
+  ("i18n/dtptngen.o", "std::__throw_system_error(int)"),
+  ("i18n/reldatefmt.o", "std::__throw_system_error(int)"),
 )
 
 def _Resolve(name, parents):
@@ -22,6 +22,8 @@
 #include "cstring.h"
 #include "unicode/localpointer.h"
 #include "islamcal.h"
+#include "gregoimp.h"
+#include "uvectr64.h"
 
 #define mkcstr(U) u_austrcpy(calloc(8, u_strlen(U) + 1), U)
 
@@ -346,6 +348,13 @@ void CalendarTest::runIndexedTest( int32_t index, UBool exec, const char* &name,
             TestChineseCalendarMapping();
           }
           break;
+        case 37:
+          name = "TestGregorianLocalTime";
+          if(exec) {
+            logln("TestGregorianLocalTime---"); logln("");
+            TestGregorianLocalTime();
+          }
+          break;
         default: name = ""; break;
     }
 }
@@ -2089,7 +2098,6 @@ void CalendarTest::TestYWOY()
 void CalendarTest::TestJD()
 {
   int32_t jd;
-  static const int32_t kEpochStartAsJulianDay = 2440588;
   UErrorCode status = U_ZERO_ERROR;
   GregorianCalendar cal(status);
   if (failure(status, "construct GregorianCalendar", TRUE)) return;
@@ -3724,6 +3732,72 @@ void CalendarTest::TestChineseCalendarMapping() {
     }
 }
 
+/**
+ * GregorianLocalTime computes the same fields as a proleptic GregorianCalendar in UTC.
+ */
+void CalendarTest::TestGregorianLocalTime() {
+    UErrorCode status = U_ZERO_ERROR;
+    GregorianCalendar cal(TimeZone::createTimeZone(u"UTC"), Locale::getEnglish(), status);
+    if (failure(status, "new GregorianCalendar", TRUE)) {
+        return;
+    }
+    cal.setGregorianChange(MIN_MILLIS, status);
+
+    // Every 13 days and some hours through 20,000 years, every leap day near
+    // years that are divisible by 100, and a few dates far away.
+    UVector64 dates(status);
+    for (double date = -377705116800000.0; date < 253402300800000.0; date += 13 * kOneDay + 7654321) {
+        dates.addElement((int64_t)date, status);
+    }
+    for (int32_t year = -1200; year <= 2800; year += 100) {
+        for (int32_t delta = -1; delta <= 1; ++delta) {
+            cal.clear();
+            cal.set(UCAL_EXTENDED_YEAR, year + delta);
+            cal.set(UCAL_MONTH, UCAL_FEBRUARY);
+            cal.set(UCAL_DATE, 28);
+            int64_t date = (int64_t)cal.getTime(status);
+            for (int32_t day = 0; day <= 2; ++day) {
+                dates.addElement(date + day * U_MILLIS_PER_DAY - 1, status);
+                dates.addElement(date + day * U_MILLIS_PER_DAY, status);
+            }
+        }
+    }
+    dates.addElement((int64_t)-1.5e17, status);
+    dates.addElement((int64_t)1.5e17, status);
+    if (failure(status, "collecting dates")) {
+        return;
+    }
+
+    for (int32_t i = 0; i < dates.size(); ++i) {
+        UDate date = (UDate)dates.elementAti(i);
+        GregorianLocalTime lt(date);
+        cal.setTime(date, status);
+        int32_t year = cal.get(UCAL_EXTENDED_YEAR, status);
+        int32_t month = cal.get(UCAL_MONTH, status);
+        int32_t dom = cal.get(UCAL_DATE, status);
+        int32_t dow = cal.get(UCAL_DAY_OF_WEEK, status);
+        int32_t doy = cal.get(UCAL_DAY_OF_YEAR, status);
+        int32_t millis = cal.get(UCAL_MILLISECONDS_IN_DAY, status);
+        if (failure(status, "GregorianCalendar::get()")) {
+            return;
+        }
+        if (lt.getExtendedYear() != year || lt.getMonth() != month || lt.getDayOfMonth() != dom ||
+                lt.getDayOfWeek() != dow || lt.getDayOfYear() != doy || lt.getMillisInDay() != millis) {
+            errln("GregorianLocalTime(%.0f) = %d-%d-%d dow %d doy %d millis %d but GregorianCalendar "
+                  "has %d-%d-%d dow %d doy %d millis %d",
+                  date, lt.getExtendedYear(), lt.getMonth() + 1, lt.getDayOfMonth(), lt.getDayOfWeek(),
+                  lt.getDayOfYear(), lt.getMillisInDay(), year, month + 1, dom, dow, doy, millis);
+            return;
+        }
+        if (lt.getHourOfDay() != millis / U_MILLIS_PER_HOUR ||
+                lt.getMinute() * U_MILLIS_PER_MINUTE + lt.getSecond() * U_MILLIS_PER_SECOND +
+                        lt.getMillisecond() != millis % U_MILLIS_PER_HOUR) {
+            errln("GregorianLocalTime(%.0f) has an inconsistent time of day", date);
+            return;
+        }
+    }
+}
+
 #endif /* #if !UCONFIG_NO_FORMATTING */
 
 //eof
@@ -109,6 +109,14 @@ void CharsetDetectionTest::runIndexedTest( int32_t index, UBool exec, const char
             if (exec) Ticket6954Test();
             break;
 
+       case 10: name = "FastDetectionTest";
+            if (exec) FastDetectionTest();
+            break;
+
+       case 11: name = "ReuseDetectorTest";
+            if (exec) ReuseDetectorTest();
+            break;
+
         default: name = "";
             break; //needed to end loop
     }
@@ -234,6 +242,68 @@ void CharsetDetectionTest::checkEncoding(const UnicodeString &testString, const
     delete[] decoded;
 }
 
+// Fast detection must agree with full detection on the top match,
+// except that 7-bit input may be reported as UTF-8.
+void CharsetDetectionTest::checkFastDetection(const UnicodeString &testString, const UnicodeString &encoding, const UnicodeString &id)
+{
+    int32_t splits = 0;
+    int32_t testLength = testString.length();
+    std::unique_ptr<UnicodeString []> eSplit(split(encoding, CH_SLASH, splits));
+    UErrorCode status = U_ZERO_ERROR;
+    int32_t cpLength = eSplit[0].length();
+    char codepage[64];
+
+    u_UCharsToChars(eSplit[0].getBuffer(), codepage, cpLength);
+    codepage[cpLength] = '\0';
+
+    int32_t byteLength = 0;
+    std::unique_ptr<char []> bytes(extractBytes(testString, codepage, byteLength));
+
+    if (! bytes) {
+        // checkEncoding() already reported this.
+        return;
+    }
+
+    LocalUCharsetDetectorPointer fullCsd(ucsdet_open(&status));
+    LocalUCharsetDetectorPointer fastCsd(ucsdet_open(&status));
+    TEST_ASSERT_SUCCESS(status);
+    TEST_ASSERT(!ucsdet_enableFastDetection(fastCsd.getAlias(), TRUE));
+    TEST_ASSERT(ucsdet_isFastDetectionEnabled(fastCsd.getAlias()));
+
+    ucsdet_setText(fullCsd.getAlias(), bytes.get(), byteLength, &status);
+    ucsdet_setText(fastCsd.getAlias(), bytes.get(), byteLength, &status);
+    const UCharsetMatch *fullMatch = ucsdet_detect(fullCsd.getAlias(), &status);
+    const UCharsetMatch *fastMatch = ucsdet_detect(fastCsd.getAlias(), &status);
+    TEST_ASSERT_SUCCESS(status);
+    if (fullMatch == NULL || fastMatch == NULL) {
+        errln("Fast detection test for " + id + ", " + eSplit[0] + ": no match");
+        return;
+    }
+
+    UBool is7Bit = TRUE;
+    for (int32_t i = 0; i < byteLength; i += 1) {
+        if ((uint8_t)bytes[i] >= 0x80) {
+            is7Bit = FALSE;
+            break;
+        }
+    }
+    UnicodeString fullName(ucsdet_getName(fullMatch, &status));
+    UnicodeString fastName(ucsdet_getName(fastMatch, &status));
+    if (fastName.compare(fullName) != 0 &&
+            !(is7Bit && fastName.compare(UNICODE_STRING_SIMPLE("UTF-8")) == 0)) {
+        errln("Fast detection failure for " + id + ", " + eSplit[0] + ": expected " + fullName + ", got " + fastName);
+        return;
+    }
+
+    // Only a prefix is examined, but the whole text is converted.
+    std::unique_ptr<UChar []> decoded(new UChar[testLength]);
+    int32_t dLength = ucsdet_getUChars(fastMatch, decoded.get(), testLength, &status);
+    TEST_ASSERT_SUCCESS(status);
+    if (testString.compare(decoded.get(), dLength) != 0) {
+        errln("Round-trip error for " + id + ", " + eSplit[0] + ": getUChars() after fast detection didn't yield the original string.");
+    }
+}
+
 const char *CharsetDetectionTest::getPath(char buffer[2048], const char *filename) {
     UErrorCode status = U_ZERO_ERROR;
     const char *testDataDirectory = IntlTest::getSourceTestData(status);
@@ -839,3 +909,97 @@ void CharsetDetectionTest::Ticket6954Test() {
     TEST_ASSERT(strcmp(name1, "windows-1252")==0);
 #endif
 }
+
+void CharsetDetectionTest::FastDetectionTest() {
+#if !UCONFIG_NO_REGULAR_EXPRESSIONS
+    UErrorCode status = U_ZERO_ERROR;
+    char path[2048];
+    const char *testFilePath = getPath(path, "csdetest.xml");
+
+    if (testFilePath == NULL) {
+        return; /* Couldn't get path: error message already output. */
+    }
+
+    LocalPointer<UXMLParser> parser(UXMLParser::createParser(status));
+    if (U_FAILURE(status)) {
+        dataerrln("FAIL: UXMLParser::createParser (%s)", u_errorName(status));
+        return;
+    }
+
+    LocalPointer<UXMLElement> root(parser->parseFile(testFilePath, status));
+    if (!assertSuccess( "parseFile",status)) return;
+
+    UnicodeString test_case = UNICODE_STRING_SIMPLE("test-case");
+    UnicodeString id_attr   = UNICODE_STRING_SIMPLE("id");
+    UnicodeString enc_attr  = UNICODE_STRING_SIMPLE("encodings");
+
+    const UXMLElement *testCase;
+    int32_t tc = 0;
+
+    while((testCase = root->nextChildElement(tc)) != NULL) {
+        if (testCase->getTagName().compare(test_case) == 0) {
+            const UnicodeString *id = testCase->getAttribute(id_attr);
+            const UnicodeString *encodings = testCase->getAttribute(enc_attr);
+            const UnicodeString  text = testCase->getText(TRUE);
+            int32_t encodingCount;
+            std::unique_ptr<UnicodeString []> encodingList(split(*encodings, CH_SPACE, encodingCount));
+
+            for(int32_t e = 0; e < encodingCount; e += 1) {
+                checkFastDetection(text, encodingList[e], *id);
+            }
+        }
+    }
+
+    // A long text is detected from its prefix, and is still converted completely.
+    UnicodeString longText;
+    for (int32_t i = 0; i < 2000; i += 1) {
+        longText.append(UNICODE_STRING_SIMPLE("Gr\\u00FC\\u00DFe aus K\\u00F6ln. ").unescape());
+    }
+    checkFastDetection(longText, UNICODE_STRING_SIMPLE("UTF-8"), UNICODE_STRING_SIMPLE("long text"));
+    checkFastDetection(longText, UNICODE_STRING_SIMPLE("ISO-8859-1"), UNICODE_STRING_SIMPLE("long text"));
+#endif
+}
+
+// The single-byte charset recognizers share n-gram scores that are computed once per input.
+// A detector that is reused for different texts must give the same results as new detectors.
+void CharsetDetectionTest::ReuseDetectorTest() {
+#if !UCONFIG_NO_LEGACY_CONVERSION
+    static const struct {
+        const char *text;
+        const char *codepage;
+    } cases[] = {
+        { "Die W\\u00FCrde des Menschen ist unantastbar. Sie zu achten und zu sch\\u00FCtzen ist Verpflichtung aller staatlichen Gewalt.", "ISO-8859-1" },
+        { "\\u0412\\u0441\\u0435 \\u043B\\u044E\\u0434\\u0438 \\u0440\\u043E\\u0436\\u0434\\u0430\\u044E\\u0442\\u0441\\u044F \\u0441\\u0432\\u043E\\u0431\\u043E\\u0434\\u043D\\u044B\\u043C\\u0438 \\u0438 \\u0440\\u0430\\u0432\\u043D\\u044B\\u043C\\u0438 \\u0432 \\u0441\\u0432\\u043E\\u0435\\u043C \\u0434\\u043E\\u0441\\u0442\\u043E\\u0438\\u043D\\u0441\\u0442\\u0432\\u0435 \\u0438 \\u043F\\u0440\\u0430\\u0432\\u0430\\u0445.", "windows-1251" },
+        { "Wszyscy ludzie rodz\\u0105 si\\u0119 wolni i r\\u00F3wni pod wzgl\\u0119dem swej godno\\u015Bci i swych praw.", "ISO-8859-2" },
+        { "Le gar\\u00E7on a mang\\u00E9 une pomme \\u00E0 la for\\u00EAt. C'est tr\\u00E8s bien, n'est-ce pas?", "ISO-8859-1" },
+    };
+    UErrorCode status = U_ZERO_ERROR;
+    LocalUCharsetDetectorPointer reused(ucsdet_open(&status));
+    TEST_ASSERT_SUCCESS(status);
+
+    for (int32_t i = 0; i < UPRV_LENGTHOF(cases); i += 1) {
+        UnicodeString text = UnicodeString(cases[i].text, -1, US_INV).unescape();
+        int32_t length = 0;
+        std::unique_ptr<char[]> bytes(extractBytes(text, cases[i].codepage, length));
+        if (!bytes) {
+            dataerrln("Can't open a %s converter", cases[i].codepage);
+            return;
+        }
+
+        LocalUCharsetDetectorPointer fresh(ucsdet_open(&status));
+        ucsdet_setText(fresh.getAlias(), bytes.get(), length, &status);
+        ucsdet_setText(reused.getAlias(), bytes.get(), length, &status);
+        int32_t freshCount = 0, reusedCount = 0;
+        const UCharsetMatch **freshMatches = ucsdet_detectAll(fresh.getAlias(), &freshCount, &status);
+        const UCharsetMatch **reusedMatches = ucsdet_detectAll(reused.getAlias(), &reusedCount, &status);
+        TEST_ASSERT_SUCCESS(status);
+        assertEquals(UnicodeString("match count for ") + cases[i].codepage, freshCount, reusedCount);
+        for (int32_t m = 0; m < freshCount && m < reusedCount; m += 1) {
+            assertEquals("name", ucsdet_getName(freshMatches[m], &status), ucsdet_getName(reusedMatches[m], &status));
+            assertEquals("confidence", ucsdet_getConfidence(freshMatches[m], &status),
+                         ucsdet_getConfidence(reusedMatches[m], &status));
+        }
+        TEST_ASSERT(strcmp(ucsdet_getName(reusedMatches[0], &status), cases[i].codepage) == 0);
+    }
+#endif
+}
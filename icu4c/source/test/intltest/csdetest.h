@@ -33,10 +33,14 @@ class CharsetDetectionTest: public IntlTest {
     virtual void IBM420Test();
     virtual void Ticket6394Test();
     virtual void Ticket6954Test();
+    virtual void FastDetectionTest();
+    virtual void ReuseDetectorTest();
 
 private:
     void checkEncoding(const UnicodeString &testString,
                        const UnicodeString &encoding, const UnicodeString &id);
+    void checkFastDetection(const UnicodeString &testString,
+                            const UnicodeString &encoding, const UnicodeString &id);
 
     virtual const char *getPath(char buffer[2048], const char *filename);
 
@@ -23,6 +23,8 @@
 #include "cmemory.h"
 #include "cstring.h"
 #include "caltest.h"  // for fieldName
+#include "cstr.h"
+#include <utility>
 #include <stdio.h> // for sprintf
 
 #if U_PLATFORM_USES_ONLY_WIN32_API
@@ -129,6 +131,10 @@ void DateFormatTest::runIndexedTest( int32_t index, UBool exec, const char* &nam
     TESTCASE_AUTO(TestParseRegression13744);
     TESTCASE_AUTO(TestAdoptCalendarLeak);
     TESTCASE_AUTO(Test20741_ABFields);
+    TESTCASE_AUTO(TestCompiledPattern);
+    TESTCASE_AUTO(TestCompiledDateFormatter);
+    TESTCASE_AUTO(TestCompiledDateFormatterBatch);
+    TESTCASE_AUTO(TestCompiledDateFormatterCutoverYear);
 
     TESTCASE_AUTO_END;
 }
@@ -5631,6 +5637,360 @@ void DateFormatTest::Test20741_ABFields() {
     }
 }
 
+/**
+ * Test that the pattern compiled for formatting splits literal text and fields
+ * the same way as the pattern was interpreted on each format() call,
+ * and that it follows pattern changes.
+ */
+void DateFormatTest::TestCompiledPattern() {
+    IcuTestErrorCode status(*this, "TestCompiledPattern");
+    // 2020-03-04 05:06:07.089 GMT
+    const UDate date = 1583298367089.0;
+    static const struct {
+        const char16_t *pattern;
+        const char16_t *expected;
+    } cases[] = {
+        { u"yyyy-MM-dd'T'HH:mm:ss.SSSXXX", u"2020-03-04T05:06:07.089Z" },
+        { u"yyyy-MM-dd HH:mm:ss,SSS", u"2020-03-04 05:06:07,089" },
+        { u"HHmmssSSS", u"050607089" },
+        { u"'o''clock' h a", u"o'clock 5 AM" },
+        { u"''yy''", u"'20'" },
+        { u"'yyyy' y", u"yyyy 2020" },
+        { u"'It''s' EEEE'!'", u"It's Wednesday!" },
+        { u"ddd", u"004" },
+        { u"", u"" },
+    };
+    SimpleDateFormat fmt(u"y", Locale::getEnglish(), status);
+    if (status.errDataIfFailureAndReset("SimpleDateFormat constructor")) {
+        return;
+    }
+    fmt.adoptTimeZone(TimeZone::createTimeZone(u"GMT"));
+    UnicodeString result;
+    for (const auto &cas : cases) {
+        fmt.applyPattern(cas.pattern);
+        assertEquals(UnicodeString(u"applyPattern ") + cas.pattern,
+                     cas.expected, fmt.format(date, result.remove()));
+
+        SimpleDateFormat copy(fmt);
+        assertEquals(UnicodeString(u"copy ") + cas.pattern,
+                     cas.expected, copy.format(date, result.remove()));
+
+        // applyLocalizedPattern() with the localized form of the same pattern
+        SimpleDateFormat localized(u"ss", Locale::getEnglish(), status);
+        localized.adoptTimeZone(TimeZone::createTimeZone(u"GMT"));
+        UnicodeString localizedPattern;
+        fmt.toLocalizedPattern(localizedPattern, status);
+        localized.applyLocalizedPattern(localizedPattern, status);
+        assertEquals(UnicodeString(u"applyLocalizedPattern ") + cas.pattern,
+                     cas.expected, localized.format(date, result.remove()));
+    }
+
+    // An unterminated quote extends to the end of the pattern.
+    fmt.applyPattern(u"d MMM 'unterminated");
+    assertEquals("unterminated quote", u"4 Mar unterminated", fmt.format(date, result.remove()));
+
+    // Literal text longer than a compiled item can hold.
+    UnicodeString dashes;
+    for (int32_t i = 0; i < 40000; ++i) {
+        dashes.append(u'-');
+    }
+    fmt.applyPattern(UnicodeString(u"y") + dashes + u"M");
+    assertEquals("long literal", UnicodeString(u"2020") + dashes + u"3",
+                 fmt.format(date, result.remove()));
+}
+
+/**
+ * Test that CompiledDateFormatter formats like a SimpleDateFormat with the same
+ * pattern, both where it computes the Gregorian fields itself and where it
+ * falls back to a Calendar.
+ */
+void DateFormatTest::TestCompiledDateFormatter() {
+    IcuTestErrorCode status(*this, "TestCompiledDateFormatter");
+    static const char16_t *const patterns[] = {
+        u"yyyy-MM-dd'T'HH:mm:ss.SSSXXX",
+        u"yyyy-MM-dd HH:mm:ss,SSS",
+        u"G y yy yyy yyyyy M MM MMM MMMM MMMMM L LLL LLLL d dd",
+        u"GGGG GGGGG D DDD F E EEEE EEEEE EEEEEE Q QQQ QQQQ q qqq qqqq",
+        u"h hh H HH k kk K KK m mm s ss S SS SSSS A a aaaaa",
+        u"z zzzz Z ZZZZ ZZZZZ v vvvv V VV VVV VVVV O OOOO",
+        u"X XX XXX XXXX XXXXX x xx xxx xxxx xxxxx",
+        u"'week' w W Y e c",  // needs a Calendar
+        u"h:mm B",  // needs a Calendar
+    };
+    static const char *const locales[] = {
+        "en", "de", "ar", "ja", "en@calendar=buddhist", "he@calendar=gregorian"
+    };
+    static const char16_t *const zones[] = {
+        u"UTC", u"America/Los_Angeles", u"Asia/Kolkata", u"Australia/Lord_Howe"
+    };
+    static const UDate dates[] = {
+        0.0,
+        1583298367089.0,    // 2020-03-04 05:06:07.089 UTC
+        1604215800000.0,    // 2020-11-01 07:30 UTC, around the Los Angeles DST end
+        951782400000.0,     // 2000-02-29
+        -12219292800000.0,  // the Gregorian cutover
+        -12220000000000.0,  // before the cutover
+        -62198755200000.0,  // 1 BC
+        4102444799999.0,    // 2099-12-31 23:59:59.999 UTC
+    };
+    for (const char *localeID : locales) {
+        for (const char16_t *pattern : patterns) {
+            SimpleDateFormat sdf(pattern, Locale(localeID), status);
+            if (status.errDataIfFailureAndReset("SimpleDateFormat(%s)", localeID)) {
+                return;
+            }
+            CompiledDateFormatter cdf = sdf.compile(status);
+            status.errIfFailureAndReset("compile()");
+            for (const char16_t *zoneID : zones) {
+                LocalPointer<TimeZone> zone(TimeZone::createTimeZone(zoneID));
+                sdf.setTimeZone(*zone);
+                for (UDate date : dates) {
+                    UnicodeString expected, actual;
+                    sdf.format(date, expected);
+                    cdf.format(date, *zone, actual, status);
+                    UnicodeString message = UnicodeString(localeID, -1, US_INV) + u" " +
+                        zoneID + u" " + pattern;
+                    if (status.errIfFailureAndReset("%s", CStr(message)())) {
+                        continue;
+                    }
+                    assertEquals(message, expected, actual);
+
+                    char16_t buffer[200];
+                    int32_t length = cdf.format(date, *zone, buffer, UPRV_LENGTHOF(buffer), status);
+                    if (!status.errIfFailureAndReset("%s into a buffer", CStr(message)())) {
+                        assertEquals(message + u" into a buffer", expected, UnicodeString(buffer, length));
+                    }
+                }
+            }
+        }
+    }
+
+    // Copies share the data. Preflighting and buffer overflow.
+    CompiledDateFormatter cdf = CompiledDateFormatter::forPattern(
+        u"yyyy-MM-dd'T'HH:mm:ss.SSSXXX", Locale::getRoot(), status);
+    if (status.errDataIfFailureAndReset("forPattern()")) {
+        return;
+    }
+    CompiledDateFormatter copy(cdf);
+    CompiledDateFormatter moved(std::move(copy));
+    LocalPointer<TimeZone> utc(TimeZone::createTimeZone(u"UTC"));
+    UnicodeString result;
+    assertEquals("moved copy", u"1970-01-01T00:00:00.000Z", moved.format(0.0, *utc, result, status));
+    int32_t length = cdf.format(0.0, *utc, nullptr, 0, status);
+    assertEquals("preflight length", 24, length);
+    assertEquals("preflight error", U_BUFFER_OVERFLOW_ERROR, status.reset());
+    char16_t buffer[24];
+    length = cdf.format(0.0, *utc, buffer, UPRV_LENGTHOF(buffer), status);
+    assertEquals("exact fit", U_STRING_NOT_TERMINATED_WARNING, status.reset());
+    assertEquals("exact fit string", u"1970-01-01T00:00:00.000Z", UnicodeString(buffer, length));
+
+    // An empty formatter.
+    CompiledDateFormatter empty;
+    empty.format(0.0, *utc, result.remove(), status);
+    assertEquals("empty formatter", U_INVALID_STATE_ERROR, status.reset());
+}
+
+/**
+ * Test that CompiledDateFormatter::formatDates() and parseDates() agree with
+ * SimpleDateFormat, for fixed-width numeric patterns and for others.
+ */
+void DateFormatTest::TestCompiledDateFormatterBatch() {
+    IcuTestErrorCode status(*this, "TestCompiledDateFormatterBatch");
+    static const char16_t *const patterns[] = {
+        u"yyyy-MM-dd'T'HH:mm:ss.SSSXXX",
+        u"yyyy-MM-dd HH:mm:ss,SSS",
+        u"yyyyMMdd'T'HHmmss.SSX",
+        u"dd.MM.yyyy HH:mm:ss.S xx Z",
+        u"yyyy-MM-dd'T'HH:mm:ssZZZ",
+        u"yyyy-MM-dd'T'HH:mmx",
+        u"EEE, d MMM yyyy HH:mm:ss zzz",  // not fixed-width
+    };
+    static const char *const locales[] = { "en", "ar", "en@calendar=buddhist" };
+    static const char16_t *const zones[] = {
+        u"UTC", u"America/Los_Angeles", u"Asia/Kolkata", u"Australia/Lord_Howe", u"Africa/Monrovia"
+    };
+    // Dates from 1965 to 2030, and some outside of the fixed-width range.
+    UDate dates[120];
+    int32_t count = 0;
+    for (UDate date = -157766400000.0; count < 114; date += 17280123456.0 + count * 79.0) {
+        dates[count++] = date;
+    }
+    dates[count++] = 1604215800000.0;     // 2020-11-01 07:30 UTC, around the Los Angeles DST end
+    dates[count++] = 1604219400000.0;     // an hour later
+    dates[count++] = -12219292800000.0;   // the Gregorian cutover
+    dates[count++] = -62198755200000.0;   // 1 BC
+    dates[count++] = 253402300800000.0;   // 10000-01-01
+    dates[count++] = 951782400000.0;      // 2000-02-29
+    for (const char *localeID : locales) {
+        for (const char16_t *pattern : patterns) {
+            SimpleDateFormat sdf(pattern, Locale(localeID), status);
+            if (status.errDataIfFailureAndReset("SimpleDateFormat(%s)", localeID)) {
+                return;
+            }
+            CompiledDateFormatter cdf = sdf.compile(status);
+            status.errIfFailureAndReset("compile()");
+            for (const char16_t *zoneID : zones) {
+                LocalPointer<TimeZone> zone(TimeZone::createTimeZone(zoneID));
+                sdf.setTimeZone(*zone);
+                UnicodeString message = UnicodeString(localeID, -1, US_INV) + u" " +
+                    zoneID + u" " + pattern;
+                UnicodeString expected;
+                int32_t expectedOffsets[UPRV_LENGTHOF(dates) + 1];
+                for (int32_t i = 0; i < count; ++i) {
+                    expectedOffsets[i] = expected.length();
+                    sdf.format(dates[i], expected);
+                }
+                expectedOffsets[count] = expected.length();
+
+                int32_t offsets[UPRV_LENGTHOF(dates) + 1];
+                int32_t length = cdf.formatDates(dates, count, *zone, nullptr, 0, offsets, status);
+                assertEquals(message + u" preflight error", U_BUFFER_OVERFLOW_ERROR, status.reset());
+                assertEquals(message + u" preflight length", expected.length(), length);
+                char16_t buffer[6000];
+                length = cdf.formatDates(dates, count, *zone, buffer, UPRV_LENGTHOF(buffer), offsets, status);
+                if (status.errIfFailureAndReset("%s", CStr(message)())) {
+                    continue;
+                }
+                assertEquals(message, expected, UnicodeString(buffer, length));
+                for (int32_t i = 0; i <= count; ++i) {
+                    if (offsets[i] != expectedOffsets[i]) {
+                        errln(message + u" offsets[" + i + u"] wrong");
+                        break;
+                    }
+                }
+
+                // Parse the strings back. Where SimpleDateFormat does not parse one completely,
+                // parseDates() must stop there as well.
+                UDate parsed[UPRV_LENGTHOF(dates)];
+                for (int32_t start = 0; start < count;) {
+                    int32_t n = cdf.parseDates(buffer, offsets + start, count - start, *zone,
+                                               parsed + start, status);
+                    int32_t limit = start + n;
+                    for (int32_t i = start; i <= limit && i < count; ++i) {
+                        UnicodeString s(buffer + offsets[i], offsets[i + 1] - offsets[i]);
+                        ParsePosition pos(0);
+                        UDate expectedDate = sdf.parse(s, pos);
+                        UBool expectedOK = pos.getIndex() == s.length() && pos.getErrorIndex() < 0;
+                        if (i < limit) {
+                            assertTrue(message + u" parsed " + s, expectedOK);
+                            assertEquals(message + u" parse " + s, expectedDate, parsed[i]);
+                        } else {
+                            assertFalse(message + u" parse error " + s, expectedOK);
+                            assertEquals(message + u" parse error", U_PARSE_ERROR, status.reset());
+                        }
+                    }
+                    start = limit + 1;
+                }
+            }
+        }
+    }
+
+    // Local times in and around the Los Angeles DST transitions,
+    // out-of-range fields, and a string that does not parse.
+    LocalPointer<TimeZone> la(TimeZone::createTimeZone(u"America/Los_Angeles"));
+    SimpleDateFormat sdf(u"yyyy-MM-dd HH:mm:ss", Locale::getRoot(), status);
+    sdf.setTimeZone(*la);
+    CompiledDateFormatter cdf = sdf.compile(status);
+    if (status.errDataIfFailureAndReset("compile()")) {
+        return;
+    }
+    static const char16_t *const strings[] = {
+        u"2020-03-08 01:59:59",
+        u"2020-03-08 02:30:00",  // skipped
+        u"2020-03-08 03:00:00",
+        u"2020-11-01 01:30:00",  // repeated
+        u"2020-11-01 02:00:00",
+        u"2020-02-30 24:61:00",  // lenient
+        u"2020-1-2 3:04:05",
+        u"2020-01-02 03:04:05 ",
+    };
+    UnicodeString text;
+    int32_t offsets[UPRV_LENGTHOF(strings) + 1];
+    for (int32_t i = 0; i < UPRV_LENGTHOF(strings); ++i) {
+        offsets[i] = text.length();
+        text.append(strings[i]);
+    }
+    offsets[UPRV_LENGTHOF(strings)] = text.length();
+    UDate parsed[UPRV_LENGTHOF(strings)];
+    int32_t n = cdf.parseDates(text.getBuffer(), offsets, UPRV_LENGTHOF(strings), *la, parsed, status);
+    assertEquals("stops at the trailing space", UPRV_LENGTHOF(strings) - 1, n);
+    assertEquals("U_PARSE_ERROR", U_PARSE_ERROR, status.reset());
+    for (int32_t i = 0; i < n; ++i) {
+        assertEquals(UnicodeString(u"parse ") + strings[i], sdf.parse(strings[i], status), parsed[i]);
+    }
+}
+
+/**
+ * Test that the day of year ('D') follows GregorianCalendar,
+ * which shifts it for the rest of the cutover year,
+ * with the default cutover and with a later one.
+ */
+void DateFormatTest::TestCompiledDateFormatterCutoverYear() {
+    IcuTestErrorCode status(*this, "TestCompiledDateFormatterCutoverYear");
+    static const char16_t *const zones[] = { u"UTC", u"America/Los_Angeles", u"Asia/Tokyo" };
+    static const UDate cutovers[] = {
+        -12219292800000.0,  // the default cutover, 1582-10-15
+        -2208988800000.0,   // 1900-01-01
+    };
+    for (const char16_t *zoneID : zones) {
+        LocalPointer<TimeZone> zone(TimeZone::createTimeZone(zoneID));
+        for (UDate cutover : cutovers) {
+            GregorianCalendar cal(*zone, Locale::getRoot(), status);
+            cal.setGregorianChange(cutover, status);
+            SimpleDateFormat sdf(u"D", Locale::getRoot(), status);
+            if (status.errDataIfFailureAndReset("SimpleDateFormat")) {
+                return;
+            }
+            sdf.setCalendar(cal);
+            CompiledDateFormatter cdf = sdf.compile(status);
+            status.errIfFailureAndReset("compile()");
+            // From the cutover into the second week of the following year, every 7.5 hours.
+            UDate dates[300];
+            UnicodeString expected;
+            for (int32_t i = 0; i < UPRV_LENGTHOF(dates); ++i) {
+                dates[i] = cutover + i * (7.5 * U_MILLIS_PER_HOUR);
+                if (i > 0) {
+                    expected.append(u' ');
+                }
+                cal.setTime(dates[i], status);
+                expected = expected + cal.get(UCAL_DAY_OF_YEAR, status);
+            }
+            if (status.errIfFailureAndReset("Calendar")) {
+                continue;
+            }
+            UnicodeString message = UnicodeString(zoneID) + u" cutover " + cutover;
+            UnicodeString actual, compiled;
+            for (int32_t i = 0; i < UPRV_LENGTHOF(dates); ++i) {
+                if (i > 0) {
+                    actual.append(u' ');
+                    compiled.append(u' ');
+                }
+                sdf.format(dates[i], actual);
+                cdf.format(dates[i], *zone, compiled, status);
+            }
+            assertEquals(message + u" format()", expected, actual);
+            assertEquals(message + u" CompiledDateFormatter::format()", expected, compiled);
+
+            char16_t buffer[2000];
+            int32_t offsets[UPRV_LENGTHOF(dates) + 1];
+            int32_t length = cdf.formatDates(dates, UPRV_LENGTHOF(dates), *zone,
+                                             buffer, UPRV_LENGTHOF(buffer), offsets, status);
+            if (status.errIfFailureAndReset("%s formatDates()", CStr(message)())) {
+                continue;
+            }
+            UnicodeString batch;
+            for (int32_t i = 0; i < UPRV_LENGTHOF(dates); ++i) {
+                if (i > 0) {
+                    batch.append(u' ');
+                }
+                batch.append(buffer, offsets[i], offsets[i + 1] - offsets[i]);
+            }
+            assertTrue(message + u" formatDates() length", length == offsets[UPRV_LENGTHOF(dates)]);
+            assertEquals(message + u" formatDates()", expected, batch);
+        }
+    }
+}
+
 #endif /* #if !UCONFIG_NO_FORMATTING */
 
 //eof
@@ -264,6 +264,10 @@ class DateFormatTest: public CalendarTimeZoneTest {
     void TestParseRegression13744();
     void TestAdoptCalendarLeak();
     void Test20741_ABFields();
+    void TestCompiledPattern();
+    void TestCompiledDateFormatter();
+    void TestCompiledDateFormatterBatch();
+    void TestCompiledDateFormatterCutoverYear();
 
 private:
     UBool showParse(DateFormat &format, const UnicodeString &formattedString);
@@ -60,6 +60,7 @@ void DateIntervalFormatTest::runIndexedTest( int32_t index, UBool exec, const ch
         TESTCASE(11, testCreateInstanceForAllLocales);
         TESTCASE(12, testTicket20707);
         TESTCASE(13, testFormatMillisecond);
+        TESTCASE(14, testRepeatedFormat);
         default: name = ""; break;
     }
 }
@@ -1958,4 +1959,83 @@ void DateIntervalFormatTest::testTicket20707() {
     }
 }
 
+void DateIntervalFormatTest::testRepeatedFormat() {
+    IcuTestErrorCode status(*this, "testRepeatedFormat");
+
+    const char *localeIDs[] = {"en", "de", "ja"};
+    const char16_t *skeletons[] = {u"yMMMd", u"hm", u"yMMMdjm", u"yMMMMdHms", u"MMMd", u"Hm"};
+    // From 2020-01-01 00:00 UTC: the same minute, and different minutes, hours,
+    // half days, days, months and years.
+    const double kMinute = 60000.0;
+    const double offsets[] = {
+        30000.0, 5 * kMinute, 130 * kMinute, 780 * kMinute, 3000 * kMinute,
+        50000 * kMinute, 600000 * kMinute
+    };
+    const UDate start = 1577836800000.0;
+    LocalPointer<TimeZone> berlin(TimeZone::createTimeZone(u"Europe/Berlin"));
+    for (const char *localeID : localeIDs) {
+        for (const char16_t *skeleton : skeletons) {
+            LocalPointer<DateIntervalFormat> fmt(DateIntervalFormat::createInstance(skeleton, localeID, status));
+            if (status.errDataIfFailureAndReset("createInstance(%s)", localeID)) {
+                return;
+            }
+            fmt->setTimeZone(*TimeZone::getGMT());
+            for (int32_t pass = 0; pass < 3; ++pass) {
+                if (pass == 1) {
+                    // Drops the formatters that were created for the old time zone.
+                    fmt->setTimeZone(*berlin);
+                } else if (pass == 2) {
+                    LocalPointer<DateIntervalFormat> clone(fmt->clone());
+                    fmt.adoptInstead(clone.orphan());
+                }
+                LocalPointer<DateIntervalFormat> fresh(DateIntervalFormat::createInstance(skeleton, localeID, status));
+                fresh->setTimeZone(pass == 0 ? *TimeZone::getGMT() : *berlin);
+                for (double offset : offsets) {
+                    DateInterval interval(start, start + offset);
+                    UnicodeString expected;
+                    FieldPosition pos;
+                    {
+                        // A new formatter applies each pattern only once.
+                        LocalPointer<DateIntervalFormat> single(fresh->clone());
+                        single->format(&interval, expected, pos, status);
+                    }
+                    for (int32_t i = 0; i < 20; ++i) {
+                        UnicodeString result;
+                        fmt->format(&interval, result, pos, status);
+                        if (result != expected) {
+                            errln(UnicodeString(u"skeleton ") + skeleton + u" in " + localeID +
+                                  u" pass " + pass + u" format #" + i + u": " + result +
+                                  u" but expected " + expected);
+                            break;
+                        }
+                    }
+                }
+            }
+            status.errIfFailureAndReset("format(%s)", localeID);
+        }
+    }
+
+    // Replacing the interval patterns drops the formatters for the old ones.
+    LocalPointer<DateIntervalFormat> fmt(DateIntervalFormat::createInstance(u"yMMMd", "en", status));
+    if (status.errDataIfFailureAndReset()) {
+        return;
+    }
+    fmt->setTimeZone(*TimeZone::getGMT());
+    DateInterval interval(start, start + 3000 * kMinute);
+    UnicodeString result;
+    FieldPosition pos;
+    for (int32_t i = 0; i < 20; ++i) {
+        fmt->format(&interval, result.remove(), pos, status);
+    }
+    assertEquals("default patterns", u"Jan 1 \u2013 3, 2020", result);
+    DateIntervalInfo dtitvinf("en", status);
+    dtitvinf.setIntervalPattern(u"yMMMd", UCAL_DATE, u"d \u2013 d MMM, y", status);
+    fmt->setDateIntervalInfo(dtitvinf, status);
+    for (int32_t i = 0; i < 20; ++i) {
+        fmt->format(&interval, result.remove(), pos, status);
+    }
+    assertEquals("replaced patterns", u"1 \u2013 3 Jan, 2020", result);
+    status.errIfFailureAndReset();
+}
+
 #endif /* #if !UCONFIG_NO_FORMATTING */
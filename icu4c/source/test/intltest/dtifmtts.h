@@ -71,6 +71,13 @@ class DateIntervalFormatTest: public IntlTestWithFieldPosition {
 
     void testTicket20707();
 
+    /**
+     * Test that formatting many intervals with the same formatter,
+     * which gives frequently used patterns their own formatters,
+     * matches formatting with new formatters.
+     */
+    void testRepeatedFormat();
+
 private:
     /**
      * Test formatting against expected result
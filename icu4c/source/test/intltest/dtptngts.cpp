@@ -44,6 +44,7 @@ void IntlTestDateTimePatternGeneratorAPI::runIndexedTest( int32_t index, UBool e
         TESTCASE(8, test20640_HourCyclArsEnNH);
         TESTCASE(9, testFallbackWithDefaultRootLocale);
         TESTCASE(10, testGetDefaultHourCycle_OnEmptyInstance);
+        TESTCASE(11, testBestPatternMemo);
         default: name = ""; break;
     }
 }
@@ -1507,4 +1508,44 @@ void IntlTestDateTimePatternGeneratorAPI::testGetDefaultHourCycle_OnEmptyInstanc
     }
 }
 
+void IntlTestDateTimePatternGeneratorAPI::testBestPatternMemo() {
+    IcuTestErrorCode status(*this, "testBestPatternMemo");
+
+    // Generators for the same locale share their best patterns until one is modified.
+    LocalPointer<DateTimePatternGenerator> first(DateTimePatternGenerator::createInstance("en", status), status);
+    LocalPointer<DateTimePatternGenerator> second(DateTimePatternGenerator::createInstance("en", status), status);
+    if (status.errIfFailureAndReset("createInstance")) {
+        return;
+    }
+    assertEquals("first yMMMd", u"MMM d, y", first->getBestPattern(u"yMMMd", status));
+    assertEquals("second yMMMd", u"MMM d, y", second->getBestPattern(u"yMMMd", status));
+    assertEquals("first yMMMdjmm", u"MMM d, y, h:mm a", first->getBestPattern(u"yMMMdjmm", status));
+
+    // The options are part of the memo key.
+    assertEquals("first hhmm", u"h:mm a", first->getBestPattern(u"hhmm", status));
+    assertEquals("first hhmm with hour field length", u"hh:mm a",
+                 first->getBestPattern(u"hhmm", UDATPG_MATCH_HOUR_FIELD_LENGTH, status));
+
+    UnicodeString conflictingPattern;
+    second->addPattern(u"d MMM y", TRUE, conflictingPattern, status);
+    second->setDateTimeFormat(u"{1} 'at' {0}");
+    assertEquals("modified yMMMd", u"d MMM y", second->getBestPattern(u"yMMMd", status));
+    assertEquals("modified yMMMdjmm", u"d MMM y 'at' h:mm a", second->getBestPattern(u"yMMMdjmm", status));
+    assertEquals("unmodified yMMMd", u"MMM d, y", first->getBestPattern(u"yMMMd", status));
+    assertEquals("unmodified yMMMdjmm", u"MMM d, y, h:mm a", first->getBestPattern(u"yMMMdjmm", status));
+
+    // A clone keeps the hour cycle data for the C metacharacter.
+    LocalPointer<DateTimePatternGenerator> clone(first->clone(), status);
+    LocalPointer<DateTimePatternGenerator> uncached(
+        DateTimePatternGenerator::internalMakeInstance("ja", status), status);
+    LocalPointer<DateTimePatternGenerator> cached(DateTimePatternGenerator::createInstance("ja", status), status);
+    if (status.errIfFailureAndReset("clone")) {
+        return;
+    }
+    assertEquals("clone Cmm", first->getBestPattern(u"Cmm", status), clone->getBestPattern(u"Cmm", status));
+    assertEquals("ja Cmm", uncached->getBestPattern(u"Cmm", status), cached->getBestPattern(u"Cmm", status));
+    assertEquals("ja hour cycle", uncached->getDefaultHourCycle(status), cached->getDefaultHourCycle(status));
+    assertTrue("ja cached == uncached", *uncached == *cached);
+}
+
 #endif /* #if !UCONFIG_NO_FORMATTING */
@@ -22,6 +22,7 @@ class FormattedStringBuilderTest : public IntlTest {
     void testFields();
     void testUnlimitedCapacity();
     void testCodePoints();
+    void testArena();
 
     void runIndexedTest(int32_t index, UBool exec, const char *&name, char *par = 0);
 
@@ -50,6 +51,7 @@ void FormattedStringBuilderTest::runIndexedTest(int32_t index, UBool exec, const
         TESTCASE_AUTO(testFields);
         TESTCASE_AUTO(testUnlimitedCapacity);
         TESTCASE_AUTO(testCodePoints);
+        TESTCASE_AUTO(testArena);
     TESTCASE_AUTO_END;
 }
 
@@ -308,6 +310,45 @@ void FormattedStringBuilderTest::testCodePoints() {
     assertEquals("Code point count is 2", 2, nsb.codePointCount());
 }
 
+void FormattedStringBuilderTest::testArena() {
+    UErrorCode status = U_ZERO_ERROR;
+    char16_t chars[100];
+    FormattedStringBuilder::Field fields[100];
+    FormattedStringBuilder sb(chars, fields, 100);
+    UnicodeString expected;
+    // Fill the arena, then grow past it onto the heap.
+    for (int32_t i = 0; i < 150; i++) {
+        UnicodeString message("Iteration #");
+        message += Int64ToUnicodeString(i);
+        if (i % 2 == 0) {
+            sb.appendChar16(u'a' + i % 26, kUndefinedField, status);
+            expected.append((char16_t)(u'a' + i % 26));
+        } else {
+            sb.insertChar16(0, u'A' + i % 26, kUndefinedField, status);
+            expected.insert(0, (char16_t)(u'A' + i % 26));
+        }
+        assertSuccess(message, status);
+        if (i < 100) {
+            assertTrue(message + u" in the arena",
+                chars <= sb.chars() && sb.chars() < chars + UPRV_LENGTHOF(chars));
+        }
+    }
+    assertFalse("on the heap", chars <= sb.chars() && sb.chars() < chars + UPRV_LENGTHOF(chars));
+    assertEqualsImpl(expected, sb);
+
+    // Assignment copies out of the arena.
+    FormattedStringBuilder sb2(chars, fields, 100);
+    sb2.append(u"arena", kUndefinedField, status);
+    FormattedStringBuilder sb3(sb2);
+    assertTrue("copy is equal", sb2.contentEquals(sb3));
+    sb2.clear();
+    sb2.append(u"other", kUndefinedField, status);
+    assertEqualsImpl(u"arena", sb3);
+    sb3 = sb2;
+    assertEqualsImpl(u"other", sb3);
+    assertSuccess("copies", status);
+}
+
 void FormattedStringBuilderTest::assertEqualsImpl(const UnicodeString &a, const FormattedStringBuilder &b) {
     // TODO: Why won't this compile without the IntlTest:: qualifier?
     IntlTest::assertEquals("Lengths should be the same", a.length(), b.length());
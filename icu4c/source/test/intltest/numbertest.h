@@ -84,6 +84,10 @@ class NumberFormatterApiTest : public IntlTestWithFieldPosition {
     void localPointerCAPI();
     void toObject();
     void toDecimalNumber();
+    void fastFormat();
+    void compiledFormatter();
+    void formatToBuffer();
+    void formatColumns();
 
     void runIndexedTest(int32_t index, UBool exec, const char *&name, char *par = 0);
 
@@ -243,6 +247,7 @@ class NumberParserTest : public IntlTest {
     void testCaseFolding();
     void test20360_BidiOverflow();
     void testInfiniteRecursion();
+    void testPlainDecimal();
 
     void runIndexedTest(int32_t index, UBool exec, const char *&name, char *par = 0);
 };
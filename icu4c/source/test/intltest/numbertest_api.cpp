@@ -9,6 +9,7 @@
 #include <cstdarg>
 #include <cmath>
 #include <memory>
+#include <thread>
 #include "unicode/unum.h"
 #include "unicode/numberformatter.h"
 #include "number_asformat.h"
@@ -17,6 +18,8 @@
 #include "numbertest.h"
 #include "unicode/utypes.h"
 #include "number_utypes.h"
+#include "putilimp.h"
+#include "unicode/plurrule.h"
 
 using number::impl::UFormattedNumberData;
 
@@ -110,6 +113,10 @@ void NumberFormatterApiTest::runIndexedTest(int32_t index, UBool exec, const cha
         TESTCASE_AUTO(localPointerCAPI);
         TESTCASE_AUTO(toObject);
         TESTCASE_AUTO(toDecimalNumber);
+        TESTCASE_AUTO(fastFormat);
+        TESTCASE_AUTO(compiledFormatter);
+        TESTCASE_AUTO(formatToBuffer);
+        TESTCASE_AUTO(formatColumns);
     TESTCASE_AUTO_END;
 }
 
@@ -3410,6 +3417,334 @@ void NumberFormatterApiTest::toDecimalNumber() {
         "9.8765E+14", fn.toDecimalNumber<std::string>(status).c_str());
 }
 
+void NumberFormatterApiTest::fastFormat() {
+    IcuTestErrorCode status(*this, "fastFormat");
+    // Compiled formatters format integers, and doubles with few fraction digits, without
+    // the MicroPropsGenerator pipeline if the settings allow it. The results must be the same
+    // as those of the pipeline, including the fields and the quantity.
+    struct TestCase {
+        const char16_t* skeleton;
+        const char* locale;
+    } cases[] = {
+        {u"", "en"},
+        {u"", "de-CH"},
+        {u"", "es"},  // minimum grouping digits
+        {u"", "en-IN"},  // secondary grouping size
+        {u"", "ar-EG"},  // non-ASCII digits
+        {u"currency/EUR", "fr"},
+        {u"currency/USD sign-accounting", "en"},
+        {u"currency/JPY unit-width-iso-code", "de"},
+        {u"percent sign-always", "en"},
+        {u".00", "en"},
+        {u".0#", "de"},
+        {u".00+", "en"},
+        {u"precision-integer decimal-always", "en"},
+        {u"precision-unlimited", "en"},
+        {u"integer-width/+000 group-off", "en"},
+        {u"integer-width/+ .00", "en"},
+        {u"sign-except-zero", "en"},
+        {u"measure-unit/length-meter", "en"},  // long name handler: no fast path
+        {u"@@@", "en"},  // significant digits: no fast path
+        {u"precision-increment/0.05", "en"},  // rounding increment: no fast path
+        {u"scale/100", "en"},  // scale: no fast path
+    };
+    static const int64_t ints[] = {
+        0, 1, -1, 7, 42, 999, 1000, -1234, 12345, 123456, 1234567, 12345678901LL,
+        INT64_MAX, INT64_MIN};
+    static const double doubles[] = {
+        0.0, -0.0, 1, -1, 0.5, 12.34, -12.34, 1234.5, 19.99, 0.05, 1234567.89, 1.005, 1.015,
+        0.1234567, 123456.123456, 4.5e15, 1e20, -9.87654321e12, 2.5, -2.5,
+        uprv_getNaN(), uprv_getInfinity()};
+    for (const TestCase& cas : cases) {
+        UnicodeString message = UnicodeString(cas.skeleton) + u" " + cas.locale;
+        status.setScope(message);
+        UnlocalizedNumberFormatter unf = NumberFormatter::forSkeleton(cas.skeleton, status);
+        LocalizedNumberFormatter pipeline = unf.threshold(0).locale(cas.locale);
+        LocalizedNumberFormatter compiled = unf.threshold(1).locale(cas.locale);
+        compiled.formatInt(1, status);  // compile it
+        for (int32_t i = 0; i < UPRV_LENGTHOF(ints) + UPRV_LENGTHOF(doubles); i++) {
+            FormattedNumber expected, actual;
+            if (i < UPRV_LENGTHOF(ints)) {
+                expected = pipeline.formatInt(ints[i], status);
+                actual = compiled.formatInt(ints[i], status);
+            } else {
+                double d = doubles[i - UPRV_LENGTHOF(ints)];
+                expected = pipeline.formatDouble(d, status);
+                actual = compiled.formatDouble(d, status);
+            }
+            UnicodeString expectedString = expected.toString(status);
+            UnicodeString caseMessage = message + u": " + expectedString;
+            assertEquals(caseMessage, expectedString, actual.toString(status));
+            // toDecimalNumber() does not support zero, NaN or infinity; it should fail the same way.
+            UErrorCode expectedStatus = U_ZERO_ERROR;
+            UErrorCode actualStatus = U_ZERO_ERROR;
+            assertEquals(caseMessage + u" toDecimalNumber",
+                expected.toDecimalNumber<std::string>(expectedStatus).c_str(),
+                actual.toDecimalNumber<std::string>(actualStatus).c_str());
+            assertEquals(caseMessage + u" toDecimalNumber status", expectedStatus, actualStatus);
+            ConstrainedFieldPosition expectedPos, actualPos;
+            while (expected.nextPosition(expectedPos, status)) {
+                assertTrue(caseMessage + u" field", actual.nextPosition(actualPos, status));
+                assertEquals(caseMessage + u" field", expectedPos.getField(), actualPos.getField());
+                assertEquals(caseMessage + u" start", expectedPos.getStart(), actualPos.getStart());
+                assertEquals(caseMessage + u" limit", expectedPos.getLimit(), actualPos.getLimit());
+            }
+            assertFalse(caseMessage + u" no more fields", actual.nextPosition(actualPos, status));
+        }
+    }
+
+    // Plural selection sees the same fraction digits.
+    LocalPointer<PluralRules> rules(PluralRules::forLocale("en", status));
+    LocalizedNumberFormatter lnf = NumberFormatter::with().precision(Precision::fixedFraction(2)).locale("en");
+    lnf.formatInt(1, status);
+    lnf.formatInt(1, status);
+    assertEquals("1 with two fraction digits", u"other", rules->select(lnf.formatInt(1, status), status));
+    assertEquals("1.00", u"1.00", lnf.formatDouble(1, status).toString(status));
+}
+
+void NumberFormatterApiTest::compiledFormatter() {
+    IcuTestErrorCode status(*this, "compiledFormatter");
+    LocalizedNumberFormatter lnf = NumberFormatter::forSkeleton(u"currency/EUR", status).locale("de");
+    CompiledNumberFormatter cnf = lnf.compile(status);
+    assertFalse("not empty", cnf.isEmpty());
+    assertEquals("int", lnf.formatInt(-1234, status).toString(status),
+        cnf.formatInt(-1234, status).toString(status));
+    assertEquals("double", lnf.formatDouble(19.99, status).toString(status),
+        cnf.formatDouble(19.99, status).toString(status));
+    assertEquals("decimal", lnf.formatDecimal("1234567.891", status).toString(status),
+        cnf.formatDecimal("1234567.891", status).toString(status));
+    assertEquals("locale", "de", cnf.getLocale().getName());
+
+    // The skeleton and locale are enough to compile an equivalent formatter.
+    UnicodeString skeleton = cnf.toSkeleton(status);
+    assertEquals("skeleton", u"currency/EUR", skeleton);
+    CompiledNumberFormatter other = CompiledNumberFormatter::forSkeleton(skeleton, cnf.getLocale(), status);
+    assertEquals("from skeleton", cnf.formatDouble(0.5, status).toString(status),
+        other.formatDouble(0.5, status).toString(status));
+
+    // Copies and moves.
+    CompiledNumberFormatter copy(cnf);
+    other = cnf;
+    CompiledNumberFormatter moved(std::move(copy));
+    assertTrue("moved from", copy.isEmpty());
+    assertEquals("copy", u"5,00\u00A0\u20AC", other.formatInt(5, status).toString(status));
+    assertEquals("moved", u"5,00\u00A0\u20AC", moved.formatInt(5, status).toString(status));
+    cnf = CompiledNumberFormatter();
+    assertEquals("shared data outlives the original", u"6,00\u00A0\u20AC",
+        moved.formatInt(6, status).toString(status));
+    status.errIfFailureAndReset();
+
+    // An empty formatter fails to format.
+    FormattedNumber result = cnf.formatInt(1, status);
+    status.expectErrorAndReset(U_INVALID_STATE_ERROR);
+    result.toString(status);
+    status.expectErrorAndReset(U_INVALID_STATE_ERROR);
+    cnf.toSkeleton(status);
+    status.expectErrorAndReset(U_INVALID_STATE_ERROR);
+    assertEquals("empty locale", "", cnf.getLocale().getName());
+
+    // Errors in the settings are reported by compile().
+    cnf = NumberFormatter::with().precision(Precision::maxFraction(1000)).locale("en").compile(status);
+    status.expectErrorAndReset(U_NUMBER_ARG_OUTOFBOUNDS_ERROR);
+    assertTrue("empty after error", cnf.isEmpty());
+    cnf = CompiledNumberFormatter::forSkeleton(u"unknown-stem", "en", status);
+    status.expectErrorAndReset(U_NUMBER_SKELETON_SYNTAX_ERROR);
+    assertTrue("empty after skeleton error", cnf.isEmpty());
+
+    // One compiled formatter and its copies are shared by several threads.
+    cnf = CompiledNumberFormatter::forSkeleton(u"percent .0", "fr", status);
+    UnicodeString expected = cnf.formatDouble(12.34, status).toString(status);
+    static const int32_t THREAD_COUNT = 4;
+    std::thread threads[THREAD_COUNT];
+    UBool ok[THREAD_COUNT];
+    for (int32_t t = 0; t < THREAD_COUNT; t++) {
+        ok[t] = TRUE;
+        threads[t] = std::thread([&cnf, &expected, &ok, t]() {
+            CompiledNumberFormatter local(cnf);
+            for (int32_t i = 0; i < 1000; i++) {
+                UErrorCode localStatus = U_ZERO_ERROR;
+                const CompiledNumberFormatter& f = (i & 1) ? local : cnf;
+                if (f.formatDouble(12.34, localStatus).toString(localStatus) != expected ||
+                        U_FAILURE(localStatus)) {
+                    ok[t] = FALSE;
+                }
+            }
+        });
+    }
+    for (int32_t t = 0; t < THREAD_COUNT; t++) {
+        threads[t].join();
+        assertTrue(UnicodeString(u"thread ") + Int64ToUnicodeString(t), ok[t]);
+    }
+}
+
+void NumberFormatterApiTest::formatToBuffer() {
+    IcuTestErrorCode status(*this, "formatToBuffer");
+    struct TestCase {
+        const char16_t* skeleton;
+        const char* locale;
+        double value;
+    } cases[] = {
+        {u"", "en", 1234567},
+        {u"currency/EUR", "de", -19.99},
+        {u"compact-long", "fr", 123456789},
+        {u"measure-unit/length-kilometer unit-width-full-name", "ru", 12345.5},
+        // Longer than the builder's stack arena.
+        {u"integer-width/+0000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000 .000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000",
+            "en", 1.5},
+    };
+    for (const TestCase& cas : cases) {
+        UnicodeString message = UnicodeString(cas.skeleton).tempSubString(0, 40) + u" " + cas.locale;
+        status.setScope(message);
+        LocalizedNumberFormatter lnf = NumberFormatter::forSkeleton(cas.skeleton, status).locale(cas.locale);
+        // Before and after compiling.
+        for (int32_t i = 0; i < 4; i++) {
+            UnicodeString expected = lnf.formatDouble(cas.value, status).toString(status);
+            std::string expected8;
+            expected.toUTF8String(expected8);
+            int64_t intValue = static_cast<int64_t>(cas.value);
+            UnicodeString expectedInt = lnf.formatInt(intValue, status).toString(status);
+
+            char16_t chars[1000];
+            int32_t length = lnf.formatDouble(cas.value, chars, UPRV_LENGTHOF(chars), status);
+            assertEquals(message + u" UTF-16", expected, UnicodeString(chars, length));
+            assertEquals(message + u" NUL-terminated", 0, chars[length]);
+            length = lnf.formatInt(intValue, chars, UPRV_LENGTHOF(chars), status);
+            assertEquals(message + u" int UTF-16", expectedInt, UnicodeString(chars, length));
+
+            char bytes[1000];
+            length = lnf.formatDoubleToUTF8(cas.value, bytes, UPRV_LENGTHOF(bytes), status);
+            assertEquals(message + u" UTF-8", expected8.c_str(), std::string(bytes, length).c_str());
+            assertEquals(message + u" UTF-8 NUL-terminated", 0, bytes[length]);
+            length = lnf.formatIntToUTF8(intValue, bytes, UPRV_LENGTHOF(bytes), status);
+            assertEquals(message + u" int UTF-8 length", (int32_t)std::string(bytes).length(), length);
+
+            // Preflighting.
+            length = lnf.formatDouble(cas.value, nullptr, 0, status);
+            status.expectErrorAndReset(U_BUFFER_OVERFLOW_ERROR);
+            assertEquals(message + u" preflight", expected.length(), length);
+            length = lnf.formatDoubleToUTF8(cas.value, nullptr, 0, status);
+            status.expectErrorAndReset(U_BUFFER_OVERFLOW_ERROR);
+            assertEquals(message + u" UTF-8 preflight", (int32_t)expected8.length(), length);
+
+            // Exactly fits without the NUL.
+            length = lnf.formatDouble(cas.value, chars, expected.length(), status);
+            status.expectErrorAndReset(U_STRING_NOT_TERMINATED_WARNING);
+            assertEquals(message + u" not terminated", expected, UnicodeString(chars, length));
+        }
+    }
+
+    status.setScope("");
+    char16_t chars[10];
+    LocalizedNumberFormatter lnf = NumberFormatter::withLocale("en");
+    lnf.formatInt(1, nullptr, 10, status);
+    status.expectErrorAndReset(U_ILLEGAL_ARGUMENT_ERROR);
+    lnf.formatInt(1, chars, -1, status);
+    status.expectErrorAndReset(U_ILLEGAL_ARGUMENT_ERROR);
+    NumberFormatter::with().precision(Precision::maxFraction(1000)).locale("en").formatInt(1, chars, 10, status);
+    status.expectErrorAndReset(U_NUMBER_ARG_OUTOFBOUNDS_ERROR);
+
+    CompiledNumberFormatter cnf = NumberFormatter::withLocale("de").compile(status);
+    assertEquals("compiled", u"1.234,5",
+        UnicodeString(chars, cnf.formatDouble(1234.5, chars, UPRV_LENGTHOF(chars), status)));
+    char bytes[10];
+    assertEquals("compiled UTF-8 length", 6, cnf.formatIntToUTF8(12345, bytes, UPRV_LENGTHOF(bytes), status));
+    assertEquals("compiled UTF-8", "12.345", bytes);
+    cnf = CompiledNumberFormatter();
+    cnf.formatInt(1, chars, UPRV_LENGTHOF(chars), status);
+    status.expectErrorAndReset(U_INVALID_STATE_ERROR);
+}
+
+void NumberFormatterApiTest::formatColumns() {
+    IcuTestErrorCode status(*this, "formatColumns");
+    const double doubles[] = {0, -1.5, 1234567.891, 3e-7, -0.0, 1e20, 42, uprv_getNaN(), -98765.4};
+    const int64_t ints[] = {0, -1, 1234567, INT64_MAX, INT64_MIN, 42, -98765};
+    const char16_t* skeletons[] = {u"", u"currency/EUR", u"percent", u"compact-short", u"sign-always .00"};
+    const char* locales[] = {"en", "de", "ar", "ru"};
+    for (const char16_t* skeleton : skeletons) {
+        for (const char* locale : locales) {
+            UnicodeString message = UnicodeString(skeleton) + u" " + locale;
+            status.setScope(message);
+            LocalizedNumberFormatter lnf = NumberFormatter::forSkeleton(skeleton, status).locale(locale);
+            // Before and after compiling.
+            for (int32_t iter = 0; iter < 4; iter++) {
+                UnicodeString expected;
+                int32_t expectedOffsets[UPRV_LENGTHOF(doubles) + 1];
+                for (int32_t i = 0; i < UPRV_LENGTHOF(doubles); i++) {
+                    expectedOffsets[i] = expected.length();
+                    expected.append(lnf.formatDouble(doubles[i], status).toString(status));
+                }
+                expectedOffsets[UPRV_LENGTHOF(doubles)] = expected.length();
+                std::string expected8;
+                expected.toUTF8String(expected8);
+
+                char16_t chars[1000];
+                int32_t offsets[UPRV_LENGTHOF(doubles) + 1];
+                int32_t length = lnf.formatDoubles(
+                    doubles, UPRV_LENGTHOF(doubles), chars, UPRV_LENGTHOF(chars), offsets, status);
+                assertEquals(message + u" doubles", expected, UnicodeString(chars, length));
+                assertEquals(message + u" NUL-terminated", 0, chars[length]);
+                for (int32_t i = 0; i <= UPRV_LENGTHOF(doubles); i++) {
+                    assertEquals(message + u" offset " + Int64ToUnicodeString(i),
+                        expectedOffsets[i], offsets[i]);
+                }
+
+                // Preflighting, and a buffer that fills up in the middle of the column.
+                length = lnf.formatDoubles(doubles, UPRV_LENGTHOF(doubles), nullptr, 0, offsets, status);
+                status.expectErrorAndReset(U_BUFFER_OVERFLOW_ERROR);
+                assertEquals(message + u" preflight", expected.length(), length);
+                assertEquals(message + u" preflight offset", expectedOffsets[3], offsets[3]);
+                length = lnf.formatDoubles(doubles, UPRV_LENGTHOF(doubles), chars, 10, nullptr, status);
+                status.expectErrorAndReset(U_BUFFER_OVERFLOW_ERROR);
+                assertEquals(message + u" partial", expected.length(), length);
+
+                char bytes[2000];
+                length = lnf.formatDoublesToUTF8(
+                    doubles, UPRV_LENGTHOF(doubles), bytes, UPRV_LENGTHOF(bytes), offsets, status);
+                assertEquals(message + u" UTF-8", expected8.c_str(), std::string(bytes, length).c_str());
+                assertEquals(message + u" UTF-8 last offset", (int32_t)expected8.length(),
+                    offsets[UPRV_LENGTHOF(doubles)]);
+                length = lnf.formatDoublesToUTF8(doubles, UPRV_LENGTHOF(doubles), bytes, 7, offsets, status);
+                status.expectErrorAndReset(U_BUFFER_OVERFLOW_ERROR);
+                assertEquals(message + u" UTF-8 partial", (int32_t)expected8.length(), length);
+
+                UnicodeString expectedInts;
+                for (int64_t value : ints) {
+                    expectedInts.append(lnf.formatInt(value, status).toString(status));
+                }
+                std::string expectedInts8;
+                expectedInts.toUTF8String(expectedInts8);
+                length = lnf.formatInts(ints, UPRV_LENGTHOF(ints), chars, UPRV_LENGTHOF(chars), nullptr, status);
+                assertEquals(message + u" ints", expectedInts, UnicodeString(chars, length));
+                length = lnf.formatIntsToUTF8(
+                    ints, UPRV_LENGTHOF(ints), bytes, UPRV_LENGTHOF(bytes), offsets, status);
+                assertEquals(message + u" ints UTF-8", expectedInts8.c_str(), std::string(bytes, length).c_str());
+            }
+        }
+    }
+
+    status.setScope("");
+    char16_t chars[10];
+    int32_t offsets[1];
+    LocalizedNumberFormatter lnf = NumberFormatter::withLocale("en");
+    assertEquals("empty column", 0, lnf.formatInts(nullptr, 0, chars, UPRV_LENGTHOF(chars), offsets, status));
+    assertEquals("empty column offset", 0, offsets[0]);
+    lnf.formatInts(nullptr, 1, chars, UPRV_LENGTHOF(chars), nullptr, status);
+    status.expectErrorAndReset(U_ILLEGAL_ARGUMENT_ERROR);
+    lnf.formatDoubles(doubles, -1, chars, UPRV_LENGTHOF(chars), nullptr, status);
+    status.expectErrorAndReset(U_ILLEGAL_ARGUMENT_ERROR);
+
+    CompiledNumberFormatter cnf = NumberFormatter::withLocale("de").compile(status);
+    const int64_t column[] = {1, 22, 1000};
+    int32_t columnOffsets[4];
+    char bytes[20];
+    int32_t length = cnf.formatIntsToUTF8(
+        column, UPRV_LENGTHOF(column), bytes, UPRV_LENGTHOF(bytes), columnOffsets, status);
+    assertEquals("compiled UTF-8", "1221.000", std::string(bytes, length).c_str());
+    assertEquals("compiled offset", 3, columnOffsets[2]);
+    cnf = CompiledNumberFormatter();
+    cnf.formatDoubles(doubles, 1, chars, UPRV_LENGTHOF(chars), nullptr, status);
+    status.expectErrorAndReset(U_INVALID_STATE_ERROR);
+}
 
 void NumberFormatterApiTest::assertFormatDescending(
         const char16_t* umessage,
@@ -25,6 +25,7 @@ void NumberParserTest::runIndexedTest(int32_t index, UBool exec, const char*& na
         TESTCASE_AUTO(testAffixPatternMatcher);
         TESTCASE_AUTO(test20360_BidiOverflow);
         TESTCASE_AUTO(testInfiniteRecursion);
+        TESTCASE_AUTO(testPlainDecimal);
     TESTCASE_AUTO_END;
 }
 
@@ -408,5 +409,73 @@ void NumberParserTest::testInfiniteRecursion() {
     assertEquals("Unlimited recursion, expected double", -5.0, resultObject.getDouble(status));
 }
 
+void NumberParserTest::testPlainDecimal() {
+    IcuTestErrorCode status(*this, "testPlainDecimal");
+    // DecimalMatcher::matchPlain() is the fast path of NumberParserImpl for plain decimal numbers.
+    // Whenever it accepts a string, the result must be the same as from match().
+    static const char16_t* inputs[] = {
+        u"0", u"7", u"0012", u"1234", u"1234.5", u"0.50", u"1000", u"1,234", u"1,234.50",
+        u"12,345,678.9", u"1,23,45,678.5", u"12,34", u"1,2345", u",123", u"1,,234", u"1,234,",
+        u"1.", u".5", u"1.2.3", u"1,234.5,6", u"1.234,5", u"1.234.567", u"12 345,6",
+        u"12\u202F345,6", u"12\u00A0345,6", u"1'234.5", u"123456789012345678901234567890.123",
+        u"1e5", u"-1", u"1a", u"\u0661\u0662", u""};
+    static const struct {
+        const char* locale;
+        int16_t grouping1;
+        int16_t grouping2;
+    } localeCases[] = {{"en", 3, 3}, {"de", 3, 3}, {"fr", 3, 3}, {"de-CH", 3, 3}, {"en-IN", 3, 2},
+                       {"en", 3, -1}, {"en", 1, 1}, {"en", 2, 2}};
+    static const parse_flags_t flagCases[] = {
+        0,
+        PARSE_FLAG_STRICT_GROUPING_SIZE | PARSE_FLAG_STRICT_SEPARATORS,
+        PARSE_FLAG_GROUPING_DISABLED,
+        PARSE_FLAG_INTEGER_ONLY,
+        PARSE_FLAG_MONETARY_SEPARATORS};
+    int32_t numAccepted = 0;
+    for (const auto& localeCase : localeCases) {
+        DecimalFormatSymbols symbols(localeCase.locale, status);
+        Grouper grouper(localeCase.grouping1, localeCase.grouping2, 1, UNUM_GROUPING_AUTO);
+        for (parse_flags_t flags : flagCases) {
+            DecimalMatcher matcher(symbols, grouper, flags);
+            UChar32 grouping, decimal;
+            matcher.getPlainSeparators(grouping, decimal);
+            for (const char16_t* input : inputs) {
+                UnicodeString str = UnicodeString(input).unescape();
+                UnicodeString message = UnicodeString(localeCase.locale) + u" " +
+                    Int64ToUnicodeString(localeCase.grouping1) + u"/" +
+                    Int64ToUnicodeString(localeCase.grouping2) + u" flags " +
+                    Int64ToUnicodeString(flags) + u": " + str;
+                ParsedNumber plain;
+                if (!matcher.matchPlain(str, 0, grouping, decimal, plain)) {
+                    assertTrue(message + u" unchanged", plain.charEnd == 0 && !plain.seenNumber());
+                    continue;
+                }
+                numAccepted++;
+                ParsedNumber expected;
+                StringSegment segment(str, false);
+                matcher.match(segment, expected, status);
+                assertEquals(message + u" charEnd", expected.charEnd, plain.charEnd);
+                assertEquals(message + u" flags", expected.flags, plain.flags);
+                assertEquals(message + u" quantity",
+                    expected.quantity.toScientificString(), plain.quantity.toScientificString());
+                assertEquals(message + u" double",
+                    expected.getDouble(status), plain.getDouble(status));
+            }
+        }
+    }
+    assertTrue("some plain numbers", numAccepted > 100);
+
+    // The common forms take the fast path.
+    DecimalFormatSymbols symbols("en", status);
+    DecimalMatcher matcher(symbols, {3, 3, 1, UNUM_GROUPING_AUTO}, 0);
+    UChar32 grouping, decimal;
+    matcher.getPlainSeparators(grouping, decimal);
+    for (const char16_t* input : {u"0", u"1234", u"1234.5", u"1,234", u"1,234.50", u"12,345,678.9"}) {
+        ParsedNumber result;
+        assertTrue(UnicodeString(u"plain: ") + input,
+            matcher.matchPlain(input, 0, grouping, decimal, result));
+    }
+}
+
 
 #endif
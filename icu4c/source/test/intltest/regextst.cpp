@@ -28,6 +28,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <thread>
 
 #include "unicode/localpointer.h"
 #include "unicode/regex.h"
@@ -107,6 +108,9 @@ void RegexTest::runIndexedTest( int32_t index, UBool exec, const char* &name, ch
     TESTCASE_AUTO(TestBug13632);
     TESTCASE_AUTO(TestBug20359);
     TESTCASE_AUTO(TestBug20863);
+    TESTCASE_AUTO(TestLinearTimeEngine);
+    TESTCASE_AUTO(TestRegexSet);
+    TESTCASE_AUTO(TestMatcherPool);
     TESTCASE_AUTO_END;
 }
 
@@ -1224,16 +1228,15 @@ void RegexTest::API_Match() {
 
     //
     //  Time Outs.
-    //       Note:  These tests will need to be changed when the regexp engine is
-    //              able to detect and cut short the exponential time behavior on
-    //              this type of match.
+    //       Note:  The backtracking engine takes exponential time on this type of match.
+    //              The linear time engine, used by default for these patterns, does not.
     //
     {
         UErrorCode status = U_ZERO_ERROR;
         //    Enough 'a's in the string to cause the match to time out.
         //       (Each on additonal 'a' doubles the time)
         UnicodeString testString("aaaaaaaaaaaaaaaaaaaaa");
-        RegexMatcher matcher("(a+)+b", testString, 0, status);
+        RegexMatcher matcher("(a+)+b", testString, UREGEX_BACKTRACKING, status);
         REGEX_CHECK_STATUS;
         REGEX_ASSERT(matcher.getTimeLimit() == 0);
         matcher.setTimeLimit(100, status);
@@ -1245,10 +1248,21 @@ void RegexTest::API_Match() {
         UErrorCode status = U_ZERO_ERROR;
         //   Few enough 'a's to slip in under the time limit.
         UnicodeString testString("aaaaaaaaaaaaaaaaaa");
+        RegexMatcher matcher("(a+)+b", testString, UREGEX_BACKTRACKING, status);
+        REGEX_CHECK_STATUS;
+        matcher.setTimeLimit(100, status);
+        REGEX_ASSERT(matcher.lookingAt(status) == FALSE);
+        REGEX_CHECK_STATUS;
+    }
+    {
+        UErrorCode status = U_ZERO_ERROR;
+        //   The linear time engine is well within the limit, with many more 'a's.
+        UnicodeString testString(10000, 0x61, 10000);
         RegexMatcher matcher("(a+)+b", testString, 0, status);
         REGEX_CHECK_STATUS;
         matcher.setTimeLimit(100, status);
         REGEX_ASSERT(matcher.lookingAt(status) == FALSE);
+        REGEX_ASSERT(matcher.find(0, status) == FALSE);
         REGEX_CHECK_STATUS;
     }
 
@@ -1261,7 +1275,7 @@ void RegexTest::API_Match() {
 
         // Adding the capturing parentheses to the pattern "(A)+A$" inhibits optimizations
         //   of the '+', and makes the stack frames larger.
-        RegexMatcher matcher("(A)+A$", testString, 0, status);
+        RegexMatcher matcher("(A)+A$", testString, UREGEX_BACKTRACKING, status);
 
         // With the default stack, this match should fail to run
         REGEX_ASSERT(matcher.lookingAt(status) == FALSE);
@@ -3277,7 +3291,8 @@ void RegexTest::Extended() {
         //
         //  Run the test
         //
-        regex_find(testPattern, testFlags, matchString, srcPath, lineNum);
+        regex_find(testPattern, testFlags, matchString, srcPath, lineNum, FALSE);
+        regex_find(testPattern, testFlags, matchString, srcPath, lineNum, TRUE);
     }
 
     delete [] testData;
@@ -3288,12 +3303,14 @@ void RegexTest::Extended() {
 
 //---------------------------------------------------------------------------
 //
-//    regex_find(pattern, flags, inputString, lineNumber)
+//    regex_find(pattern, flags, inputString, lineNumber, nativeUTF8)
 //
 //         Function to run a single test from the Extended (data driven) tests.
 //         See file test/testdata/regextst.txt for a description of the
 //         pattern and inputString fields, and the allowed flags.
 //         lineNumber is the source line in regextst.txt of the test.
+//         nativeUTF8 gives the UTF-8 matcher its input with resetUTF8()
+//         rather than as a UText.
 //
 //---------------------------------------------------------------------------
 
@@ -3342,7 +3359,8 @@ void RegexTest::regex_find(const UnicodeString &pattern,
                            const UnicodeString &flags,
                            const UnicodeString &inputString,
                            const char *srcPath,
-                           int32_t line) {
+                           int32_t line,
+                           UBool nativeUTF8) {
     UnicodeString       unEscapedInput;
     UnicodeString       deTaggedInput;
 
@@ -3560,7 +3578,12 @@ void RegexTest::regex_find(const UnicodeString &pattern,
         utext_openUTF8(&inputText, inputChars, inputUTF8Length, &status);
 
         if (status == U_ZERO_ERROR) {
-            UTF8Matcher = &UTF8Pattern->matcher(status)->reset(&inputText);
+            if (nativeUTF8) {
+                UTF8Matcher = &UTF8Pattern->matcher(status)->resetUTF8(
+                    StringPiece(inputChars, inputUTF8Length), status);
+            } else {
+                UTF8Matcher = &UTF8Pattern->matcher(status)->reset(&inputText);
+            }
             REGEX_CHECK_STATUS_L(line);
         }
 
@@ -6014,4 +6037,271 @@ void RegexTest::TestBug20863() {
 }
 
 
+void RegexTest::TestLinearTimeEngine() {
+    UErrorCode status = U_ZERO_ERROR;
+    UParseError pe;
+
+    // Patterns the linear time engine can not handle are refused with UREGEX_LINEAR_TIME.
+    static const char16_t *unsupported[] = {
+        u"(a)\\1", u"a(?=b)", u"(?<!a)b", u"(?>a+)b", u"a++b", u"(ab){2,3}", u"\\X"};
+    for (const char16_t *patternText : unsupported) {
+        status = U_ZERO_ERROR;
+        LocalPointer<RegexPattern> pattern(
+            RegexPattern::compile(patternText, UREGEX_LINEAR_TIME, pe, status), status);
+        assertEquals(WHERE, U_REGEX_UNIMPLEMENTED, status);
+        status = U_ZERO_ERROR;
+        pattern.adoptInstead(RegexPattern::compile(patternText, 0, pe, status));
+        assertSuccess(WHERE, status);
+    }
+    status = U_ZERO_ERROR;
+    LocalPointer<RegexPattern> bothEngines(
+        RegexPattern::compile(u"abc", UREGEX_LINEAR_TIME | UREGEX_BACKTRACKING, pe, status), status);
+    assertEquals(WHERE, U_REGEX_INVALID_FLAG, status);
+
+    // The two engines find the same matches and capture groups.
+    static const struct {
+        const char16_t *pattern;
+        int32_t         flags;
+        const char16_t *text;
+    } cases[] = {
+        {u"(a|ab)(c|bcd)(d*)", 0, u"abcd abcd"},
+        {u"(a*)*?(b+?)(b*)", 0, u"aabbb ab b"},
+        {u"((a)|b)+", 0, u"ababb xba"},
+        {u"(\\w+)\\s*=\\s*(\\d+|\\w+);?", 0, u"x = 10; yy=zz; =3"},
+        {u"^(.*?)(\\d*)$", UREGEX_MULTILINE, u"abc123\r\ndef\r\n456\n"},
+        {u"(?s)(.*)(\\r\\n|x)", 0, u"ab\r\ncd\r\nx"},
+        {u".*(\\R)", 0, u"ab\r\ncd\n"},
+        {u"\\b(\\w)(\\w*)\\b", 0, u"one two, three."},
+        {u"(Stra\u00dfe|s)+", UREGEX_CASE_INSENSITIVE, u"STRASSE strasse STRA\u00dfE s"},
+        {u"[a-c]*(c|d)?$", 0, u"abcabcd\n"},
+        {u"\\G(a|b)", 0, u"abac"},
+        {u"x*", 0, u"axxb"},
+        {u"(\\x{10000}|\\p{L})+", 0, u"a\\ud800\\udc00b 1 \\ud800\\udc00"},
+    };
+    for (const auto &c : cases) {
+        status = U_ZERO_ERROR;
+        UnicodeString text = UnicodeString(c.text).unescape();
+        RegexMatcher nfa(c.pattern, text, c.flags, status);
+        RegexMatcher backtracking(c.pattern, text, c.flags | UREGEX_BACKTRACKING, status);
+        if (!assertSuccess(WHERE, status)) {
+            continue;
+        }
+        for (;;) {
+            UBool found = nfa.find(status);
+            assertEquals(UnicodeString(WHERE) + u" " + c.pattern, backtracking.find(status), found);
+            assertEquals(UnicodeString(WHERE) + u" " + c.pattern, backtracking.hitEnd(), nfa.hitEnd());
+            if (!found || U_FAILURE(status)) {
+                break;
+            }
+            for (int32_t group = 0; group <= nfa.groupCount(); group++) {
+                assertEquals(UnicodeString(WHERE) + u" " + c.pattern,
+                             backtracking.start(group, status), nfa.start(group, status));
+                assertEquals(UnicodeString(WHERE) + u" " + c.pattern,
+                             backtracking.end(group, status), nfa.end(group, status));
+            }
+        }
+        assertSuccess(WHERE, status);
+    }
+
+    // Catastrophic backtracking patterns run in linear time.
+    UnicodeString as(1000, 0x61, 1000);
+    static const char16_t *exponential[] = {
+        u"(a+)+b", u"(a|a)*b", u"(a|aa)*b", u"(.*a)(.*a)(.*a)(.*a)(.*a)b"};
+    for (const char16_t *patternText : exponential) {
+        status = U_ZERO_ERROR;
+        LocalPointer<RegexPattern> pattern(RegexPattern::compile(patternText, 0, pe, status), status);
+        if (!assertSuccess(WHERE, status)) {
+            continue;
+        }
+        LocalPointer<RegexMatcher> matcher(pattern->matcher(as, status), status);
+        if (!assertSuccess(WHERE, status)) {
+            continue;
+        }
+        matcher->setTimeLimit(1000, status);
+        assertFalse(WHERE, matcher->matches(status));
+        assertFalse(WHERE, matcher->find(0, status));
+        assertSuccess(UnicodeString(WHERE) + u" " + patternText, status);
+    }
+}
+
+
+void RegexTest::TestRegexSet() {
+    UErrorCode status = U_ZERO_ERROR;
+    UParseError pe;
+
+    // A mix of patterns for the linear time engine, sharing some of their sets, and
+    //   patterns that need backtracking.
+    UnicodeString patterns[] = {
+        u"error", u"(?i)warn(ing)?", u"[0-9]+ms", u"\\d{4}-\\d\\d-\\d\\d", u"^start",
+        u"(?m)^done$", u"[a-z]+@[a-z]+\\.com", u"(\\w)\\1", u"x(?=y)", u"\\u0416+",
+        u"[0-9]+ms", u"timeout", u"\\bid=\\d+", u"(?s)begin.*end", u"z*"};
+    int32_t patternCount = UPRV_LENGTHOF(patterns);
+    LocalPointer<RegexSet> set(RegexSet::compile(patterns, patternCount, 0, pe, status), status);
+    if (!assertSuccess(WHERE, status)) {
+        return;
+    }
+    assertEquals(WHERE, patternCount, set->size());
+    assertTrue(WHERE, set->getPattern(3) != nullptr && set->getPattern(3)->pattern() == patterns[3]);
+    assertTrue(WHERE, set->getPattern(patternCount) == nullptr);
+
+    static const char16_t *texts[] = {
+        u"", u"start: request took 15ms", u"2020-01-31 ERROR at x", u"Warning: xy\ndone\r\n",
+        u"mail bob@example.com for id=42", u"begin\r\nЖЖ ... end", u"aa timeout",
+        u"start error warn 12ms 2020-01-31 done bob@example.com aa xy Ж timeout id=1 begin end"};
+    for (const char16_t *text : texts) {
+        UnicodeString input(text);
+        int32_t indexes[UPRV_LENGTHOF(patterns)];
+        int32_t count = set->findAll(input, indexes, UPRV_LENGTHOF(indexes), status);
+        if (!assertSuccess(WHERE, status)) {
+            continue;
+        }
+        // The same patterns match as with find() on each of them.
+        int32_t expectedCount = 0;
+        for (int32_t i = 0; i < patternCount; i++) {
+            RegexMatcher matcher(patterns[i], input, 0, status);
+            if (matcher.find(status)) {
+                assertTrue(UnicodeString(WHERE) + u" " + patterns[i] + u" in " + input,
+                           expectedCount < count && indexes[expectedCount] == i);
+                expectedCount++;
+            }
+        }
+        assertEquals(UnicodeString(WHERE) + u" " + input, expectedCount, count);
+
+        // Preflighting.
+        int32_t preflightCount = set->findAll(input, nullptr, 0, status);
+        assertEquals(WHERE, count, preflightCount);
+        assertEquals(WHERE, count > 0 ? U_BUFFER_OVERFLOW_ERROR : U_ZERO_ERROR, status);
+        status = U_ZERO_ERROR;
+    }
+
+    // Syntax errors, and flags that apply to all of the patterns.
+    UnicodeString badPatterns[] = {u"abc", u"a(b"};
+    LocalPointer<RegexSet> badSet(RegexSet::compile(badPatterns, 2, 0, pe, status), status);
+    assertEquals(WHERE, U_REGEX_MISMATCHED_PAREN, status);
+    status = U_ZERO_ERROR;
+    LocalPointer<RegexSet> linearSet(RegexSet::compile(patterns, patternCount, UREGEX_LINEAR_TIME, pe, status), status);
+    assertEquals(WHERE, U_REGEX_UNIMPLEMENTED, status);
+    status = U_ZERO_ERROR;
+    UnicodeString caseless[] = {u"ERROR", u"Waſi", u"ж"};
+    LocalPointer<RegexSet> caselessSet(
+        RegexSet::compile(caseless, UPRV_LENGTHOF(caseless), UREGEX_CASE_INSENSITIVE, pe, status), status);
+    if (assertSuccess(WHERE, status)) {
+        int32_t indexes[3];
+        assertEquals(WHERE, 2, caselessSet->findAll(u"an error, Ж", indexes, 3, status));
+        assertEquals(WHERE, 0, indexes[0]);
+        assertEquals(WHERE, 2, indexes[1]);
+        assertEquals(WHERE, 1, caselessSet->findAll(u"WASI", indexes, 3, status));
+        assertSuccess(WHERE, status);
+    }
+}
+
+
+void RegexTest::TestMatcherPool() {
+    UErrorCode status = U_ZERO_ERROR;
+    UParseError pe;
+
+    // (a|b)*(?=c)c runs on the backtracking engine, saving a state for each
+    //   character it consumes.
+    LocalPointer<RegexPattern> pattern(RegexPattern::compile(u"(a|b)*(?=c)c", 0, pe, status), status);
+    if (!assertSuccess(WHERE, status)) {
+        return;
+    }
+    RegexMatcher *m = pattern->acquireMatcher(status);
+    if (!assertSuccess(WHERE, status)) {
+        return;
+    }
+    assertEquals(WHERE, 0, m->getMaxStackSize());
+    assertEquals(WHERE, (int64_t)0, m->getStateSaveCount());
+
+    UnicodeString shortInput(u"ababc");
+    UnicodeString longInput;
+    for (int32_t i = 0; i < 1000; i++) {
+        longInput.append(u"ab");
+    }
+    longInput.append(u'c');
+    m->reset(shortInput);
+    assertTrue(WHERE, m->matches(status));
+    int32_t shortStackSize = m->getMaxStackSize();
+    assertTrue(WHERE, shortStackSize > 0);
+    assertTrue(WHERE, m->getStateSaveCount() >= 5);
+    assertTrue(WHERE, m->getMatchSteps() >= m->getStateSaveCount());
+
+    m->reset(longInput);
+    assertTrue(WHERE, m->matches(status));
+    int32_t longStackSize = m->getMaxStackSize();
+    assertTrue(WHERE, longStackSize > shortStackSize);
+    assertTrue(WHERE, m->getStateSaveCount() >= 2000);
+
+    // The statistics tell how small a stack limit the match can run with.
+    m->reset();
+    m->setStackLimit(longStackSize, status);
+    assertTrue(WHERE, m->matches(status));
+    assertSuccess(WHERE, status);
+    m->setStackLimit(longStackSize / 2, status);
+    m->matches(status);
+    assertEquals(WHERE, U_REGEX_STACK_OVERFLOW, status);
+    status = U_ZERO_ERROR;
+
+    // A released matcher comes back from the pool with default settings and no input.
+    m->setTimeLimit(5, status);
+    m->useTransparentBounds(TRUE);
+    pattern->releaseMatcher(m);
+    RegexMatcher *m2 = pattern->acquireMatcher(status);
+    assertTrue(WHERE, m == m2);
+    assertEquals(WHERE, 0, m2->getTimeLimit());
+    assertEquals(WHERE, 8000000, m2->getStackLimit());
+    assertFalse(WHERE, m2->hasTransparentBounds());
+    assertEquals(WHERE, 0, m2->getMaxStackSize());
+    assertTrue(WHERE, m2->input().isEmpty());
+    assertFalse(WHERE, m2->find(status));
+    m2->reset(longInput);
+    assertTrue(WHERE, m2->matches(status));
+    assertSuccess(WHERE, status);
+
+    // A second matcher while the first is in use is a different one.
+    RegexMatcher *m3 = pattern->acquireMatcher(status);
+    assertTrue(WHERE, m3 != nullptr && m3 != m2);
+    pattern->releaseMatcher(m2);
+    pattern->releaseMatcher(m3);
+    pattern->releaseMatcher(nullptr);
+
+    // The linear time engine does not save backtrack states.
+    LocalPointer<RegexPattern> linear(RegexPattern::compile(u"[a-z]+@[a-z]+", 0, pe, status), status);
+    if (assertSuccess(WHERE, status)) {
+        RegexMatcher *lm = linear->acquireMatcher(status);
+        lm->reset(UnicodeString(u"mail bob@example.com"));
+        assertTrue(WHERE, lm->find(status));
+        assertEquals(WHERE, (int64_t)0, lm->getStateSaveCount());
+        assertTrue(WHERE, lm->getMatchSteps() > 0);
+        linear->releaseMatcher(lm);
+    }
+
+    // Threads using the pool concurrently.  Each gets its own matcher.
+    static const int32_t THREAD_COUNT = 8;
+    int32_t failures[THREAD_COUNT] = {};
+    std::thread threads[THREAD_COUNT];
+    for (int32_t t = 0; t < THREAD_COUNT; t++) {
+        threads[t] = std::thread([&pattern, &longInput, &failures, t]() {
+            for (int32_t i = 0; i < 50; i++) {
+                UErrorCode threadStatus = U_ZERO_ERROR;
+                RegexMatcher *tm = pattern->acquireMatcher(threadStatus);
+                if (U_FAILURE(threadStatus)) {
+                    failures[t]++;
+                    continue;
+                }
+                tm->reset(longInput);
+                if (!tm->matches(threadStatus) || tm->end(threadStatus) != longInput.length()) {
+                    failures[t]++;
+                }
+                pattern->releaseMatcher(tm);
+            }
+        });
+    }
+    for (int32_t t = 0; t < THREAD_COUNT; t++) {
+        threads[t].join();
+        assertEquals(WHERE, 0, failures[t]);
+    }
+}
+
+
 #endif  /* !UCONFIG_NO_REGULAR_EXPRESSIONS  */
@@ -61,6 +61,9 @@ class RegexTest: public IntlTest {
     virtual void TestBug13632();
     virtual void TestBug20359();
     virtual void TestBug20863();
+    virtual void TestLinearTimeEngine();
+    virtual void TestRegexSet();
+    virtual void TestMatcherPool();
 
     // The following functions are internal to the regexp tests.
     virtual void assertUText(const char *expected, UText *actual, const char *file, int line);
@@ -68,7 +71,8 @@ class RegexTest: public IntlTest {
     virtual UBool doRegexLMTest(const char *pat, const char *text, UBool looking, UBool match, int32_t line);
     virtual UBool doRegexLMTestUTF8(const char *pat, const char *text, UBool looking, UBool match, int32_t line);
     virtual void regex_find(const UnicodeString &pat, const UnicodeString &flags,
-                            const UnicodeString &input, const char *srcPath, int32_t line);
+                            const UnicodeString &input, const char *srcPath, int32_t line,
+                            UBool nativeUTF8);
     virtual void regex_err(const char *pat, int32_t errline, int32_t errcol,
                             UErrorCode expectedStatus, int32_t line);
     virtual UChar *ReadAndConvertFile(const char *fileName, int32_t &len, const char *charset, UErrorCode &status);
@@ -797,6 +797,7 @@ class RelativeDateTimeFormatterTest : public IntlTestWithFieldPosition {
     void TestLocales();
     void TestFields();
     void TestRBNF();
+    void TestFormatMemo();
 
     void RunTest(
             const Locale& locale,
@@ -891,6 +892,7 @@ void RelativeDateTimeFormatterTest::runIndexedTest(
     TESTCASE_AUTO(TestLocales);
     TESTCASE_AUTO(TestFields);
     TESTCASE_AUTO(TestRBNF);
+    TESTCASE_AUTO(TestFormatMemo);
     TESTCASE_AUTO_END;
 }
 
@@ -1484,6 +1486,70 @@ void RelativeDateTimeFormatterTest::TestRBNF() {
     }
 }
 
+void RelativeDateTimeFormatterTest::TestFormatMemo() {
+    IcuTestErrorCode status(*this, "TestFormatMemo");
+
+    RelativeDateTimeFormatter fmt("en", nullptr, UDAT_STYLE_LONG,
+        UDISPCTX_CAPITALIZATION_FOR_BEGINNING_OF_SENTENCE, status);
+    if (status.errDataIfFailureAndReset("Unable to create format object")) { return; }
+    RelativeDateTimeFormatter copy(fmt);
+    UnicodeString result;
+    // Repeated calls are answered from the memo. They must append, and must distinguish
+    // between the format functions and between 0 and -0.
+    for (int32_t i = 0; i < 2; ++i) {
+        const RelativeDateTimeFormatter &f = (i == 0) ? fmt : copy;
+        assertEquals("format (relative)", "Tomorrow",
+            f.format(1, UDAT_REL_UNIT_DAY, result.remove(), status));
+        assertEquals("formatNumeric", "In 1 day",
+            f.formatNumeric(1, UDAT_REL_UNIT_DAY, result.remove(), status));
+        assertEquals("formatNumeric 0", "In 0 days",
+            f.formatNumeric(0.0, UDAT_REL_UNIT_DAY, result.remove(), status));
+        assertEquals("formatNumeric -0", "0 days ago",
+            f.formatNumeric(-0.0, UDAT_REL_UNIT_DAY, result.remove(), status));
+        assertEquals("format (direction)", "In 2 hours",
+            f.format(2, UDAT_DIRECTION_NEXT, UDAT_RELATIVE_HOURS, result.remove(), status));
+        assertEquals("format (absolute)", "Yesterday",
+            f.format(UDAT_DIRECTION_LAST, UDAT_ABSOLUTE_DAY, result.remove(), status));
+        assertEquals("append", "Yesterday; Yesterday",
+            f.format(UDAT_DIRECTION_LAST, UDAT_ABSOLUTE_DAY, result.append(u"; "), status));
+    }
+    // More results than the memo holds, each formatted twice,
+    // compared with a formatter that has its own memo.
+    // Fractions and large quantities are not memoized but must format the same.
+    static const URelativeDateTimeUnit units[] = {
+        UDAT_REL_UNIT_MINUTE, UDAT_REL_UNIT_HOUR, UDAT_REL_UNIT_DAY
+    };
+    RelativeDateTimeFormatter other("en", nullptr, UDAT_STYLE_LONG,
+        UDISPCTX_CAPITALIZATION_FOR_BEGINNING_OF_SENTENCE, status);
+    UnicodeString expected;
+    for (int32_t i = 0; i < 1200; ++i) {
+        double quantity = (i / 3) % 100 - 50;
+        if (i >= 600) {
+            quantity = (i % 2 == 0) ? quantity + 0.5 : quantity * 3;
+        }
+        URelativeDateTimeUnit unit = units[i % 3];
+        fmt.format(quantity, unit, result.remove(), status);
+        other.format(quantity, unit, expected.remove(), status);
+        if (result != expected) {
+            errln(UnicodeString(u"format(") + quantity + u", " + unit + u") = " + result +
+                  u" but expected " + expected);
+            break;
+        }
+    }
+    assertEquals("formatNumeric fraction", "In 1.5 days",
+        fmt.formatNumeric(1.5, UDAT_REL_UNIT_DAY, result.remove(), status));
+    assertEquals("formatNumeric fraction again", "In 1.5 days",
+        fmt.formatNumeric(1.5, UDAT_REL_UNIT_DAY, result.remove(), status));
+    assertEquals("format after many", "In 2 hours",
+        fmt.format(2, UDAT_DIRECTION_NEXT, UDAT_RELATIVE_HOURS, result.remove(), status));
+    // Assignment shares the other formatter's memo, not its own old results.
+    RelativeDateTimeFormatter shortFmt("en", nullptr, UDAT_STYLE_SHORT,
+        UDISPCTX_CAPITALIZATION_NONE, status);
+    copy = shortFmt;
+    assertEquals("format after assignment", "in 2 hr.",
+        copy.format(2, UDAT_DIRECTION_NEXT, UDAT_RELATIVE_HOURS, result.remove(), status));
+}
+
 static const char *kLast2 = "Last_2";
 static const char *kLast = "Last";
 static const char *kThis = "This";
@@ -12,6 +12,9 @@
 #include "tsdtfmsy.h"
 
 #include "unicode/dtfmtsym.h"
+#include "unicode/smpdtfmt.h"
+#include "unicode/udat.h"
+#include "cmemory.h"
 
 
 //--------------------------------------------------------------------
@@ -29,6 +32,7 @@ void IntlTestDateFormatSymbols::runIndexedTest( int32_t index, UBool exec, const
         TESTCASE(3,TestGetWeekdays2);
         TESTCASE(4,TestGetEraNames);
         TESTCASE(5,TestGetSetSpecificItems);
+        TESTCASE(6,TestSharedArrays);
         default: name = ""; break;
     }
 }
@@ -164,6 +168,62 @@ void IntlTestDateFormatSymbols::TestGetSetSpecificItems()
     delete symbol;
 }
 
+/**
+ * Formatters for the same locale share the symbol arrays of the cached
+ * DateFormatSymbols; setting symbols must copy them first.
+ */
+void IntlTestDateFormatSymbols::TestSharedArrays()
+{
+    UErrorCode status = U_ZERO_ERROR;
+    UDate date = 1577836800000.0;  // 2020-01-01T00:00Z
+    SimpleDateFormat fmt1(UnicodeString(u"MMMM"), Locale::getEnglish(), status);
+    SimpleDateFormat fmt2(UnicodeString(u"MMMM"), Locale::getEnglish(), status);
+    if (U_FAILURE(status)) {
+        dataerrln("ERROR: Couldn't create English SimpleDateFormat " + (UnicodeString)u_errorName(status));
+        return;
+    }
+    fmt1.adoptTimeZone(TimeZone::getGMT()->clone());
+    fmt2.adoptTimeZone(TimeZone::getGMT()->clone());
+    int32_t count1, count2;
+    const UnicodeString *months1 = fmt1.getDateFormatSymbols()->getMonths(count1);
+    const UnicodeString *months2 = fmt2.getDateFormatSymbols()->getMonths(count2);
+    assertTrue("formatters share the month names", months1 == months2 && count1 == count2);
+    SimpleDateFormat fmt3(fmt1);
+    assertTrue("a copy shares the month names",
+               fmt3.getDateFormatSymbols()->getMonths(count2) == months1);
+
+    // Modify a copy of the symbols.
+    DateFormatSymbols symbols(*fmt1.getDateFormatSymbols());
+    UnicodeString newMonths[12];
+    for (int32_t i = 0; i < 12; ++i) {
+        newMonths[i] = months1[i] + u"!";
+    }
+    symbols.setMonths(newMonths, 12);
+    assertFalse("setMonths() copies the shared arrays", symbols.getMonths(count2) == months1);
+    assertEquals("shared month name unchanged", u"January", months1[0]);
+    fmt1.setDateFormatSymbols(symbols);
+    UnicodeString result;
+    assertEquals("modified symbols", u"January!", fmt1.format(date, result));
+    result.remove();
+    assertEquals("other formatter", u"January", fmt2.format(date, result));
+
+    // Modify one formatter's symbols in place through the C API.
+    UDateFormat *udf = udat_clone((const UDateFormat *)&fmt2, &status);
+    udat_setSymbols(udf, UDAT_MONTHS, 0, const_cast<UChar *>(u"Jan?"), -1, &status);
+    UChar buffer[32];
+    int32_t length = udat_format(udf, date, buffer, UPRV_LENGTHOF(buffer), NULL, &status);
+    if (assertSuccess("udat_setSymbols()", status)) {
+        assertEquals("udat_setSymbols() result", u"Jan?", UnicodeString(buffer, length));
+    }
+    udat_close(udf);
+    result.remove();
+    assertEquals("after udat_setSymbols()", u"January", fmt2.format(date, result));
+    SimpleDateFormat fmt4(UnicodeString(u"MMMM"), Locale::getEnglish(), status);
+    fmt4.adoptTimeZone(TimeZone::getGMT()->clone());
+    result.remove();
+    assertEquals("new formatter", u"January", fmt4.format(date, result));
+}
+
 /**
  * Test the API of DateFormatSymbols; primarily a simple get/set set.
  */
@@ -35,6 +35,7 @@ class IntlTestDateFormatSymbols: public IntlTest {
     void TestGetWeekdays2(void);
     void TestGetEraNames(void);
     void TestGetSetSpecificItems(void);
+    void TestSharedArrays(void);
 
     UBool UnicodeStringsArePrefixes(int32_t count, int32_t prefixLen, const UnicodeString *prefixArray, const UnicodeString *baseArray);
 };
@@ -52,6 +52,7 @@ MultithreadTest::~MultithreadTest()
 #include "unicode/locid.h"
 #include "unicode/coll.h"
 #include "unicode/calendar.h"
+#include "unicode/smpdtfmt.h"
 #include "ucaconf.h"
 
 
@@ -79,6 +80,9 @@ void MultithreadTest::runIndexedTest( int32_t index, UBool exec,
     TESTCASE_AUTO(Test20104);
 #endif /* #if !UCONFIG_NO_FORMATTING */
 #endif /* #if !UCONFIG_NO_TRANSLITERATION */
+#if !UCONFIG_NO_FORMATTING
+    TESTCASE_AUTO(TestCompiledDateFormatter);
+#endif
     TESTCASE_AUTO_END;
 }
 
@@ -1366,3 +1370,84 @@ void MultithreadTest::Test20104() {
 #endif /* !UCONFIG_NO_FORMATTING */
 
 #endif /* !UCONFIG_NO_TRANSLITERATION */
+
+#if !UCONFIG_NO_FORMATTING
+//-------------------------------------------------------------------------------------------
+//
+//   TestCompiledDateFormatter   Format with one CompiledDateFormatter from several threads,
+//                               without locking, and compare with a SimpleDateFormat.
+//
+//-------------------------------------------------------------------------------------------
+
+static const CompiledDateFormatter *gCompiledDateFormatter = nullptr;
+static const TimeZone *gCompiledDateFormatterZone = nullptr;
+static const UnicodeString *gCompiledDateFormatterExpected = nullptr;
+static constexpr int32_t COMPILED_DATE_FORMATTER_DATES = 200;
+
+static UDate compiledDateFormatterDate(int32_t i) {
+    // Every 37 days and a bit over an hour from 1990, across DST transitions.
+    return 631152000000.0 + i * (37 * 86400000.0 + 3723004.0);
+}
+
+class CompiledDateFormatterThread : public SimpleThread {
+public:
+    CompiledDateFormatterThread() {}
+    virtual void run();
+};
+
+void CompiledDateFormatterThread::run() {
+    for (int32_t loop = 0; loop < 20; ++loop) {
+        for (int32_t i = 0; i < COMPILED_DATE_FORMATTER_DATES; ++i) {
+            UErrorCode status = U_ZERO_ERROR;
+            UnicodeString actual;
+            gCompiledDateFormatter->format(compiledDateFormatterDate(i), *gCompiledDateFormatterZone,
+                                           actual, status);
+            if (U_FAILURE(status) || actual != gCompiledDateFormatterExpected[i]) {
+                IntlTest::gTest->errln("%s:%d CompiledDateFormatter::format() mismatch for date %d - %s",
+                                       __FILE__, __LINE__, (int)i, u_errorName(status));
+                return;
+            }
+        }
+    }
+}
+
+void MultithreadTest::TestCompiledDateFormatter() {
+    IcuTestErrorCode status(*this, "TestCompiledDateFormatter");
+    // One pattern that computes the Gregorian fields directly,
+    // and one that needs a temporary Calendar for the week fields.
+    static const char16_t *const patterns[] = {
+        u"EEEE, d MMMM y 'at' h:mm:ss.SSS a zzzz",
+        u"Y-'W'ww-e HH:mm"
+    };
+    LocalPointer<TimeZone> zone(TimeZone::createTimeZone(u"Europe/Paris"));
+    for (const char16_t *pattern : patterns) {
+        SimpleDateFormat sdf(pattern, Locale::getFrench(), status);
+        if (status.errDataIfFailureAndReset("SimpleDateFormat")) {
+            return;
+        }
+        sdf.setTimeZone(*zone);
+        UnicodeString expected[COMPILED_DATE_FORMATTER_DATES];
+        for (int32_t i = 0; i < COMPILED_DATE_FORMATTER_DATES; ++i) {
+            sdf.format(compiledDateFormatterDate(i), expected[i]);
+        }
+        CompiledDateFormatter cdf = sdf.compile(status);
+        if (status.errIfFailureAndReset("compile()")) {
+            return;
+        }
+        gCompiledDateFormatter = &cdf;
+        gCompiledDateFormatterZone = zone.getAlias();
+        gCompiledDateFormatterExpected = expected;
+
+        CompiledDateFormatterThread threads[4];
+        for (auto &thread : threads) {
+            thread.start();
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+    }
+    gCompiledDateFormatter = nullptr;
+    gCompiledDateFormatterZone = nullptr;
+    gCompiledDateFormatterExpected = nullptr;
+}
+#endif /* !UCONFIG_NO_FORMATTING */
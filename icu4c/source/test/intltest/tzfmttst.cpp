@@ -20,6 +20,7 @@
 #include "unicode/uchar.h"
 #include "unicode/basictz.h"
 #include "unicode/tzfmt.h"
+#include "unicode/tznames.h"
 #include "unicode/localpointer.h"
 #include "unicode/utf16.h"
 
@@ -27,6 +28,7 @@
 #include "cstr.h"
 #include "mutex.h"
 #include "simplethread.h"
+#include "tznames_impl.h"
 #include "uassert.h"
 #include "zonemeta.h"
 
@@ -86,6 +88,8 @@ TimeZoneFormatTest::runIndexedTest( int32_t index, UBool exec, const char* &name
         TESTCASE(6, TestFormatCustomZone);
         TESTCASE(7, TestFormatTZDBNamesAllZoneCoverage);
         TESTCASE(8, TestAdoptDefaultThreadSafe);
+        TESTCASE(9, TestFindAllNames);
+        TESTCASE(10, TestTextTrieMap);
     default: name = ""; break;
     }
 }
@@ -1340,4 +1344,132 @@ TimeZoneFormatTest::TestFormatTZDBNamesAllZoneCoverage(void) {
         }
     }
 }
+void
+TimeZoneFormatTest::TestFindAllNames(void) {
+    // After loading all of the names, find() matches them case-insensitively
+    // in the index of all names.
+    UErrorCode status = U_ZERO_ERROR;
+    LocalPointer<TimeZoneNames> tzn(TimeZoneNames::createInstance(Locale("en"), status));
+    if (U_FAILURE(status)) {
+        dataerrln("FAIL: TimeZoneNames::createInstance failed for en - %s", u_errorName(status));
+        return;
+    }
+    tzn->loadAllDisplayNames(status);
+    assertSuccess("loadAllDisplayNames", status);
+
+    static const struct {
+        const char16_t *text;
+        int32_t start;
+        uint32_t types;
+        UTimeZoneNameType expectedType;
+        int32_t expectedLength;
+        const char16_t *expectedZoneID;
+        const char16_t *expectedMetaZoneID;
+    } TESTDATA[] = {
+        { u"Central European Summer Time", 0, UTZNM_LONG_DAYLIGHT, UTZNM_LONG_DAYLIGHT, 28,
+          nullptr, u"Europe_Central" },
+        { u"at CENTRAL european SUMMER time.", 3, UTZNM_LONG_DAYLIGHT | UTZNM_LONG_STANDARD,
+          UTZNM_LONG_DAYLIGHT, 28, nullptr, u"Europe_Central" },
+        { u"in pariS", 3, UTZNM_EXEMPLAR_LOCATION, UTZNM_EXEMPLAR_LOCATION, 5,
+          u"Europe/Paris", nullptr },
+        { u"Nowhere Time", 0, UTZNM_LONG_GENERIC | UTZNM_LONG_STANDARD | UTZNM_EXEMPLAR_LOCATION,
+          UTZNM_UNKNOWN, 0, nullptr, nullptr },
+    };
+    for (const auto &item : TESTDATA) {
+        UnicodeString text(item.text);
+        LocalPointer<TimeZoneNames::MatchInfoCollection> matches(
+            tzn->find(text, item.start, item.types, status));
+        if (!assertSuccess(UnicodeString(u"find ") + text, status)) {
+            return;
+        }
+        if (item.expectedType == UTZNM_UNKNOWN) {
+            assertTrue(UnicodeString(u"no match for ") + text, matches.isNull());
+            continue;
+        }
+        if (matches.isNull() || matches->size() != 1) {
+            errln(UnicodeString(u"FAIL: expected one match for ") + text);
+            continue;
+        }
+        assertEquals(UnicodeString(u"type for ") + text, item.expectedType, matches->getNameTypeAt(0));
+        assertEquals(UnicodeString(u"length for ") + text, item.expectedLength, matches->getMatchLengthAt(0));
+        UnicodeString id;
+        if (item.expectedZoneID != nullptr) {
+            matches->getTimeZoneIDAt(0, id);
+            assertEquals(UnicodeString(u"zone for ") + text, item.expectedZoneID, id);
+        } else {
+            matches->getMetaZoneIDAt(0, id);
+            assertEquals(UnicodeString(u"metazone for ") + text, item.expectedMetaZoneID, id);
+        }
+    }
+}
+
+// Collects the matches of a TextTrieMap search as "length:value" strings,
+// for match lengths up to 9.
+class TextTrieMapTestHandler : public TextTrieMapSearchResultHandler {
+public:
+    UBool handleMatch(int32_t matchLength, const TextTrieMapValues *values, UErrorCode &) {
+        for (int32_t i = 0; i < values->countValues(); i++) {
+            matches.append((UChar)(u'0' + matchLength)).append(u':')
+                .append(UnicodeString((const char *)values->getValue(i), -1, US_INV)).append(u' ');
+        }
+        return TRUE;
+    }
+    UnicodeString matches;
+};
+
+void
+TimeZoneFormatTest::TestTextTrieMap() {
+    IcuTestErrorCode status(*this, "TestTextTrieMap");
+    TextTrieMap trie(TRUE, NULL);
+    assertTrue("new map is empty", trie.isEmpty());
+    static const struct {
+        const char16_t *key;
+        const char *value;
+    } entries[] = {
+        { u"Paris", "paris" },
+        { u"Pa", "pa" },
+        { u"PARIS", "PARIS" },
+        { u"Straße", "strasse" },
+        { u"Lisbon", "lisbon" },
+    };
+    for (const auto &entry : entries) {
+        trie.put(entry.key, const_cast<char *>(entry.value), status);
+    }
+    // Enough other entries that one more is matched without rebuilding the trie.
+    static const char16_t *const fillers[] = {
+        u"Ab", u"Bc", u"Cd", u"De", u"Ef", u"Fg", u"Gh", u"Hi",
+        u"Ij", u"Jk", u"Kl", u"Lm", u"Mn", u"No", u"Op", u"Pq"
+    };
+    for (const char16_t *filler : fillers) {
+        trie.put(filler, const_cast<char *>("filler"), status);
+    }
+    assertFalse("map is not empty", trie.isEmpty());
+
+    // The first search builds the trie.
+    static const struct {
+        const char16_t *text;
+        int32_t start;
+        const char *expected;
+    } cases[] = {
+        { u"paris, france", 0, "2:pa 5:paris 5:PARIS " },
+        { u"in PA", 3, "2:pa " },
+        { u"STRASSE", 0, "7:strasse " },
+        { u"Lisbo", 0, "" },
+        { u"", 0, "" },
+    };
+    for (const auto &cas : cases) {
+        TextTrieMapTestHandler handler;
+        trie.search(cas.text, cas.start, &handler, status);
+        assertEquals(UnicodeString(u"search ") + cas.text, cas.expected, handler.matches);
+    }
+
+    // A few entries put after the trie was built are found as well, after the trie's.
+    static const char16_t key[] = u"PARis";
+    trie.put(key, const_cast<char *>("later"), status);
+    TextTrieMapTestHandler handler;
+    trie.search(u"Paris", 0, &handler, status);
+    assertEquals("search after put", "2:pa 5:paris 5:PARIS 5:later ", handler.matches);
+    status.errIfFailureAndReset();
+}
+
 #endif /* #if !UCONFIG_NO_FORMATTING */
@@ -30,6 +30,8 @@ class TimeZoneFormatTest : public IntlTest {
     void TestFormatCustomZone(void);
     void TestFormatTZDBNamesAllZoneCoverage(void);
     void TestAdoptDefaultThreadSafe(void);
+    void TestFindAllNames(void);
+    void TestTextTrieMap(void);
 
     void RunTimeRoundTripTests(int32_t threadNumber);
     void RunAdoptDefaultThreadSafeTests(int32_t threadNumber);
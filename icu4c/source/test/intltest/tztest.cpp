@@ -16,6 +16,7 @@
 #include "unicode/gregocal.h"
 #include "unicode/resbund.h"
 #include "unicode/strenum.h"
+#include "unicode/tztrans.h"
 #include "unicode/uversion.h"
 #include "tztest.h"
 #include "cmemory.h"
@@ -75,6 +76,7 @@ void TimeZoneTest::runIndexedTest( int32_t index, UBool exec, const char* &name,
     TESTCASE_AUTO(TestGetGMT);
     TESTCASE_AUTO(TestGetWindowsID);
     TESTCASE_AUTO(TestGetIDForWindowsID);
+    TESTCASE_AUTO(TestOffsetLookupOrder);
     TESTCASE_AUTO_END;
 }
 
@@ -2492,4 +2494,143 @@ void TimeZoneTest::TestGetIDForWindowsID(void) {
     }
 }
 
+/*
+ * OlsonTimeZone remembers the transition interval of the last lookup, and looks up
+ * dates in the finalZone range in a table of transitions.  The offsets must not depend
+ * on the order of the lookups, including dates beyond the end of that table,
+ * and must match the zones' final rules.
+ */
+void TimeZoneTest::TestOffsetLookupOrder() {
+    static const char *const ZONES[] = {
+        "America/New_York", "Europe/London", "Australia/Lord_Howe", "America/Sao_Paulo",
+        "Asia/Tokyo", "Africa/Casablanca", "Pacific/Apia", "Antarctica/Troll"
+    };
+    // 1800 to 2200, in steps of about five weeks, and some times near transitions
+    static const int32_t COUNT = 4000;
+    const UDate start = -5364662400000.0;
+    const UDate step = 36.6 * U_MILLIS_PER_DAY + 3601;
+    for (int32_t z = 0; z < UPRV_LENGTHOF(ZONES); z++) {
+        UErrorCode status = U_ZERO_ERROR;
+        LocalPointer<BasicTimeZone> zone(
+            dynamic_cast<BasicTimeZone *>(TimeZone::createTimeZone(ZONES[z])));
+        if (zone.isNull()) {
+            errln("Could not create %s", ZONES[z]);
+            continue;
+        }
+        UDate dates[COUNT];
+        for (int32_t i = 0; i < COUNT; i++) {
+            dates[i] = start + i * step;
+        }
+        TimeZoneTransition tzt;
+        UDate base = start;
+        for (int32_t i = 0; i < COUNT / 2 && zone->getNextTransition(base, FALSE, tzt); i += 4) {
+            base = tzt.getTime();
+            dates[i] = base;
+            dates[i + 1] = base - 1;
+            dates[i + 2] = base + 1.5 * U_MILLIS_PER_HOUR;
+            dates[i + 3] = base - 1.5 * U_MILLIS_PER_HOUR;
+        }
+        int32_t raw[COUNT], dst[COUNT], localRaw[COUNT], localDst[COUNT];
+        for (int32_t i = 0; i < COUNT; i++) {
+            zone->getOffset(dates[i], FALSE, raw[i], dst[i], status);
+            zone->getOffsetFromLocal(dates[i], BasicTimeZone::kFormer, BasicTimeZone::kLatter,
+                                     localRaw[i], localDst[i], status);
+        }
+        // Every lookup in a new zone, and in a scrambled order in one zone.
+        for (int32_t i = 0; i < COUNT && U_SUCCESS(status); i++) {
+            LocalPointer<BasicTimeZone> fresh(zone->clone());
+            int32_t r, d;
+            fresh->getOffset(dates[i], FALSE, r, d, status);
+            if (r != raw[i] || d != dst[i]) {
+                errln("%s: getOffset(%.0f) in a new zone %d/%d, expected %d/%d",
+                      ZONES[z], dates[i], (int)r, (int)d, (int)raw[i], (int)dst[i]);
+            }
+            int32_t j = (int32_t)(((int64_t)i * 7919) % COUNT);
+            zone->getOffset(dates[j], FALSE, r, d, status);
+            if (r != raw[j] || d != dst[j]) {
+                errln("%s: getOffset(%.0f) out of order %d/%d, expected %d/%d",
+                      ZONES[z], dates[j], (int)r, (int)d, (int)raw[j], (int)dst[j]);
+            }
+            zone->getOffsetFromLocal(dates[j], BasicTimeZone::kFormer, BasicTimeZone::kLatter, r, d, status);
+            if (r != localRaw[j] || d != localDst[j]) {
+                errln("%s: getOffsetFromLocal(%.0f) out of order %d/%d, expected %d/%d",
+                      ZONES[z], dates[j], (int)r, (int)d, (int)localRaw[j], (int)localDst[j]);
+            }
+        }
+        if (U_FAILURE(status)) {
+            errln("%s: %s", ZONES[z], u_errorName(status));
+        }
+    }
+
+    // Compare with the final rules from the tz database, which SimpleTimeZone applies
+    // with calendar field computations, up to well past the end of the table
+    // of transitions (100 years from the start of each final rule).
+    UErrorCode status = U_ZERO_ERROR;
+    SimpleTimeZone newYork(-5 * U_MILLIS_PER_HOUR, u"America/New_York",
+        UCAL_MARCH, 2, UCAL_SUNDAY, 2 * U_MILLIS_PER_HOUR,
+        UCAL_NOVEMBER, 1, UCAL_SUNDAY, 2 * U_MILLIS_PER_HOUR, U_MILLIS_PER_HOUR, status);
+    SimpleTimeZone london(0, u"Europe/London",
+        UCAL_MARCH, -1, UCAL_SUNDAY, U_MILLIS_PER_HOUR,
+        UCAL_OCTOBER, -1, UCAL_SUNDAY, 2 * U_MILLIS_PER_HOUR, U_MILLIS_PER_HOUR, status);
+    SimpleTimeZone lordHowe(10 * U_MILLIS_PER_HOUR + 30 * U_MILLIS_PER_MINUTE, u"Australia/Lord_Howe",
+        UCAL_OCTOBER, 1, -UCAL_SUNDAY, 2 * U_MILLIS_PER_HOUR,
+        UCAL_APRIL, 1, -UCAL_SUNDAY, 2 * U_MILLIS_PER_HOUR, 30 * U_MILLIS_PER_MINUTE, status);
+    if (U_FAILURE(status)) {
+        errln("SimpleTimeZone: %s", u_errorName(status));
+        return;
+    }
+    const SimpleTimeZone *const references[] = { &newYork, &london, &lordHowe };
+    const UDate start2020 = 1577836800000.0;
+    const UDate start2100 = 4102444800000.0;
+    const UDate start2200 = 7258118400000.0;
+    for (const SimpleTimeZone *reference : references) {
+        UnicodeString id;
+        reference->getID(id);
+        LocalPointer<BasicTimeZone> zone(
+            dynamic_cast<BasicTimeZone *>(TimeZone::createTimeZone(id)));
+        if (zone.isNull()) {
+            errln(UnicodeString(u"Could not create ") + id);
+            continue;
+        }
+        // 2020 to 2200 in steps of about 25 days, then the times
+        // around each transition from 2100 to 2200.
+        UDate dates[COUNT];
+        int32_t count = 0;
+        for (UDate date = start2020; date < start2200 && count < COUNT;
+                date += 25.3 * U_MILLIS_PER_DAY + 1234) {
+            dates[count++] = date;
+        }
+        TimeZoneTransition tzt;
+        UDate base = start2100;
+        while (count + 4 <= COUNT && reference->getNextTransition(base, FALSE, tzt) &&
+                tzt.getTime() < start2200) {
+            base = tzt.getTime();
+            dates[count++] = base;
+            dates[count++] = base - 1;
+            dates[count++] = base + 0.5 * U_MILLIS_PER_HOUR;
+            dates[count++] = base - 1.5 * U_MILLIS_PER_HOUR;
+        }
+        for (int32_t i = 0; i < count && U_SUCCESS(status); i++) {
+            int32_t r, d, expectedRaw, expectedDst;
+            zone->getOffset(dates[i], FALSE, r, d, status);
+            reference->getOffset(dates[i], FALSE, expectedRaw, expectedDst, status);
+            if (r != expectedRaw || d != expectedDst) {
+                errln(id + u": getOffset(" + dates[i] + u") " + r + u"/" + d +
+                      u", expected " + expectedRaw + u"/" + expectedDst);
+            }
+            zone->getOffsetFromLocal(dates[i], BasicTimeZone::kFormer, BasicTimeZone::kLatter,
+                                     r, d, status);
+            reference->getOffsetFromLocal(dates[i], BasicTimeZone::kFormer, BasicTimeZone::kLatter,
+                                          expectedRaw, expectedDst, status);
+            if (r != expectedRaw || d != expectedDst) {
+                errln(id + u": getOffsetFromLocal(" + dates[i] + u") " + r + u"/" + d +
+                      u", expected " + expectedRaw + u"/" + expectedDst);
+            }
+        }
+        if (U_FAILURE(status)) {
+            errln(id + u": " + u_errorName(status));
+        }
+    }
+}
+
 #endif /* #if !UCONFIG_NO_FORMATTING */
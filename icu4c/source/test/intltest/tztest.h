@@ -104,6 +104,8 @@ class TimeZoneTest: public CalendarTimeZoneTest {
     void TestGetWindowsID(void);
     void TestGetIDForWindowsID(void);
 
+    void TestOffsetLookupOrder();
+
     static const UDate INTERVAL;
 
 private:
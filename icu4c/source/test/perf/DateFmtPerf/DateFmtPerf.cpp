@@ -60,6 +60,16 @@ UPerfFunction* DateFormatPerfTest::runIndexedTest(int32_t index, UBool exec,cons
         TESTCASE(22,DateFmtCopy10000);
         TESTCASE(23,DateFmtCreate250);
         TESTCASE(24,DateFmtCreate10000);
+        TESTCASE(25,DateFmtISO10000);
+        TESTCASE(26,DateFmtLog10000);
+        TESTCASE(27,DateFmtLog1000000);
+        TESTCASE(28, DTPatternGeneratorCreateBest250);
+        TESTCASE(29, DTPatternGeneratorCreateBest10000);
+        TESTCASE(30,DateFmtLogBatch1000000);
+        TESTCASE(31,DateFmtParseISO100000);
+        TESTCASE(32,DateFmtParseISOBatch100000);
+        TESTCASE(33, DIFFormat100000);
+        TESTCASE(34, RelDateFmt100000);
 
 
         default: 
@@ -168,6 +178,14 @@ UPerfFunction *DateFormatPerfTest::DTPatternGeneratorBestValue10000() {
     return new DTPatternGeneratorBestValueFunction(10000, locale);
 }
 
+UPerfFunction *DateFormatPerfTest::DTPatternGeneratorCreateBest250() {
+    return new DTPatternGeneratorCreateBestFunction(250, locale);
+}
+
+UPerfFunction *DateFormatPerfTest::DTPatternGeneratorCreateBest10000() {
+    return new DTPatternGeneratorCreateBestFunction(10000, locale);
+}
+
 UPerfFunction* DateFormatPerfTest::DateFmtCopy250(){
     return new DateFmtCopyFunction(250, locale);
 }
@@ -184,6 +202,41 @@ UPerfFunction* DateFormatPerfTest::DateFmtCreate10000(){
     return new DateFmtCreateFunction(10000, locale);
 }
 
+UPerfFunction* DateFormatPerfTest::DateFmtISO10000(){
+    return new DateFmtPatternFunction(10000, locale, u"yyyy-MM-dd'T'HH:mm:ss.SSSXXX");
+}
+
+UPerfFunction* DateFormatPerfTest::DateFmtLog10000(){
+    return new DateFmtPatternFunction(10000, locale, u"yyyy-MM-dd HH:mm:ss,SSS");
+}
+
+UPerfFunction* DateFormatPerfTest::DateFmtLog1000000(){
+    return new DateFmtPatternFunction(1000000, locale, u"yyyy-MM-dd HH:mm:ss,SSS");
+}
+
+UPerfFunction* DateFormatPerfTest::DateFmtLogBatch1000000(){
+    return new DateFmtBatchFunction(1000000, locale, u"yyyy-MM-dd HH:mm:ss,SSS",
+                                    DateFmtBatchFunction::FORMAT_BATCH);
+}
+
+UPerfFunction* DateFormatPerfTest::DateFmtParseISO100000(){
+    return new DateFmtBatchFunction(100000, locale, u"yyyy-MM-dd'T'HH:mm:ss.SSSXXX",
+                                    DateFmtBatchFunction::PARSE_EACH);
+}
+
+UPerfFunction* DateFormatPerfTest::DateFmtParseISOBatch100000(){
+    return new DateFmtBatchFunction(100000, locale, u"yyyy-MM-dd'T'HH:mm:ss.SSSXXX",
+                                    DateFmtBatchFunction::PARSE_BATCH);
+}
+
+UPerfFunction* DateFormatPerfTest::DIFFormat100000(){
+    return new IntervalFmtFunction(100000, locale, IntervalFmtFunction::DATE_INTERVAL);
+}
+
+UPerfFunction* DateFormatPerfTest::RelDateFmt100000(){
+    return new IntervalFmtFunction(100000, locale, IntervalFmtFunction::RELATIVE_DATE_TIME);
+}
+
 
 int main(int argc, const char* argv[]){
 
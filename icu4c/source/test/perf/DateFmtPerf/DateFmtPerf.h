@@ -19,8 +19,10 @@
 #include "unicode/uperf.h"
 
 #include "unicode/dtitvfmt.h"
+#include "unicode/reldatefmt.h"
 #include "unicode/utypes.h"
 #include "unicode/datefmt.h"
+#include "unicode/smpdtfmt.h"
 #include "unicode/calendar.h"
 #include "unicode/uclean.h"
 #include "unicode/brkiter.h"
@@ -372,6 +374,72 @@ class DIFCreateFunction : public UPerfFunction
 
 };
 
+// Formats num intervals, or relative dates, with a single formatter,
+// cycling through the interval buckets (largest different field)
+// and through a few relative quantities and units.
+class IntervalFmtFunction : public UPerfFunction
+{
+
+public:
+    enum Mode { DATE_INTERVAL, RELATIVE_DATE_TIME };
+
+private:
+    int num;
+    Mode mode;
+    char locale[25];
+
+public:
+
+    IntervalFmtFunction(int a, const char* loc, Mode m) : num(a), mode(m)
+    {
+        strcpy(locale, loc);
+    }
+
+    virtual void call(UErrorCode* /* status */)
+    {
+        UErrorCode status2 = U_ZERO_ERROR;
+        Locale loc(locale);
+        UnicodeString result;
+        if (mode == RELATIVE_DATE_TIME) {
+            RelativeDateTimeFormatter fmt(loc, status2);
+            check(status2, "RelativeDateTimeFormatter constructor");
+            for(int j = 0; j < num; j++) {
+                fmt.format((j % 7) - 3, (URelativeDateTimeUnit)(j % UDAT_REL_UNIT_SUNDAY),
+                           result.remove(), status2);
+            }
+            check(status2, "RelativeDateTimeFormatter::format()");
+            return;
+        }
+        LocalPointer<DateIntervalFormat> fmt(
+            DateIntervalFormat::createInstance(UnicodeString("yMMMdjm"), loc, status2));
+        check(status2, "DateIntervalFormat::createInstance");
+        fmt->adoptTimeZone(TimeZone::createTimeZone("GMT"));
+        // 2020-01-01, and minutes, hours, days, months or years later.
+        static const double deltas[] = { 6e4 * 5, 6e4 * 130, 6e4 * 780, 6e4 * 3000, 6e4 * 50000, 6e4 * 600000 };
+        UDate from = 1577836800000.0;
+        FieldPosition pos;
+        for(int j = 0; j < num; j++) {
+            DateInterval interval(from, from + deltas[j % UPRV_LENGTHOF(deltas)]);
+            fmt->format(&interval, result.remove(), pos, status2);
+        }
+        check(status2, "DateIntervalFormat::format()");
+    }
+
+    virtual long getOperationsPerIteration()
+    {
+        return num;
+    }
+
+    // Verify that a UErrorCode is successful; exit(1) if not
+    void check(UErrorCode& status, const char* msg) {
+        if (U_FAILURE(status)) {
+            printf("ERROR: %s (%s)\n", u_errorName(status), msg);
+            exit(1);
+        }
+    }
+
+};
+
 class TimeZoneCreateFunction : public UPerfFunction
 {
 
@@ -556,6 +624,203 @@ class DTPatternGeneratorBestValueFunction : public UPerfFunction
 
 };
 
+// Creates a generator and gets one best pattern from it, as code does that
+// opens a generator wherever it needs a pattern for a skeleton.
+class DTPatternGeneratorCreateBestFunction : public UPerfFunction
+{
+private:
+    int num;
+    char locale[25];
+public:
+    DTPatternGeneratorCreateBestFunction(int a, const char* loc)
+    {
+        num = a;
+        strcpy(locale, loc);
+    }
+
+    virtual void call(UErrorCode* /* status */)
+    {
+        UErrorCode status2 = U_ZERO_ERROR;
+        Locale loc(locale);
+        static const char16_t *const skeletons[] = {
+            u"yMMMd", u"yMMMMEEEEd", u"jmm", u"MMMdjmm", u"yQQQ", u"Hms"
+        };
+
+        for(int j = 0; j < num; j++) {
+            LocalPointer<DateTimePatternGenerator> gen(
+                DateTimePatternGenerator::createInstance(loc, status2));
+            if (U_FAILURE(status2)) {
+                break;
+            }
+            gen->getBestPattern(skeletons[j % UPRV_LENGTHOF(skeletons)], status2);
+        }
+        check(status2, "createInstance+getBestPattern");
+    }
+
+    virtual long getOperationsPerIteration()
+    {
+        return num;
+    }
+
+    // Verify that a UErrorCode is successful; exit(1) if not
+    void check(UErrorCode& status, const char* msg) {
+        if (U_FAILURE(status)) {
+            printf("ERROR: %s (%s)\n", u_errorName(status), msg);
+            exit(1);
+        }
+    }
+};
+
+// Formats timestamps with a fixed, numeric pattern, as when writing ISO 8601
+// dates or log timestamps: A shared formatter, one call per timestamp.
+class DateFmtPatternFunction : public UPerfFunction
+{
+
+private:
+    int num;
+    char locale[25];
+    UnicodeString pattern;
+public:
+
+    DateFmtPatternFunction(int a, const char* loc, const UnicodeString &pat)
+            : num(a), pattern(pat)
+    {
+        strcpy(locale, loc);
+    }
+
+    virtual void call(UErrorCode* /* status */)
+    {
+        UErrorCode status2 = U_ZERO_ERROR;
+        SimpleDateFormat fmt(pattern, Locale(locale), status2);
+        check(status2, "SimpleDateFormat constructor");
+        fmt.adoptTimeZone(TimeZone::createTimeZone("GMT"));
+        UnicodeString str;
+        // 2020-01-01, then about every three hours and a millisecond later.
+        UDate date = 1577836800000.0;
+        for(int j = 0; j < num; j++) {
+            str.remove();
+            fmt.format(date, str);
+            date += 10800001.0;
+        }
+    }
+
+    virtual long getOperationsPerIteration()
+    {
+        return num;
+    }
+
+    // Verify that a UErrorCode is successful; exit(1) if not
+    void check(UErrorCode& status, const char* msg) {
+        if (U_FAILURE(status)) {
+            printf("ERROR: %s (%s)\n", u_errorName(status), msg);
+            exit(1);
+        }
+    }
+
+};
+
+// Formats or parses the same timestamps as DateFmtPatternFunction,
+// with CompiledDateFormatter::formatDates() and parseDates() on batches of 1000,
+// or with one SimpleDateFormat::parse() call per timestamp.
+class DateFmtBatchFunction : public UPerfFunction
+{
+
+public:
+    enum Mode { FORMAT_BATCH, PARSE_EACH, PARSE_BATCH };
+
+private:
+    static const int32_t kBatchSize = 1000;
+    int num;
+    Mode mode;
+    char locale[25];
+    UnicodeString pattern;
+    UDate *dates;
+    UnicodeString text;     // the formatted dates for parsing
+    int32_t *offsets;
+
+public:
+
+    DateFmtBatchFunction(int a, const char* loc, const UnicodeString &pat, Mode m)
+            : num(a), mode(m), pattern(pat)
+    {
+        strcpy(locale, loc);
+        dates = new UDate[num];
+        offsets = new int32_t[num + 1];
+        // 2020-01-01, then about every three hours and a millisecond later.
+        UDate date = 1577836800000.0;
+        for(int j = 0; j < num; j++) {
+            dates[j] = date;
+            date += 10800001.0;
+        }
+        if (mode != FORMAT_BATCH) {
+            UErrorCode status = U_ZERO_ERROR;
+            SimpleDateFormat fmt(pattern, Locale(locale), status);
+            check(status, "SimpleDateFormat constructor");
+            fmt.adoptTimeZone(TimeZone::createTimeZone("GMT"));
+            for(int j = 0; j < num; j++) {
+                offsets[j] = text.length();
+                fmt.format(dates[j], text);
+            }
+            offsets[num] = text.length();
+        }
+    }
+
+    virtual ~DateFmtBatchFunction()
+    {
+        delete[] dates;
+        delete[] offsets;
+    }
+
+    virtual void call(UErrorCode* /* status */)
+    {
+        UErrorCode status2 = U_ZERO_ERROR;
+        LocalPointer<TimeZone> zone(TimeZone::createTimeZone("GMT"));
+        if (mode == PARSE_EACH) {
+            SimpleDateFormat fmt(pattern, Locale(locale), status2);
+            check(status2, "SimpleDateFormat constructor");
+            fmt.adoptTimeZone(zone->clone());
+            ParsePosition pos;
+            for(int j = 0; j < num; j++) {
+                UnicodeString s(text, offsets[j], offsets[j + 1] - offsets[j]);
+                pos.setIndex(0);
+                dates[j] = fmt.parse(s, pos);
+            }
+            return;
+        }
+        CompiledDateFormatter cdf = CompiledDateFormatter::forPattern(pattern, Locale(locale), status2);
+        check(status2, "CompiledDateFormatter::forPattern()");
+        if (mode == PARSE_BATCH) {
+            for(int j = 0; j < num; j += kBatchSize) {
+                int32_t count = num - j < kBatchSize ? num - j : kBatchSize;
+                cdf.parseDates(text.getBuffer(), offsets + j, count, *zone, dates + j, status2);
+            }
+            check(status2, "parseDates()");
+            return;
+        }
+        char16_t buffer[kBatchSize * 32];
+        int32_t batchOffsets[kBatchSize + 1];
+        for(int j = 0; j < num; j += kBatchSize) {
+            int32_t count = num - j < kBatchSize ? num - j : kBatchSize;
+            cdf.formatDates(dates + j, count, *zone, buffer, UPRV_LENGTHOF(buffer), batchOffsets, status2);
+        }
+        check(status2, "formatDates()");
+    }
+
+    virtual long getOperationsPerIteration()
+    {
+        return num;
+    }
+
+    // Verify that a UErrorCode is successful; exit(1) if not
+    void check(UErrorCode& status, const char* msg) {
+        if (U_FAILURE(status)) {
+            printf("ERROR: %s (%s)\n", u_errorName(status), msg);
+            exit(1);
+        }
+    }
+
+};
+
 class NumFmtFunction : public UPerfFunction
 {
 
@@ -844,6 +1109,16 @@ class DateFormatPerfTest : public UPerfTest
     UPerfFunction* DTPatternGeneratorCopy10000();
     UPerfFunction* DTPatternGeneratorBestValue250();
     UPerfFunction* DTPatternGeneratorBestValue10000();
+    UPerfFunction* DTPatternGeneratorCreateBest250();
+    UPerfFunction* DTPatternGeneratorCreateBest10000();
+    UPerfFunction* DateFmtISO10000();
+    UPerfFunction* DateFmtLog10000();
+    UPerfFunction* DateFmtLog1000000();
+    UPerfFunction* DateFmtLogBatch1000000();
+    UPerfFunction* DateFmtParseISO100000();
+    UPerfFunction* DateFmtParseISOBatch100000();
+    UPerfFunction* DIFFormat100000();
+    UPerfFunction* RelDateFmt100000();
 };
 
 #endif // DateFmtPerf
@@ -116,6 +116,13 @@ UPerfFunction* ConverterPerformanceTest::runIndexedTest(int32_t index, UBool exe
         TESTCASE(52,TestWinANSI_ISO2022JP_ToUnicode);
         TESTCASE(53,TestWinANSI_ISO2022JP_FromUnicode);
 
+        TESTCASE(54,TestICU_SJIS_ToUTF8);
+        TESTCASE(55,TestICU_SJIS_ToUTF8ViaUTF16);
+        TESTCASE(56,TestICU_GBK_ToUTF8);
+        TESTCASE(57,TestICU_GBK_ToUTF8ViaUTF16);
+        TESTCASE(58,TestICU_Windows1252_ToUTF8);
+        TESTCASE(59,TestICU_Windows1252_ToUTF8ViaUTF16);
+
         default: 
             name = ""; 
             return NULL;
@@ -657,3 +664,57 @@ UPerfFunction*  ConverterPerformanceTest::TestWinANSI_ISO2022JP_ToUnicode(){
     }
     return pf;
 }
+
+UPerfFunction* ConverterPerformanceTest::TestICU_SJIS_ToUTF8(){
+    UErrorCode status = U_ZERO_ERROR;
+    UPerfFunction* pf = new ICUConvertToUTF8PerfFunction("sjis",(char*)sjis_encSource, UPRV_LENGTHOF(sjis_encSource), FALSE, status);
+    if(U_FAILURE(status)){
+        return NULL;
+    }
+    return pf;
+}
+
+UPerfFunction* ConverterPerformanceTest::TestICU_SJIS_ToUTF8ViaUTF16(){
+    UErrorCode status = U_ZERO_ERROR;
+    UPerfFunction* pf = new ICUConvertToUTF8PerfFunction("sjis",(char*)sjis_encSource, UPRV_LENGTHOF(sjis_encSource), TRUE, status);
+    if(U_FAILURE(status)){
+        return NULL;
+    }
+    return pf;
+}
+
+UPerfFunction* ConverterPerformanceTest::TestICU_GBK_ToUTF8(){
+    UErrorCode status = U_ZERO_ERROR;
+    UPerfFunction* pf = new ICUConvertToUTF8PerfFunction("gbk",(char*)gb2312_encSource, UPRV_LENGTHOF(gb2312_encSource), FALSE, status);
+    if(U_FAILURE(status)){
+        return NULL;
+    }
+    return pf;
+}
+
+UPerfFunction* ConverterPerformanceTest::TestICU_GBK_ToUTF8ViaUTF16(){
+    UErrorCode status = U_ZERO_ERROR;
+    UPerfFunction* pf = new ICUConvertToUTF8PerfFunction("gbk",(char*)gb2312_encSource, UPRV_LENGTHOF(gb2312_encSource), TRUE, status);
+    if(U_FAILURE(status)){
+        return NULL;
+    }
+    return pf;
+}
+
+UPerfFunction* ConverterPerformanceTest::TestICU_Windows1252_ToUTF8(){
+    UErrorCode status = U_ZERO_ERROR;
+    UPerfFunction* pf = new ICUConvertToUTF8PerfFunction("windows-1252",(char*)latin1_encSource, UPRV_LENGTHOF(latin1_encSource), FALSE, status);
+    if(U_FAILURE(status)){
+        return NULL;
+    }
+    return pf;
+}
+
+UPerfFunction* ConverterPerformanceTest::TestICU_Windows1252_ToUTF8ViaUTF16(){
+    UErrorCode status = U_ZERO_ERROR;
+    UPerfFunction* pf = new ICUConvertToUTF8PerfFunction("windows-1252",(char*)latin1_encSource, UPRV_LENGTHOF(latin1_encSource), TRUE, status);
+    if(U_FAILURE(status)){
+        return NULL;
+    }
+    return pf;
+}
@@ -117,6 +117,55 @@ class ICUFromUnicodePerfFunction : public UPerfFunction{
     }
 };
 
+/*
+ * Converts from a charset directly to UTF-8 with ucnv_convertEx(),
+ * or with ucnv_toUnicode() + ucnv_fromUnicode() through a UTF-16 buffer
+ * for comparison.
+ */
+class ICUConvertToUTF8PerfFunction : public UPerfFunction{
+private:
+    UConverter* conv;
+    UConverter* utf8Conv;
+    const char* src;
+    int32_t srcLen;
+    UBool viaUTF16;
+    UChar pivot[MAX_BUF_SIZE];
+    char target[MAX_BUF_SIZE*3];
+
+public:
+    ICUConvertToUTF8PerfFunction(const char* name, const char* source, int32_t sourceLen, UBool viaUnicode, UErrorCode& status){
+        conv = ucnv_open(name,&status);
+        utf8Conv = ucnv_open("UTF-8",&status);
+        src = source;
+        srcLen = sourceLen;
+        viaUTF16 = viaUnicode;
+        if(U_SUCCESS(status) && srcLen>MAX_BUF_SIZE){
+            status = U_BUFFER_OVERFLOW_ERROR;
+        }
+    }
+    virtual void call(UErrorCode* status){
+        const char* mySrc = src;
+        const char* sourceLimit = src + srcLen;
+        char* myTarget = target;
+        if(viaUTF16) {
+            UChar* myPivot = pivot;
+            const UChar* pivotSrc = pivot;
+            ucnv_toUnicode(conv, &myPivot, pivot+MAX_BUF_SIZE, &mySrc, sourceLimit, NULL, TRUE, status);
+            ucnv_fromUnicode(utf8Conv, &myTarget, target+sizeof(target), &pivotSrc, myPivot, NULL, TRUE, status);
+        } else {
+            ucnv_convertEx(utf8Conv, conv, &myTarget, target+sizeof(target), &mySrc, sourceLimit,
+                           NULL, NULL, NULL, NULL, TRUE, TRUE, status);
+        }
+    }
+    virtual long getOperationsPerIteration(void){
+        return srcLen;
+    }
+    ~ICUConvertToUTF8PerfFunction(){
+        ucnv_close(conv);
+        ucnv_close(utf8Conv);
+    }
+};
+
 class ICUOpenAllConvertersFunction : public UPerfFunction{
 private:
     UBool cleanup;
@@ -564,7 +613,14 @@ class  ConverterPerformanceTest : public UPerfTest{
     UPerfFunction* TestWinANSI_ISO2022JP_ToUnicode();
     UPerfFunction* TestWinANSI_ISO2022JP_FromUnicode();
     UPerfFunction* TestWinIML2_ISO2022JP_ToUnicode();
-    UPerfFunction* TestWinIML2_ISO2022JP_FromUnicode(); 
+    UPerfFunction* TestWinIML2_ISO2022JP_FromUnicode();
+
+    UPerfFunction* TestICU_SJIS_ToUTF8();
+    UPerfFunction* TestICU_SJIS_ToUTF8ViaUTF16();
+    UPerfFunction* TestICU_GBK_ToUTF8();
+    UPerfFunction* TestICU_GBK_ToUTF8ViaUTF16();
+    UPerfFunction* TestICU_Windows1252_ToUTF8();
+    UPerfFunction* TestICU_Windows1252_ToUTF8ViaUTF16(); 
 
 };
 
@@ -0,0 +1,166 @@
+/*
+**************************************************************************
+*    © 2020 and later: Unicode, Inc. and others.
+*    License & terms of use: http://www.unicode.org/copyright.html#License
+**************************************************************************
+*   file name:  csdetperf.cpp
+*   encoding:   UTF-8
+*   tab size:   8 (not used)
+*   indentation:4
+*
+*   Charset detection performance and accuracy test.
+*   The input file is converted to the --charset, which is the label that
+*   the detected charset is compared against, and is then detected
+*   with the default and with the fast detection mode.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "unicode/uperf.h"
+#include "unicode/ucnv.h"
+#include "unicode/ucsdet.h"
+#include "uoptions.h"
+#include "cmemory.h" // for UPRV_LENGTHOF
+
+// Command-line options specific to csdetperf.
+// Options do not have abbreviations: Force readable command lines.
+// (Using U+0001 for abbreviation characters.)
+enum {
+    CHARSET,
+    CSDETPERF_OPTIONS_COUNT
+};
+
+static UOption options[CSDETPERF_OPTIONS_COUNT]={
+    UOPTION_DEF("charset", '\x01', UOPT_REQUIRES_ARG)
+};
+
+static const char *const csdetperf_usage =
+    "\t--charset   Charset that the input text is converted to before detection.\n"
+    "\t            Default: UTF-8\n";
+
+// Test object with setup data.
+class CharsetDetectionPerformanceTest : public UPerfTest {
+public:
+    CharsetDetectionPerformanceTest(int32_t argc, const char *argv[], UErrorCode &status)
+            : UPerfTest(argc, argv, options, UPRV_LENGTHOF(options), csdetperf_usage, status),
+              bytes(NULL), bytesLength(0) {
+        if (U_SUCCESS(status)) {
+            charset=options[CHARSET].value;
+
+            int32_t inputLength;
+            const UChar *input=UPerfTest::getBuffer(inputLength, status);
+            if(U_FAILURE(status)) {
+                return;
+            }
+
+            // Preflight the length in the labeled charset and allocate bytes.
+            LocalUConverterPointer cnv(ucnv_open(charset, &status));
+            bytesLength=ucnv_fromUChars(cnv.getAlias(), NULL, 0, input, inputLength, &status);
+            if(status==U_BUFFER_OVERFLOW_ERROR) {
+                status=U_ZERO_ERROR;
+                bytes=(char *)malloc(bytesLength);
+                if(bytes!=NULL) {
+                    ucnv_fromUChars(cnv.getAlias(), bytes, bytesLength, input, inputLength, &status);
+                } else {
+                    status=U_MEMORY_ALLOCATION_ERROR;
+                }
+            }
+            if(U_SUCCESS(status)) {
+                printAccuracy(FALSE, status);
+                printAccuracy(TRUE, status);
+            }
+        }
+    }
+
+    ~CharsetDetectionPerformanceTest() {
+        free(bytes);
+    }
+
+    virtual UPerfFunction* runIndexedTest(int32_t index, UBool exec, const char* &name, char* par = NULL);
+
+    // Reports whether the top match agrees with the label.
+    void printAccuracy(UBool fast, UErrorCode &status) const {
+        LocalUCharsetDetectorPointer csd(ucsdet_open(&status));
+        ucsdet_enableFastDetection(csd.getAlias(), fast);
+        ucsdet_setText(csd.getAlias(), bytes, bytesLength, &status);
+        const UCharsetMatch *match=ucsdet_detect(csd.getAlias(), &status);
+        if(U_FAILURE(status) || match==NULL) {
+            return;
+        }
+        const char *name=ucsdet_getName(match, &status);
+        printf("%s detection of %s: %s (confidence %d) %s\n",
+               fast ? "fast" : "full", charset, name,
+               (int)ucsdet_getConfidence(match, &status),
+               ucnv_compareNames(name, charset)==0 ? "correct" : "WRONG");
+    }
+
+    const char *charset;
+    char *bytes;
+    int32_t bytesLength;
+};
+
+// Performance test function object.
+class Detect : public UPerfFunction {
+protected:
+    Detect(const CharsetDetectionPerformanceTest &testcase, UBool fast, UErrorCode &status)
+            : testcase(testcase), csd(ucsdet_open(&status)) {
+        ucsdet_enableFastDetection(csd.getAlias(), fast);
+    }
+
+public:
+    static UPerfFunction* get(const CharsetDetectionPerformanceTest &testcase, UBool fast) {
+        UErrorCode status=U_ZERO_ERROR;
+        Detect *detect=new Detect(testcase, fast, status);
+        if(U_FAILURE(status)) {
+            fprintf(stderr, "error: ucsdet_open() failed - %s\n", u_errorName(status));
+            delete detect;
+            return NULL;
+        }
+        return detect;
+    }
+
+    virtual void call(UErrorCode* pErrorCode) {
+        ucsdet_setText(csd.getAlias(), testcase.bytes, testcase.bytesLength, pErrorCode);
+        ucsdet_detect(csd.getAlias(), pErrorCode);
+    }
+
+    virtual long getOperationsPerIteration() {
+        return testcase.bytesLength;
+    }
+
+    const CharsetDetectionPerformanceTest &testcase;
+    LocalUCharsetDetectorPointer csd;
+};
+
+UPerfFunction* CharsetDetectionPerformanceTest::runIndexedTest(int32_t index, UBool exec, const char* &name, char* /*par*/) {
+    switch (index) {
+        case 0: name = "DetectFull"; if (exec) return Detect::get(*this, FALSE); break;
+        case 1: name = "DetectFast"; if (exec) return Detect::get(*this, TRUE); break;
+        default: name = ""; break;
+    }
+    return NULL;
+}
+
+int main(int argc, const char *argv[])
+{
+    // Default values for command-line options.
+    options[CHARSET].value = "UTF-8";
+
+    UErrorCode status = U_ZERO_ERROR;
+    CharsetDetectionPerformanceTest test(argc, argv, status);
+
+    if (U_FAILURE(status)){
+        printf("The error is %s\n", u_errorName(status));
+        test.usage();
+        return status;
+    }
+
+    if (test.run() == FALSE){
+        fprintf(stderr, "FAILED: Tests could not be run, please check the "
+                        "arguments.\n");
+        return 1;
+    }
+
+    return 0;
+}
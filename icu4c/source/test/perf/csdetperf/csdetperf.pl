@@ -0,0 +1,66 @@
+#!/usr/bin/perl
+#  ********************************************************************
+#  * Copyright (C) 2020 and later: Unicode, Inc. and others.
+#  * License & terms of use: http://www.unicode.org/copyright.html#License
+#  ********************************************************************
+
+#use strict;
+
+require "../perldriver/Common.pl";
+
+use lib '../perldriver';
+
+use PerfFramework;
+
+# Each run converts the text to the charset that labels it, and prints whether
+# full and fast detection found that charset, before timing them.
+my $options = {
+    "title"=>"Charset detection performance",
+    "headers"=>"Full Fast",
+    "operationIs"=>"input byte",
+    "passes"=>"3",
+    "time"=>"2",
+    #"outputType"=>"HTML",
+    "dataDir"=>$UDHRDataPath,
+    "outputDir"=>"../results"
+};
+
+# programs
+# tests will be done for all the programs. Results will be stored and connected
+my $p;
+if ($OnWindows) {
+    $p = "cd ".$ICULatest."/bin && ".$ICUPathLatest."/csdetperf/$WindowsPlatform/Release/csdetperf.exe";
+} else {
+    $p = "LD_LIBRARY_PATH=".$ICULatest."/source/lib:".$ICULatest."/source/tools/ctestfw ".$ICUPathLatest."/csdetperf/csdetperf";
+}
+
+# The labeled corpus: charsets, each with the texts that it can encode.
+my @corpus = (
+    "UTF-8", ["udhr_eng.txt", "udhr_deu_1996.txt", "udhr_fra.txt", "udhr_rus.txt",
+              "udhr_tha.txt", "udhr_jpn.txt", "udhr_cmn_hans.txt", "udhr_cmn_hant.txt"],
+    "UTF-16LE", ["udhr_eng.txt", "udhr_rus.txt", "udhr_jpn.txt"],
+    "ISO-8859-1", ["udhr_eng.txt", "udhr_deu_1996.txt", "udhr_fra.txt"],
+    "windows-1251", ["udhr_rus.txt"],
+    "KOI8-R", ["udhr_rus.txt"],
+    "Shift_JIS", ["udhr_jpn.txt"],
+    "EUC-JP", ["udhr_jpn.txt"],
+    "GB18030", ["udhr_cmn_hans.txt"],
+    "Big5", ["udhr_cmn_hant.txt"]
+);
+
+while (@corpus) {
+    my $charset = shift @corpus;
+    my $files = shift @corpus;
+    my $tests = {
+        "Detect $charset",
+        [
+            "$p,DetectFull --charset $charset",
+            "$p,DetectFast --charset $charset"
+        ]
+    };
+    my $dataFiles = {
+        "",
+        $files
+    };
+    runTests($options, $tests, $dataFiles);
+}
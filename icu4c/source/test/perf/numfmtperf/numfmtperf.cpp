@@ -0,0 +1,214 @@
+/*
+*******************************************************************************
+*
+*   © 2020 and later: Unicode, Inc. and others.
+*   License & terms of use: http://www.unicode.org/copyright.html#License
+*
+*******************************************************************************
+*   file name:  numfmtperf.cpp
+*   encoding:   UTF-8
+*   tab size:   8 (not used)
+*   indentation:4
+*
+*   Test performance (time & heap allocations) of steady-state number formatting
+*   with LocalizedNumberFormatter, comparing FormattedNumber::toString()
+*   with formatting into a caller-provided UTF-16 or UTF-8 buffer,
+*   and with formatting whole columns of values into one UTF-8 buffer.
+*
+*   Also measures parsing the values of CSV columns with DecimalFormat,
+*   for plain decimal numbers and for values with signs or currency symbols.
+*
+*   Run with one optional command-line argument:
+*   You can specify the path to the ICU data directory.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <atomic>
+#include "unicode/utypes.h"
+#include "unicode/numberformatter.h"
+#include "unicode/numfmt.h"
+#include "unicode/putil.h"
+#include "unicode/uclean.h"
+#include "unicode/utimer.h"
+
+using namespace icu;
+using namespace icu::number;
+
+static std::atomic<int64_t> icuAllocCount(0);
+
+U_CDECL_BEGIN
+
+// Counts the calls, and passes them on to the C library
+// so that memory allocated before the hook is installed can be freed as usual.
+void *U_CALLCONV
+my_alloc(const void * /*context*/, size_t size) {
+    ++icuAllocCount;
+    return malloc(size);
+}
+
+void *U_CALLCONV
+my_realloc(const void * /*context*/, void *mem, size_t size) {
+    ++icuAllocCount;
+    return realloc(mem, size);
+}
+
+void U_CALLCONV
+my_free(const void * /*context*/, void *mem) {
+    free(mem);
+}
+
+U_CDECL_END
+
+static const int32_t kIterations = 1000000;
+
+enum Mode { TO_STRING, UTF16_BUFFER, UTF8_BUFFER, UTF8_COLUMN };
+
+static const char *const modeNames[] = { "toString()", "char16_t buffer", "UTF-8 buffer", "UTF-8 column" };
+
+// The number of values per column in UTF8_COLUMN mode.
+static const int32_t kColumnLength = 1000;
+
+// Formats kIterations numbers and prints the time and the heap allocations per call.
+static void measure(const char *label, const LocalizedNumberFormatter &lnf, double base, Mode mode) {
+    char16_t chars[128];
+    char bytes[256];
+    UnicodeString s;
+    static double column[kColumnLength];
+    static char columnBytes[kColumnLength * 64];
+    static int32_t offsets[kColumnLength + 1];
+    for (int32_t i = 0; i < kColumnLength; ++i) {
+        column[i] = base + (i & 0xff);
+    }
+    UErrorCode errorCode = U_ZERO_ERROR;
+    int64_t allocsBefore = icuAllocCount;
+    UTimer start_time;
+    utimer_getTime(&start_time);
+    if (mode == UTF8_COLUMN) {
+        for (int32_t i = 0; i < kIterations && U_SUCCESS(errorCode); i += kColumnLength) {
+            lnf.formatDoublesToUTF8(column, kColumnLength, columnBytes, (int32_t)sizeof(columnBytes),
+                                    offsets, errorCode);
+        }
+    }
+    for (int32_t i = 0; mode != UTF8_COLUMN && i < kIterations && U_SUCCESS(errorCode); ++i) {
+        double value = base + (i & 0xff);
+        switch (mode) {
+        case TO_STRING:
+            s = lnf.formatDouble(value, errorCode).toString(errorCode);
+            break;
+        case UTF16_BUFFER:
+            lnf.formatDouble(value, chars, 128, errorCode);
+            break;
+        case UTF8_BUFFER:
+            lnf.formatDoubleToUTF8(value, bytes, 256, errorCode);
+            break;
+        case UTF8_COLUMN:
+            break;
+        }
+    }
+    double elapsed = utimer_getElapsedSeconds(&start_time);
+    int64_t allocs = icuAllocCount - allocsBefore;
+    if (U_FAILURE(errorCode)) {
+        fprintf(stderr, "%s: formatting failed - %s\n", label, u_errorName(errorCode));
+        return;
+    }
+    printf("%-24s %-16s %8.1f ns/call %6.2f allocations/call\n",
+           label, modeNames[mode], elapsed * 1e9 / kIterations, (double)allocs / kIterations);
+}
+
+// Parses a column of CSV values kIterations times in total,
+// and prints the time per value and the sum as a sanity check.
+static void measureParse(const char *label, const NumberFormat &nf, const UnicodeString values[],
+                         int32_t count) {
+    double sum = 0;
+    UTimer start_time;
+    utimer_getTime(&start_time);
+    for (int32_t i = 0; i < kIterations; ++i) {
+        Formattable result;
+        ParsePosition pos(0);
+        nf.parse(values[i % count], result, pos);
+        UErrorCode errorCode = U_ZERO_ERROR;
+        sum += result.getDouble(errorCode);
+    }
+    double elapsed = utimer_getElapsedSeconds(&start_time);
+    printf("%-24s %-16s %8.1f ns/value (sum %g)\n",
+           label, "parse()", elapsed * 1e9 / kIterations, sum);
+}
+
+static void measureParseColumns(const char *locale, UErrorCode &errorCode) {
+    LocalPointer<NumberFormat> nf(NumberFormat::createInstance(locale, errorCode), errorCode);
+    LocalPointer<NumberFormat> cf(NumberFormat::createCurrencyInstance(locale, errorCode), errorCode);
+    if (U_FAILURE(errorCode)) {
+        fprintf(stderr, "%s: creating the parsers failed - %s\n", locale, u_errorName(errorCode));
+        return;
+    }
+    // Columns of a CSV export: the values as formatted for the locale,
+    // plain, negative, and as currency amounts.
+    static const int32_t kCount = 1000;
+    UnicodeString plain[kCount], negative[kCount], amounts[kCount];
+    for (int32_t i = 0; i < kCount; ++i) {
+        double value = ((i * 7919) % 100000) * 1.25 + (i % 100) / 100.0;
+        nf->format(value, plain[i]);
+        nf->format(-value, negative[i]);
+        cf->format(value, amounts[i]);
+    }
+    char label[32];
+    sprintf(label, "CSV plain %s", locale);
+    measureParse(label, *nf, plain, kCount);
+    sprintf(label, "CSV negative %s", locale);
+    measureParse(label, *nf, negative, kCount);
+    sprintf(label, "CSV currency %s", locale);
+    measureParse(label, *cf, amounts, kCount);
+}
+
+int main(int argc, const char *argv[]) {
+    UErrorCode errorCode = U_ZERO_ERROR;
+
+    // Hook in our own memory allocation functions so that we can count the allocations.
+    u_setMemoryFunctions(NULL, my_alloc, my_realloc, my_free, &errorCode);
+    if(U_FAILURE(errorCode)) {
+        fprintf(stderr,
+                "u_setMemoryFunctions() failed - %s\n",
+                u_errorName(errorCode));
+        return errorCode;
+    }
+
+    if (argc > 1) {
+        printf("u_setDataDirectory(%s)\n", argv[1]);
+        u_setDataDirectory(argv[1]);
+    }
+
+    struct {
+        const char *label;
+        const char16_t *skeleton;
+        const char *locale;
+        double base;
+    } cases[] = {
+        { "integer en", u"", "en", 1234567 },
+        { "price de", u"currency/EUR", "de", 19.99 },
+        { "long currency en", u"currency/USD unit-width-full-name", "en", 1234567.25 },
+        { "long compact fr", u"compact-long", "fr", 123456789 },
+        { "spelled-out unit ru", u"measure-unit/length-kilometer unit-width-full-name", "ru", 12345.5 },
+    };
+    for (const auto &cas : cases) {
+        LocalizedNumberFormatter lnf =
+            NumberFormatter::forSkeleton(cas.skeleton, errorCode).locale(cas.locale);
+        // Compile the formatter before measuring.
+        lnf.formatInt(1, errorCode);
+        lnf.formatInt(1, errorCode);
+        lnf.formatInt(1, errorCode);
+        if(U_FAILURE(errorCode)) {
+            fprintf(stderr, "%s: creating the formatter failed - %s\n", cas.label, u_errorName(errorCode));
+            return errorCode;
+        }
+        for (int32_t mode = TO_STRING; mode <= UTF8_COLUMN; ++mode) {
+            measure(cas.label, lnf, cas.base, (Mode)mode);
+        }
+    }
+
+    measureParseColumns("en-US", errorCode);
+    measureParseColumns("de-DE", errorCode);
+
+    u_cleanup();
+    return 0;
+}
@@ -0,0 +1,323 @@
+/*
+**************************************************************************
+*    © 2020 and later: Unicode, Inc. and others.
+*    License & terms of use: http://www.unicode.org/copyright.html#License
+**************************************************************************
+*   file name:  regexperf.cpp
+*   encoding:   UTF-8
+*   tab size:   8 (not used)
+*   indentation:4
+*
+*   Regular expression performance test.
+*   Finds which of a set of patterns match each line of the input file,
+*   with a RegexMatcher per pattern, and with a RegexSet.
+*   The matchers also find all matches in the UTF-8 version of each line,
+*   through a UTF-8 UText and with RegexMatcher::resetUTF8().
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include "unicode/uperf.h"
+#include "unicode/regex.h"
+#include "unicode/stringpiece.h"
+#include "unicode/utext.h"
+#include "uoptions.h"
+#include "ucbuf.h"
+#include "cmemory.h" // for UPRV_LENGTHOF
+
+// Command-line options specific to regexperf.
+// Options do not have abbreviations: Force readable command lines.
+// (Using U+0001 for abbreviation characters.)
+enum {
+    PATTERNS,
+    REGEXPERF_OPTIONS_COUNT
+};
+
+static UOption options[REGEXPERF_OPTIONS_COUNT]={
+    UOPTION_DEF("patterns", '\x01', UOPT_REQUIRES_ARG)
+};
+
+static const char *const regexperf_usage =
+    "\t--patterns  Number of patterns in the set, at most 24.\n"
+    "\t            Default: 24\n";
+
+// Patterns that might be used to classify the lines of a text.
+static const char16_t *const patternStrings[] = {
+    u"(?i)freedom", u"\\brights?\\b", u"(?i)everyone", u"\\bno one\\b",
+    u"[0-9]+", u"Article \\d+", u"(?i)educat(ion|ed)", u"\\bmarri(age|ed)\\b",
+    u"\\p{Lu}{3,}", u"\\w+tion\\b", u"(?i)(dignity|conscience)", u"\\bwork\\w*",
+    u"protection of the law", u"\\(\\d\\)", u"[;:]\\s*$", u"^\\s*$",
+    u"(?i)nationality", u"\\b(he|she)\\b", u"\\w+ness\\b", u"\\bUnited Nations\\b",
+    u"(?i)\\bsecurity\\b", u"\\w+-\\w+", u"(?i)torture", u"\\bpropert(y|ies)\\b"
+};
+
+// Test object with setup data.
+class RegexPerformanceTest : public UPerfTest {
+public:
+    RegexPerformanceTest(int32_t argc, const char *argv[], UErrorCode &status)
+            : UPerfTest(argc, argv, options, UPRV_LENGTHOF(options), regexperf_usage, status),
+              patternCount(0), lines(NULL), lineCount(0), utf8Lines(NULL) {
+        if (U_SUCCESS(status)) {
+            patternCount=atoi(options[PATTERNS].value);
+            if(patternCount<=0 || patternCount>UPRV_LENGTHOF(patternStrings)) {
+                status=U_ILLEGAL_ARGUMENT_ERROR;
+                return;
+            }
+            lines=UPerfTest::getLines(status);
+            lineCount=numLines;
+            for(int32_t i=0; i<patternCount; ++i) {
+                patterns[i]=patternStrings[i];
+            }
+            if(U_SUCCESS(status)) {
+                utf8Lines=new std::string[lineCount];
+                for(int32_t i=0; i<lineCount; ++i) {
+                    UnicodeString(FALSE, lines[i].name, lines[i].len).toUTF8String(utf8Lines[i]);
+                }
+            }
+        }
+    }
+
+    virtual ~RegexPerformanceTest() {
+        delete[] utf8Lines;
+    }
+
+    virtual UPerfFunction* runIndexedTest(int32_t index, UBool exec, const char* &name, char* par = NULL);
+
+    int32_t patternCount;
+    UnicodeString patterns[UPRV_LENGTHOF(patternStrings)];
+    ULine *lines;
+    int32_t lineCount;
+    std::string *utf8Lines;
+};
+
+// Performance test function object.
+// Finds the patterns matching each line with a matcher per pattern.
+class FindEach : public UPerfFunction {
+protected:
+    FindEach(const RegexPerformanceTest &testcase, UErrorCode &status) : testcase(testcase) {
+        for(int32_t i=0; i<testcase.patternCount; ++i) {
+            matchers[i]=new RegexMatcher(testcase.patterns[i], 0, status);
+        }
+    }
+
+public:
+    static UPerfFunction* get(const RegexPerformanceTest &testcase) {
+        UErrorCode status=U_ZERO_ERROR;
+        FindEach *find=new FindEach(testcase, status);
+        if(U_FAILURE(status)) {
+            fprintf(stderr, "error: creating the matchers failed - %s\n", u_errorName(status));
+            delete find;
+            return NULL;
+        }
+        return find;
+    }
+
+    virtual ~FindEach() {
+        for(int32_t i=0; i<testcase.patternCount; ++i) {
+            delete matchers[i];
+        }
+    }
+
+    virtual void call(UErrorCode* pErrorCode) {
+        UText text=UTEXT_INITIALIZER;
+        for(int32_t i=0; i<testcase.lineCount; ++i) {
+            utext_openUChars(&text, testcase.lines[i].name, testcase.lines[i].len, pErrorCode);
+            for(int32_t j=0; j<testcase.patternCount; ++j) {
+                matchers[j]->reset(&text);
+                matchers[j]->find(*pErrorCode);
+            }
+        }
+        utext_close(&text);
+    }
+
+    virtual long getOperationsPerIteration() {
+        return testcase.lineCount;
+    }
+
+    const RegexPerformanceTest &testcase;
+    RegexMatcher *matchers[UPRV_LENGTHOF(patternStrings)];
+};
+
+// Finds the patterns matching each line with a RegexSet.
+class FindSet : public UPerfFunction {
+protected:
+    FindSet(const RegexPerformanceTest &testcase, UErrorCode &status)
+            : testcase(testcase), set(NULL) {
+        UParseError pe;
+        set=RegexSet::compile(testcase.patterns, testcase.patternCount, 0, pe, status);
+    }
+
+public:
+    static UPerfFunction* get(const RegexPerformanceTest &testcase) {
+        UErrorCode status=U_ZERO_ERROR;
+        FindSet *find=new FindSet(testcase, status);
+        if(U_FAILURE(status)) {
+            fprintf(stderr, "error: RegexSet::compile() failed - %s\n", u_errorName(status));
+            delete find;
+            return NULL;
+        }
+        return find;
+    }
+
+    virtual ~FindSet() {
+        delete set;
+    }
+
+    virtual void call(UErrorCode* pErrorCode) {
+        UText text=UTEXT_INITIALIZER;
+        int32_t indexes[UPRV_LENGTHOF(patternStrings)];
+        for(int32_t i=0; i<testcase.lineCount; ++i) {
+            utext_openUChars(&text, testcase.lines[i].name, testcase.lines[i].len, pErrorCode);
+            set->findAll(&text, indexes, UPRV_LENGTHOF(indexes), *pErrorCode);
+        }
+        utext_close(&text);
+    }
+
+    virtual long getOperationsPerIteration() {
+        return testcase.lineCount;
+    }
+
+    const RegexPerformanceTest &testcase;
+    RegexSet *set;
+};
+
+// Finds all matches of each pattern in each line of UTF-8 text,
+// through a UTF-8 UText or with resetUTF8().
+class FindAllUTF8 : public FindEach {
+protected:
+    FindAllUTF8(const RegexPerformanceTest &testcase, UBool useUText, UErrorCode &status)
+            : FindEach(testcase, status), useUText(useUText) {}
+
+public:
+    static UPerfFunction* get(const RegexPerformanceTest &testcase, UBool useUText) {
+        UErrorCode status=U_ZERO_ERROR;
+        FindAllUTF8 *find=new FindAllUTF8(testcase, useUText, status);
+        if(U_FAILURE(status)) {
+            fprintf(stderr, "error: creating the matchers failed - %s\n", u_errorName(status));
+            delete find;
+            return NULL;
+        }
+        return find;
+    }
+
+    virtual void call(UErrorCode* pErrorCode) {
+        UText text=UTEXT_INITIALIZER;
+        for(int32_t i=0; i<testcase.lineCount; ++i) {
+            const std::string &line=testcase.utf8Lines[i];
+            if(useUText) {
+                utext_openUTF8(&text, line.data(), (int64_t)line.length(), pErrorCode);
+            }
+            for(int32_t j=0; j<testcase.patternCount; ++j) {
+                if(useUText) {
+                    matchers[j]->reset(&text);
+                } else {
+                    matchers[j]->resetUTF8(line, *pErrorCode);
+                }
+                while(matchers[j]->find(*pErrorCode)) {}
+            }
+        }
+        utext_close(&text);
+    }
+
+    UBool useUText;
+};
+
+// Finds the patterns matching each line with a matcher per line and pattern,
+// as code that shares the patterns between threads would, either creating
+// the matchers or taking them from RegexPattern::acquireMatcher().
+class FindPerLine : public UPerfFunction {
+protected:
+    FindPerLine(const RegexPerformanceTest &testcase, UBool usePool, UErrorCode &status)
+            : testcase(testcase), usePool(usePool) {
+        UParseError pe;
+        for(int32_t i=0; i<testcase.patternCount; ++i) {
+            patterns[i]=RegexPattern::compile(testcase.patterns[i], 0, pe, status);
+        }
+    }
+
+public:
+    static UPerfFunction* get(const RegexPerformanceTest &testcase, UBool usePool) {
+        UErrorCode status=U_ZERO_ERROR;
+        FindPerLine *find=new FindPerLine(testcase, usePool, status);
+        if(U_FAILURE(status)) {
+            fprintf(stderr, "error: compiling the patterns failed - %s\n", u_errorName(status));
+            delete find;
+            return NULL;
+        }
+        return find;
+    }
+
+    virtual ~FindPerLine() {
+        for(int32_t i=0; i<testcase.patternCount; ++i) {
+            delete patterns[i];
+        }
+    }
+
+    virtual void call(UErrorCode* pErrorCode) {
+        UText text=UTEXT_INITIALIZER;
+        for(int32_t i=0; i<testcase.lineCount; ++i) {
+            utext_openUChars(&text, testcase.lines[i].name, testcase.lines[i].len, pErrorCode);
+            for(int32_t j=0; j<testcase.patternCount; ++j) {
+                RegexMatcher *matcher=
+                    usePool ? patterns[j]->acquireMatcher(*pErrorCode) : patterns[j]->matcher(*pErrorCode);
+                if(matcher==NULL) {
+                    continue;
+                }
+                matcher->reset(&text);
+                matcher->find(*pErrorCode);
+                if(usePool) {
+                    patterns[j]->releaseMatcher(matcher);
+                } else {
+                    delete matcher;
+                }
+            }
+        }
+        utext_close(&text);
+    }
+
+    virtual long getOperationsPerIteration() {
+        return testcase.lineCount;
+    }
+
+    const RegexPerformanceTest &testcase;
+    UBool usePool;
+    RegexPattern *patterns[UPRV_LENGTHOF(patternStrings)];
+};
+
+UPerfFunction* RegexPerformanceTest::runIndexedTest(int32_t index, UBool exec, const char* &name, char* /*par*/) {
+    switch (index) {
+        case 0: name = "FindEach"; if (exec) return FindEach::get(*this); break;
+        case 1: name = "FindSet"; if (exec) return FindSet::get(*this); break;
+        case 2: name = "FindAllUTF8UText"; if (exec) return FindAllUTF8::get(*this, TRUE); break;
+        case 3: name = "FindAllUTF8"; if (exec) return FindAllUTF8::get(*this, FALSE); break;
+        case 4: name = "NewMatcher"; if (exec) return FindPerLine::get(*this, FALSE); break;
+        case 5: name = "AcquireMatcher"; if (exec) return FindPerLine::get(*this, TRUE); break;
+        default: name = ""; break;
+    }
+    return NULL;
+}
+
+int main(int argc, const char *argv[])
+{
+    // Default values for command-line options.
+    options[PATTERNS].value = "24";
+
+    UErrorCode status = U_ZERO_ERROR;
+    RegexPerformanceTest test(argc, argv, status);
+
+    if (U_FAILURE(status)){
+        printf("The error is %s\n", u_errorName(status));
+        test.usage();
+        return status;
+    }
+
+    if (test.run() == FALSE){
+        fprintf(stderr, "FAILED: Tests could not be run, please check the "
+                        "arguments.\n");
+        return 1;
+    }
+
+    return 0;
+}
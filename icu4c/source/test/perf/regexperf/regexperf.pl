@@ -0,0 +1,82 @@
+#!/usr/bin/perl
+#  ********************************************************************
+#  * Copyright (C) 2020 and later: Unicode, Inc. and others.
+#  * License & terms of use: http://www.unicode.org/copyright.html#License
+#  ********************************************************************
+
+#use strict;
+
+require "../perldriver/Common.pl";
+
+use lib '../perldriver';
+
+use PerfFramework;
+
+# Each run finds which of a number of patterns match each line of the text,
+# with a matcher per pattern and with a RegexSet.
+my $options = {
+    "title"=>"Regular expression set performance",
+    "headers"=>"FindEach FindSet",
+    "operationIs"=>"line",
+    "passes"=>"3",
+    "time"=>"2",
+    #"outputType"=>"HTML",
+    "dataDir"=>$UDHRDataPath,
+    "outputDir"=>"../results"
+};
+
+# programs
+# tests will be done for all the programs. Results will be stored and connected
+my $p;
+if ($OnWindows) {
+    $p = "cd ".$ICULatest."/bin && ".$ICUPathLatest."/regexperf/$WindowsPlatform/Release/regexperf.exe";
+} else {
+    $p = "LD_LIBRARY_PATH=".$ICULatest."/source/lib:".$ICULatest."/source/tools/ctestfw ".$ICUPathLatest."/regexperf/regexperf";
+}
+
+foreach my $count (4, 24) {
+    my $tests = {
+        "$count patterns",
+        [
+            "$p,FindEach --patterns $count",
+            "$p,FindSet --patterns $count"
+        ]
+    };
+    my $dataFiles = {
+        "",
+        ["udhr_eng.txt", "udhr_fra.txt"]
+    };
+    runTests($options, $tests, $dataFiles);
+}
+
+# Finding all matches in UTF-8 text, through a UTF-8 UText and natively.
+$options->{"title"} = "Regular expression UTF-8 performance";
+$options->{"headers"} = "FindAllUTF8UText FindAllUTF8";
+my $tests = {
+    "UTF-8",
+    [
+        "$p,FindAllUTF8UText",
+        "$p,FindAllUTF8"
+    ]
+};
+my $dataFiles = {
+    "",
+    ["udhr_eng.txt", "udhr_fra.txt", "udhr_rus.txt"]
+};
+runTests($options, $tests, $dataFiles);
+
+# A matcher for each line, created or taken from the pattern's pool.
+$options->{"title"} = "Regular expression matcher pool performance";
+$options->{"headers"} = "NewMatcher AcquireMatcher";
+$tests = {
+    "Matcher per line",
+    [
+        "$p,NewMatcher",
+        "$p,AcquireMatcher"
+    ]
+};
+$dataFiles = {
+    "",
+    ["udhr_eng.txt", "udhr_fra.txt"]
+};
+runTests($options, $tests, $dataFiles);
@@ -0,0 +1,118 @@
+/*
+*******************************************************************************
+*
+*   © 2020 and later: Unicode, Inc. and others.
+*   License & terms of use: http://www.unicode.org/copyright.html
+*
+*******************************************************************************
+*   file name:  tzperf.cpp
+*   encoding:   UTF-8
+*   tab size:   8 (not used)
+*   indentation:4
+*
+*   Test performance of time zone offset lookups, as done by calendar
+*   computations which convert many timestamps in the same zone and era:
+*   UTC and local lookups of recent dates (in the range of the zone's final rule),
+*   of historical dates (in the range of the transition table),
+*   and a Calendar converting each timestamp to fields and back.
+*
+*   Run with one optional command-line argument:
+*   You can specify the path to the ICU data directory.
+*/
+
+#include <stdio.h>
+#include "unicode/utypes.h"
+#include "unicode/basictz.h"
+#include "unicode/calendar.h"
+#include "unicode/localpointer.h"
+#include "unicode/putil.h"
+#include "unicode/timezone.h"
+#include "unicode/uclean.h"
+#include "unicode/utimer.h"
+
+using namespace icu;
+
+static const int32_t kIterations = 1000000;
+
+enum Mode { UTC_OFFSET, LOCAL_OFFSET, CALENDAR };
+
+static const char *const modeNames[] = { "getOffset()", "getOffsetFromLocal()", "Calendar" };
+
+// Looks up kIterations timestamps about a quarter hour apart, starting at start,
+// and prints the time per lookup.
+static void measure(const char *zoneID, const char *era, UDate start, Mode mode) {
+    UErrorCode errorCode = U_ZERO_ERROR;
+    LocalPointer<BasicTimeZone> zone(
+        dynamic_cast<BasicTimeZone *>(TimeZone::createTimeZone(zoneID)));
+    if (zone.isNull()) {
+        fprintf(stderr, "%s: creating the zone failed\n", zoneID);
+        return;
+    }
+    LocalPointer<Calendar> cal(Calendar::createInstance(zone->clone(), "en@calendar=gregorian", errorCode));
+    if (U_FAILURE(errorCode)) {
+        fprintf(stderr, "%s: creating the calendar failed - %s\n", zoneID, u_errorName(errorCode));
+        return;
+    }
+    const UDate step = 900000.0 + 7919;
+    int64_t sum = 0;
+    UTimer start_time;
+    utimer_getTime(&start_time);
+    for (int32_t i = 0; i < kIterations && U_SUCCESS(errorCode); ++i) {
+        UDate date = start + i * step;
+        int32_t raw, dst;
+        switch (mode) {
+        case UTC_OFFSET:
+            zone->getOffset(date, FALSE, raw, dst, errorCode);
+            sum += raw + dst;
+            break;
+        case LOCAL_OFFSET:
+            zone->getOffsetFromLocal(date, BasicTimeZone::kFormer, BasicTimeZone::kLatter,
+                                     raw, dst, errorCode);
+            sum += raw + dst;
+            break;
+        case CALENDAR:
+            cal->setTime(date, errorCode);
+            cal->set(UCAL_MINUTE, 0);
+            sum += (int64_t)(cal->getTime(errorCode) - date);
+            break;
+        }
+    }
+    double elapsed = utimer_getElapsedSeconds(&start_time);
+    if (U_FAILURE(errorCode)) {
+        fprintf(stderr, "%s: lookup failed - %s\n", zoneID, u_errorName(errorCode));
+        return;
+    }
+    printf("%-20s %-12s %-22s %8.1f ns/call (sum %lld)\n",
+           zoneID, era, modeNames[mode], elapsed * 1e9 / kIterations, (long long)sum);
+}
+
+int main(int argc, const char *argv[]) {
+    if (argc > 1) {
+        printf("u_setDataDirectory(%s)\n", argv[1]);
+        u_setDataDirectory(argv[1]);
+    }
+
+    static const char *const zones[] = {
+        "America/New_York", "Europe/Berlin", "Australia/Sydney", "Asia/Tokyo"
+    };
+    // From 2020-01-01, in the range of the zones' final rules,
+    // and from 1960-01-01, in their transition tables.
+    // One million quarter hours are about 28 years.
+    static const struct {
+        const char *era;
+        UDate start;
+    } eras[] = {
+        { "recent", 1577836800000.0 },
+        { "historical", -315619200000.0 },
+    };
+    for (const char *zone : zones) {
+        for (const auto &era : eras) {
+            for (int32_t mode = UTC_OFFSET; mode <= CALENDAR; ++mode) {
+                measure(zone, era.era, era.start, (Mode)mode);
+            }
+        }
+    }
+
+    u_cleanup();
+    return 0;
+}
@@ -40,17 +40,25 @@
             // new behavior
             if (ucnv_canCreateConverter(converterName, &localStatus)) {
 #endif
+*
+*   Also measures how ucnv_open()/ucnv_close() scale across threads,
+*   compared with pinned converter data (ucnv_setCachePinning())
+*   and with a converter pool (ucnvpool.h).
 */
 
 #include <malloc.h>
 #include <stdio.h>
+#include <atomic>
+#include <thread>
+#include <vector>
 #include "unicode/utypes.h"
 #include "unicode/putil.h"
 #include "unicode/uclean.h"
 #include "unicode/ucnv.h"
+#include "unicode/ucnvpool.h"
 #include "unicode/utimer.h"
 
-static size_t icuMemUsage = 0;
+static std::atomic<size_t> icuMemUsage(0);
 
 U_CDECL_BEGIN
 
@@ -84,6 +92,46 @@ my_realloc(const void *context, void *mem, size_t size) {
 
 U_CDECL_END
 
+static const int32_t kIterations = 100000;
+static const char *const kConverterName = "Shift_JIS";
+
+enum OpenMode { OPEN_CLOSE, POOL };
+
+static void openCloseLoop(OpenMode mode, UConverterPool *pool) {
+    static const UChar text[] = { 0x3042, 0x3044, 0x3046 };
+    char bytes[16];
+    for (int32_t i = 0; i < kIterations; ++i) {
+        UErrorCode errorCode = U_ZERO_ERROR;
+        UConverter *cnv = mode == POOL ?
+            ucnvpool_acquire(pool, kConverterName, &errorCode) :
+            ucnv_open(kConverterName, &errorCode);
+        ucnv_fromUChars(cnv, bytes, (int32_t)sizeof(bytes), text, 3, &errorCode);
+        if (mode == POOL) {
+            ucnvpool_release(pool, cnv);
+        } else {
+            ucnv_close(cnv);
+        }
+    }
+}
+
+// Prints the throughput of open+convert+close with 1..8 threads.
+static void measureScaling(const char *label, OpenMode mode, UConverterPool *pool) {
+    for (int32_t numThreads = 1; numThreads <= 8; numThreads *= 2) {
+        UTimer start_time;
+        utimer_getTime(&start_time);
+        std::vector<std::thread> threads;
+        for (int32_t t = 0; t < numThreads; ++t) {
+            threads.push_back(std::thread(openCloseLoop, mode, pool));
+        }
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+        double elapsed = utimer_getElapsedSeconds(&start_time);
+        printf("%-28s %d thread(s): %10.0f conversions/second\n",
+               label, (int)numThreads, (numThreads * kIterations) / elapsed);
+    }
+}
+
 int main(int argc, const char *argv[]) {
     UErrorCode errorCode = U_ZERO_ERROR;
 
@@ -128,6 +176,22 @@ int main(int argc, const char *argv[]) {
     ucnv_flushCache();
     printf("memory usage after ucnv_flushCache(): %lu\n", (long)icuMemUsage);
 
+    measureScaling("ucnv_open/ucnv_close", OPEN_CLOSE, NULL);
+
+    ucnv_flushCache();
+    ucnv_setCachePinning(TRUE);
+    measureScaling("pinned ucnv_open/ucnv_close", OPEN_CLOSE, NULL);
+    ucnv_setCachePinning(FALSE);
+
+    UConverterPool *pool = ucnvpool_open(8, &errorCode);
+    if(U_FAILURE(errorCode)) {
+        fprintf(stderr, "ucnvpool_open() failed - %s\n", u_errorName(errorCode));
+        return errorCode;
+    }
+    measureScaling("ucnvpool_acquire/release", POOL, pool);
+    printf("memory usage with a warm converter pool: %lu\n", (long)icuMemUsage);
+    ucnvpool_close(pool);
+
     u_cleanup();
     printf("memory usage after u_cleanup(): %lu\n", (long)icuMemUsage);
 